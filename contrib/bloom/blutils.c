@@ -120,6 +120,7 @@ blhandler(PG_FUNCTION_ARGS)
 	amroutine->amclusterable = false;
 	amroutine->ampredlocks = false;
 	amroutine->amcanparallel = false;
+	amroutine->amcanbuildparallel = false;
 	amroutine->amkeytype = InvalidOid;
 
 	amroutine->ambuild = blbuild;
@@ -136,6 +137,7 @@ blhandler(PG_FUNCTION_ARGS)
 	amroutine->amrescan = blrescan;
 	amroutine->amgettuple = NULL;
 	amroutine->amgetbitmap = blgetbitmap;
+	amroutine->amskip = NULL;
 	amroutine->amendscan = blendscan;
 	amroutine->ammarkpos = NULL;
 	amroutine->amrestrpos = NULL;
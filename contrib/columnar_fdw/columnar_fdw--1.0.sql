@@ -0,0 +1,60 @@
+/* contrib/columnar_fdw/columnar_fdw--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION columnar_fdw" to load this file. \quit
+
+CREATE FUNCTION columnar_fdw_handler()
+RETURNS fdw_handler
+AS 'MODULE_PATHNAME'
+LANGUAGE C STRICT;
+
+CREATE FUNCTION columnar_fdw_validator(text[], oid)
+RETURNS void
+AS 'MODULE_PATHNAME'
+LANGUAGE C STRICT;
+
+CREATE FOREIGN DATA WRAPPER columnar_fdw
+  HANDLER columnar_fdw_handler
+  VALIDATOR columnar_fdw_validator;
+
+-- The data of all columnar tables: one row per column per chunk.  "data"
+-- holds the column's values for the chunk, as an array of the column's type,
+-- and "minval" and "maxval" the text form of their minimum and maximum, as
+-- output with DateStyle = ISO, IntervalStyle = postgres and
+-- extra_float_digits = 3.
+CREATE TABLE columnar_chunk (
+    relid oid NOT NULL,
+    stripe int8 NOT NULL,
+    chunkno int4 NOT NULL,
+    attnum int2 NOT NULL,
+    typid oid NOT NULL,
+    nrows int4 NOT NULL,
+    nnulls int4 NOT NULL,
+    minval text,
+    maxval text,
+    data bytea NOT NULL,
+    PRIMARY KEY (relid, stripe, chunkno, attnum)
+);
+
+-- Source of the stripe numbers, one per INSERT or COPY
+CREATE SEQUENCE columnar_stripe_seq;
+
+REVOKE ALL ON columnar_chunk, columnar_stripe_seq FROM PUBLIC;
+
+-- Remove the data of columnar tables when they are dropped
+CREATE FUNCTION columnar_drop_trigger()
+RETURNS event_trigger
+LANGUAGE plpgsql
+SECURITY DEFINER
+SET search_path = pg_catalog
+AS $$
+BEGIN
+    DELETE FROM columnar.columnar_chunk
+    WHERE relid IN (SELECT objid FROM pg_event_trigger_dropped_objects()
+                    WHERE classid = 'pg_class'::regclass
+                      AND objsubid = 0);
+END;
+$$;
+
+CREATE EVENT TRIGGER columnar_drop_trigger ON sql_drop
+    EXECUTE PROCEDURE columnar_drop_trigger();
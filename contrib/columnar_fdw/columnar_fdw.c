@@ -0,0 +1,1543 @@
+/*-------------------------------------------------------------------------
+ *
+ * columnar_fdw.c
+ *		  foreign-data wrapper for column-oriented, compressed table storage.
+ *
+ * A columnar_fdw foreign table keeps its data in the extension's
+ * columnar.columnar_chunk table, rather than in a heap of its own.  Rows are
+ * appended a chunk at a time (chunk_rows rows, 10000 by default), and each
+ * column of a chunk is stored as a separate columnar_chunk row, holding the
+ * column's values for the whole chunk as an array, along with their minimum
+ * and maximum.  The data arrays are generally big enough to be compressed
+ * and moved out of line by TOAST, so that:
+ *
+ * - a scan fetches and decompresses only the columns the query uses, and
+ * - a scan with a qual of the form "column op constant" skips every chunk
+ *	 whose range of values for the column can't satisfy it, without
+ *	 fetching any of its data.
+ *
+ * Because the chunk table is an ordinary table, the data is WAL-logged,
+ * MVCC-visible and vacuumed like any other.  Only INSERT is supported; the
+ * rows inserted by one statement form a "stripe" of consecutive chunks.
+ *
+ * The minimum and maximum are kept in text form, so that they can be
+ * examined with SQL; they're written and read with the same settings that
+ * postgres_fdw uses to transmit values, so that the round trip is exact.
+ * The data arrays are kept in the server's internal array format, since
+ * converting every value to and from text would defeat the purpose.
+ *
+ * Copyright (c) 2017, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *		  contrib/columnar_fdw/columnar_fdw.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <math.h>
+
+#include "access/genam.h"
+#include "access/heapam.h"
+#include "access/htup_details.h"
+#include "access/nbtree.h"
+#include "access/reloptions.h"
+#include "access/sysattr.h"
+#include "catalog/namespace.h"
+#include "catalog/pg_foreign_table.h"
+#include "catalog/pg_type.h"
+#include "commands/defrem.h"
+#include "commands/explain.h"
+#include "commands/sequence.h"
+#include "commands/vacuum.h"
+#include "executor/spi.h"
+#include "foreign/fdwapi.h"
+#include "foreign/foreign.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/cost.h"
+#include "optimizer/pathnode.h"
+#include "optimizer/planmain.h"
+#include "optimizer/restrictinfo.h"
+#include "optimizer/var.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/datum.h"
+#include "utils/fmgroids.h"
+#include "utils/guc.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/rel.h"
+#include "utils/sampling.h"
+#include "utils/snapmgr.h"
+#include "utils/typcache.h"
+
+PG_MODULE_MAGIC;
+
+/* Names of the extension's objects that hold the data */
+#define COLUMNAR_SCHEMA			"columnar"
+#define COLUMNAR_CHUNK_TABLE	"columnar_chunk"
+#define COLUMNAR_CHUNK_INDEX	"columnar_chunk_pkey"
+#define COLUMNAR_STRIPE_SEQ		"columnar_stripe_seq"
+
+/* Columns of columnar_chunk */
+#define Natts_columnar_chunk			10
+#define Anum_columnar_chunk_relid		1
+#define Anum_columnar_chunk_stripe		2
+#define Anum_columnar_chunk_chunkno		3
+#define Anum_columnar_chunk_attnum		4
+#define Anum_columnar_chunk_typid		5
+#define Anum_columnar_chunk_nrows		6
+#define Anum_columnar_chunk_nnulls		7
+#define Anum_columnar_chunk_minval		8
+#define Anum_columnar_chunk_maxval		9
+#define Anum_columnar_chunk_data		10
+
+#define DEFAULT_CHUNK_ROWS		10000
+#define MAX_CHUNK_ROWS			1000000
+
+/*
+ * FDW-specific information for RelOptInfo.fdw_private.
+ */
+typedef struct ColumnarFdwPlanState
+{
+	double		ntuples;		/* number of rows stored */
+	double		nchunks;		/* number of chunks they're stored in */
+} ColumnarFdwPlanState;
+
+/*
+ * Reader for the columnar_chunk rows of one table, a chunk at a time.
+ */
+typedef struct ChunkReader
+{
+	MemoryContext cxt;			/* holds the rows; outlives each call */
+	Relation	chunkrel;
+	Relation	chunkidx;
+	SysScanDesc scan;
+	HeapTuple	pending;		/* first row of next chunk, if already read */
+	bool		done;			/* has the index scan run out? */
+	int			maxattnum;		/* ignore rows for higher attnums */
+
+	/* The current chunk */
+	int32		nrows;			/* number of rows in it */
+	HeapTuple  *rows;			/* columnar_chunk rows, indexed by attnum - 1;
+								 * NULL for a column with no data */
+} ChunkReader;
+
+/*
+ * A qual that lets us skip chunks by looking at the minimum and maximum
+ * value of a column: "column op constant", where op is a btree operator.
+ */
+typedef struct ColumnarSkipClause
+{
+	AttrNumber	attnum;
+	StrategyNumber strategy;	/* with the column on the left */
+	FmgrInfo	cmpproc;		/* btree comparison, column vs constant */
+	Oid			collation;
+	Datum		constvalue;
+	FmgrInfo	typinput;		/* to read the column's minimum and maximum */
+	Oid			typioparam;
+	int32		typmod;
+} ColumnarSkipClause;
+
+/*
+ * FDW-specific information for ForeignScanState.fdw_state.
+ */
+typedef struct ColumnarFdwScanState
+{
+	ChunkReader *reader;
+	bool	   *needed;			/* which attributes to fetch */
+	List	   *skipclauses;	/* ColumnarSkipClauses */
+	MemoryContext chunkcxt;		/* holds the current chunk's column data */
+
+	/* The current chunk */
+	int			nrows;
+	int			rowno;			/* next row to return */
+	Datum	  **values;			/* values[attnum - 1][rowno] */
+	bool	  **nulls;			/* NULL for a column not fetched */
+
+	/* For EXPLAIN ANALYZE */
+	long		chunks_read;
+	long		chunks_skipped;
+} ColumnarFdwScanState;
+
+/*
+ * FDW-specific information for ResultRelInfo.ri_FdwState.
+ */
+typedef struct ColumnarFdwModifyState
+{
+	Relation	rel;			/* the foreign table */
+	Relation	chunkrel;
+	SPIPlanPtr	insertplan;		/* inserts one columnar_chunk row */
+	int			chunk_rows;
+	int64		stripe;			/* -1 until the first chunk is written */
+	int32		chunkno;		/* next chunk number in stripe */
+
+	/* Per-attribute information */
+	FmgrInfo  **cmpproc;		/* btree comparison function, or NULL if we
+								 * don't keep the minimum and maximum */
+	FmgrInfo  **outproc;		/* output function, if cmpproc isn't NULL */
+
+	/* Rows buffered for the next chunk */
+	MemoryContext buffercxt;	/* holds buffered values */
+	int			nbuffered;
+	Datum	  **values;			/* values[attnum - 1][row] */
+	bool	  **nulls;
+} ColumnarFdwModifyState;
+
+/*
+ * SQL functions
+ */
+PG_FUNCTION_INFO_V1(columnar_fdw_handler);
+PG_FUNCTION_INFO_V1(columnar_fdw_validator);
+
+/*
+ * FDW callback routines
+ */
+static void columnarGetForeignRelSize(PlannerInfo *root,
+						  RelOptInfo *baserel,
+						  Oid foreigntableid);
+static void columnarGetForeignPaths(PlannerInfo *root,
+						RelOptInfo *baserel,
+						Oid foreigntableid);
+static ForeignScan *columnarGetForeignPlan(PlannerInfo *root,
+					   RelOptInfo *baserel,
+					   Oid foreigntableid,
+					   ForeignPath *best_path,
+					   List *tlist,
+					   List *scan_clauses,
+					   Plan *outer_plan);
+static void columnarExplainForeignScan(ForeignScanState *node,
+						   ExplainState *es);
+static void columnarBeginForeignScan(ForeignScanState *node, int eflags);
+static TupleTableSlot *columnarIterateForeignScan(ForeignScanState *node);
+static void columnarReScanForeignScan(ForeignScanState *node);
+static void columnarEndForeignScan(ForeignScanState *node);
+static void columnarBeginForeignModify(ModifyTableState *mtstate,
+						   ResultRelInfo *rinfo,
+						   List *fdw_private,
+						   int subplan_index,
+						   int eflags);
+static TupleTableSlot *columnarExecForeignInsert(EState *estate,
+						  ResultRelInfo *rinfo,
+						  TupleTableSlot *slot,
+						  TupleTableSlot *planSlot);
+static void columnarEndForeignModify(EState *estate,
+						 ResultRelInfo *rinfo);
+static int	columnarIsForeignRelUpdatable(Relation rel);
+static bool columnarAnalyzeForeignTable(Relation relation,
+							AcquireSampleRowsFunc *func,
+							BlockNumber *totalpages);
+
+/*
+ * Helper functions
+ */
+static int	get_chunk_rows(Oid foreigntableid);
+static Oid	get_columnar_relid(const char *relname);
+static ChunkReader *chunk_reader_begin(Oid relid, Snapshot snapshot,
+				   int maxattnum);
+static bool chunk_reader_next(ChunkReader *reader);
+static void chunk_reader_end(ChunkReader *reader);
+static bool analyze_skip_clause(Expr *clause, TupleDesc tupdesc,
+					ColumnarSkipClause *skip);
+static bool chunk_can_be_skipped(ColumnarFdwScanState *state,
+					 TupleDesc tupdesc);
+static void load_chunk(ColumnarFdwScanState *state, TupleDesc tupdesc,
+		   Oid relid);
+static void flush_chunk(ColumnarFdwModifyState *state);
+static int	set_transmission_modes(void);
+static void reset_transmission_modes(int nestlevel);
+static int columnar_acquire_sample_rows(Relation onerel, int elevel,
+							 HeapTuple *rows, int targrows,
+							 double *totalrows,
+							 double *totaldeadrows);
+
+
+/*
+ * Foreign-data wrapper handler function: return a struct with pointers
+ * to my callback routines.
+ */
+Datum
+columnar_fdw_handler(PG_FUNCTION_ARGS)
+{
+	FdwRoutine *fdwroutine = makeNode(FdwRoutine);
+
+	fdwroutine->GetForeignRelSize = columnarGetForeignRelSize;
+	fdwroutine->GetForeignPaths = columnarGetForeignPaths;
+	fdwroutine->GetForeignPlan = columnarGetForeignPlan;
+	fdwroutine->ExplainForeignScan = columnarExplainForeignScan;
+	fdwroutine->BeginForeignScan = columnarBeginForeignScan;
+	fdwroutine->IterateForeignScan = columnarIterateForeignScan;
+	fdwroutine->ReScanForeignScan = columnarReScanForeignScan;
+	fdwroutine->EndForeignScan = columnarEndForeignScan;
+	fdwroutine->BeginForeignModify = columnarBeginForeignModify;
+	fdwroutine->ExecForeignInsert = columnarExecForeignInsert;
+	fdwroutine->EndForeignModify = columnarEndForeignModify;
+	fdwroutine->IsForeignRelUpdatable = columnarIsForeignRelUpdatable;
+	fdwroutine->AnalyzeForeignTable = columnarAnalyzeForeignTable;
+
+	PG_RETURN_POINTER(fdwroutine);
+}
+
+/*
+ * Validate the generic options given to a FOREIGN DATA WRAPPER, SERVER,
+ * USER MAPPING or FOREIGN TABLE that uses columnar_fdw.
+ *
+ * The only option is chunk_rows, for foreign tables.
+ */
+Datum
+columnar_fdw_validator(PG_FUNCTION_ARGS)
+{
+	List	   *options_list = untransformRelOptions(PG_GETARG_DATUM(0));
+	Oid			catalog = PG_GETARG_OID(1);
+	ListCell   *cell;
+
+	foreach(cell, options_list)
+	{
+		DefElem    *def = (DefElem *) lfirst(cell);
+
+		if (catalog == ForeignTableRelationId &&
+			strcmp(def->defname, "chunk_rows") == 0)
+		{
+			int			chunk_rows;
+
+			if (!parse_int(defGetString(def), &chunk_rows, 0, NULL) ||
+				chunk_rows < 1 || chunk_rows > MAX_CHUNK_ROWS)
+				ereport(ERROR,
+						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+						 errmsg("\"%s\" must be an integer between %d and %d",
+								def->defname, 1, MAX_CHUNK_ROWS)));
+		}
+		else
+			ereport(ERROR,
+					(errcode(ERRCODE_FDW_INVALID_OPTION_NAME),
+					 errmsg("invalid option \"%s\"", def->defname),
+					 catalog == ForeignTableRelationId
+					 ? errhint("Valid options in this context are: %s",
+							   "chunk_rows")
+					 : errhint("There are no valid options in this context.")));
+	}
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * Fetch the chunk_rows option of a columnar_fdw foreign table.
+ */
+static int
+get_chunk_rows(Oid foreigntableid)
+{
+	ForeignTable *table = GetForeignTable(foreigntableid);
+	ListCell   *lc;
+
+	foreach(lc, table->options)
+	{
+		DefElem    *def = (DefElem *) lfirst(lc);
+
+		if (strcmp(def->defname, "chunk_rows") == 0)
+			return pg_atoi(defGetString(def), sizeof(int32), 0);
+	}
+
+	return DEFAULT_CHUNK_ROWS;
+}
+
+/*
+ * Look up one of the relations that make up the extension's storage.
+ */
+static Oid
+get_columnar_relid(const char *relname)
+{
+	Oid			relid;
+
+	relid = get_relname_relid(relname,
+							  get_namespace_oid(COLUMNAR_SCHEMA, false));
+	if (!OidIsValid(relid))
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_TABLE),
+				 errmsg("relation \"%s.%s\" does not exist",
+						COLUMNAR_SCHEMA, relname)));
+
+	return relid;
+}
+
+/*
+ * Start reading the chunks stored for a table, in order.
+ *
+ * Rows for columns beyond maxattnum aren't kept, and maxattnum can be zero
+ * if only the chunk sizes are of interest.  A NULL snapshot means to use a
+ * catalog snapshot, as in systable_beginscan_ordered.
+ */
+static ChunkReader *
+chunk_reader_begin(Oid relid, Snapshot snapshot, int maxattnum)
+{
+	ChunkReader *reader = (ChunkReader *) palloc0(sizeof(ChunkReader));
+	ScanKeyData key;
+
+	reader->cxt = CurrentMemoryContext;
+	reader->chunkrel = heap_open(get_columnar_relid(COLUMNAR_CHUNK_TABLE),
+								 AccessShareLock);
+	reader->chunkidx = index_open(get_columnar_relid(COLUMNAR_CHUNK_INDEX),
+								  AccessShareLock);
+
+	ScanKeyInit(&key,
+				Anum_columnar_chunk_relid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(relid));
+	reader->scan = systable_beginscan_ordered(reader->chunkrel,
+											  reader->chunkidx,
+											  snapshot, 1, &key);
+
+	reader->maxattnum = maxattnum;
+	if (maxattnum > 0)
+		reader->rows = (HeapTuple *) palloc0(maxattnum * sizeof(HeapTuple));
+
+	return reader;
+}
+
+/*
+ * Advance to the next chunk.  Returns false if there are no more.
+ */
+static bool
+chunk_reader_next(ChunkReader *reader)
+{
+	TupleDesc	tupdesc = RelationGetDescr(reader->chunkrel);
+	HeapTuple	tuple;
+	bool		isnull;
+	int64		stripe;
+	int32		chunkno;
+	MemoryContext oldcontext;
+	int			i;
+
+	for (i = 0; i < reader->maxattnum; i++)
+	{
+		if (reader->rows[i] != NULL)
+			heap_freetuple(reader->rows[i]);
+		reader->rows[i] = NULL;
+	}
+
+	/* The caller's context may be reset before we're called again */
+	oldcontext = MemoryContextSwitchTo(reader->cxt);
+
+	tuple = reader->pending;
+	reader->pending = NULL;
+	if (tuple == NULL)
+	{
+		/* Don't ask again once the scan has ended; it would start over */
+		if (!reader->done)
+			tuple = systable_getnext_ordered(reader->scan,
+											 ForwardScanDirection);
+		if (!HeapTupleIsValid(tuple))
+		{
+			reader->done = true;
+			MemoryContextSwitchTo(oldcontext);
+			return false;
+		}
+		tuple = heap_copytuple(tuple);
+	}
+
+	stripe = DatumGetInt64(heap_getattr(tuple, Anum_columnar_chunk_stripe,
+										tupdesc, &isnull));
+	chunkno = DatumGetInt32(heap_getattr(tuple, Anum_columnar_chunk_chunkno,
+										 tupdesc, &isnull));
+	reader->nrows = DatumGetInt32(heap_getattr(tuple, Anum_columnar_chunk_nrows,
+											   tupdesc, &isnull));
+
+	/* Collect the rows for all the columns of this chunk */
+	for (;;)
+	{
+		int			attnum;
+
+		attnum = DatumGetInt16(heap_getattr(tuple, Anum_columnar_chunk_attnum,
+											tupdesc, &isnull));
+		if (attnum >= 1 && attnum <= reader->maxattnum)
+			reader->rows[attnum - 1] = tuple;
+		else
+			heap_freetuple(tuple);
+
+		tuple = systable_getnext_ordered(reader->scan, ForwardScanDirection);
+		if (!HeapTupleIsValid(tuple))
+		{
+			reader->done = true;
+			break;
+		}
+		tuple = heap_copytuple(tuple);
+
+		if (DatumGetInt64(heap_getattr(tuple, Anum_columnar_chunk_stripe,
+									   tupdesc, &isnull)) != stripe ||
+			DatumGetInt32(heap_getattr(tuple, Anum_columnar_chunk_chunkno,
+									   tupdesc, &isnull)) != chunkno)
+		{
+			reader->pending = tuple;
+			break;
+		}
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return true;
+}
+
+/*
+ * Finish reading chunks.
+ */
+static void
+chunk_reader_end(ChunkReader *reader)
+{
+	int			i;
+
+	for (i = 0; i < reader->maxattnum; i++)
+	{
+		if (reader->rows[i] != NULL)
+			heap_freetuple(reader->rows[i]);
+	}
+	if (reader->pending != NULL)
+		heap_freetuple(reader->pending);
+
+	systable_endscan_ordered(reader->scan);
+	index_close(reader->chunkidx, AccessShareLock);
+	heap_close(reader->chunkrel, AccessShareLock);
+}
+
+/*
+ * columnarGetForeignRelSize
+ *		Obtain relation size estimates for a foreign table
+ *
+ * ANALYZE records the number of rows in pg_class.reltuples, and the number
+ * of chunks in relpages.  If the table hasn't been analyzed, we fake it, as
+ * postgres_fdw does.
+ */
+static void
+columnarGetForeignRelSize(PlannerInfo *root,
+						  RelOptInfo *baserel,
+						  Oid foreigntableid)
+{
+	ColumnarFdwPlanState *fdw_private;
+	Selectivity sel;
+
+	fdw_private = (ColumnarFdwPlanState *) palloc0(sizeof(ColumnarFdwPlanState));
+
+	if (baserel->pages > 0)
+	{
+		fdw_private->ntuples = baserel->tuples;
+		fdw_private->nchunks = baserel->pages;
+	}
+	else
+	{
+		int			tuple_width;
+
+		tuple_width = MAXALIGN(baserel->reltarget->width) +
+			MAXALIGN(SizeofHeapTupleHeader);
+		fdw_private->ntuples = (10 * BLCKSZ) / tuple_width;
+		fdw_private->nchunks = ceil(fdw_private->ntuples /
+									get_chunk_rows(foreigntableid));
+	}
+
+	baserel->fdw_private = (void *) fdw_private;
+
+	sel = clauselist_selectivity(root,
+								 baserel->baserestrictinfo,
+								 0,
+								 JOIN_INNER,
+								 NULL);
+	baserel->rows = clamp_row_est(fdw_private->ntuples * sel);
+}
+
+/*
+ * columnarGetForeignPaths
+ *		Create possible access paths for a scan on the foreign table
+ *
+ *		There is just one, returning the rows in the order they were
+ *		inserted.  We charge one page fetch for each column of each chunk,
+ *		regardless of how many columns are needed: reading fewer columns
+ *		makes a columnar table cheaper to scan, but not cheaper than
+ *		alternatives such as an index scan on a different table, so there's
+ *		little point in refining this.
+ */
+static void
+columnarGetForeignPaths(PlannerInfo *root,
+						RelOptInfo *baserel,
+						Oid foreigntableid)
+{
+	ColumnarFdwPlanState *fdw_private =
+	(ColumnarFdwPlanState *) baserel->fdw_private;
+	Cost		startup_cost;
+	Cost		run_cost;
+	Cost		cpu_per_tuple;
+
+	startup_cost = baserel->baserestrictcost.startup;
+	cpu_per_tuple = cpu_tuple_cost + baserel->baserestrictcost.per_tuple;
+	run_cost = seq_page_cost * fdw_private->nchunks +
+		cpu_per_tuple * fdw_private->ntuples;
+
+	add_path(baserel, (Path *)
+			 create_foreignscan_path(root, baserel,
+									 NULL,	/* default pathtarget */
+									 baserel->rows,
+									 startup_cost,
+									 startup_cost + run_cost,
+									 NIL,	/* no pathkeys */
+									 NULL,	/* no outer rel either */
+									 NULL,	/* no extra plan */
+									 NIL));
+}
+
+/*
+ * columnarGetForeignPlan
+ *		Create a ForeignScan plan node for scanning the foreign table
+ *
+ * fdw_private holds the attribute numbers of the columns the query needs,
+ * and the restriction clauses that can be used to skip chunks.  The latter
+ * are still checked for every row, by the executor.
+ */
+static ForeignScan *
+columnarGetForeignPlan(PlannerInfo *root,
+					   RelOptInfo *baserel,
+					   Oid foreigntableid,
+					   ForeignPath *best_path,
+					   List *tlist,
+					   List *scan_clauses,
+					   Plan *outer_plan)
+{
+	Bitmapset  *attrs_used = NULL;
+	List	   *attnums = NIL;
+	List	   *skipclauses = NIL;
+	Relation	rel;
+	TupleDesc	tupdesc;
+	ListCell   *lc;
+	int			i;
+
+	/* Collect all the attributes needed for joins, output or quals. */
+	pull_varattnos((Node *) baserel->reltarget->exprs, baserel->relid,
+				   &attrs_used);
+	foreach(lc, baserel->baserestrictinfo)
+	{
+		RestrictInfo *rinfo = (RestrictInfo *) lfirst(lc);
+
+		pull_varattnos((Node *) rinfo->clause, baserel->relid,
+					   &attrs_used);
+	}
+
+	rel = heap_open(foreigntableid, AccessShareLock);
+	tupdesc = RelationGetDescr(rel);
+
+	for (i = 1; i <= tupdesc->natts; i++)
+	{
+		if (TupleDescAttr(tupdesc, i - 1)->attisdropped)
+			continue;
+
+		/* a whole-row reference needs every column */
+		if (bms_is_member(i - FirstLowInvalidHeapAttributeNumber, attrs_used) ||
+			bms_is_member(0 - FirstLowInvalidHeapAttributeNumber, attrs_used))
+			attnums = lappend_int(attnums, i);
+	}
+
+	scan_clauses = extract_actual_clauses(scan_clauses, false);
+	foreach(lc, scan_clauses)
+	{
+		Expr	   *clause = (Expr *) lfirst(lc);
+
+		if (analyze_skip_clause(clause, tupdesc, NULL))
+			skipclauses = lappend(skipclauses, clause);
+	}
+
+	heap_close(rel, AccessShareLock);
+
+	/* Create the ForeignScan node */
+	return make_foreignscan(tlist,
+							scan_clauses,
+							baserel->relid,
+							NIL,	/* no expressions to evaluate */
+							list_make2(attnums, skipclauses),
+							NIL,	/* no custom tlist */
+							NIL,	/* no remote quals */
+							outer_plan);
+}
+
+/*
+ * Check whether a restriction clause can be used to skip chunks, and if so,
+ * and skip isn't NULL, fill in *skip for it.
+ *
+ * The clause must compare a column with a non-null constant, using an
+ * operator of the column type's default btree operator family, and the same
+ * collation that was used to compute the column's minimum and maximum.
+ */
+static bool
+analyze_skip_clause(Expr *clause, TupleDesc tupdesc, ColumnarSkipClause *skip)
+{
+	OpExpr	   *opexpr;
+	Node	   *leftop;
+	Node	   *rightop;
+	Var		   *var;
+	Const	   *con;
+	Form_pg_attribute attr;
+	TypeCacheEntry *typentry;
+	int			strategy;
+	Oid			lefttype;
+	Oid			righttype;
+	Oid			cmpproc;
+
+	if (!IsA(clause, OpExpr))
+		return false;
+	opexpr = (OpExpr *) clause;
+	if (list_length(opexpr->args) != 2)
+		return false;
+
+	leftop = (Node *) linitial(opexpr->args);
+	rightop = (Node *) lsecond(opexpr->args);
+	if (IsA(leftop, Var) && IsA(rightop, Const))
+	{
+		var = (Var *) leftop;
+		con = (Const *) rightop;
+	}
+	else if (IsA(leftop, Const) && IsA(rightop, Var))
+	{
+		var = (Var *) rightop;
+		con = (Const *) leftop;
+	}
+	else
+		return false;
+
+	if (var->varattno <= 0 || var->varattno > tupdesc->natts ||
+		con->constisnull)
+		return false;
+
+	attr = TupleDescAttr(tupdesc, var->varattno - 1);
+	if (var->vartype != attr->atttypid ||
+		opexpr->inputcollid != attr->attcollation)
+		return false;
+
+	typentry = lookup_type_cache(attr->atttypid, TYPECACHE_BTREE_OPFAMILY);
+	if (!OidIsValid(typentry->btree_opf) ||
+		!op_in_opfamily(opexpr->opno, typentry->btree_opf))
+		return false;
+
+	get_op_opfamily_properties(opexpr->opno, typentry->btree_opf, false,
+							   &strategy, &lefttype, &righttype);
+	if ((Node *) var == rightop)
+	{
+		Oid			tmp = lefttype;
+
+		/* commute, so that the column is on the left */
+		strategy = BTCommuteStrategyNumber(strategy);
+		lefttype = righttype;
+		righttype = tmp;
+	}
+
+	cmpproc = get_opfamily_proc(typentry->btree_opf, lefttype, righttype,
+								BTORDER_PROC);
+	if (!OidIsValid(cmpproc))
+		return false;
+
+	if (skip != NULL)
+	{
+		Oid			typinput;
+
+		skip->attnum = var->varattno;
+		skip->strategy = strategy;
+		fmgr_info(cmpproc, &skip->cmpproc);
+		skip->collation = opexpr->inputcollid;
+		skip->constvalue = con->constvalue;
+		getTypeInputInfo(attr->atttypid, &typinput, &skip->typioparam);
+		fmgr_info(typinput, &skip->typinput);
+		skip->typmod = attr->atttypmod;
+	}
+
+	return true;
+}
+
+/*
+ * columnarExplainForeignScan
+ *		Produce extra output for EXPLAIN
+ */
+static void
+columnarExplainForeignScan(ForeignScanState *node, ExplainState *es)
+{
+	ColumnarFdwScanState *state = (ColumnarFdwScanState *) node->fdw_state;
+
+	if (es->analyze && state != NULL)
+	{
+		ExplainPropertyLong("Chunks Read", state->chunks_read, es);
+		ExplainPropertyLong("Chunks Skipped", state->chunks_skipped, es);
+	}
+}
+
+/*
+ * columnarBeginForeignScan
+ *		Initiate access to the table's chunks
+ */
+static void
+columnarBeginForeignScan(ForeignScanState *node, int eflags)
+{
+	ForeignScan *plan = (ForeignScan *) node->ss.ps.plan;
+	Relation	rel = node->ss.ss_currentRelation;
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	ColumnarFdwScanState *state;
+	ListCell   *lc;
+
+	/*
+	 * Do nothing in EXPLAIN (no ANALYZE) case.  node->fdw_state stays NULL.
+	 */
+	if (eflags & EXEC_FLAG_EXPLAIN_ONLY)
+		return;
+
+	state = (ColumnarFdwScanState *) palloc0(sizeof(ColumnarFdwScanState));
+
+	state->needed = (bool *) palloc0(tupdesc->natts * sizeof(bool));
+	foreach(lc, (List *) linitial(plan->fdw_private))
+		state->needed[lfirst_int(lc) - 1] = true;
+
+	foreach(lc, (List *) lsecond(plan->fdw_private))
+	{
+		ColumnarSkipClause *skip;
+
+		skip = (ColumnarSkipClause *) palloc(sizeof(ColumnarSkipClause));
+		if (!analyze_skip_clause((Expr *) lfirst(lc), tupdesc, skip))
+			elog(ERROR, "unexpected columnar_fdw skip clause");
+		state->skipclauses = lappend(state->skipclauses, skip);
+	}
+
+	state->chunkcxt = AllocSetContextCreate(CurrentMemoryContext,
+											"columnar_fdw chunk",
+											ALLOCSET_DEFAULT_SIZES);
+	state->values = (Datum **) palloc0(tupdesc->natts * sizeof(Datum *));
+	state->nulls = (bool **) palloc0(tupdesc->natts * sizeof(bool *));
+
+	state->reader = chunk_reader_begin(RelationGetRelid(rel),
+									   node->ss.ps.state->es_snapshot,
+									   tupdesc->natts);
+
+	node->fdw_state = (void *) state;
+}
+
+/*
+ * Can the reader's current chunk be skipped, based on the skip clauses?
+ */
+static bool
+chunk_can_be_skipped(ColumnarFdwScanState *state, TupleDesc tupdesc)
+{
+	TupleDesc	chunkdesc = RelationGetDescr(state->reader->chunkrel);
+	bool		skipit = false;
+	int			nestlevel;
+	ListCell   *lc;
+
+	if (state->skipclauses == NIL)
+		return false;
+
+	/* Read the minimum and maximum values the same way they were written */
+	nestlevel = set_transmission_modes();
+
+	foreach(lc, state->skipclauses)
+	{
+		ColumnarSkipClause *skip = (ColumnarSkipClause *) lfirst(lc);
+		HeapTuple	row = state->reader->rows[skip->attnum - 1];
+		Datum		values[Natts_columnar_chunk];
+		bool		isnull[Natts_columnar_chunk];
+		Oid			typid;
+		char	   *str;
+		Datum		minval;
+		Datum		maxval;
+		int32		mincmp;
+		int32		maxcmp;
+
+		/*
+		 * The skip clauses are strict, so a chunk in which the column is all
+		 * nulls can always be skipped.  That includes the case where the
+		 * column was added after the chunk was written.
+		 */
+		if (row == NULL)
+		{
+			skipit = true;
+			break;
+		}
+		heap_deform_tuple(row, chunkdesc, values, isnull);
+		if (DatumGetInt32(values[Anum_columnar_chunk_nnulls - 1]) ==
+			DatumGetInt32(values[Anum_columnar_chunk_nrows - 1]))
+		{
+			skipit = true;
+			break;
+		}
+		typid = DatumGetObjectId(values[Anum_columnar_chunk_typid - 1]);
+		if (typid != TupleDescAttr(tupdesc, skip->attnum - 1)->atttypid ||
+			isnull[Anum_columnar_chunk_minval - 1] ||
+			isnull[Anum_columnar_chunk_maxval - 1])
+			continue;
+
+		str = TextDatumGetCString(values[Anum_columnar_chunk_minval - 1]);
+		minval = InputFunctionCall(&skip->typinput, str,
+								   skip->typioparam, skip->typmod);
+		str = TextDatumGetCString(values[Anum_columnar_chunk_maxval - 1]);
+		maxval = InputFunctionCall(&skip->typinput, str,
+								   skip->typioparam, skip->typmod);
+
+		mincmp = DatumGetInt32(FunctionCall2Coll(&skip->cmpproc,
+												 skip->collation,
+												 minval,
+												 skip->constvalue));
+		maxcmp = DatumGetInt32(FunctionCall2Coll(&skip->cmpproc,
+												 skip->collation,
+												 maxval,
+												 skip->constvalue));
+
+		switch (skip->strategy)
+		{
+			case BTLessStrategyNumber:
+				skipit = (mincmp >= 0);
+				break;
+			case BTLessEqualStrategyNumber:
+				skipit = (mincmp > 0);
+				break;
+			case BTEqualStrategyNumber:
+				skipit = (mincmp > 0 || maxcmp < 0);
+				break;
+			case BTGreaterEqualStrategyNumber:
+				skipit = (maxcmp < 0);
+				break;
+			case BTGreaterStrategyNumber:
+				skipit = (maxcmp <= 0);
+				break;
+			default:
+				elog(ERROR, "unrecognized StrategyNumber: %d",
+					 (int) skip->strategy);
+				skipit = false; /* keep compiler quiet */
+				break;
+		}
+		if (skipit)
+			break;
+	}
+
+	reset_transmission_modes(nestlevel);
+
+	return skipit;
+}
+
+/*
+ * Fetch and decompress the needed columns of the reader's current chunk.
+ */
+static void
+load_chunk(ColumnarFdwScanState *state, TupleDesc tupdesc, Oid relid)
+{
+	ChunkReader *reader = state->reader;
+	TupleDesc	chunkdesc = RelationGetDescr(reader->chunkrel);
+	MemoryContext oldcontext;
+	int			i;
+
+	MemoryContextReset(state->chunkcxt);
+	oldcontext = MemoryContextSwitchTo(state->chunkcxt);
+
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		HeapTuple	row = reader->rows[i];
+		bool		isnull;
+		Oid			typid;
+		ArrayType  *array;
+		int			nelems;
+
+		state->values[i] = NULL;
+		state->nulls[i] = NULL;
+		if (!state->needed[i] || row == NULL)
+			continue;
+
+		typid = DatumGetObjectId(heap_getattr(row, Anum_columnar_chunk_typid,
+											  chunkdesc, &isnull));
+		if (typid != attr->atttypid)
+			ereport(ERROR,
+					(errcode(ERRCODE_DATATYPE_MISMATCH),
+					 errmsg("column \"%s\" of columnar table \"%s\" has type %s, but its stored data has type %s",
+							NameStr(attr->attname), get_rel_name(relid),
+							format_type_be(attr->atttypid),
+							format_type_be(typid))));
+
+		array = DatumGetArrayTypeP(heap_getattr(row, Anum_columnar_chunk_data,
+												chunkdesc, &isnull));
+		if (ARR_NDIM(array) != 1 || ARR_ELEMTYPE(array) != typid)
+			elog(ERROR, "invalid columnar chunk data");
+
+		deconstruct_array(array, typid,
+						  attr->attlen, attr->attbyval, attr->attalign,
+						  &state->values[i], &state->nulls[i], &nelems);
+		if (nelems != reader->nrows)
+			elog(ERROR, "invalid columnar chunk data");
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+
+	state->nrows = reader->nrows;
+	state->rowno = 0;
+}
+
+/*
+ * columnarIterateForeignScan
+ *		Read next record from the table's chunks and store it into the
+ *		ScanTupleSlot as a virtual tuple
+ */
+static TupleTableSlot *
+columnarIterateForeignScan(ForeignScanState *node)
+{
+	ColumnarFdwScanState *state = (ColumnarFdwScanState *) node->fdw_state;
+	TupleTableSlot *slot = node->ss.ss_ScanTupleSlot;
+	Relation	rel = node->ss.ss_currentRelation;
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	int			rowno;
+	int			i;
+
+	ExecClearTuple(slot);
+
+	while (state->rowno >= state->nrows)
+	{
+		if (!chunk_reader_next(state->reader))
+			return slot;
+
+		if (chunk_can_be_skipped(state, tupdesc))
+		{
+			state->chunks_skipped++;
+			continue;
+		}
+
+		load_chunk(state, tupdesc, RelationGetRelid(rel));
+		state->chunks_read++;
+	}
+
+	rowno = state->rowno++;
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		if (state->nulls[i] == NULL)
+		{
+			slot->tts_values[i] = (Datum) 0;
+			slot->tts_isnull[i] = true;
+		}
+		else
+		{
+			slot->tts_values[i] = state->values[i][rowno];
+			slot->tts_isnull[i] = state->nulls[i][rowno];
+		}
+	}
+	ExecStoreVirtualTuple(slot);
+
+	return slot;
+}
+
+/*
+ * columnarReScanForeignScan
+ *		Rescan table, possibly with new parameters
+ */
+static void
+columnarReScanForeignScan(ForeignScanState *node)
+{
+	ColumnarFdwScanState *state = (ColumnarFdwScanState *) node->fdw_state;
+	Relation	rel = node->ss.ss_currentRelation;
+
+	chunk_reader_end(state->reader);
+	state->reader = chunk_reader_begin(RelationGetRelid(rel),
+									   node->ss.ps.state->es_snapshot,
+									   RelationGetDescr(rel)->natts);
+	state->nrows = 0;
+	state->rowno = 0;
+}
+
+/*
+ * columnarEndForeignScan
+ *		Finish scanning foreign table and dispose objects used for this scan
+ */
+static void
+columnarEndForeignScan(ForeignScanState *node)
+{
+	ColumnarFdwScanState *state = (ColumnarFdwScanState *) node->fdw_state;
+
+	/* if state is NULL, we are in EXPLAIN; nothing to do */
+	if (state)
+		chunk_reader_end(state->reader);
+}
+
+/*
+ * columnarBeginForeignModify
+ *		Begin an insert operation on a foreign table
+ */
+static void
+columnarBeginForeignModify(ModifyTableState *mtstate,
+						   ResultRelInfo *rinfo,
+						   List *fdw_private,
+						   int subplan_index,
+						   int eflags)
+{
+	Relation	rel = rinfo->ri_RelationDesc;
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	ColumnarFdwModifyState *state;
+	int			i;
+
+	/*
+	 * Do nothing in EXPLAIN (no ANALYZE) case.  rinfo->ri_FdwState stays
+	 * NULL.
+	 */
+	if (eflags & EXEC_FLAG_EXPLAIN_ONLY)
+		return;
+
+	state = (ColumnarFdwModifyState *) palloc0(sizeof(ColumnarFdwModifyState));
+	state->rel = rel;
+	state->chunkrel = heap_open(get_columnar_relid(COLUMNAR_CHUNK_TABLE),
+								RowExclusiveLock);
+	state->chunk_rows = get_chunk_rows(RelationGetRelid(rel));
+	state->stripe = -1;
+	state->chunkno = 0;
+
+	state->cmpproc = (FmgrInfo **) palloc0(tupdesc->natts * sizeof(FmgrInfo *));
+	state->outproc = (FmgrInfo **) palloc0(tupdesc->natts * sizeof(FmgrInfo *));
+	state->values = (Datum **) palloc0(tupdesc->natts * sizeof(Datum *));
+	state->nulls = (bool **) palloc0(tupdesc->natts * sizeof(bool *));
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		TypeCacheEntry *typentry;
+
+		if (attr->attisdropped)
+			continue;
+
+		/*
+		 * The text form of money depends on lc_monetary, so it can't be
+		 * relied on to read back the same value later.
+		 */
+		typentry = lookup_type_cache(attr->atttypid, TYPECACHE_CMP_PROC_FINFO);
+		if (OidIsValid(typentry->cmp_proc_finfo.fn_oid) &&
+			attr->atttypid != CASHOID)
+		{
+			Oid			typoutput;
+			bool		typisvarlena;
+
+			state->cmpproc[i] = &typentry->cmp_proc_finfo;
+			getTypeOutputInfo(attr->atttypid, &typoutput, &typisvarlena);
+			state->outproc[i] = (FmgrInfo *) palloc(sizeof(FmgrInfo));
+			fmgr_info(typoutput, state->outproc[i]);
+		}
+
+		state->values[i] = (Datum *) palloc(state->chunk_rows * sizeof(Datum));
+		state->nulls[i] = (bool *) palloc(state->chunk_rows * sizeof(bool));
+	}
+
+	state->buffercxt = AllocSetContextCreate(CurrentMemoryContext,
+											 "columnar_fdw insert buffer",
+											 ALLOCSET_DEFAULT_SIZES);
+	state->nbuffered = 0;
+
+	rinfo->ri_FdwState = state;
+}
+
+/*
+ * columnarExecForeignInsert
+ *		Buffer one row, and write out the chunk once it's full
+ */
+static TupleTableSlot *
+columnarExecForeignInsert(EState *estate,
+						  ResultRelInfo *rinfo,
+						  TupleTableSlot *slot,
+						  TupleTableSlot *planSlot)
+{
+	ColumnarFdwModifyState *state = (ColumnarFdwModifyState *) rinfo->ri_FdwState;
+	TupleDesc	tupdesc = RelationGetDescr(state->rel);
+	MemoryContext oldcontext;
+	int			row = state->nbuffered;
+	int			i;
+
+	slot_getallattrs(slot);
+
+	oldcontext = MemoryContextSwitchTo(state->buffercxt);
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+
+		if (attr->attisdropped)
+			continue;
+
+		state->nulls[i][row] = slot->tts_isnull[i];
+		if (slot->tts_isnull[i])
+			state->values[i][row] = (Datum) 0;
+		else if (attr->attlen == -1)
+			state->values[i][row] =
+				PointerGetDatum(PG_DETOAST_DATUM_COPY(slot->tts_values[i]));
+		else
+			state->values[i][row] = datumCopy(slot->tts_values[i],
+											  attr->attbyval, attr->attlen);
+	}
+	MemoryContextSwitchTo(oldcontext);
+
+	if (++state->nbuffered == state->chunk_rows)
+		flush_chunk(state);
+
+	return slot;
+}
+
+/*
+ * Write out the buffered rows as a chunk: one columnar_chunk row per column.
+ *
+ * The user inserting into the foreign table needn't have privileges on the
+ * chunk table, so, like the RI triggers, we switch to the chunk table's
+ * owner while inserting into it.
+ */
+static void
+flush_chunk(ColumnarFdwModifyState *state)
+{
+	TupleDesc	tupdesc = RelationGetDescr(state->rel);
+	MemoryContext oldcontext;
+	int			nrows = state->nbuffered;
+	Oid			save_userid;
+	int			save_sec_context;
+	int			nestlevel;
+	int			i;
+
+	if (nrows == 0)
+		return;
+
+	if (state->stripe < 0)
+		state->stripe = nextval_internal(get_columnar_relid(COLUMNAR_STRIPE_SEQ),
+										 false);
+
+	oldcontext = MemoryContextSwitchTo(state->buffercxt);
+
+	GetUserIdAndSecContext(&save_userid, &save_sec_context);
+	SetUserIdAndSecContext(RelationGetForm(state->chunkrel)->relowner,
+						   save_sec_context | SECURITY_LOCAL_USERID_CHANGE);
+	if (SPI_connect() != SPI_OK_CONNECT)
+		elog(ERROR, "SPI_connect failed");
+
+	/*
+	 * Chunks are written with an ordinary INSERT, so that the chunk table's
+	 * indexes are maintained.  Prepare it on first use, as the owner.
+	 */
+	if (state->insertplan == NULL)
+	{
+		static const char *sql =
+		"INSERT INTO " COLUMNAR_SCHEMA "." COLUMNAR_CHUNK_TABLE
+		" (relid, stripe, chunkno, attnum, typid, nrows, nnulls,"
+		" minval, maxval, data)"
+		" VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10)";
+		Oid			argtypes[Natts_columnar_chunk] = {
+			OIDOID, INT8OID, INT4OID, INT2OID, OIDOID, INT4OID, INT4OID,
+			TEXTOID, TEXTOID, BYTEAOID
+		};
+
+		state->insertplan = SPI_prepare(sql, Natts_columnar_chunk, argtypes);
+		if (state->insertplan == NULL)
+			elog(ERROR, "SPI_prepare returned %s for %s",
+				 SPI_result_code_string(SPI_result), sql);
+		SPI_keepplan(state->insertplan);
+	}
+
+	/* Write the minimum and maximum values so that they read back exactly */
+	nestlevel = set_transmission_modes();
+
+	for (i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		Datum	   *values = state->values[i];
+		bool	   *nulls = state->nulls[i];
+		Datum		chunkvalues[Natts_columnar_chunk];
+		char		chunknulls[Natts_columnar_chunk];
+		int			lbound = 1;
+		int			nnulls = 0;
+		int			minrow = -1;
+		int			maxrow = -1;
+		int			row;
+		ArrayType  *array;
+
+		if (attr->attisdropped)
+			continue;
+
+		for (row = 0; row < nrows; row++)
+		{
+			if (nulls[row])
+			{
+				nnulls++;
+				continue;
+			}
+			if (state->cmpproc[i] == NULL)
+				continue;
+			if (minrow < 0 ||
+				DatumGetInt32(FunctionCall2Coll(state->cmpproc[i],
+												attr->attcollation,
+												values[row],
+												values[minrow])) < 0)
+				minrow = row;
+			if (maxrow < 0 ||
+				DatumGetInt32(FunctionCall2Coll(state->cmpproc[i],
+												attr->attcollation,
+												values[row],
+												values[maxrow])) > 0)
+				maxrow = row;
+		}
+
+		array = construct_md_array(values, nulls, 1, &nrows, &lbound,
+								   attr->atttypid, attr->attlen,
+								   attr->attbyval, attr->attalign);
+
+		memset(chunknulls, ' ', sizeof(chunknulls));
+		chunkvalues[Anum_columnar_chunk_relid - 1] =
+			ObjectIdGetDatum(RelationGetRelid(state->rel));
+		chunkvalues[Anum_columnar_chunk_stripe - 1] =
+			Int64GetDatum(state->stripe);
+		chunkvalues[Anum_columnar_chunk_chunkno - 1] =
+			Int32GetDatum(state->chunkno);
+		chunkvalues[Anum_columnar_chunk_attnum - 1] =
+			Int16GetDatum(attr->attnum);
+		chunkvalues[Anum_columnar_chunk_typid - 1] =
+			ObjectIdGetDatum(attr->atttypid);
+		chunkvalues[Anum_columnar_chunk_nrows - 1] = Int32GetDatum(nrows);
+		chunkvalues[Anum_columnar_chunk_nnulls - 1] = Int32GetDatum(nnulls);
+		if (minrow >= 0)
+		{
+			chunkvalues[Anum_columnar_chunk_minval - 1] =
+				CStringGetTextDatum(OutputFunctionCall(state->outproc[i],
+													   values[minrow]));
+			chunkvalues[Anum_columnar_chunk_maxval - 1] =
+				CStringGetTextDatum(OutputFunctionCall(state->outproc[i],
+													   values[maxrow]));
+		}
+		else
+		{
+			chunknulls[Anum_columnar_chunk_minval - 1] = 'n';
+			chunknulls[Anum_columnar_chunk_maxval - 1] = 'n';
+		}
+		/* the array is stored as the bytes of a bytea */
+		chunkvalues[Anum_columnar_chunk_data - 1] = PointerGetDatum(array);
+
+		if (SPI_execute_plan(state->insertplan, chunkvalues, chunknulls,
+							 false, 0) != SPI_OK_INSERT)
+			elog(ERROR, "could not insert columnar chunk");
+	}
+
+	reset_transmission_modes(nestlevel);
+
+	if (SPI_finish() != SPI_OK_FINISH)
+		elog(ERROR, "SPI_finish failed");
+	SetUserIdAndSecContext(save_userid, save_sec_context);
+
+	MemoryContextSwitchTo(oldcontext);
+	MemoryContextReset(state->buffercxt);
+
+	state->chunkno++;
+	state->nbuffered = 0;
+}
+
+/*
+ * columnarEndForeignModify
+ *		Finish an insert operation on a foreign table
+ */
+static void
+columnarEndForeignModify(EState *estate,
+						 ResultRelInfo *rinfo)
+{
+	ColumnarFdwModifyState *state = (ColumnarFdwModifyState *) rinfo->ri_FdwState;
+
+	/* If state is NULL, we are in EXPLAIN; nothing to do */
+	if (state == NULL)
+		return;
+
+	flush_chunk(state);
+	if (state->insertplan != NULL)
+		SPI_freeplan(state->insertplan);
+	heap_close(state->chunkrel, NoLock);
+}
+
+/*
+ * columnarIsForeignRelUpdatable
+ *		Columnar tables are append-only
+ */
+static int
+columnarIsForeignRelUpdatable(Relation rel)
+{
+	return (1 << CMD_INSERT);
+}
+
+/*
+ * columnarAnalyzeForeignTable
+ *		Test whether analyzing this foreign table is supported
+ *
+ * It always is.  We report the number of chunks as the number of pages;
+ * columnarGetForeignRelSize relies on that.  Must return at least 1 so that
+ * we can tell later on that pg_class.relpages is not default.
+ */
+static bool
+columnarAnalyzeForeignTable(Relation relation,
+							AcquireSampleRowsFunc *func,
+							BlockNumber *totalpages)
+{
+	ChunkReader *reader;
+	BlockNumber nchunks = 0;
+
+	reader = chunk_reader_begin(RelationGetRelid(relation),
+								GetActiveSnapshot(), 0);
+	while (chunk_reader_next(reader))
+		nchunks++;
+	chunk_reader_end(reader);
+
+	*totalpages = Max(nchunks, 1);
+	*func = columnar_acquire_sample_rows;
+
+	return true;
+}
+
+/*
+ * columnar_acquire_sample_rows -- acquire a random sample of rows from the
+ * table
+ *
+ * Selected rows are returned in the caller-allocated array rows[],
+ * which must have at least targrows entries.
+ * The actual number of rows selected is returned as the function result.
+ * We also count the total number of rows in the table and return it into
+ * *totalrows.  Note that *totaldeadrows is always set to 0.
+ *
+ * As in file_fdw, the returned rows aren't in order by position in the
+ * table, which is OK since the planner doesn't use correlation here.
+ */
+static int
+columnar_acquire_sample_rows(Relation onerel, int elevel,
+							 HeapTuple *rows, int targrows,
+							 double *totalrows, double *totaldeadrows)
+{
+	TupleDesc	tupdesc = RelationGetDescr(onerel);
+	ColumnarFdwScanState state;
+	ReservoirStateData rstate;
+	double		rowstoskip = -1;	/* -1 means not set yet */
+	int			numrows = 0;
+	Datum	   *values;
+	bool	   *nulls;
+	int			i;
+
+	/* Fetch every column, as a scan of the whole row would */
+	memset(&state, 0, sizeof(state));
+	state.needed = (bool *) palloc(tupdesc->natts * sizeof(bool));
+	for (i = 0; i < tupdesc->natts; i++)
+		state.needed[i] = !TupleDescAttr(tupdesc, i)->attisdropped;
+	state.chunkcxt = AllocSetContextCreate(CurrentMemoryContext,
+										   "columnar_fdw chunk",
+										   ALLOCSET_DEFAULT_SIZES);
+	state.values = (Datum **) palloc0(tupdesc->natts * sizeof(Datum *));
+	state.nulls = (bool **) palloc0(tupdesc->natts * sizeof(bool *));
+	state.reader = chunk_reader_begin(RelationGetRelid(onerel),
+									  GetActiveSnapshot(), tupdesc->natts);
+
+	values = (Datum *) palloc(tupdesc->natts * sizeof(Datum));
+	nulls = (bool *) palloc(tupdesc->natts * sizeof(bool));
+
+	/* Prepare for sampling rows */
+	reservoir_init_selection_state(&rstate, targrows);
+
+	*totalrows = 0;
+	*totaldeadrows = 0;
+	while (chunk_reader_next(state.reader))
+	{
+		int			rowno;
+
+		/* Check for user-requested abort or sleep */
+		vacuum_delay_point();
+
+		load_chunk(&state, tupdesc, RelationGetRelid(onerel));
+
+		for (rowno = 0; rowno < state.nrows; rowno++)
+		{
+			int			k = -1;
+
+			/*
+			 * The first targrows sample rows are simply copied into the
+			 * reservoir.  Then we start replacing tuples in the sample until
+			 * we reach the end of the relation.  This algorithm is from Jeff
+			 * Vitter's paper (see more info in commands/analyze.c).
+			 */
+			if (numrows < targrows)
+				k = numrows++;
+			else
+			{
+				/*
+				 * t in Vitter's paper is the number of records already
+				 * processed.  If we need to compute a new S value, we must
+				 * use the not-yet-incremented value of totalrows as t.
+				 */
+				if (rowstoskip < 0)
+					rowstoskip = reservoir_get_next_S(&rstate, *totalrows,
+													  targrows);
+
+				if (rowstoskip <= 0)
+				{
+					/*
+					 * Found a suitable tuple, so save it, replacing one old
+					 * tuple at random
+					 */
+					k = (int) (targrows * sampler_random_fract(rstate.randstate));
+					Assert(k >= 0 && k < targrows);
+					heap_freetuple(rows[k]);
+				}
+
+				rowstoskip -= 1;
+			}
+
+			if (k >= 0)
+			{
+				for (i = 0; i < tupdesc->natts; i++)
+				{
+					if (state.nulls[i] == NULL)
+					{
+						values[i] = (Datum) 0;
+						nulls[i] = true;
+					}
+					else
+					{
+						values[i] = state.values[i][rowno];
+						nulls[i] = state.nulls[i][rowno];
+					}
+				}
+				rows[k] = heap_form_tuple(tupdesc, values, nulls);
+			}
+
+			*totalrows += 1;
+		}
+	}
+
+	chunk_reader_end(state.reader);
+	MemoryContextDelete(state.chunkcxt);
+
+	ereport(elevel,
+			(errmsg("\"%s\": table contains %.0f rows; "
+					"%d rows in sample",
+					RelationGetRelationName(onerel),
+					*totalrows, numrows)));
+
+	return numrows;
+}
+
+/*
+ * Force assorted GUC parameters to settings that ensure that we'll output
+ * data values in a form that can be read back exactly, whatever the user's
+ * settings.  These are the settings that postgres_fdw uses to transmit
+ * values to a remote server, and that pg_dump uses.
+ *
+ * The settings persist only until reset_transmission_modes() is called with
+ * the returned nestlevel.  If an error is thrown in between, guc.c will take
+ * care of undoing them.
+ */
+static int
+set_transmission_modes(void)
+{
+	int			nestlevel = NewGUCNestLevel();
+
+	if (DateStyle != USE_ISO_DATES)
+		(void) set_config_option("datestyle", "ISO",
+								 PGC_USERSET, PGC_S_SESSION,
+								 GUC_ACTION_SAVE, true, 0, false);
+	if (IntervalStyle != INTSTYLE_POSTGRES)
+		(void) set_config_option("intervalstyle", "postgres",
+								 PGC_USERSET, PGC_S_SESSION,
+								 GUC_ACTION_SAVE, true, 0, false);
+	if (extra_float_digits < 3)
+		(void) set_config_option("extra_float_digits", "3",
+								 PGC_USERSET, PGC_S_SESSION,
+								 GUC_ACTION_SAVE, true, 0, false);
+
+	return nestlevel;
+}
+
+/*
+ * Undo the effects of set_transmission_modes().
+ */
+static void
+reset_transmission_modes(int nestlevel)
+{
+	AtEOXact_GUC(true, nestlevel);
+}
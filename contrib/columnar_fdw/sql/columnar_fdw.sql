@@ -0,0 +1,92 @@
+--
+-- Test columnar_fdw
+--
+CREATE EXTENSION columnar_fdw;
+CREATE SERVER columnar_server FOREIGN DATA WRAPPER columnar_fdw;
+
+-- validator tests
+CREATE FOREIGN TABLE tbl (a int) SERVER columnar_server OPTIONS (chunk_rows '0');  -- ERROR
+CREATE FOREIGN TABLE tbl (a int) SERVER columnar_server OPTIONS (chunk_rows 'x');  -- ERROR
+CREATE FOREIGN TABLE tbl (a int) SERVER columnar_server OPTIONS (filename 'x');    -- ERROR
+CREATE SERVER tbl_server FOREIGN DATA WRAPPER columnar_fdw OPTIONS (chunk_rows '10');  -- ERROR
+
+CREATE FOREIGN TABLE events (id int, kind text, amount int8)
+  SERVER columnar_server OPTIONS (chunk_rows '1000');
+SELECT count(*) FROM events;
+
+INSERT INTO events SELECT g, 'kind' || (g % 3), g * 2 FROM generate_series(1, 10000) g;
+SELECT count(*), min(id), max(id), sum(amount) FROM events;
+SELECT kind, count(*) FROM events GROUP BY kind ORDER BY kind;
+SELECT stripe > 0 AS stripe, count(DISTINCT chunkno) AS chunks, count(*) AS rows,
+       sum(nrows) AS nrows, count(minval) AS bounded
+  FROM columnar.columnar_chunk
+ WHERE relid = 'events'::regclass AND attnum = 1
+ GROUP BY 1;
+SELECT chunkno, minval::int, maxval::int
+  FROM columnar.columnar_chunk
+ WHERE relid = 'events'::regclass AND attnum = 1 AND chunkno < 3
+ ORDER BY chunkno;
+
+-- row estimates come from ANALYZE
+EXPLAIN SELECT * FROM events;
+ANALYZE events;
+EXPLAIN SELECT * FROM events;
+SELECT relpages, reltuples FROM pg_class WHERE oid = 'events'::regclass;
+
+-- chunks that can't contain matching rows are skipped
+SELECT count(*), sum(amount) FROM events WHERE id BETWEEN 2500 AND 3200;
+EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT count(*) FROM events WHERE id BETWEEN 2500 AND 3200;
+EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT count(*) FROM events WHERE 9500 < id;
+EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT count(*) FROM events WHERE kind = 'kind1';
+
+-- columns added and dropped later
+ALTER FOREIGN TABLE events ADD COLUMN note text;
+INSERT INTO events VALUES (10001, 'kind0', 1, 'new');
+SELECT count(*), count(note) FROM events;
+EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT * FROM events WHERE note = 'new';
+SELECT * FROM events WHERE note = 'new';
+ALTER FOREIGN TABLE events DROP COLUMN amount;
+SELECT * FROM events WHERE id > 9998;
+
+-- inserts are transactional
+BEGIN;
+INSERT INTO events VALUES (20000, 'kind9', 'rolled back');
+SELECT count(*) FROM events WHERE id = 20000;
+ROLLBACK;
+SELECT count(*) FROM events WHERE id = 20000;
+
+-- users without privileges on the chunk table can still insert
+CREATE ROLE regress_columnar_user;
+GRANT INSERT, SELECT ON events TO regress_columnar_user;
+SET ROLE regress_columnar_user;
+INSERT INTO events VALUES (20001, 'kind8', 'by user');
+SELECT id, kind, note FROM events WHERE id > 20000;
+RESET ROLE;
+
+-- updates aren't supported
+UPDATE events SET kind = 'x';
+DELETE FROM events WHERE id = 1;
+
+-- chunk bounds don't depend on how values are output
+CREATE FOREIGN TABLE floats (x float8) SERVER columnar_server OPTIONS (chunk_rows '2');
+SET extra_float_digits = 0;
+INSERT INTO floats VALUES (0.1), (0.1::float8 + 0.2::float8), (0.2), (0.25);
+EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF, SUMMARY OFF)
+SELECT * FROM floats WHERE x > 0.3;
+SELECT x = 0.3 AS is_point_three FROM floats WHERE x > 0.3;
+RESET extra_float_digits;
+SELECT minval, maxval FROM columnar.columnar_chunk
+ WHERE relid = 'floats'::regclass ORDER BY chunkno;
+DROP FOREIGN TABLE floats;
+
+-- dropping a table removes its data
+DROP FOREIGN TABLE events;
+SELECT count(*) FROM columnar.columnar_chunk;
+
+-- cleanup
+DROP EXTENSION columnar_fdw CASCADE;
+DROP ROLE regress_columnar_user;
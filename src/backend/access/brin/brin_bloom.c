@@ -0,0 +1,424 @@
+/*
+ * brin_bloom.c
+ *		Implementation of Bloom opclass for BRIN
+ *
+ * A bloom filter summarizes the set of values in a page range, and can only
+ * answer equality queries: a value that's not in the filter is certainly not
+ * in the range, while a value that is in the filter may or may not be there.
+ * This is useful for data where minmax summaries are useless because values
+ * are not correlated with their physical location, e.g. UUIDs or hashes.
+ *
+ * The filter is stored as a single bytea value.  Its size is fixed when the
+ * first value is added, based on an estimate of the number of distinct values
+ * in a page range (derived from pages_per_range) and the target false
+ * positive rate.  Values are hashed using the type's hash function (support
+ * procedure BLOOM_PROCNUM_HASH), and the bit positions are derived from that
+ * hash using double hashing.
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * IDENTIFICATION
+ *	  src/backend/access/brin/brin_bloom.c
+ */
+#include "postgres.h"
+
+#include <math.h>
+
+#include "access/brin.h"
+#include "access/brin_internal.h"
+#include "access/brin_tuple.h"
+#include "access/genam.h"
+#include "access/hash.h"
+#include "access/htup_details.h"
+#include "catalog/pg_type.h"
+#include "utils/builtins.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+
+
+/* support procedure numbers */
+#define BLOOM_PROCNUM_HASH			11
+
+/* the only operator strategy; bloom opclasses just support equality */
+#define BLOOM_EQUAL_STRATEGY_NUMBER	1
+
+/*
+ * The filter is sized to keep the false positive rate at about
+ * BLOOM_FALSE_POSITIVE_RATE when the range contains the estimated number of
+ * distinct values.  That estimate is a fraction of the maximum number of
+ * tuples in the range, but never less than BLOOM_MIN_NDISTINCT.  The filter
+ * never gets larger than BLOOM_MAX_BYTES, so that a couple of bloom columns
+ * fit into an index tuple.
+ */
+#define BLOOM_NDISTINCT_FRACTION	0.1
+#define BLOOM_MIN_NDISTINCT			16
+#define BLOOM_FALSE_POSITIVE_RATE	0.01
+#define BLOOM_MAX_BYTES				(BLCKSZ / 4)
+#define BLOOM_MAX_HASHES			32
+
+/* seeds for deriving the two independent hashes used for double hashing */
+#define BLOOM_SEED_1	0x71d924af
+#define BLOOM_SEED_2	0xba48b314
+
+/*
+ * On-disk (and in-memory) representation of a bloom filter.  The bitmap
+ * follows the header; nbits is always a multiple of 8.
+ */
+typedef struct BloomFilter
+{
+	int32		vl_len_;		/* varlena header (do not touch directly!) */
+	uint16		nhashes;		/* number of hash functions */
+	uint16		flags;			/* unused for now, always zero */
+	uint32		nbits;			/* number of bits in the bitmap */
+	char		data[FLEXIBLE_ARRAY_MEMBER];
+} BloomFilter;
+
+#define BloomFilterHeaderSize	offsetof(BloomFilter, data)
+
+typedef struct BloomOpaque
+{
+	Oid			cached_subtype;
+	FmgrInfo	hash_procinfo;
+} BloomOpaque;
+
+static BloomFilter *bloom_init(BlockNumber pagesPerRange);
+static bool bloom_add_value(BloomFilter *filter, uint32 value);
+static bool bloom_contains_value(BloomFilter *filter, uint32 value);
+static FmgrInfo *bloom_get_hash_procinfo(BrinDesc *bdesc, uint16 attno,
+						Oid subtype);
+
+
+/*
+ * Create an empty bloom filter, sized for a range of the given number of
+ * pages.
+ */
+static BloomFilter *
+bloom_init(BlockNumber pagesPerRange)
+{
+	BloomFilter *filter;
+	double		ndistinct;
+	double		nbits;
+	int			nbytes;
+	int			nhashes;
+
+	ndistinct = BLOOM_NDISTINCT_FRACTION * MaxHeapTuplesPerPage *
+		(double) pagesPerRange;
+	ndistinct = Max(ndistinct, BLOOM_MIN_NDISTINCT);
+
+	/* optimal number of bits and hash functions for the target rate */
+	nbits = ceil(-(ndistinct * log(BLOOM_FALSE_POSITIVE_RATE)) /
+				 (M_LN2 * M_LN2));
+	nbytes = (int) Min(ceil(nbits / 8), BLOOM_MAX_BYTES);
+	nbits = nbytes * 8;
+
+	nhashes = (int) rint(M_LN2 * nbits / ndistinct);
+	nhashes = Max(nhashes, 1);
+	nhashes = Min(nhashes, BLOOM_MAX_HASHES);
+
+	filter = (BloomFilter *) palloc0(BloomFilterHeaderSize + nbytes);
+	SET_VARSIZE(filter, BloomFilterHeaderSize + nbytes);
+	filter->nhashes = nhashes;
+	filter->nbits = (uint32) nbits;
+
+	return filter;
+}
+
+/*
+ * Add a hashed value to the filter.  Returns true if any bit changed, which
+ * means the index tuple needs to be updated.
+ */
+static bool
+bloom_add_value(BloomFilter *filter, uint32 value)
+{
+	uint64		h1,
+				h2;
+	int			i;
+	bool		updated = false;
+
+	h1 = DatumGetUInt64(hash_uint32_extended(value, BLOOM_SEED_1)) %
+		filter->nbits;
+	h2 = DatumGetUInt64(hash_uint32_extended(value, BLOOM_SEED_2)) %
+		filter->nbits;
+
+	for (i = 0; i < filter->nhashes; i++)
+	{
+		uint32		bit = (uint32) ((h1 + i * h2) % filter->nbits);
+		uint32		byte = bit / 8;
+		uint8		mask = (uint8) (1 << (bit % 8));
+
+		if (!(filter->data[byte] & mask))
+		{
+			filter->data[byte] |= mask;
+			updated = true;
+		}
+	}
+
+	return updated;
+}
+
+/*
+ * Check whether the filter may contain the hashed value.
+ */
+static bool
+bloom_contains_value(BloomFilter *filter, uint32 value)
+{
+	uint64		h1,
+				h2;
+	int			i;
+
+	h1 = DatumGetUInt64(hash_uint32_extended(value, BLOOM_SEED_1)) %
+		filter->nbits;
+	h2 = DatumGetUInt64(hash_uint32_extended(value, BLOOM_SEED_2)) %
+		filter->nbits;
+
+	for (i = 0; i < filter->nhashes; i++)
+	{
+		uint32		bit = (uint32) ((h1 + i * h2) % filter->nbits);
+
+		if (!(filter->data[bit / 8] & (1 << (bit % 8))))
+			return false;
+	}
+
+	return true;
+}
+
+Datum
+brin_bloom_opcinfo(PG_FUNCTION_ARGS)
+{
+	BrinOpcInfo *result;
+
+	/*
+	 * opaque->hash_procinfo is initialized lazily; here it is set to
+	 * uninitialized by palloc0 which sets fn_oid to InvalidOid.
+	 *
+	 * The summary is stored as a bytea regardless of the indexed type.
+	 */
+	result = palloc0(MAXALIGN(SizeofBrinOpcInfo(1)) +
+					 sizeof(BloomOpaque));
+	result->oi_nstored = 1;
+	result->oi_opaque = (BloomOpaque *)
+		MAXALIGN((char *) result + SizeofBrinOpcInfo(1));
+	result->oi_typcache[0] = lookup_type_cache(BYTEAOID, 0);
+
+	PG_RETURN_POINTER(result);
+}
+
+/*
+ * Examine the given index tuple (which contains partial status of a certain
+ * page range) by comparing it to the given value that comes from another heap
+ * tuple.  If the new value is not yet represented in the bloom filter, add it
+ * and return true.  Otherwise, return false and do not modify in this case.
+ */
+Datum
+brin_bloom_add_value(PG_FUNCTION_ARGS)
+{
+	BrinDesc   *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+	BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+	Datum		newval = PG_GETARG_DATUM(2);
+	bool		isnull = PG_GETARG_DATUM(3);
+	Oid			colloid = PG_GET_COLLATION();
+	FmgrInfo   *hashFn;
+	uint32		hashValue;
+	BloomFilter *filter;
+	MemoryContext oldcxt;
+	bool		updated = false;
+
+	/*
+	 * If the new value is null, we record that we saw it if it's the first
+	 * one; otherwise, there's nothing to do.
+	 */
+	if (isnull)
+	{
+		if (column->bv_hasnulls)
+			PG_RETURN_BOOL(false);
+
+		column->bv_hasnulls = true;
+		PG_RETURN_BOOL(true);
+	}
+
+	/*
+	 * The filter is modified in place, so make sure we have a plain,
+	 * non-packed copy of it living as long as the rest of the tuple.
+	 */
+	oldcxt = MemoryContextSwitchTo(column->bv_context);
+	if (column->bv_allnulls)
+	{
+		filter = bloom_init(BrinGetPagesPerRange(bdesc->bd_index));
+		column->bv_values[0] = PointerGetDatum(filter);
+		column->bv_allnulls = false;
+		updated = true;
+	}
+	else
+	{
+		filter = (BloomFilter *) PG_DETOAST_DATUM(column->bv_values[0]);
+		column->bv_values[0] = PointerGetDatum(filter);
+	}
+	MemoryContextSwitchTo(oldcxt);
+
+	hashFn = index_getprocinfo(bdesc->bd_index, column->bv_attno,
+							   BLOOM_PROCNUM_HASH);
+	hashValue = DatumGetUInt32(FunctionCall1Coll(hashFn, colloid, newval));
+
+	updated |= bloom_add_value(filter, hashValue);
+
+	PG_RETURN_BOOL(updated);
+}
+
+/*
+ * Given an index tuple corresponding to a certain page range and a scan key,
+ * return whether the scan key is consistent with the index tuple's bloom
+ * filter.  Return true if so, false otherwise.
+ */
+Datum
+brin_bloom_consistent(PG_FUNCTION_ARGS)
+{
+	BrinDesc   *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+	BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+	ScanKey		key = (ScanKey) PG_GETARG_POINTER(2);
+	Oid			colloid = PG_GET_COLLATION();
+	BloomFilter *filter;
+	FmgrInfo   *finfo;
+	uint32		hashValue;
+
+	Assert(key->sk_attno == column->bv_attno);
+
+	/* handle IS NULL/IS NOT NULL tests */
+	if (key->sk_flags & SK_ISNULL)
+	{
+		if (key->sk_flags & SK_SEARCHNULL)
+		{
+			if (column->bv_allnulls || column->bv_hasnulls)
+				PG_RETURN_BOOL(true);
+			PG_RETURN_BOOL(false);
+		}
+
+		/*
+		 * For IS NOT NULL, we can only skip ranges that are known to have
+		 * only nulls.
+		 */
+		if (key->sk_flags & SK_SEARCHNOTNULL)
+			PG_RETURN_BOOL(!column->bv_allnulls);
+
+		/*
+		 * Neither IS NULL nor IS NOT NULL was used; assume all indexable
+		 * operators are strict and return false.
+		 */
+		PG_RETURN_BOOL(false);
+	}
+
+	/* if the range is all empty, it cannot possibly be consistent */
+	if (column->bv_allnulls)
+		PG_RETURN_BOOL(false);
+
+	if (key->sk_strategy != BLOOM_EQUAL_STRATEGY_NUMBER)
+		elog(ERROR, "invalid strategy number %d", key->sk_strategy);
+
+	filter = (BloomFilter *) PG_DETOAST_DATUM(column->bv_values[0]);
+
+	finfo = bloom_get_hash_procinfo(bdesc, key->sk_attno, key->sk_subtype);
+	hashValue = DatumGetUInt32(FunctionCall1Coll(finfo, colloid,
+												 key->sk_argument));
+
+	PG_RETURN_BOOL(bloom_contains_value(filter, hashValue));
+}
+
+/*
+ * Given two BrinValues, update the first of them as a union of the summary
+ * values contained in both.  The second one is untouched.
+ */
+Datum
+brin_bloom_union(PG_FUNCTION_ARGS)
+{
+	BrinValues *col_a = (BrinValues *) PG_GETARG_POINTER(1);
+	BrinValues *col_b = (BrinValues *) PG_GETARG_POINTER(2);
+	BloomFilter *filter_a;
+	BloomFilter *filter_b;
+	MemoryContext oldcxt;
+	int			nbytes;
+	int			i;
+
+	Assert(col_a->bv_attno == col_b->bv_attno);
+
+	/* Adjust "hasnulls" */
+	if (!col_a->bv_hasnulls && col_b->bv_hasnulls)
+		col_a->bv_hasnulls = true;
+
+	/* If there are no values in B, there's nothing left to do */
+	if (col_b->bv_allnulls)
+		PG_RETURN_VOID();
+
+	filter_b = (BloomFilter *) PG_DETOAST_DATUM(col_b->bv_values[0]);
+
+	/*
+	 * Adjust "allnulls".  If A doesn't have values, just copy the filter from
+	 * B into A, and we're done.
+	 */
+	oldcxt = MemoryContextSwitchTo(col_a->bv_context);
+	if (col_a->bv_allnulls)
+	{
+		col_a->bv_allnulls = false;
+		col_a->bv_values[0] = datumCopy(PointerGetDatum(filter_b),
+										false, -1);
+		MemoryContextSwitchTo(oldcxt);
+		PG_RETURN_VOID();
+	}
+
+	filter_a = (BloomFilter *) PG_DETOAST_DATUM(col_a->bv_values[0]);
+	col_a->bv_values[0] = PointerGetDatum(filter_a);
+	MemoryContextSwitchTo(oldcxt);
+
+	/* both filters were sized using the same index parameters */
+	if (filter_a->nbits != filter_b->nbits ||
+		filter_a->nhashes != filter_b->nhashes)
+		elog(ERROR, "bloom filter parameters mismatch (%u/%u bits, %u/%u hashes)",
+			 filter_a->nbits, filter_b->nbits,
+			 filter_a->nhashes, filter_b->nhashes);
+
+	nbytes = filter_a->nbits / 8;
+	for (i = 0; i < nbytes; i++)
+		filter_a->data[i] |= filter_b->data[i];
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * Cache and return the hash procedure for values of the given subtype.
+ *
+ * For values of the indexed type itself we use the opclass support procedure;
+ * for other types in the operator family (cross-type scan keys), we look up
+ * the support procedure registered for that type in the family.  Hash
+ * functions within a family are compatible for logically equal values.
+ */
+static FmgrInfo *
+bloom_get_hash_procinfo(BrinDesc *bdesc, uint16 attno, Oid subtype)
+{
+	BloomOpaque *opaque;
+	Form_pg_attribute attr;
+
+	attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+	if (subtype == InvalidOid || subtype == attr->atttypid)
+		return index_getprocinfo(bdesc->bd_index, attno, BLOOM_PROCNUM_HASH);
+
+	opaque = (BloomOpaque *) bdesc->bd_info[attno - 1]->oi_opaque;
+
+	if (opaque->cached_subtype != subtype ||
+		opaque->hash_procinfo.fn_oid == InvalidOid)
+	{
+		Oid			opfamily;
+		Oid			procid;
+
+		opfamily = bdesc->bd_index->rd_opfamily[attno - 1];
+		procid = get_opfamily_proc(opfamily, subtype, subtype,
+								   BLOOM_PROCNUM_HASH);
+		if (!OidIsValid(procid))
+			elog(ERROR, "missing support function %d(%u,%u) in opfamily %u",
+				 BLOOM_PROCNUM_HASH, subtype, subtype, opfamily);
+
+		fmgr_info_cxt(procid, &opaque->hash_procinfo, bdesc->bd_context);
+		opaque->cached_subtype = subtype;
+	}
+
+	return &opaque->hash_procinfo;
+}
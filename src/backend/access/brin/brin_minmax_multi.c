@@ -0,0 +1,1038 @@
+/*
+ * brin_minmax_multi.c
+ *		Implementation of Multi Min/Max opclass for BRIN
+ *
+ * The plain minmax opclass summarizes a page range with a single [min, max]
+ * interval, which becomes useless as soon as a few outliers get into the
+ * range.  This opclass instead keeps a small set of disjoint intervals and
+ * single points, so that values that are far apart in the domain don't make
+ * the whole gap between them match.
+ *
+ * While values are being added, the summary is kept in memory in a
+ * deserialized form (struct Ranges, referenced by bv_mem_value) with room for
+ * MINMAX_BUFFER_VALUES boundary values; new values that are not yet covered
+ * are simply added as points.  When the buffer fills up, and when the tuple
+ * is serialized, the summary is reduced to at most MINMAX_MAX_VALUES boundary
+ * values by merging the neighbouring intervals that are closest to each
+ * other, as determined by the opclass' distance support procedure.
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * IDENTIFICATION
+ *	  src/backend/access/brin/brin_minmax_multi.c
+ */
+#include "postgres.h"
+
+#include "access/brin_internal.h"
+#include "access/brin_tuple.h"
+#include "access/genam.h"
+#include "access/stratnum.h"
+#include "access/tupmacs.h"
+#include "catalog/pg_amop.h"
+#include "catalog/pg_type.h"
+#include "utils/builtins.h"
+#include "utils/date.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
+#include "utils/numeric.h"
+#include "utils/rel.h"
+#include "utils/syscache.h"
+#include "utils/timestamp.h"
+
+
+/* support procedure numbers */
+#define MINMAX_MULTI_PROCNUM_DISTANCE	11
+
+/*
+ * Maximum number of boundary values stored on disk for a page range (each
+ * interval takes two values, each single point one), and the size of the
+ * in-memory buffer used while adding values.
+ */
+#define MINMAX_MAX_VALUES		32
+#define MINMAX_BUFFER_VALUES	(2 * MINMAX_MAX_VALUES)
+
+typedef struct MinmaxMultiOpaque
+{
+	FmgrInfo	lt_procinfo;	/* "less than" for the indexed type */
+	Oid			cached_subtype;
+	FmgrInfo	strategy_procinfos[BTMaxStrategyNumber];
+} MinmaxMultiOpaque;
+
+/*
+ * In-memory representation of the summary.  The first 2 * nranges entries
+ * of values[] are the boundaries of disjoint intervals, in ascending order;
+ * they are followed by nvalues single points, also sorted, unique and not
+ * covered by any of the intervals.
+ */
+typedef struct Ranges
+{
+	Oid			typid;			/* indexed data type */
+	Oid			colloid;		/* collation to use for comparisons */
+	FmgrInfo   *cmp;			/* "less than" for the indexed type */
+	FmgrInfo   *distance;		/* distance support procedure */
+	int			nranges;		/* number of intervals */
+	int			nvalues;		/* number of single points */
+	int			maxvalues;		/* size of the values[] array */
+	Datum		values[FLEXIBLE_ARRAY_MEMBER];
+} Ranges;
+
+/*
+ * On-disk representation of the summary, stored as a bytea.  The values are
+ * laid out as in Ranges, each aligned according to the data type.
+ */
+typedef struct SerializedRanges
+{
+	int32		vl_len_;		/* varlena header (do not touch directly!) */
+	uint16		nranges;		/* number of intervals */
+	uint16		nvalues;		/* number of single points */
+	char		data[FLEXIBLE_ARRAY_MEMBER];
+} SerializedRanges;
+
+/* a single interval (or point) while rebuilding the summary */
+typedef struct ExpandedRange
+{
+	Datum		minval;
+	Datum		maxval;
+	bool		collapsed;		/* single point, minval == maxval */
+} ExpandedRange;
+
+static Ranges *minmax_multi_init(int maxvalues);
+static SerializedRanges *range_serialize(Ranges *ranges);
+static Ranges *range_deserialize(SerializedRanges *serialized, Oid typid,
+				  int maxvalues);
+static void brin_minmax_multi_serialize(BrinDesc *bdesc, Datum src,
+							Datum *dst);
+static bool range_contains_value(Ranges *ranges, Datum value);
+static bool range_add_value(Ranges *ranges, Datum value);
+static int	range_expand(Ranges *ranges, ExpandedRange *eranges);
+static void range_rebuild(Ranges *ranges, ExpandedRange *eranges,
+			  int neranges, int max_values);
+static int	compare_expanded_ranges(const void *a, const void *b, void *arg);
+static FmgrInfo *minmax_multi_get_lt_procinfo(BrinDesc *bdesc, uint16 attno);
+static FmgrInfo *minmax_multi_get_strategy_procinfo(BrinDesc *bdesc,
+								   uint16 attno, Oid subtype,
+								   uint16 strategynum);
+static void minmax_multi_lookup_operator(BrinDesc *bdesc, uint16 attno,
+							 Oid subtype, uint16 strategynum,
+							 FmgrInfo *finfo);
+
+#define range_lt(ranges, a, b) \
+	DatumGetBool(FunctionCall2Coll((ranges)->cmp, (ranges)->colloid, (a), (b)))
+
+
+/*
+ * Allocate an empty in-memory summary with room for maxvalues values.
+ */
+static Ranges *
+minmax_multi_init(int maxvalues)
+{
+	Ranges	   *ranges;
+
+	ranges = (Ranges *) palloc0(offsetof(Ranges, values) +
+								maxvalues * sizeof(Datum));
+	ranges->maxvalues = maxvalues;
+
+	return ranges;
+}
+
+/*
+ * Convert the in-memory summary into the on-disk bytea.  By-reference values
+ * are copied into the result, so the summary may be discarded afterwards.
+ */
+static SerializedRanges *
+range_serialize(Ranges *ranges)
+{
+	SerializedRanges *serialized;
+	int16		typlen;
+	bool		typbyval;
+	char		typalign;
+	int			nvalues;
+	Size		len;
+	char	   *ptr;
+	int			i;
+
+	get_typlenbyvalalign(ranges->typid, &typlen, &typbyval, &typalign);
+
+	nvalues = 2 * ranges->nranges + ranges->nvalues;
+	Assert(nvalues <= MINMAX_MAX_VALUES);
+
+	/* compute the required space, following the alignment of the values */
+	len = offsetof(SerializedRanges, data);
+	for (i = 0; i < nvalues; i++)
+	{
+		len = att_align_nominal(len, typalign);
+		len = att_addlength_datum(len, typlen, ranges->values[i]);
+	}
+
+	serialized = (SerializedRanges *) palloc0(len);
+	SET_VARSIZE(serialized, len);
+	serialized->nranges = ranges->nranges;
+	serialized->nvalues = ranges->nvalues;
+
+	ptr = (char *) serialized + offsetof(SerializedRanges, data);
+	for (i = 0; i < nvalues; i++)
+	{
+		char	   *start = (char *) serialized;
+
+		ptr = start + att_align_nominal(ptr - start, typalign);
+
+		if (typbyval)
+			store_att_byval(ptr, ranges->values[i], typlen);
+		else if (typlen > 0)
+			memcpy(ptr, DatumGetPointer(ranges->values[i]), typlen);
+		else if (typlen == -1)
+			memcpy(ptr, DatumGetPointer(ranges->values[i]),
+				   VARSIZE_ANY(DatumGetPointer(ranges->values[i])));
+		else
+			strcpy(ptr, DatumGetCString(ranges->values[i]));
+
+		ptr = (char *) att_addlength_datum(ptr, typlen, ranges->values[i]);
+	}
+
+	Assert(ptr == (char *) serialized + len);
+
+	return serialized;
+}
+
+/*
+ * Convert the on-disk bytea into an in-memory summary with room for at least
+ * maxvalues values.  By-reference values point into the serialized data, so
+ * it must not be freed while the summary is in use.
+ */
+static Ranges *
+range_deserialize(SerializedRanges *serialized, Oid typid, int maxvalues)
+{
+	Ranges	   *ranges;
+	int16		typlen;
+	bool		typbyval;
+	char		typalign;
+	int			nvalues;
+	char	   *start;
+	char	   *ptr;
+	int			i;
+
+	get_typlenbyvalalign(typid, &typlen, &typbyval, &typalign);
+
+	nvalues = 2 * serialized->nranges + serialized->nvalues;
+	ranges = minmax_multi_init(Max(nvalues, maxvalues));
+	ranges->typid = typid;
+	ranges->nranges = serialized->nranges;
+	ranges->nvalues = serialized->nvalues;
+
+	start = (char *) serialized;
+	ptr = start + offsetof(SerializedRanges, data);
+	for (i = 0; i < nvalues; i++)
+	{
+		ptr = start + att_align_nominal(ptr - start, typalign);
+		ranges->values[i] = fetch_att(ptr, typbyval, typlen);
+		ptr = (char *) att_addlength_pointer(ptr, typlen, ptr);
+	}
+
+	return ranges;
+}
+
+/*
+ * Serialization callback, invoked by brin_form_tuple: reduce the summary to
+ * the number of values we keep on disk, and store it as the column value.
+ */
+static void
+brin_minmax_multi_serialize(BrinDesc *bdesc, Datum src, Datum *dst)
+{
+	Ranges	   *ranges = (Ranges *) DatumGetPointer(src);
+	ExpandedRange *eranges;
+	int			neranges;
+
+	eranges = palloc(sizeof(ExpandedRange) *
+					 (ranges->nranges + ranges->nvalues));
+	neranges = range_expand(ranges, eranges);
+	range_rebuild(ranges, eranges, neranges, MINMAX_MAX_VALUES);
+	pfree(eranges);
+
+	dst[0] = PointerGetDatum(range_serialize(ranges));
+}
+
+/*
+ * Does the summary cover the given value?
+ */
+static bool
+range_contains_value(Ranges *ranges, Datum value)
+{
+	int			lo,
+				hi;
+
+	/* binary search over the intervals */
+	lo = 0;
+	hi = ranges->nranges - 1;
+	while (lo <= hi)
+	{
+		int			mid = (lo + hi) / 2;
+
+		if (range_lt(ranges, value, ranges->values[2 * mid]))
+			hi = mid - 1;
+		else if (range_lt(ranges, ranges->values[2 * mid + 1], value))
+			lo = mid + 1;
+		else
+			return true;
+	}
+
+	/* binary search over the single points */
+	lo = 2 * ranges->nranges;
+	hi = 2 * ranges->nranges + ranges->nvalues - 1;
+	while (lo <= hi)
+	{
+		int			mid = (lo + hi) / 2;
+
+		if (range_lt(ranges, value, ranges->values[mid]))
+			hi = mid - 1;
+		else if (range_lt(ranges, ranges->values[mid], value))
+			lo = mid + 1;
+		else
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Add a value to the summary, unless it's already covered.  The caller must
+ * have copied the value into a suitable memory context.  Returns true if the
+ * summary was modified.
+ */
+static bool
+range_add_value(Ranges *ranges, Datum value)
+{
+	int			lo,
+				hi;
+	Datum	   *points;
+
+	if (range_contains_value(ranges, value))
+		return false;
+
+	/*
+	 * If the buffer is full, merge the closest intervals first.  That may
+	 * make the new value covered by one of them, in which case we're done.
+	 */
+	if (2 * ranges->nranges + ranges->nvalues >= ranges->maxvalues)
+	{
+		ExpandedRange *eranges;
+		int			neranges;
+
+		eranges = palloc(sizeof(ExpandedRange) *
+						 (ranges->nranges + ranges->nvalues));
+		neranges = range_expand(ranges, eranges);
+		range_rebuild(ranges, eranges, neranges, MINMAX_MAX_VALUES);
+		pfree(eranges);
+
+		if (range_contains_value(ranges, value))
+			return true;
+	}
+
+	/* insert the new point, keeping the points sorted */
+	points = &ranges->values[2 * ranges->nranges];
+	lo = 0;
+	hi = ranges->nvalues;
+	while (lo < hi)
+	{
+		int			mid = (lo + hi) / 2;
+
+		if (range_lt(ranges, points[mid], value))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	memmove(&points[lo + 1], &points[lo],
+			(ranges->nvalues - lo) * sizeof(Datum));
+	points[lo] = value;
+	ranges->nvalues++;
+
+	return true;
+}
+
+/*
+ * Expand the summary into an array of intervals, with single points as
+ * collapsed intervals.  The array must have room for nranges + nvalues
+ * entries; returns the number of entries filled in.  The result is not
+ * sorted.
+ */
+static int
+range_expand(Ranges *ranges, ExpandedRange *eranges)
+{
+	int			i;
+	int			n = 0;
+
+	for (i = 0; i < ranges->nranges; i++)
+	{
+		eranges[n].minval = ranges->values[2 * i];
+		eranges[n].maxval = ranges->values[2 * i + 1];
+		eranges[n].collapsed = false;
+		n++;
+	}
+
+	for (i = 0; i < ranges->nvalues; i++)
+	{
+		eranges[n].minval = ranges->values[2 * ranges->nranges + i];
+		eranges[n].maxval = eranges[n].minval;
+		eranges[n].collapsed = true;
+		n++;
+	}
+
+	return n;
+}
+
+/*
+ * Rebuild the summary from an arbitrary array of intervals and points, so
+ * that it uses at most max_values boundary values.
+ *
+ * The intervals are sorted and overlapping ones merged.  Then, as long as
+ * there are too many values, the two neighbouring intervals with the smallest
+ * gap between them are merged.  Merging doesn't change the gaps between the
+ * other neighbours, so the distances only need to be computed once.
+ */
+static void
+range_rebuild(Ranges *ranges, ExpandedRange *eranges, int neranges,
+			  int max_values)
+{
+	double	   *gaps;
+	int			nvalues;
+	int			n;
+	int			i;
+
+	Assert(max_values >= 2 && max_values <= ranges->maxvalues);
+
+	if (neranges == 0)
+	{
+		ranges->nranges = 0;
+		ranges->nvalues = 0;
+		return;
+	}
+
+	qsort_arg(eranges, neranges, sizeof(ExpandedRange),
+			  compare_expanded_ranges, ranges);
+
+	/* merge overlapping intervals (and duplicate points) */
+	n = 0;
+	for (i = 1; i < neranges; i++)
+	{
+		if (range_lt(ranges, eranges[n].maxval, eranges[i].minval))
+		{
+			eranges[++n] = eranges[i];
+			continue;
+		}
+
+		if (range_lt(ranges, eranges[n].maxval, eranges[i].maxval))
+			eranges[n].maxval = eranges[i].maxval;
+		eranges[n].collapsed = eranges[n].collapsed && eranges[i].collapsed;
+	}
+	neranges = n + 1;
+
+	nvalues = 0;
+	for (i = 0; i < neranges; i++)
+		nvalues += eranges[i].collapsed ? 1 : 2;
+
+	if (nvalues > max_values)
+	{
+		gaps = palloc(sizeof(double) * neranges);
+		for (i = 0; i < neranges - 1; i++)
+			gaps[i] = DatumGetFloat8(FunctionCall2Coll(ranges->distance,
+													   ranges->colloid,
+													   eranges[i].maxval,
+													   eranges[i + 1].minval));
+
+		while (nvalues > max_values)
+		{
+			int			best = 0;
+
+			Assert(neranges > 1);
+
+			for (i = 1; i < neranges - 1; i++)
+			{
+				if (gaps[i] < gaps[best])
+					best = i;
+			}
+
+			/* merge eranges[best + 1] into eranges[best] */
+			nvalues -= (eranges[best].collapsed ? 1 : 2) +
+				(eranges[best + 1].collapsed ? 1 : 2) - 2;
+			eranges[best].maxval = eranges[best + 1].maxval;
+			eranges[best].collapsed = false;
+
+			memmove(&eranges[best + 1], &eranges[best + 2],
+					(neranges - best - 2) * sizeof(ExpandedRange));
+			memmove(&gaps[best], &gaps[best + 1],
+					(neranges - best - 2) * sizeof(double));
+			neranges--;
+		}
+
+		pfree(gaps);
+	}
+
+	/* store intervals first, then the single points; both stay sorted */
+	ranges->nranges = 0;
+	for (i = 0; i < neranges; i++)
+	{
+		if (eranges[i].collapsed)
+			continue;
+		ranges->values[2 * ranges->nranges] = eranges[i].minval;
+		ranges->values[2 * ranges->nranges + 1] = eranges[i].maxval;
+		ranges->nranges++;
+	}
+
+	ranges->nvalues = 0;
+	for (i = 0; i < neranges; i++)
+	{
+		if (!eranges[i].collapsed)
+			continue;
+		ranges->values[2 * ranges->nranges + ranges->nvalues] =
+			eranges[i].minval;
+		ranges->nvalues++;
+	}
+}
+
+/* qsort_arg comparator for ExpandedRange, by minimum value */
+static int
+compare_expanded_ranges(const void *a, const void *b, void *arg)
+{
+	ExpandedRange *ra = (ExpandedRange *) a;
+	ExpandedRange *rb = (ExpandedRange *) b;
+	Ranges	   *ranges = (Ranges *) arg;
+
+	if (range_lt(ranges, ra->minval, rb->minval))
+		return -1;
+	if (range_lt(ranges, rb->minval, ra->minval))
+		return 1;
+	return 0;
+}
+
+Datum
+brin_minmax_multi_opcinfo(PG_FUNCTION_ARGS)
+{
+	BrinOpcInfo *result;
+
+	/*
+	 * opaque->lt_procinfo and opaque->strategy_procinfos are initialized
+	 * lazily; here they are set to all-uninitialized by palloc0 which sets
+	 * fn_oid to InvalidOid.
+	 *
+	 * The summary is stored as a bytea regardless of the indexed type.
+	 */
+	result = palloc0(MAXALIGN(SizeofBrinOpcInfo(1)) +
+					 sizeof(MinmaxMultiOpaque));
+	result->oi_nstored = 1;
+	result->oi_opaque = (MinmaxMultiOpaque *)
+		MAXALIGN((char *) result + SizeofBrinOpcInfo(1));
+	result->oi_typcache[0] = lookup_type_cache(BYTEAOID, 0);
+
+	PG_RETURN_POINTER(result);
+}
+
+/*
+ * Examine the given index tuple (which contains partial status of a certain
+ * page range) by comparing it to the given value that comes from another heap
+ * tuple.  If the new value is not covered by the existing summary, add it and
+ * return true.  Otherwise, return false and do not modify in this case.
+ */
+Datum
+brin_minmax_multi_add_value(PG_FUNCTION_ARGS)
+{
+	BrinDesc   *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+	BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+	Datum		newval = PG_GETARG_DATUM(2);
+	bool		isnull = PG_GETARG_DATUM(3);
+	Oid			colloid = PG_GET_COLLATION();
+	bool		updated = false;
+	Form_pg_attribute attr;
+	AttrNumber	attno;
+	Ranges	   *ranges;
+	MemoryContext oldcxt;
+
+	/*
+	 * If the new value is null, we record that we saw it if it's the first
+	 * one; otherwise, there's nothing to do.
+	 */
+	if (isnull)
+	{
+		if (column->bv_hasnulls)
+			PG_RETURN_BOOL(false);
+
+		column->bv_hasnulls = true;
+		PG_RETURN_BOOL(true);
+	}
+
+	attno = column->bv_attno;
+	attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+
+	/* the summary and the values in it must live as long as the tuple */
+	oldcxt = MemoryContextSwitchTo(column->bv_context);
+
+	/*
+	 * Deserialize the summary the first time we see this tuple, and keep it
+	 * in bv_mem_value for the following values; brin_form_tuple serializes it
+	 * again through the callback.
+	 */
+	if (DatumGetPointer(column->bv_mem_value) == NULL)
+	{
+		if (column->bv_allnulls)
+		{
+			ranges = minmax_multi_init(MINMAX_BUFFER_VALUES);
+			ranges->typid = attr->atttypid;
+			column->bv_allnulls = false;
+			updated = true;
+		}
+		else
+		{
+			SerializedRanges *serialized;
+
+			serialized = (SerializedRanges *)
+				PG_DETOAST_DATUM(column->bv_values[0]);
+			ranges = range_deserialize(serialized, attr->atttypid,
+									   MINMAX_BUFFER_VALUES);
+		}
+
+		ranges->colloid = colloid;
+		ranges->cmp = minmax_multi_get_lt_procinfo(bdesc, attno);
+		ranges->distance = index_getprocinfo(bdesc->bd_index, attno,
+											 MINMAX_MULTI_PROCNUM_DISTANCE);
+
+		column->bv_mem_value = PointerGetDatum(ranges);
+		column->bv_serialize = brin_minmax_multi_serialize;
+	}
+	else
+		ranges = (Ranges *) DatumGetPointer(column->bv_mem_value);
+
+	if (!range_contains_value(ranges, newval))
+	{
+		/* store a plain copy, as the summary gets copied verbatim */
+		if (attr->attlen == -1)
+			newval = PointerGetDatum(PG_DETOAST_DATUM(newval));
+		newval = datumCopy(newval, attr->attbyval, attr->attlen);
+
+		updated |= range_add_value(ranges, newval);
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+
+	PG_RETURN_BOOL(updated);
+}
+
+/*
+ * Given an index tuple corresponding to a certain page range and a scan key,
+ * return whether the scan key is consistent with the intervals and points in
+ * the index tuple's summary.  Return true if so, false otherwise.
+ */
+Datum
+brin_minmax_multi_consistent(PG_FUNCTION_ARGS)
+{
+	BrinDesc   *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+	BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+	ScanKey		key = (ScanKey) PG_GETARG_POINTER(2);
+	Oid			colloid = PG_GET_COLLATION(),
+				subtype;
+	AttrNumber	attno;
+	Datum		value;
+	Form_pg_attribute attr;
+	SerializedRanges *serialized;
+	Ranges	   *ranges;
+	Datum	   *points;
+	FmgrInfo   *finfo;
+	bool		matches = false;
+	int			i;
+
+	Assert(key->sk_attno == column->bv_attno);
+
+	/* handle IS NULL/IS NOT NULL tests */
+	if (key->sk_flags & SK_ISNULL)
+	{
+		if (key->sk_flags & SK_SEARCHNULL)
+		{
+			if (column->bv_allnulls || column->bv_hasnulls)
+				PG_RETURN_BOOL(true);
+			PG_RETURN_BOOL(false);
+		}
+
+		/*
+		 * For IS NOT NULL, we can only skip ranges that are known to have
+		 * only nulls.
+		 */
+		if (key->sk_flags & SK_SEARCHNOTNULL)
+			PG_RETURN_BOOL(!column->bv_allnulls);
+
+		/*
+		 * Neither IS NULL nor IS NOT NULL was used; assume all indexable
+		 * operators are strict and return false.
+		 */
+		PG_RETURN_BOOL(false);
+	}
+
+	/* if the range is all empty, it cannot possibly be consistent */
+	if (column->bv_allnulls)
+		PG_RETURN_BOOL(false);
+
+	attno = key->sk_attno;
+	subtype = key->sk_subtype;
+	value = key->sk_argument;
+	attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+
+	serialized = (SerializedRanges *) PG_DETOAST_DATUM(column->bv_values[0]);
+	ranges = range_deserialize(serialized, attr->atttypid, 0);
+	points = &ranges->values[2 * ranges->nranges];
+
+	switch (key->sk_strategy)
+	{
+		case BTLessStrategyNumber:
+		case BTLessEqualStrategyNumber:
+
+			/* only the smallest interval and point can match */
+			finfo = minmax_multi_get_strategy_procinfo(bdesc, attno, subtype,
+													   key->sk_strategy);
+			if (ranges->nranges > 0)
+				matches = DatumGetBool(FunctionCall2Coll(finfo, colloid,
+														 ranges->values[0],
+														 value));
+			if (!matches && ranges->nvalues > 0)
+				matches = DatumGetBool(FunctionCall2Coll(finfo, colloid,
+														 points[0],
+														 value));
+			break;
+		case BTEqualStrategyNumber:
+
+			/*
+			 * In the equality case (WHERE col = someval), we want to return
+			 * the current page range if any of the intervals contains the
+			 * scan key, or any of the points is equal to it.
+			 */
+			for (i = 0; i < ranges->nranges && !matches; i++)
+			{
+				Datum		minval = ranges->values[2 * i];
+				Datum		maxval = ranges->values[2 * i + 1];
+
+				finfo = minmax_multi_get_strategy_procinfo(bdesc, attno, subtype,
+														   BTLessEqualStrategyNumber);
+				if (!DatumGetBool(FunctionCall2Coll(finfo, colloid,
+													minval, value)))
+					continue;
+				finfo = minmax_multi_get_strategy_procinfo(bdesc, attno, subtype,
+														   BTGreaterEqualStrategyNumber);
+				matches = DatumGetBool(FunctionCall2Coll(finfo, colloid,
+														 maxval, value));
+			}
+
+			finfo = minmax_multi_get_strategy_procinfo(bdesc, attno, subtype,
+													   BTEqualStrategyNumber);
+			for (i = 0; i < ranges->nvalues && !matches; i++)
+				matches = DatumGetBool(FunctionCall2Coll(finfo, colloid,
+														 points[i], value));
+			break;
+		case BTGreaterEqualStrategyNumber:
+		case BTGreaterStrategyNumber:
+
+			/* only the largest interval and point can match */
+			finfo = minmax_multi_get_strategy_procinfo(bdesc, attno, subtype,
+													   key->sk_strategy);
+			if (ranges->nranges > 0)
+			{
+				Datum		maxval = ranges->values[2 * ranges->nranges - 1];
+
+				matches = DatumGetBool(FunctionCall2Coll(finfo, colloid,
+														 maxval, value));
+			}
+			if (!matches && ranges->nvalues > 0)
+			{
+				Datum		maxval = points[ranges->nvalues - 1];
+
+				matches = DatumGetBool(FunctionCall2Coll(finfo, colloid,
+														 maxval, value));
+			}
+			break;
+		default:
+			/* shouldn't happen */
+			elog(ERROR, "invalid strategy number %d", key->sk_strategy);
+			break;
+	}
+
+	PG_RETURN_BOOL(matches);
+}
+
+/*
+ * Given two BrinValues, update the first of them as a union of the summary
+ * values contained in both.  The second one is untouched.
+ */
+Datum
+brin_minmax_multi_union(PG_FUNCTION_ARGS)
+{
+	BrinDesc   *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+	BrinValues *col_a = (BrinValues *) PG_GETARG_POINTER(1);
+	BrinValues *col_b = (BrinValues *) PG_GETARG_POINTER(2);
+	Oid			colloid = PG_GET_COLLATION();
+	AttrNumber	attno;
+	Form_pg_attribute attr;
+	Ranges	   *ranges_a;
+	Ranges	   *ranges_b;
+	ExpandedRange *eranges;
+	int			neranges;
+	int			i;
+	MemoryContext oldcxt;
+
+	Assert(col_a->bv_attno == col_b->bv_attno);
+
+	/* Adjust "hasnulls" */
+	if (!col_a->bv_hasnulls && col_b->bv_hasnulls)
+		col_a->bv_hasnulls = true;
+
+	/* If there are no values in B, there's nothing left to do */
+	if (col_b->bv_allnulls)
+		PG_RETURN_VOID();
+
+	attno = col_a->bv_attno;
+	attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+
+	oldcxt = MemoryContextSwitchTo(col_a->bv_context);
+
+	/*
+	 * Get A's summary: it may be already deserialized if values were added
+	 * to it, or it may have no values at all.
+	 */
+	if (DatumGetPointer(col_a->bv_mem_value) != NULL)
+		ranges_a = (Ranges *) DatumGetPointer(col_a->bv_mem_value);
+	else
+	{
+		if (col_a->bv_allnulls)
+		{
+			ranges_a = minmax_multi_init(MINMAX_BUFFER_VALUES);
+			ranges_a->typid = attr->atttypid;
+			col_a->bv_allnulls = false;
+		}
+		else
+			ranges_a = range_deserialize((SerializedRanges *)
+										 PG_DETOAST_DATUM(col_a->bv_values[0]),
+										 attr->atttypid,
+										 MINMAX_BUFFER_VALUES);
+
+		ranges_a->colloid = colloid;
+		ranges_a->cmp = minmax_multi_get_lt_procinfo(bdesc, attno);
+		ranges_a->distance = index_getprocinfo(bdesc->bd_index, attno,
+											   MINMAX_MULTI_PROCNUM_DISTANCE);
+
+		col_a->bv_mem_value = PointerGetDatum(ranges_a);
+		col_a->bv_serialize = brin_minmax_multi_serialize;
+	}
+
+	/* B's values must be copied, as they may go away after we return */
+	ranges_b = range_deserialize((SerializedRanges *)
+								 PG_DETOAST_DATUM(col_b->bv_values[0]),
+								 attr->atttypid, 0);
+	for (i = 0; i < 2 * ranges_b->nranges + ranges_b->nvalues; i++)
+		ranges_b->values[i] = datumCopy(ranges_b->values[i],
+										attr->attbyval, attr->attlen);
+
+	/* combine both summaries and reduce the result */
+	eranges = palloc(sizeof(ExpandedRange) *
+					 (ranges_a->nranges + ranges_a->nvalues +
+					  ranges_b->nranges + ranges_b->nvalues));
+	neranges = range_expand(ranges_a, eranges);
+	neranges += range_expand(ranges_b, &eranges[neranges]);
+	range_rebuild(ranges_a, eranges, neranges, MINMAX_MAX_VALUES);
+	pfree(eranges);
+
+	MemoryContextSwitchTo(oldcxt);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * Compute distance between two int2 values.
+ */
+Datum
+brin_minmax_multi_distance_int2(PG_FUNCTION_ARGS)
+{
+	int16		a = PG_GETARG_INT16(0);
+	int16		b = PG_GETARG_INT16(1);
+
+	PG_RETURN_FLOAT8((double) b - (double) a);
+}
+
+/*
+ * Compute distance between two int4 values.
+ */
+Datum
+brin_minmax_multi_distance_int4(PG_FUNCTION_ARGS)
+{
+	int32		a = PG_GETARG_INT32(0);
+	int32		b = PG_GETARG_INT32(1);
+
+	PG_RETURN_FLOAT8((double) b - (double) a);
+}
+
+/*
+ * Compute distance between two int8 values.
+ */
+Datum
+brin_minmax_multi_distance_int8(PG_FUNCTION_ARGS)
+{
+	int64		a = PG_GETARG_INT64(0);
+	int64		b = PG_GETARG_INT64(1);
+
+	PG_RETURN_FLOAT8((double) b - (double) a);
+}
+
+/*
+ * Compute distance between two float4 values.
+ */
+Datum
+brin_minmax_multi_distance_float4(PG_FUNCTION_ARGS)
+{
+	float4		a = PG_GETARG_FLOAT4(0);
+	float4		b = PG_GETARG_FLOAT4(1);
+
+	PG_RETURN_FLOAT8((double) b - (double) a);
+}
+
+/*
+ * Compute distance between two float8 values.
+ */
+Datum
+brin_minmax_multi_distance_float8(PG_FUNCTION_ARGS)
+{
+	float8		a = PG_GETARG_FLOAT8(0);
+	float8		b = PG_GETARG_FLOAT8(1);
+
+	PG_RETURN_FLOAT8(b - a);
+}
+
+/*
+ * Compute distance between two numeric values.
+ */
+Datum
+brin_minmax_multi_distance_numeric(PG_FUNCTION_ARGS)
+{
+	Datum		a = PG_GETARG_DATUM(0);
+	Datum		b = PG_GETARG_DATUM(1);
+	Datum		d;
+
+	d = DirectFunctionCall2(numeric_sub, b, a);
+
+	PG_RETURN_DATUM(DirectFunctionCall1(numeric_float8, d));
+}
+
+/*
+ * Compute distance between two date values, in days.
+ */
+Datum
+brin_minmax_multi_distance_date(PG_FUNCTION_ARGS)
+{
+	DateADT		a = PG_GETARG_DATEADT(0);
+	DateADT		b = PG_GETARG_DATEADT(1);
+
+	PG_RETURN_FLOAT8((double) b - (double) a);
+}
+
+/*
+ * Compute distance between two timestamp (or timestamptz) values, in
+ * microseconds.
+ */
+Datum
+brin_minmax_multi_distance_timestamp(PG_FUNCTION_ARGS)
+{
+	Timestamp	a = PG_GETARG_TIMESTAMP(0);
+	Timestamp	b = PG_GETARG_TIMESTAMP(1);
+
+	PG_RETURN_FLOAT8((double) b - (double) a);
+}
+
+/*
+ * Cache and return the "less than" procedure of the indexed type, which we
+ * use to keep the summary sorted.  Unlike the procedures returned by
+ * minmax_multi_get_strategy_procinfo, this one is never invalidated, so it
+ * can be referenced from the in-memory summary.
+ */
+static FmgrInfo *
+minmax_multi_get_lt_procinfo(BrinDesc *bdesc, uint16 attno)
+{
+	MinmaxMultiOpaque *opaque;
+
+	opaque = (MinmaxMultiOpaque *) bdesc->bd_info[attno - 1]->oi_opaque;
+
+	if (opaque->lt_procinfo.fn_oid == InvalidOid)
+	{
+		Form_pg_attribute attr;
+
+		attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+		minmax_multi_lookup_operator(bdesc, attno, attr->atttypid,
+									 BTLessStrategyNumber,
+									 &opaque->lt_procinfo);
+	}
+
+	return &opaque->lt_procinfo;
+}
+
+/*
+ * Cache and return the procedure for the given strategy.
+ *
+ * Note: this function mirrors minmax_get_strategy_procinfo; see notes there.
+ * If changes are made here, see that function too.
+ */
+static FmgrInfo *
+minmax_multi_get_strategy_procinfo(BrinDesc *bdesc, uint16 attno, Oid subtype,
+								   uint16 strategynum)
+{
+	MinmaxMultiOpaque *opaque;
+
+	Assert(strategynum >= 1 &&
+		   strategynum <= BTMaxStrategyNumber);
+
+	opaque = (MinmaxMultiOpaque *) bdesc->bd_info[attno - 1]->oi_opaque;
+
+	/*
+	 * We cache the procedures for the previous subtype in the opaque struct,
+	 * to avoid repetitive syscache lookups.  If the subtype changed,
+	 * invalidate all the cached entries.
+	 */
+	if (opaque->cached_subtype != subtype)
+	{
+		uint16		i;
+
+		for (i = 1; i <= BTMaxStrategyNumber; i++)
+			opaque->strategy_procinfos[i - 1].fn_oid = InvalidOid;
+		opaque->cached_subtype = subtype;
+	}
+
+	if (opaque->strategy_procinfos[strategynum - 1].fn_oid == InvalidOid)
+		minmax_multi_lookup_operator(bdesc, attno, subtype, strategynum,
+									 &opaque->strategy_procinfos[strategynum - 1]);
+
+	return &opaque->strategy_procinfos[strategynum - 1];
+}
+
+/*
+ * Look up the operator for the given strategy and subtype in the opfamily of
+ * the given index column, and initialize finfo with its procedure.
+ */
+static void
+minmax_multi_lookup_operator(BrinDesc *bdesc, uint16 attno, Oid subtype,
+							 uint16 strategynum, FmgrInfo *finfo)
+{
+	Form_pg_attribute attr;
+	HeapTuple	tuple;
+	Oid			opfamily,
+				oprid;
+	bool		isNull;
+
+	opfamily = bdesc->bd_index->rd_opfamily[attno - 1];
+	attr = TupleDescAttr(bdesc->bd_tupdesc, attno - 1);
+	tuple = SearchSysCache4(AMOPSTRATEGY, ObjectIdGetDatum(opfamily),
+							ObjectIdGetDatum(attr->atttypid),
+							ObjectIdGetDatum(subtype),
+							Int16GetDatum(strategynum));
+
+	if (!HeapTupleIsValid(tuple))
+		elog(ERROR, "missing operator %d(%u,%u) in opfamily %u",
+			 strategynum, attr->atttypid, subtype, opfamily);
+
+	oprid = DatumGetObjectId(SysCacheGetAttr(AMOPSTRATEGY, tuple,
+											 Anum_pg_amop_amopopr, &isNull));
+	ReleaseSysCache(tuple);
+	Assert(!isNull && RegProcedureIsValid(oprid));
+
+	fmgr_info_cxt(get_opcode(oprid), finfo, bdesc->bd_context);
+}
@@ -139,6 +139,18 @@ brin_form_tuple(BrinDesc *brdesc, BlockNumber blkno, BrinMemTuple *tuple,
 		if (tuple->bt_columns[keyno].bv_hasnulls)
 			anynulls = true;
 
+		/*
+		 * If the opclass keeps a working representation of the summary,
+		 * convert it to the stored values first.
+		 */
+		if (tuple->bt_columns[keyno].bv_serialize)
+		{
+			BrinValues *column = &tuple->bt_columns[keyno];
+
+			column->bv_serialize(brdesc, column->bv_mem_value,
+								 column->bv_values);
+		}
+
 		for (datumno = 0;
 			 datumno < brdesc->bd_info[keyno]->oi_nstored;
 			 datumno++)
@@ -400,6 +412,9 @@ brin_memtuple_initialize(BrinMemTuple *dtuple, BrinDesc *brdesc)
 		dtuple->bt_columns[i].bv_allnulls = true;
 		dtuple->bt_columns[i].bv_hasnulls = false;
 		dtuple->bt_columns[i].bv_values = (Datum *) currdatum;
+		dtuple->bt_columns[i].bv_mem_value = PointerGetDatum(NULL);
+		dtuple->bt_columns[i].bv_context = dtuple->bt_context;
+		dtuple->bt_columns[i].bv_serialize = NULL;
 		currdatum += sizeof(Datum) * brdesc->bd_info[i]->oi_nstored;
 	}
 
@@ -915,6 +915,102 @@ heap_modify_tuple_by_cols(HeapTuple tuple,
 	return newTuple;
 }
 
+/*
+ * compute_fixed_prefix
+ *		Work out the tuple descriptor's fixed-width prefix, for
+ *		deform_fixed_prefix.
+ *
+ * The fixed-width prefix is the run of leading attributes that are neither
+ * variable-width nor dropped.  Each of those starts at the same offset in
+ * every tuple in which none of them is null, so we can fill in all their
+ * attcacheoffs right away instead of discovering them one by one.
+ *
+ * Note that attnotnull is no help in deciding whether an attribute can be
+ * null in a given tuple: composite values of a table's rowtype use the
+ * table's descriptor, and may well have nulls in its NOT NULL columns.
+ *
+ * This is done once per descriptor, the first time a tuple using it is
+ * deformed; anything that changes an attribute of a descriptor resets
+ * tdfixedatts to -1.
+ */
+static void
+compute_fixed_prefix(TupleDesc tupleDesc)
+{
+	int			attnum;
+	long		off = 0;
+
+	for (attnum = 0; attnum < tupleDesc->natts; attnum++)
+	{
+		Form_pg_attribute thisatt = TupleDescAttr(tupleDesc, attnum);
+
+		if (thisatt->attlen <= 0 || thisatt->attisdropped)
+			break;
+
+		off = att_align_nominal(off, thisatt->attalign);
+		thisatt->attcacheoff = off;
+		off += thisatt->attlen;
+	}
+
+	tupleDesc->tdfixedatts = attnum;
+}
+
+/*
+ * fixed_prefix_natts
+ *		How many leading attributes of the tuple, up to natts, can be
+ *		fetched from their cached offsets by deform_fixed_prefix?
+ *
+ * If the tuple has nulls, that's the leading attributes that the null
+ * bitmap shows to be present in this tuple.  The bitmap is checked a byte
+ * at a time where possible.
+ */
+static inline int
+fixed_prefix_natts(TupleDesc tupleDesc, bool hasnulls, bits8 *bp, int natts)
+{
+	int			n;
+
+	if (tupleDesc->tdfixedatts < 0)
+		compute_fixed_prefix(tupleDesc);
+
+	natts = Min(natts, tupleDesc->tdfixedatts);
+	if (!hasnulls)
+		return natts;
+
+	n = 0;
+	while (n + 8 <= natts && bp[n >> 3] == 0xFF)
+		n += 8;
+	while (n < natts && !att_isnull(n, bp))
+		n++;
+
+	return n;
+}
+
+/*
+ * deform_fixed_prefix
+ *		Extract attributes attnum up to natts - 1, which must all be in the
+ *		fixed-width prefix and not null, from their cached offsets.
+ *
+ * This is the fast path of heap_deform_tuple and slot_deform_tuple: there
+ * is no null bitmap to look at and no alignment to compute, just a fetch
+ * per attribute.  Returns the offset just past the last attribute fetched.
+ */
+static inline long
+deform_fixed_prefix(TupleDesc tupleDesc, char *tp, int attnum, int natts,
+					Datum *values, bool *isnull)
+{
+	Form_pg_attribute thisatt = NULL;
+
+	Assert(attnum < natts && natts <= tupleDesc->tdfixedatts);
+
+	for (; attnum < natts; attnum++)
+	{
+		thisatt = TupleDescAttr(tupleDesc, attnum);
+		values[attnum] = fetchatt(thisatt, tp + thisatt->attcacheoff);
+		isnull[attnum] = false;
+	}
+
+	return thisatt->attcacheoff + thisatt->attlen;
+}
+
 /*
  * heap_deform_tuple
  *		Given a tuple, extract data into values/isnull arrays; this is
@@ -940,6 +1036,7 @@ heap_deform_tuple(HeapTuple tuple, TupleDesc tupleDesc,
 	bool		hasnulls = HeapTupleHasNulls(tuple);
 	int			tdesc_natts = tupleDesc->natts;
 	int			natts;			/* number of atts to extract */
+	int			fixednatts;		/* number we can get from cached offsets */
 	int			attnum;
 	char	   *tp;				/* ptr to tuple data */
 	long		off;			/* offset in tuple data */
@@ -958,8 +1055,17 @@ heap_deform_tuple(HeapTuple tuple, TupleDesc tupleDesc,
 	tp = (char *) tup + tup->t_hoff;
 
 	off = 0;
+	attnum = 0;
+
+	fixednatts = fixed_prefix_natts(tupleDesc, hasnulls, bp, natts);
+	if (fixednatts > 0)
+	{
+		off = deform_fixed_prefix(tupleDesc, tp, 0, fixednatts,
+								  values, isnull);
+		attnum = fixednatts;
+	}
 
-	for (attnum = 0; attnum < natts; attnum++)
+	for (; attnum < natts; attnum++)
 	{
 		Form_pg_attribute thisatt = TupleDescAttr(tupleDesc, attnum);
 
@@ -1046,6 +1152,7 @@ slot_deform_tuple(TupleTableSlot *slot, int natts)
 	long		off;			/* offset in tuple data */
 	bits8	   *bp = tup->t_bits;	/* ptr to null bitmap in tuple */
 	bool		slow;			/* can we use/set attcacheoff? */
+	int			fixednatts;		/* number we can get from cached offsets */
 
 	/*
 	 * Check whether the first call for this tuple, and initialize or restore
@@ -1067,6 +1174,18 @@ slot_deform_tuple(TupleTableSlot *slot, int natts)
 
 	tp = (char *) tup + tup->t_hoff;
 
+	/*
+	 * Attributes in the descriptor's fixed-width prefix that can't be null in
+	 * this tuple are fetched straight from their cached offsets.
+	 */
+	fixednatts = fixed_prefix_natts(tupleDesc, hasnulls, bp, natts);
+	if (attnum < fixednatts)
+	{
+		off = deform_fixed_prefix(tupleDesc, tp, attnum, fixednatts,
+								  values, isnull);
+		attnum = fixednatts;
+	}
+
 	for (; attnum < natts; attnum++)
 	{
 		Form_pg_attribute thisatt = TupleDescAttr(tupleDesc, attnum);
@@ -1216,6 +1335,20 @@ slot_getattr(TupleTableSlot *slot, int attnum, bool *isnull)
 		return (Datum) 0;
 	}
 
+	/*
+	 * If the attribute and everything before it are at fixed offsets, fetch
+	 * it directly, without extracting the preceding attributes.
+	 */
+	if (fixed_prefix_natts(tupleDesc, HeapTupleHasNulls(tuple), tup->t_bits,
+						   attnum) == attnum)
+	{
+		Form_pg_attribute thisatt = TupleDescAttr(tupleDesc, attnum - 1);
+
+		*isnull = false;
+		return fetchatt(thisatt, (char *) tup + tup->t_hoff +
+						thisatt->attcacheoff);
+	}
+
 	/*
 	 * Extract the attribute, along with any preceding attributes.
 	 */
@@ -65,6 +65,7 @@ CreateTemplateTupleDesc(int natts, bool hasoid)
 	desc->tdtypmod = -1;
 	desc->tdhasoid = hasoid;
 	desc->tdrefcount = -1;		/* assume not reference-counted */
+	desc->tdfixedatts = -1;
 
 	return desc;
 }
@@ -221,6 +222,7 @@ TupleDescCopyEntry(TupleDesc dst, AttrNumber dstAttno,
 	 */
 	dstAtt->attnum = dstAttno;
 	dstAtt->attcacheoff = -1;
+	dst->tdfixedatts = -1;
 
 	/* since we're not copying constraints or defaults, clear these */
 	dstAtt->attnotnull = false;
@@ -364,6 +366,8 @@ equalTupleDescs(TupleDesc tupdesc1, TupleDesc tupdesc2)
 			return false;
 		if (attr1->attstorage != attr2->attstorage)
 			return false;
+		if (attr1->attcompression != attr2->attcompression)
+			return false;
 		if (attr1->attalign != attr2->attalign)
 			return false;
 		if (attr1->attnotnull != attr2->attnotnull)
@@ -523,6 +527,7 @@ TupleDescInitEntry(TupleDesc desc,
 
 	att->attstattarget = -1;
 	att->attcacheoff = -1;
+	desc->tdfixedatts = -1;
 	att->atttypmod = typmod;
 
 	att->attnum = attributeNumber;
@@ -546,6 +551,7 @@ TupleDescInitEntry(TupleDesc desc,
 	att->attbyval = typeForm->typbyval;
 	att->attalign = typeForm->typalign;
 	att->attstorage = typeForm->typstorage;
+	att->attcompression = '\0';
 	att->attcollation = typeForm->typcollation;
 
 	ReleaseSysCache(tuple);
@@ -581,6 +587,7 @@ TupleDescInitBuiltinEntry(TupleDesc desc,
 
 	att->attstattarget = -1;
 	att->attcacheoff = -1;
+	desc->tdfixedatts = -1;
 	att->atttypmod = typmod;
 
 	att->attnum = attributeNumber;
@@ -595,6 +602,7 @@ TupleDescInitBuiltinEntry(TupleDesc desc,
 	/* attacl, attoptions and attfdwoptions are not present in tupledescs */
 
 	att->atttypid = oidtypeid;
+	att->attcompression = '\0';
 
 	/*
 	 * Our goal here is to support just enough types to let basic builtin
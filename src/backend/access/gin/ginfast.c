@@ -36,6 +36,13 @@
 /* GUC parameter */
 int			gin_pending_list_limit = 0;
 
+/*
+ * When cleanup of the pending list has been handed to autovacuum, inserters
+ * leave the list alone until it grows to this multiple of its limit; past
+ * that point they assume autovacuum is not keeping up and help out.
+ */
+#define GIN_PENDING_LIST_BACKGROUND_FACTOR	2
+
 #define GIN_PAGE_FREESIZE \
 	( BLCKSZ - MAXALIGN(SizeOfPageHeaderData) - MAXALIGN(sizeof(GinPageOpaqueData)) )
 
@@ -47,6 +54,8 @@ typedef struct KeyArray
 	int32		maxvalues;		/* allocated size of arrays */
 } KeyArray;
 
+static bool ginRequestBackgroundCleanup(Relation index, Relation heapRel);
+
 
 /*
  * Build a pending-list page from the given array of tuples, and write it out.
@@ -219,7 +228,8 @@ makeSublist(Relation index, IndexTuple *tuples, int32 ntuples,
  * preserving order
  */
 void
-ginHeapTupleFastInsert(GinState *ginstate, GinTupleCollector *collector)
+ginHeapTupleFastInsert(GinState *ginstate, Relation heapRel,
+					   GinTupleCollector *collector)
 {
 	Relation	index = ginstate->index;
 	Buffer		metabuffer;
@@ -230,6 +240,7 @@ ginHeapTupleFastInsert(GinState *ginstate, GinTupleCollector *collector)
 	ginxlogUpdateMeta data;
 	bool		separateList = false;
 	bool		needCleanup = false;
+	bool		pendingTooLong = false;
 	int			cleanupSize;
 	bool		needWal;
 
@@ -435,13 +446,57 @@ ginHeapTupleFastInsert(GinState *ginstate, GinTupleCollector *collector)
 	cleanupSize = GinGetPendingListCleanupSize(index);
 	if (metadata->nPendingPages * GIN_PAGE_FREESIZE > cleanupSize * 1024L)
 		needCleanup = true;
+	if (metadata->nPendingPages * GIN_PAGE_FREESIZE >
+		GIN_PENDING_LIST_BACKGROUND_FACTOR * cleanupSize * 1024L)
+		pendingTooLong = true;
 
 	UnlockReleaseBuffer(metabuffer);
 
 	END_CRIT_SECTION();
 
 	if (needCleanup)
-		ginInsertCleanup(ginstate, false, true, NULL);
+	{
+		/*
+		 * Rather than making this insert pay for merging the pending list
+		 * into the main index, ask autovacuum to do it.  We only do the work
+		 * ourselves if that's not possible, or if the list has grown so long
+		 * that autovacuum is evidently not keeping up; and even then we just
+		 * do one bounded cleanup cycle, without waiting for anyone else who
+		 * is already cleaning up.
+		 */
+		if (!pendingTooLong && ginRequestBackgroundCleanup(index, heapRel))
+			return;
+
+		ginInsertCleanup(ginstate, false, true, false, NULL);
+	}
+}
+
+/*
+ * Ask autovacuum to clean up the pending list of the index.
+ *
+ * Returns false if autovacuum can't take the job, in which case the caller
+ * should clean up the list itself.
+ */
+static bool
+ginRequestBackgroundCleanup(Relation index, Relation heapRel)
+{
+	StdRdOptions *heapOptions = (StdRdOptions *) heapRel->rd_options;
+
+	/* Autovacuum doesn't process temp tables */
+	if (!AutoVacuumingActive() || RelationUsesLocalBuffers(index))
+		return false;
+
+	/* Respect a table-level autovacuum_enabled = off */
+	if (heapOptions != NULL && !heapOptions->autovacuum.enabled)
+		return false;
+
+	/* Autovacuum itself should just do the work */
+	if (IsAutoVacuumWorkerProcess())
+		return false;
+
+	return AutoVacuumRequestWork(AVW_GINCleanPendingList,
+								 RelationGetRelid(index),
+								 InvalidBlockNumber);
 }
 
 /*
@@ -723,11 +778,19 @@ processPendingPage(BuildAccumulator *accum, KeyArray *ka,
  * to FSM otherwise caller is responsible to put deleted pages into
  * FSM.
  *
+ * forceCleanup is true for callers that must get the list cleaned up, such
+ * as vacuum; they wait for any concurrent cleanup to finish first, and use
+ * maintenance_work_mem.  Otherwise (a regular insert), we give up at once if
+ * someone else is cleaning up the list, use work_mem, and stop after
+ * moving a single work_mem-sized batch, so that the insert that happened to
+ * trigger the cleanup isn't stalled for long.
+ *
  * If stats isn't null, we count deleted pending pages into the counts.
  */
 void
 ginInsertCleanup(GinState *ginstate, bool full_clean,
-				 bool fill_fsm, IndexBulkDeleteResult *stats)
+				 bool fill_fsm, bool forceCleanup,
+				 IndexBulkDeleteResult *stats)
 {
 	Relation	index = ginstate->index;
 	Buffer		metabuffer,
@@ -744,7 +807,6 @@ ginInsertCleanup(GinState *ginstate, bool full_clean,
 	bool		cleanupFinish = false;
 	bool		fsm_vac = false;
 	Size		workMemory;
-	bool		inVacuum = (stats == NULL);
 
 	/*
 	 * We would like to prevent concurrent cleanup process. For that we will
@@ -753,7 +815,7 @@ ginInsertCleanup(GinState *ginstate, bool full_clean,
 	 * insertion into pending list
 	 */
 
-	if (inVacuum)
+	if (forceCleanup)
 	{
 		/*
 		 * We are called from [auto]vacuum/analyze or gin_clean_pending_list()
@@ -930,9 +992,11 @@ ginInsertCleanup(GinState *ginstate, bool full_clean,
 
 			/*
 			 * if we removed the whole pending list or we cleanup tail (which
-			 * we remembered on start our cleanup process) then just exit
+			 * we remembered on start our cleanup process) then just exit.
+			 * A regular insert also exits after its first batch, leaving the
+			 * rest of the list to the next cleanup.
 			 */
-			if (blkno == InvalidBlockNumber || cleanupFinish)
+			if (blkno == InvalidBlockNumber || cleanupFinish || !forceCleanup)
 				break;
 
 			/*
@@ -1016,7 +1080,7 @@ gin_clean_pending_list(PG_FUNCTION_ARGS)
 
 	memset(&stats, 0, sizeof(stats));
 	initGinState(&ginstate, indexRel);
-	ginInsertCleanup(&ginstate, true, true, &stats);
+	ginInsertCleanup(&ginstate, true, true, true, &stats);
 
 	index_close(indexRel, AccessShareLock);
 
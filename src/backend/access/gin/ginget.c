@@ -578,6 +578,48 @@ startScan(IndexScanDesc scan)
 		startScanKey(ginstate, so, so->keys + i);
 }
 
+/*
+ * Find the first item in the sorted array items[start .. nitems - 1] that is
+ * greater than advancePast, and return its index, or nitems if there is none.
+ *
+ * When several entries are intersected, one entry can move far ahead of
+ * another, so that the lagging entry needs to skip a lot of items.  Rather
+ * than stepping through them one at a time, we gallop: probe exponentially
+ * growing distances from 'start' until we overshoot, then binary search
+ * within the last interval.  That costs O(log d) comparisons to skip d
+ * items, yet only a single comparison when the next item already qualifies.
+ */
+static int
+ginGallopItemPointers(ItemPointerData *items, int start, int nitems,
+					  ItemPointerData advancePast)
+{
+	int			lo = start;
+	int			hi = start;
+	int			step = 1;
+
+	while (hi < nitems && ginCompareItemPointers(&items[hi], &advancePast) <= 0)
+	{
+		lo = hi + 1;
+		hi += step;
+		step <<= 1;
+	}
+	if (hi > nitems)
+		hi = nitems;
+
+	/* items before lo are <= advancePast, and items[hi] is > advancePast */
+	while (lo < hi)
+	{
+		int			mid = lo + (hi - lo) / 2;
+
+		if (ginCompareItemPointers(&items[mid], &advancePast) <= 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
 /*
  * Load the next batch of item pointers from a posting tree.
  *
@@ -703,22 +745,20 @@ entryLoadMoreItems(GinState *ginstate, GinScanEntry entry,
 
 		entry->list = GinDataLeafPageGetItems(page, &entry->nlist, advancePast);
 
-		for (i = 0; i < entry->nlist; i++)
+		i = ginGallopItemPointers(entry->list, 0, entry->nlist, advancePast);
+		if (i < entry->nlist)
 		{
-			if (ginCompareItemPointers(&advancePast, &entry->list[i]) < 0)
-			{
-				entry->offset = i;
+			entry->offset = i;
 
-				if (GinPageRightMost(page))
-				{
-					/* after processing the copied items, we're done. */
-					UnlockReleaseBuffer(entry->buffer);
-					entry->buffer = InvalidBuffer;
-				}
-				else
-					LockBuffer(entry->buffer, GIN_UNLOCK);
-				return;
+			if (GinPageRightMost(page))
+			{
+				/* after processing the copied items, we're done. */
+				UnlockReleaseBuffer(entry->buffer);
+				entry->buffer = InvalidBuffer;
 			}
+			else
+				LockBuffer(entry->buffer, GIN_UNLOCK);
+			return;
 		}
 	}
 }
@@ -843,17 +883,15 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 		 * A posting list from an entry tuple, or the last page of a posting
 		 * tree.
 		 */
-		do
+		entry->offset = ginGallopItemPointers(entry->list, entry->offset,
+											  entry->nlist, advancePast);
+		if (entry->offset >= entry->nlist)
 		{
-			if (entry->offset >= entry->nlist)
-			{
-				ItemPointerSetInvalid(&entry->curItem);
-				entry->isFinished = TRUE;
-				break;
-			}
-
+			ItemPointerSetInvalid(&entry->curItem);
+			entry->isFinished = TRUE;
+		}
+		else
 			entry->curItem = entry->list[entry->offset++];
-		} while (ginCompareItemPointers(&entry->curItem, &advancePast) <= 0);
 		/* XXX: shouldn't we apply the fuzzy search limit here? */
 	}
 	else
@@ -861,6 +899,20 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 		/* A posting tree */
 		do
 		{
+			int			offset;
+
+			/*
+			 * Skip over items <= advancePast in the current batch.  Remember
+			 * the last skipped item as the current one, so that
+			 * entryLoadMoreItems can tell whether to step right or to
+			 * re-descend the tree.
+			 */
+			offset = ginGallopItemPointers(entry->list, entry->offset,
+										   entry->nlist, advancePast);
+			if (offset > entry->offset)
+				entry->curItem = entry->list[offset - 1];
+			entry->offset = offset;
+
 			/* If we've processed the current batch, load more items */
 			while (entry->offset >= entry->nlist)
 			{
@@ -875,8 +927,7 @@ entryGetItem(GinState *ginstate, GinScanEntry entry,
 
 			entry->curItem = entry->list[entry->offset++];
 
-		} while (ginCompareItemPointers(&entry->curItem, &advancePast) <= 0 ||
-				 (entry->reduceResult == TRUE && dropItem(entry)));
+		} while (entry->reduceResult == TRUE && dropItem(entry));
 	}
 }
 
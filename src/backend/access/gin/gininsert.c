@@ -16,16 +16,87 @@
 
 #include "access/gin_private.h"
 #include "access/ginxlog.h"
+#include "access/parallel.h"
+#include "access/relscan.h"
+#include "access/xact.h"
 #include "access/xloginsert.h"
 #include "catalog/index.h"
+#include "lib/binaryheap.h"
 #include "miscadmin.h"
 #include "storage/bufmgr.h"
+#include "storage/shm_mq.h"
 #include "storage/smgr.h"
 #include "storage/indexfsm.h"
+#include "storage/spin.h"
+#include "utils/datum.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "utils/snapmgr.h"
+#include "utils/tuplesort.h"
 
 
+/* Magic numbers for parallel state sharing */
+#define PARALLEL_KEY_GIN_SHARED			UINT64CONST(0xA000000000000001)
+#define PARALLEL_KEY_GIN_QUEUES			UINT64CONST(0xA000000000000002)
+
+/* Size of the queue each worker uses to send its sorted output */
+#define GIN_PARALLEL_QUEUE_SIZE			65536
+
+/*
+ * Status for a parallel GIN index build, in shared memory.
+ *
+ * Each participant (the workers and the leader) scans part of the heap
+ * through a shared parallel heap scan, and accumulates and sorts the keys
+ * it extracted privately.  Workers then stream their sorted output to the
+ * leader through a per-worker shm_mq, and the leader merges all the streams
+ * and inserts each key into the index once.
+ */
+typedef struct GinShared
+{
+	/*
+	 * These fields are not modified during the build.  They primarily exist
+	 * for the benefit of worker processes that need to create state
+	 * corresponding to that used by the leader.
+	 */
+	Oid			heaprelid;
+	Oid			indexrelid;
+	bool		isconcurrent;
+	int			nparticipants;	/* planned participants, including leader */
+
+	/*
+	 * mutex protects all fields below.
+	 *
+	 * These fields contain status information of interest to the leader once
+	 * all participants have finished scanning the heap.
+	 */
+	slock_t		mutex;
+
+	int			nparticipantsdone;
+	double		reltuples;
+	double		indtuples;
+	bool		brokenhotchain;
+
+	/*
+	 * This variable-sized field must come last.
+	 *
+	 * See ginBeginParallel().
+	 */
+	ParallelHeapScanDescData heapdesc;
+} GinShared;
+
+/*
+ * Status for the leader of a parallel GIN index build, in leader's private
+ * memory.
+ */
+typedef struct GinLeader
+{
+	ParallelContext *pcxt;		/* parallel context itself */
+	int			nworkers;		/* number of workers actually launched */
+	GinShared  *ginshared;		/* shared state in the DSM segment */
+	shm_mq_handle **queues;		/* queue from each launched worker */
+	Snapshot	snapshot;		/* snapshot used by the heap scan */
+} GinLeader;
+
 typedef struct
 {
 	GinState	ginstate;
@@ -34,8 +105,41 @@ typedef struct
 	MemoryContext tmpCtx;
 	MemoryContext funcCtx;
 	BuildAccumulator accum;
+
+	/* these are used only by parallel builds */
+	Tuplesortstate *bs_sortstate;	/* accumulated runs, sorted */
+	Size		bs_maxmem;		/* flush accum once it uses this much */
 } GinBuildState;
 
+/*
+ * Buffer of TIDs collected for a single key while merging sorted
+ * GinBuildTuples during a parallel build.
+ */
+typedef struct GinBuffer
+{
+	OffsetNumber attnum;
+	GinNullCategory category;
+	Datum		key;			/* palloc'd copy of key, if by-reference */
+	int16		typlen;
+	bool		typbyval;
+	bool		sorted;			/* are items[] known to be sorted? */
+	uint32		nitems;
+	uint32		maxitems;
+	Size		maxbytes;		/* flush once items[] reaches this size */
+	ItemPointerData *items;
+} GinBuffer;
+
+static GinLeader *ginBeginParallel(Relation heap, Relation index,
+				 bool isconcurrent, int request);
+static void ginEndParallel(GinLeader *ginleader);
+static double ginParallelBuild(GinLeader *ginleader,
+				 GinBuildState *buildstate, Relation heap,
+				 Relation index, IndexInfo *indexInfo);
+static void ginParallelScanAndSort(GinBuildState *buildstate,
+					   GinShared *ginshared, Relation heap,
+					   Relation index, IndexInfo *indexInfo,
+					   int sortmem);
+
 
 /*
  * Adds array of item pointers to tuple's posting list, or
@@ -321,6 +425,7 @@ ginbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	uint32		nlist;
 	MemoryContext oldCtx;
 	OffsetNumber attnum;
+	GinLeader  *ginleader = NULL;
 
 	if (RelationGetNumberOfBlocks(index) != 0)
 		elog(ERROR, "index \"%s\" already contains data",
@@ -329,6 +434,8 @@ ginbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	initGinState(&buildstate.ginstate, index);
 	buildstate.indtuples = 0;
 	memset(&buildstate.buildStats, 0, sizeof(GinStatsData));
+	buildstate.bs_sortstate = NULL;
+	buildstate.bs_maxmem = 0;
 
 	/* initialize the meta page */
 	MetaBuffer = GinNewBuffer(index);
@@ -387,24 +494,41 @@ ginbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	ginInitBA(&buildstate.accum);
 
 	/*
-	 * Do the heap scan.  We disallow sync scan here because dataPlaceToPage
-	 * prefers to receive tuples in TID order.
+	 * If the planner asked for parallel workers, try to launch them.  If
+	 * none could be started, just fall back to a serial build.
 	 */
-	reltuples = IndexBuildHeapScan(heap, index, indexInfo, false,
-								   ginBuildCallback, (void *) &buildstate);
+	if (indexInfo->ii_ParallelWorkers > 0)
+		ginleader = ginBeginParallel(heap, index, indexInfo->ii_Concurrent,
+									 indexInfo->ii_ParallelWorkers);
 
-	/* dump remaining entries to the index */
-	oldCtx = MemoryContextSwitchTo(buildstate.tmpCtx);
-	ginBeginBAScan(&buildstate.accum);
-	while ((list = ginGetBAEntry(&buildstate.accum,
-								 &attnum, &key, &category, &nlist)) != NULL)
+	if (ginleader != NULL)
 	{
-		/* there could be many entries, so be willing to abort here */
-		CHECK_FOR_INTERRUPTS();
-		ginEntryInsert(&buildstate.ginstate, attnum, key, category,
-					   list, nlist, &buildstate.buildStats);
+		reltuples = ginParallelBuild(ginleader, &buildstate,
+									 heap, index, indexInfo);
+		ginEndParallel(ginleader);
+	}
+	else
+	{
+		/*
+		 * Do the heap scan.  We disallow sync scan here because
+		 * dataPlaceToPage prefers to receive tuples in TID order.
+		 */
+		reltuples = IndexBuildHeapScan(heap, index, indexInfo, false,
+									   ginBuildCallback, (void *) &buildstate);
+
+		/* dump remaining entries to the index */
+		oldCtx = MemoryContextSwitchTo(buildstate.tmpCtx);
+		ginBeginBAScan(&buildstate.accum);
+		while ((list = ginGetBAEntry(&buildstate.accum,
+									 &attnum, &key, &category, &nlist)) != NULL)
+		{
+			/* there could be many entries, so be willing to abort here */
+			CHECK_FOR_INTERRUPTS();
+			ginEntryInsert(&buildstate.ginstate, attnum, key, category,
+						   list, nlist, &buildstate.buildStats);
+		}
+		MemoryContextSwitchTo(oldCtx);
 	}
-	MemoryContextSwitchTo(oldCtx);
 
 	MemoryContextDelete(buildstate.funcCtx);
 	MemoryContextDelete(buildstate.tmpCtx);
@@ -426,6 +550,753 @@ ginbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	return result;
 }
 
+/*
+ * Routines for building and decoding GinBuildTuples
+ */
+
+/* Offset of the key value within a GinBuildTuple */
+#define GinBuildTupleKeyOffset	MAXALIGN(offsetof(GinBuildTuple, data))
+
+static inline ItemPointer
+ginBuildTupleGetItems(GinBuildTuple *tup)
+{
+	return (ItemPointer) ((char *) tup +
+						  SHORTALIGN(GinBuildTupleKeyOffset + tup->keylen));
+}
+
+static inline Datum
+ginBuildTupleGetKey(GinBuildTuple *tup)
+{
+	char	   *ptr = (char *) tup + GinBuildTupleKeyOffset;
+	Datum		key;
+
+	if (tup->category != GIN_CAT_NORM_KEY)
+		return (Datum) 0;
+
+	if (tup->typbyval)
+	{
+		memcpy(&key, ptr, sizeof(Datum));
+		return key;
+	}
+
+	return PointerGetDatum(ptr);
+}
+
+/*
+ * Form a palloc'd GinBuildTuple from a key and its (sorted) TIDs.
+ */
+static GinBuildTuple *
+ginFormBuildTuple(GinState *ginstate, OffsetNumber attnum,
+				  GinNullCategory category, Datum key,
+				  ItemPointerData *items, uint32 nitems)
+{
+	Form_pg_attribute attr = TupleDescAttr(ginstate->origTupdesc, attnum - 1);
+	GinBuildTuple *tup;
+	Size		keylen;
+	Size		tuplen;
+	char	   *ptr;
+
+	if (category != GIN_CAT_NORM_KEY)
+		keylen = 0;
+	else if (attr->attbyval)
+		keylen = sizeof(Datum);
+	else
+		keylen = datumGetSize(key, false, attr->attlen);
+
+	tuplen = SHORTALIGN(GinBuildTupleKeyOffset + keylen) +
+		nitems * sizeof(ItemPointerData);
+
+	tup = (GinBuildTuple *) palloc0(tuplen);
+	tup->tuplen = tuplen;
+	tup->attrnum = attnum;
+	tup->typlen = attr->attlen;
+	tup->typbyval = attr->attbyval;
+	tup->category = category;
+	tup->keylen = keylen;
+	tup->nitems = nitems;
+
+	ptr = (char *) tup + GinBuildTupleKeyOffset;
+	if (keylen > 0)
+	{
+		if (attr->attbyval)
+			memcpy(ptr, &key, sizeof(Datum));
+		else
+			memcpy(ptr, DatumGetPointer(key), keylen);
+	}
+
+	memcpy(ginBuildTupleGetItems(tup), items,
+		   nitems * sizeof(ItemPointerData));
+
+	return tup;
+}
+
+/*
+ * Compare two GinBuildTuples: first by attribute number and key, as the
+ * index orders them, then by the first TID in each.
+ */
+int
+ginCompareBuildTuples(GinState *ginstate, GinBuildTuple *a, GinBuildTuple *b)
+{
+	int			res;
+
+	res = ginCompareAttEntries(ginstate,
+							   a->attrnum, ginBuildTupleGetKey(a),
+							   a->category,
+							   b->attrnum, ginBuildTupleGetKey(b),
+							   b->category);
+	if (res != 0)
+		return res;
+
+	return ginCompareItemPointers(ginBuildTupleGetItems(a),
+								  ginBuildTupleGetItems(b));
+}
+
+static int
+qsortCompareItemPointers(const void *a, const void *b)
+{
+	int			res = ginCompareItemPointers((ItemPointer) a, (ItemPointer) b);
+
+	/* each heap tuple is scanned by exactly one participant */
+	Assert(res != 0);
+	return res;
+}
+
+/*
+ * Routines for the per-key GinBuffer
+ */
+
+static void
+ginBufferInit(GinBuffer *buffer, Size maxbytes)
+{
+	memset(buffer, 0, sizeof(GinBuffer));
+	buffer->maxbytes = Max(maxbytes, 1024 * sizeof(ItemPointerData));
+	buffer->maxitems = 1024;
+	buffer->items = (ItemPointerData *)
+		palloc(buffer->maxitems * sizeof(ItemPointerData));
+}
+
+static inline bool
+ginBufferIsEmpty(GinBuffer *buffer)
+{
+	return buffer->nitems == 0;
+}
+
+static inline bool
+ginBufferIsFull(GinBuffer *buffer)
+{
+	return buffer->nitems * sizeof(ItemPointerData) >= buffer->maxbytes;
+}
+
+/*
+ * Does the tuple's key match the key of the (non-empty) buffer?
+ */
+static bool
+ginBufferKeyEquals(GinState *ginstate, GinBuffer *buffer, GinBuildTuple *tup)
+{
+	Assert(!ginBufferIsEmpty(buffer));
+
+	if (tup->attrnum != buffer->attnum || tup->category != buffer->category)
+		return false;
+
+	/* all null/empty placeholders of one attribute are equal */
+	if (tup->category != GIN_CAT_NORM_KEY)
+		return true;
+
+	return ginCompareEntries(ginstate, tup->attrnum,
+							 buffer->key, buffer->category,
+							 ginBuildTupleGetKey(tup), tup->category) == 0;
+}
+
+/*
+ * Add the TIDs of a tuple to the buffer.  If the buffer is empty, the
+ * tuple's key becomes the buffer's key; otherwise the keys must match.
+ */
+static void
+ginBufferStoreTuple(GinBuffer *buffer, GinBuildTuple *tup)
+{
+	ItemPointer items = ginBuildTupleGetItems(tup);
+
+	if (ginBufferIsEmpty(buffer))
+	{
+		buffer->attnum = tup->attrnum;
+		buffer->category = tup->category;
+		buffer->typlen = tup->typlen;
+		buffer->typbyval = tup->typbyval;
+		if (tup->category == GIN_CAT_NORM_KEY)
+			buffer->key = datumCopy(ginBuildTupleGetKey(tup),
+									tup->typbyval, tup->typlen);
+		else
+			buffer->key = (Datum) 0;
+		buffer->sorted = true;
+	}
+	else if (buffer->sorted &&
+			 ginCompareItemPointers(&buffer->items[buffer->nitems - 1],
+									&items[0]) >= 0)
+	{
+		/* TID ranges from different participants overlap */
+		buffer->sorted = false;
+	}
+
+	if (buffer->nitems + tup->nitems > buffer->maxitems)
+	{
+		while (buffer->nitems + tup->nitems > buffer->maxitems)
+			buffer->maxitems *= 2;
+		buffer->items = (ItemPointerData *)
+			repalloc_huge(buffer->items,
+						  buffer->maxitems * sizeof(ItemPointerData));
+	}
+
+	memcpy(&buffer->items[buffer->nitems], items,
+		   tup->nitems * sizeof(ItemPointerData));
+	buffer->nitems += tup->nitems;
+}
+
+/*
+ * Make sure the buffered TIDs are in order, as ginEntryInsert expects.
+ */
+static void
+ginBufferSortItems(GinBuffer *buffer)
+{
+	if (!buffer->sorted)
+	{
+		qsort(buffer->items, buffer->nitems, sizeof(ItemPointerData),
+			  qsortCompareItemPointers);
+		buffer->sorted = true;
+	}
+}
+
+static void
+ginBufferReset(GinBuffer *buffer)
+{
+	if (buffer->category == GIN_CAT_NORM_KEY && !buffer->typbyval)
+		pfree(DatumGetPointer(buffer->key));
+	buffer->key = (Datum) 0;
+	buffer->nitems = 0;
+}
+
+/*
+ * Dump the BuildAccumulator's contents into the participant's tuplesort,
+ * and reset it.
+ */
+static void
+ginFlushToSort(GinBuildState *buildstate)
+{
+	ItemPointerData *list;
+	Datum		key;
+	GinNullCategory category;
+	uint32		nlist;
+	OffsetNumber attnum;
+	MemoryContext oldCtx;
+
+	oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
+
+	ginBeginBAScan(&buildstate->accum);
+	while ((list = ginGetBAEntry(&buildstate->accum,
+								 &attnum, &key, &category, &nlist)) != NULL)
+	{
+		GinBuildTuple *tup;
+
+		/* there could be many entries, so be willing to abort here */
+		CHECK_FOR_INTERRUPTS();
+
+		tup = ginFormBuildTuple(&buildstate->ginstate, attnum, category, key,
+								list, nlist);
+		tuplesort_putgintuple(buildstate->bs_sortstate, tup);
+		pfree(tup);
+	}
+
+	MemoryContextSwitchTo(oldCtx);
+
+	MemoryContextReset(buildstate->tmpCtx);
+	ginInitBA(&buildstate->accum);
+}
+
+/*
+ * Callback for a parallel build: like ginBuildCallback, but the accumulated
+ * entries are flushed into the participant's tuplesort rather than into the
+ * index.
+ */
+static void
+ginBuildCallbackParallel(Relation index, HeapTuple htup, Datum *values,
+						 bool *isnull, bool tupleIsAlive, void *state)
+{
+	GinBuildState *buildstate = (GinBuildState *) state;
+	MemoryContext oldCtx;
+	int			i;
+
+	oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
+
+	for (i = 0; i < buildstate->ginstate.origTupdesc->natts; i++)
+		ginHeapTupleBulkInsert(buildstate, (OffsetNumber) (i + 1),
+							   values[i], isnull[i],
+							   &htup->t_self);
+
+	MemoryContextSwitchTo(oldCtx);
+
+	/* If we've used up our share of memory, spill everything to the sort */
+	if (buildstate->accum.allocatedMemory >= buildstate->bs_maxmem)
+		ginFlushToSort(buildstate);
+}
+
+/*
+ * Scan this participant's portion of the heap, and sort what we extracted.
+ *
+ * The participant's share of maintenance_work_mem is split evenly between
+ * the BuildAccumulator and the tuplesort.  The per-participant totals are
+ * reported back through the shared state.
+ */
+static void
+ginParallelScanAndSort(GinBuildState *buildstate, GinShared *ginshared,
+					   Relation heap, Relation index, IndexInfo *indexInfo,
+					   int sortmem)
+{
+	HeapScanDesc scan;
+	double		reltuples;
+
+	buildstate->bs_sortstate =
+		tuplesort_begin_index_gin(&buildstate->ginstate,
+								  Max(sortmem / 2, 64), false);
+	buildstate->bs_maxmem = (Size) Max(sortmem / 2, 64) * 1024L;
+
+	/* Join the parallel heap scan; IndexBuildHeapRangeScan ends it */
+	scan = heap_beginscan_parallel(heap, &ginshared->heapdesc);
+	reltuples = IndexBuildHeapRangeScan(heap, index, indexInfo, true, false,
+										0, InvalidBlockNumber,
+										ginBuildCallbackParallel,
+										(void *) buildstate, scan);
+
+	/* dump remaining entries to the sort, and sort everything */
+	ginFlushToSort(buildstate);
+	tuplesort_performsort(buildstate->bs_sortstate);
+
+	SpinLockAcquire(&ginshared->mutex);
+	ginshared->nparticipantsdone++;
+	ginshared->reltuples += reltuples;
+	ginshared->indtuples += buildstate->indtuples;
+	if (indexInfo->ii_BrokenHotChain)
+		ginshared->brokenhotchain = true;
+	SpinLockRelease(&ginshared->mutex);
+}
+
+/*
+ * Send the worker's sorted output to the leader, combining consecutive
+ * tuples with equal keys on the way so the leader has less to merge.
+ */
+static void
+ginParallelSendSorted(GinBuildState *buildstate, shm_mq_handle *mqh)
+{
+	GinState   *ginstate = &buildstate->ginstate;
+	GinBuffer	buffer;
+	GinBuildTuple *tup;
+	bool		detached = false;
+
+	ginBufferInit(&buffer, Min(buildstate->bs_maxmem, MaxAllocSize / 2));
+
+	for (;;)
+	{
+		tup = tuplesort_getgintuple(buildstate->bs_sortstate, true);
+
+		if (!ginBufferIsEmpty(&buffer) &&
+			(tup == NULL || !ginBufferKeyEquals(ginstate, &buffer, tup) ||
+			 ginBufferIsFull(&buffer)))
+		{
+			GinBuildTuple *out;
+			shm_mq_result result;
+
+			CHECK_FOR_INTERRUPTS();
+
+			ginBufferSortItems(&buffer);
+			out = ginFormBuildTuple(ginstate, buffer.attnum, buffer.category,
+									buffer.key, buffer.items, buffer.nitems);
+			result = shm_mq_send(mqh, out->tuplen, out, false);
+			pfree(out);
+			ginBufferReset(&buffer);
+
+			/* If the leader went away, there's no point in continuing */
+			if (result == SHM_MQ_DETACHED)
+			{
+				detached = true;
+				break;
+			}
+			else if (result != SHM_MQ_SUCCESS)
+				ereport(ERROR,
+						(errcode(ERRCODE_INTERNAL_ERROR),
+						 errmsg("could not send tuple to shared-memory queue")));
+		}
+
+		if (tup == NULL)
+			break;
+
+		ginBufferStoreTuple(&buffer, tup);
+	}
+
+	if (detached)
+		elog(DEBUG1, "GIN build leader detached before receiving all tuples");
+
+	pfree(buffer.items);
+}
+
+/*
+ * Fetch the next tuple from one merge input (a worker's queue, or the
+ * leader's own tuplesort), as a palloc'd copy.  Returns NULL at the end of
+ * that input.
+ */
+static GinBuildTuple *
+ginMergeFetch(GinLeader *ginleader, GinBuildState *buildstate, int source)
+{
+	GinBuildTuple *tup;
+	Size		len;
+	void	   *data;
+
+	if (source < ginleader->nworkers)
+	{
+		shm_mq_result result;
+
+		result = shm_mq_receive(ginleader->queues[source], &len, &data, false);
+		if (result == SHM_MQ_DETACHED)
+			return NULL;
+		Assert(result == SHM_MQ_SUCCESS);
+	}
+	else
+	{
+		data = tuplesort_getgintuple(buildstate->bs_sortstate, true);
+		if (data == NULL)
+			return NULL;
+		len = ((GinBuildTuple *) data)->tuplen;
+	}
+
+	tup = (GinBuildTuple *) palloc(len);
+	memcpy(tup, data, len);
+
+	return tup;
+}
+
+typedef struct GinMergeState
+{
+	GinState   *ginstate;
+	GinBuildTuple **current;	/* current tuple of each input */
+} GinMergeState;
+
+/*
+ * binaryheap comparator for the merge inputs.  binaryheap is a max-heap, so
+ * invert the order.
+ */
+static int
+ginMergeCompare(Datum a, Datum b, void *arg)
+{
+	GinMergeState *ms = (GinMergeState *) arg;
+
+	return -ginCompareBuildTuples(ms->ginstate,
+								  ms->current[DatumGetInt32(a)],
+								  ms->current[DatumGetInt32(b)]);
+}
+
+/*
+ * Insert the buffered TIDs of one key into the index.
+ */
+static void
+ginFlushBufferToIndex(GinBuildState *buildstate, GinBuffer *buffer)
+{
+	MemoryContext oldCtx;
+
+	CHECK_FOR_INTERRUPTS();
+
+	ginBufferSortItems(buffer);
+
+	oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
+	ginEntryInsert(&buildstate->ginstate, buffer->attnum, buffer->key,
+				   buffer->category, buffer->items, buffer->nitems,
+				   &buildstate->buildStats);
+	MemoryContextSwitchTo(oldCtx);
+	MemoryContextReset(buildstate->tmpCtx);
+
+	ginBufferReset(buffer);
+}
+
+/*
+ * Perform the leader's part of a parallel build: scan our share of the heap
+ * like any other participant, then merge the sorted output of all
+ * participants and insert it into the index.  Returns the number of heap
+ * tuples scanned by all participants.
+ */
+static double
+ginParallelBuild(GinLeader *ginleader, GinBuildState *buildstate,
+				 Relation heap, Relation index, IndexInfo *indexInfo)
+{
+	GinShared  *ginshared = ginleader->ginshared;
+	int			sortmem = maintenance_work_mem / ginshared->nparticipants;
+	int			nsources = ginleader->nworkers + 1;
+	GinMergeState ms;
+	binaryheap *heapq;
+	GinBuffer	buffer;
+	double		reltuples;
+	int			i;
+
+	ginParallelScanAndSort(buildstate, ginshared, heap, index, indexInfo,
+						   sortmem);
+
+	/* Set up the merge of all workers' queues and our own sort */
+	ms.ginstate = &buildstate->ginstate;
+	ms.current = (GinBuildTuple **) palloc0(nsources * sizeof(GinBuildTuple *));
+	heapq = binaryheap_allocate(nsources, ginMergeCompare, &ms);
+
+	for (i = 0; i < nsources; i++)
+	{
+		ms.current[i] = ginMergeFetch(ginleader, buildstate, i);
+		if (ms.current[i] != NULL)
+			binaryheap_add_unordered(heapq, Int32GetDatum(i));
+	}
+	binaryheap_build(heapq);
+
+	ginBufferInit(&buffer, (Size) Max(sortmem / 2, 64) * 1024L);
+
+	while (!binaryheap_empty(heapq))
+	{
+		GinBuildTuple *tup;
+
+		i = DatumGetInt32(binaryheap_first(heapq));
+		tup = ms.current[i];
+
+		if (!ginBufferIsEmpty(&buffer) &&
+			(!ginBufferKeyEquals(&buildstate->ginstate, &buffer, tup) ||
+			 ginBufferIsFull(&buffer)))
+			ginFlushBufferToIndex(buildstate, &buffer);
+
+		ginBufferStoreTuple(&buffer, tup);
+
+		pfree(tup);
+		ms.current[i] = ginMergeFetch(ginleader, buildstate, i);
+		if (ms.current[i] != NULL)
+			binaryheap_replace_first(heapq, Int32GetDatum(i));
+		else
+			(void) binaryheap_remove_first(heapq);
+	}
+
+	if (!ginBufferIsEmpty(&buffer))
+		ginFlushBufferToIndex(buildstate, &buffer);
+
+	binaryheap_free(heapq);
+	pfree(ms.current);
+	pfree(buffer.items);
+	tuplesort_end(buildstate->bs_sortstate);
+	buildstate->bs_sortstate = NULL;
+
+	/*
+	 * Wait for the workers to finish, so that the totals they reported are
+	 * complete.  This also reports any error raised by a worker, which
+	 * might otherwise look like a normal end of its queue.
+	 */
+	WaitForParallelWorkersToFinish(ginleader->pcxt);
+
+	Assert(ginshared->nparticipantsdone <= ginleader->nworkers + 1);
+	reltuples = ginshared->reltuples;
+	buildstate->indtuples = ginshared->indtuples;
+	if (ginshared->brokenhotchain)
+		indexInfo->ii_BrokenHotChain = true;
+
+	return reltuples;
+}
+
+/*
+ * Create the parallel context and launch workers for a parallel build.
+ *
+ * Returns NULL if no worker could be launched, in which case the caller
+ * should do a serial build instead.
+ */
+static GinLeader *
+ginBeginParallel(Relation heap, Relation index, bool isconcurrent,
+				 int request)
+{
+	ParallelContext *pcxt;
+	Snapshot	snapshot;
+	Size		estginshared;
+	GinShared  *ginshared;
+	char	   *queuespace;
+	GinLeader  *ginleader;
+	int			i;
+
+	Assert(request > 0);
+
+	EnterParallelMode();
+	pcxt = CreateParallelContext("postgres", "ginParallelBuildMain", request);
+
+	/*
+	 * Prepare for the heap scan the same way IndexBuildHeapRangeScan would:
+	 * SnapshotAny for a normal build, an MVCC snapshot for a concurrent one.
+	 */
+	if (!isconcurrent)
+		snapshot = SnapshotAny;
+	else
+		snapshot = RegisterSnapshot(GetTransactionSnapshot());
+
+	/* Estimate size of the shared state, and of the workers' queues */
+	estginshared = add_size(offsetof(GinShared, heapdesc),
+							heap_parallelscan_estimate(snapshot));
+	shm_toc_estimate_chunk(&pcxt->estimator, estginshared);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(GIN_PARALLEL_QUEUE_SIZE, request));
+	shm_toc_estimate_keys(&pcxt->estimator, 2);
+
+	InitializeParallelDSM(pcxt);
+
+	/* Store shared build state */
+	ginshared = (GinShared *) shm_toc_allocate(pcxt->toc, estginshared);
+	ginshared->heaprelid = RelationGetRelid(heap);
+	ginshared->indexrelid = RelationGetRelid(index);
+	ginshared->isconcurrent = isconcurrent;
+	ginshared->nparticipants = request + 1;
+	SpinLockInit(&ginshared->mutex);
+	ginshared->nparticipantsdone = 0;
+	ginshared->reltuples = 0.0;
+	ginshared->indtuples = 0.0;
+	ginshared->brokenhotchain = false;
+	heap_parallelscan_initialize(&ginshared->heapdesc, heap, snapshot);
+
+	/* Create a queue for each worker, with ourselves as the receiver */
+	queuespace = shm_toc_allocate(pcxt->toc,
+								  mul_size(GIN_PARALLEL_QUEUE_SIZE, request));
+	for (i = 0; i < request; i++)
+	{
+		shm_mq	   *mq;
+
+		mq = shm_mq_create(queuespace + ((Size) i) * GIN_PARALLEL_QUEUE_SIZE,
+						   (Size) GIN_PARALLEL_QUEUE_SIZE);
+		shm_mq_set_receiver(mq, MyProc);
+	}
+
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_GIN_SHARED, ginshared);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_GIN_QUEUES, queuespace);
+
+	LaunchParallelWorkers(pcxt);
+
+	/* If no workers were successfully launched, back out (do serial build) */
+	if (pcxt->nworkers_launched == 0)
+	{
+		DestroyParallelContext(pcxt);
+		if (IsMVCCSnapshot(snapshot))
+			UnregisterSnapshot(snapshot);
+		ExitParallelMode();
+		return NULL;
+	}
+
+	ginleader = (GinLeader *) palloc0(sizeof(GinLeader));
+	ginleader->pcxt = pcxt;
+	ginleader->nworkers = pcxt->nworkers_launched;
+	ginleader->ginshared = ginshared;
+	ginleader->snapshot = snapshot;
+
+	/*
+	 * Attach to the launched workers' queues.  Passing the worker handle
+	 * lets shm_mq notice a worker that fails to start.
+	 */
+	ginleader->queues = (shm_mq_handle **)
+		palloc(ginleader->nworkers * sizeof(shm_mq_handle *));
+	for (i = 0; i < ginleader->nworkers; i++)
+	{
+		shm_mq	   *mq;
+
+		mq = (shm_mq *) (queuespace + ((Size) i) * GIN_PARALLEL_QUEUE_SIZE);
+		ginleader->queues[i] = shm_mq_attach(mq, pcxt->seg,
+											 pcxt->worker[i].bgwhandle);
+	}
+
+	return ginleader;
+}
+
+/*
+ * Shut down workers, destroy parallel context, and end parallel mode.
+ */
+static void
+ginEndParallel(GinLeader *ginleader)
+{
+	int			i;
+
+	for (i = 0; i < ginleader->nworkers; i++)
+		shm_mq_detach(ginleader->queues[i]);
+
+	/* Shutdown worker processes */
+	WaitForParallelWorkersToFinish(ginleader->pcxt);
+	/* Free last reference to MVCC snapshot, if one was used */
+	if (IsMVCCSnapshot(ginleader->snapshot))
+		UnregisterSnapshot(ginleader->snapshot);
+	DestroyParallelContext(ginleader->pcxt);
+	ExitParallelMode();
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+ginParallelBuildMain(dsm_segment *seg, shm_toc *toc)
+{
+	GinShared  *ginshared;
+	GinBuildState buildstate;
+	Relation	heapRel;
+	Relation	indexRel;
+	LOCKMODE	heapLockmode;
+	LOCKMODE	indexLockmode;
+	IndexInfo  *indexInfo;
+	char	   *queuespace;
+	shm_mq	   *mq;
+	shm_mq_handle *mqh;
+
+	/* Look up gin shared state */
+	ginshared = shm_toc_lookup(toc, PARALLEL_KEY_GIN_SHARED, false);
+
+	/* Open relations using lock modes known to be obtained by index.c */
+	if (!ginshared->isconcurrent)
+	{
+		heapLockmode = ShareLock;
+		indexLockmode = AccessExclusiveLock;
+	}
+	else
+	{
+		heapLockmode = ShareUpdateExclusiveLock;
+		indexLockmode = RowExclusiveLock;
+	}
+
+	heapRel = heap_open(ginshared->heaprelid, heapLockmode);
+	indexRel = index_open(ginshared->indexrelid, indexLockmode);
+
+	/* Attach to our queue to the leader */
+	queuespace = shm_toc_lookup(toc, PARALLEL_KEY_GIN_QUEUES, false);
+	mq = (shm_mq *) (queuespace +
+					 ((Size) ParallelWorkerNumber) * GIN_PARALLEL_QUEUE_SIZE);
+	shm_mq_set_sender(mq, MyProc);
+	mqh = shm_mq_attach(mq, seg, NULL);
+
+	indexInfo = BuildIndexInfo(indexRel);
+	indexInfo->ii_Concurrent = ginshared->isconcurrent;
+
+	/* Set up the same private build state the leader uses */
+	initGinState(&buildstate.ginstate, indexRel);
+	buildstate.indtuples = 0;
+	memset(&buildstate.buildStats, 0, sizeof(GinStatsData));
+	buildstate.tmpCtx = AllocSetContextCreate(CurrentMemoryContext,
+											  "Gin build temporary context",
+											  ALLOCSET_DEFAULT_SIZES);
+	buildstate.funcCtx = AllocSetContextCreate(CurrentMemoryContext,
+											   "Gin build temporary context for user-defined function",
+											   ALLOCSET_DEFAULT_SIZES);
+	buildstate.accum.ginstate = &buildstate.ginstate;
+	ginInitBA(&buildstate.accum);
+
+	ginParallelScanAndSort(&buildstate, ginshared, heapRel, indexRel,
+						   indexInfo,
+						   maintenance_work_mem / ginshared->nparticipants);
+
+	ginParallelSendSorted(&buildstate, mqh);
+
+	tuplesort_end(buildstate.bs_sortstate);
+	shm_mq_detach(mqh);
+
+	MemoryContextDelete(buildstate.funcCtx);
+	MemoryContextDelete(buildstate.tmpCtx);
+
+	index_close(indexRel, indexLockmode);
+	heap_close(heapRel, heapLockmode);
+}
+
 /*
  *	ginbuildempty() -- build an empty gin index in the initialization fork
  */
@@ -519,7 +1390,7 @@ gininsert(Relation index, Datum *values, bool *isnull,
 									values[i], isnull[i],
 									ht_ctid);
 
-		ginHeapTupleFastInsert(ginstate, &collector);
+		ginHeapTupleFastInsert(ginstate, heapRel, &collector);
 	}
 	else
 	{
@@ -62,8 +62,17 @@
  * that holds for removing items from a posting list, you must also be
  * careful to not cause expansion e.g. when merging uncompressed items on the
  * page into the compressed lists, when vacuuming.
+ *
+ * In dense posting lists, most deltas are small enough to fit in a single
+ * byte. The decoder takes advantage of that by checking eight bytes at a
+ * time for continuation bits; if there are none, all eight bytes are
+ * complete deltas and can be decoded in a tight loop without any branches
+ * on the byte contents.
  */
 
+/* Continuation bits of eight consecutive varbyte-encoded bytes */
+#define VARBYTE_CONTINUATION_MASK	UINT64CONST(0x8080808080808080)
+
 /*
  * How many bits do you need to encode offset number? OffsetNumber is a 16-bit
  * integer, but you can't fit that many items on a page. 11 ought to be more
@@ -298,10 +307,14 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 	ndecoded = 0;
 	while ((char *) segment < endseg)
 	{
-		/* enlarge output array if needed */
-		if (ndecoded >= nallocated)
+		/*
+		 * Enlarge output array if needed.  Every item takes at least one
+		 * byte, so a segment can't hold more than nbytes + 1 items; making
+		 * room for that many up front saves checking for each item.
+		 */
+		if (ndecoded + segment->nbytes + 1 > nallocated)
 		{
-			nallocated *= 2;
+			nallocated = Max(nallocated * 2, ndecoded + segment->nbytes + 1);
 			result = repalloc(result, nallocated * sizeof(ItemPointerData));
 		}
 
@@ -316,11 +329,25 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 		endptr = segment->bytes + segment->nbytes;
 		while (ptr < endptr)
 		{
-			/* enlarge output array if needed */
-			if (ndecoded >= nallocated)
+			/* Fast path for a run of eight single-byte deltas */
+			if (endptr - ptr >= sizeof(uint64))
 			{
-				nallocated *= 2;
-				result = repalloc(result, nallocated * sizeof(ItemPointerData));
+				uint64		chunk;
+
+				memcpy(&chunk, ptr, sizeof(uint64));
+				if ((chunk & VARBYTE_CONTINUATION_MASK) == 0)
+				{
+					int			i;
+
+					for (i = 0; i < sizeof(uint64); i++)
+					{
+						val += ptr[i];
+						uint64_to_itemptr(val, &result[ndecoded + i]);
+					}
+					ndecoded += sizeof(uint64);
+					ptr += sizeof(uint64);
+					continue;
+				}
 			}
 
 			val += decode_varbyte(&ptr);
@@ -51,6 +51,7 @@ ginhandler(PG_FUNCTION_ARGS)
 	amroutine->amclusterable = false;
 	amroutine->ampredlocks = false;
 	amroutine->amcanparallel = false;
+	amroutine->amcanbuildparallel = true;
 	amroutine->amkeytype = InvalidOid;
 
 	amroutine->ambuild = ginbuild;
@@ -67,6 +68,7 @@ ginhandler(PG_FUNCTION_ARGS)
 	amroutine->amrescan = ginrescan;
 	amroutine->amgettuple = NULL;
 	amroutine->amgetbitmap = gingetbitmap;
+	amroutine->amskip = NULL;
 	amroutine->amendscan = ginendscan;
 	amroutine->ammarkpos = NULL;
 	amroutine->amrestrpos = NULL;
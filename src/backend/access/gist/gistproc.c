@@ -24,6 +24,7 @@
 #include "access/stratnum.h"
 #include "utils/builtins.h"
 #include "utils/geo_decls.h"
+#include "utils/sortsupport.h"
 
 
 static bool gist_box_leaf_consistent(BOX *key, BOX *query,
@@ -1571,3 +1572,152 @@ gist_poly_distance(PG_FUNCTION_ARGS)
 
 	PG_RETURN_FLOAT8(distance);
 }
+
+/*
+ * Z-order routines for fast index build
+ *
+ * A sorted GiST build orders the leaf tuples along a space-filling curve
+ * before packing them into pages, so that points that are close to each
+ * other end up on the same leaf page.  We use the Z-order (Morton) curve,
+ * which is simple to compute: the bits of the X and Y coordinates are
+ * interleaved into a single 64-bit integer.  To make that work with
+ * floating point coordinates, each coordinate is first mapped to a 32-bit
+ * unsigned integer that sorts the same way as the float.
+ *
+ * The point opclass stores points as degenerate boxes, so the comparators
+ * work on the compressed BOX datums, using the lower-left corner.
+ */
+
+/*
+ * Convert a float to an unsigned 32-bit integer with the same sort order.
+ *
+ * With IEEE 754 floats, the bit patterns of non-negative values already sort
+ * correctly as unsigned integers, once the sign bit is set so that they sort
+ * above the negative values.  For negative values, flipping all the bits
+ * reverses their order, and moves them below the non-negative values.
+ * NaNs sort last, as they do in float comparisons.
+ */
+static uint32
+ieee_float32_to_uint32(float f)
+{
+	union
+	{
+		float		f;
+		uint32		i;
+	}			u;
+
+	if (isnan(f))
+		return 0xFFFFFFFF;
+
+	u.f = f;
+	if ((u.i & 0x80000000) != 0)
+		u.i ^= 0xFFFFFFFF;
+	else
+		u.i |= 0x80000000;
+
+	return u.i;
+}
+
+/* Spread the bits of a 32-bit integer into the even bits of a 64-bit one */
+static uint64
+part_bits32_by2(uint32 x)
+{
+	uint64		n = x;
+
+	n = (n | (n << 16)) & UINT64CONST(0x0000FFFF0000FFFF);
+	n = (n | (n << 8)) & UINT64CONST(0x00FF00FF00FF00FF);
+	n = (n | (n << 4)) & UINT64CONST(0x0F0F0F0F0F0F0F0F);
+	n = (n | (n << 2)) & UINT64CONST(0x3333333333333333);
+	n = (n | (n << 1)) & UINT64CONST(0x5555555555555555);
+
+	return n;
+}
+
+/*
+ * Compute the Z-order value of a point.  The coordinates are reduced to
+ * single precision first; that only affects the quality of the ordering,
+ * not correctness.
+ */
+static uint64
+point_zorder_internal(float8 x, float8 y)
+{
+	uint32		ix = ieee_float32_to_uint32((float) x);
+	uint32		iy = ieee_float32_to_uint32((float) y);
+
+	return part_bits32_by2(ix) | (part_bits32_by2(iy) << 1);
+}
+
+static int
+gist_bbox_zorder_cmp(Datum a, Datum b, SortSupport ssup)
+{
+	Point	   *p1 = &(DatumGetBoxP(a)->low);
+	Point	   *p2 = &(DatumGetBoxP(b)->low);
+	uint64		z1;
+	uint64		z2;
+
+	/*
+	 * Do a quick check for equality first.  It's not clear if this is worth
+	 * it in general, but certainly is when used as tie-breaker with
+	 * abbreviated keys.
+	 */
+	if (p1->x == p2->x && p1->y == p2->y)
+		return 0;
+
+	z1 = point_zorder_internal(p1->x, p1->y);
+	z2 = point_zorder_internal(p2->x, p2->y);
+	if (z1 > z2)
+		return 1;
+	else if (z1 < z2)
+		return -1;
+	else
+		return 0;
+}
+
+#if SIZEOF_DATUM >= 8
+
+/*
+ * With 64-bit Datums, the whole Z-order value fits in the abbreviated key,
+ * so the full comparator is only needed for ties.
+ */
+static Datum
+gist_bbox_zorder_abbrev_convert(Datum original, SortSupport ssup)
+{
+	Point	   *p = &(DatumGetBoxP(original)->low);
+
+	return (Datum) point_zorder_internal(p->x, p->y);
+}
+
+/*
+ * The abbreviated key is as discriminating as the full comparison (apart
+ * from the loss of precision), so there's never a reason to abort.
+ */
+static bool
+gist_bbox_zorder_abbrev_abort(int memtupcount, SortSupport ssup)
+{
+	return false;
+}
+
+#endif							/* SIZEOF_DATUM >= 8 */
+
+/*
+ * Sort support routine for fast GiST index build by sorting.
+ */
+Datum
+gist_point_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+#if SIZEOF_DATUM >= 8
+	if (ssup->abbreviate)
+	{
+		ssup->comparator = ssup_datum_unsigned_cmp;
+		ssup->abbrev_converter = gist_bbox_zorder_abbrev_convert;
+		ssup->abbrev_abort = gist_bbox_zorder_abbrev_abort;
+		ssup->abbrev_full_comparator = gist_bbox_zorder_cmp;
+	}
+	else
+#endif
+		ssup->comparator = gist_bbox_zorder_cmp;
+
+	PG_RETURN_VOID();
+}
@@ -36,24 +36,69 @@
 #include "access/xact.h"
 #include "catalog/catalog.h"
 #include "common/pg_lzcompress.h"
+#include "lib/ilist.h"
 #include "miscadmin.h"
+#include "storage/proc.h"
 #include "utils/expandeddatum.h"
 #include "utils/fmgroids.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/snapmgr.h"
 #include "utils/typcache.h"
 #include "utils/tqual.h"
 
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+
 
 #undef TOAST_DEBUG
 
+/* GUC variables */
+int			default_toast_compression = TOAST_PGLZ_COMPRESSION;
+int			toast_cache_size = 4096;	/* kB */
+
+/*
+ * Cache of detoasted out-of-line values, keyed by toast relation and value
+ * OID, so that a query that detoasts the same value repeatedly (say, the
+ * inner side of a join, or several expressions over one column) only
+ * fetches and decompresses it once.  Entries are kept in LRU order, and
+ * the total size of the cached values is limited to toast_cache_size kB.
+ *
+ * A stored toast value never changes, but once it has been deleted and
+ * vacuumed away its OID can be reused for a different value.  That can't
+ * happen while we hold a snapshot that could still see the old value,
+ * that is, while our advertised xmin stays put; so the cache is emptied
+ * whenever our xmin is reset or advanced (see SnapshotResetXmin), which
+ * in practice means once per query.
+ */
+typedef struct ToastCacheKey
+{
+	Oid			toastrelid;
+	Oid			valueid;
+} ToastCacheKey;
+
+typedef struct ToastCacheEntry
+{
+	ToastCacheKey key;			/* hash key; must be first */
+	struct varlena *value;		/* detoasted value, in ToastCacheContext */
+	dlist_node	lru_node;		/* position in ToastCacheLRU */
+} ToastCacheEntry;
+
+static MemoryContext ToastCacheContext = NULL;
+static HTAB *ToastCacheHash = NULL;
+static dlist_head ToastCacheLRU = DLIST_STATIC_INIT(ToastCacheLRU);
+static Size ToastCacheBytes = 0;
+
 /*
  *	The information at the start of the compressed toast data.
  */
 typedef struct toast_compress_header
 {
 	int32		vl_len_;		/* varlena header (do not touch directly!) */
-	int32		rawsize;
+	uint32		tcinfo;			/* 2 bits for compression method and 30 bits
+								 * for raw size */
 } toast_compress_header;
 
 /*
@@ -61,11 +106,25 @@ typedef struct toast_compress_header
  * toast entries.
  */
 #define TOAST_COMPRESS_HDRSZ		((int32) sizeof(toast_compress_header))
-#define TOAST_COMPRESS_RAWSIZE(ptr) (((toast_compress_header *) (ptr))->rawsize)
+#define TOAST_COMPRESS_RAWSIZE(ptr) \
+	(((toast_compress_header *) (ptr))->tcinfo & VARLENA_EXTSIZE_MASK)
+#define TOAST_COMPRESS_METHOD(ptr) \
+	(((toast_compress_header *) (ptr))->tcinfo >> VARLENA_EXTSIZE_BITS)
 #define TOAST_COMPRESS_RAWDATA(ptr) \
 	(((char *) (ptr)) + TOAST_COMPRESS_HDRSZ)
-#define TOAST_COMPRESS_SET_RAWSIZE(ptr, len) \
-	(((toast_compress_header *) (ptr))->rawsize = (len))
+#define TOAST_COMPRESS_SET_SIZE_AND_METHOD(ptr, len, cm_method) \
+	do { \
+		Assert((len) > 0 && (len) <= VARLENA_EXTSIZE_MASK); \
+		((toast_compress_header *) (ptr))->tcinfo = \
+			(len) | ((uint32) (cm_method) << VARLENA_EXTSIZE_BITS); \
+	} while (0)
+
+#define NO_LZ4_SUPPORT() \
+	ereport(ERROR, \
+			(errcode(ERRCODE_FEATURE_NOT_SUPPORTED), \
+			 errmsg("unsupported LZ4 compression method"), \
+			 errdetail("This functionality requires the server to be built with lz4 support."), \
+			 errhint("You need to rebuild PostgreSQL using --with-lz4.")))
 
 static void toast_delete_datum(Relation rel, Datum value, bool is_speculative);
 static Datum toast_save_datum(Relation rel, Datum value,
@@ -76,6 +135,13 @@ static struct varlena *toast_fetch_datum(struct varlena *attr);
 static struct varlena *toast_fetch_datum_slice(struct varlena *attr,
 						int32 sliceoffset, int32 length);
 static struct varlena *toast_decompress_datum(struct varlena *attr);
+static struct varlena *toast_decompress_datum_slice(struct varlena *attr,
+							 int32 slicelength);
+static struct varlena *toast_cache_lookup(struct varatt_external *toast_pointer,
+				   int32 sliceoffset, int32 slicelength);
+static void toast_cache_insert(struct varatt_external *toast_pointer,
+				   struct varlena *value);
+static void toast_cache_forget(Oid toastrelid, Oid valueid);
 static int toast_open_indexes(Relation toastrel,
 				   LOCKMODE lock,
 				   Relation **toastidxs,
@@ -173,17 +239,30 @@ heap_tuple_untoast_attr(struct varlena *attr)
 {
 	if (VARATT_IS_EXTERNAL_ONDISK(attr))
 	{
+		struct varatt_external toast_pointer;
+		struct varlena *cached;
+
+		VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+
 		/*
-		 * This is an externally stored datum --- fetch it back from there
+		 * This is an externally stored datum --- fetch it back from there,
+		 * unless we have detoasted it already
 		 */
-		attr = toast_fetch_datum(attr);
-		/* If it's compressed, decompress it */
-		if (VARATT_IS_COMPRESSED(attr))
+		cached = toast_cache_lookup(&toast_pointer, 0, -1);
+		if (cached != NULL)
+			attr = cached;
+		else
 		{
-			struct varlena *tmp = attr;
+			attr = toast_fetch_datum(attr);
+			/* If it's compressed, decompress it */
+			if (VARATT_IS_COMPRESSED(attr))
+			{
+				struct varlena *tmp = attr;
 
-			attr = toast_decompress_datum(tmp);
-			pfree(tmp);
+				attr = toast_decompress_datum(tmp);
+				pfree(tmp);
+			}
+			toast_cache_insert(&toast_pointer, attr);
 		}
 	}
 	else if (VARATT_IS_EXTERNAL_INDIRECT(attr))
@@ -262,6 +341,16 @@ heap_tuple_untoast_attr_slice(struct varlena *attr,
 	struct varlena *result;
 	char	   *attrdata;
 	int32		attrsize;
+	int32		prefixlen;
+
+	/*
+	 * Compressed data can be decompressed only from the start, so work out
+	 * how long a prefix the slice needs; -1 means the whole value.
+	 */
+	if (slicelength < 0 || (int64) sliceoffset + slicelength > PG_INT32_MAX)
+		prefixlen = -1;
+	else
+		prefixlen = sliceoffset + slicelength;
 
 	if (VARATT_IS_EXTERNAL_ONDISK(attr))
 	{
@@ -269,12 +358,36 @@ heap_tuple_untoast_attr_slice(struct varlena *attr,
 
 		VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
 
+		/* if we've detoasted the whole value already, use that */
+		result = toast_cache_lookup(&toast_pointer, sliceoffset, slicelength);
+		if (result != NULL)
+			return result;
+
 		/* fast path for non-compressed external datums */
 		if (!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
 			return toast_fetch_datum_slice(attr, sliceoffset, slicelength);
 
-		/* fetch it back (compressed marker will get set automatically) */
-		preslice = toast_fetch_datum(attr);
+		/*
+		 * For pglz, we need only as many compressed chunks as can possibly
+		 * be needed to produce the requested slice; fetch just those.  Other
+		 * methods give no such bound, so fetch the whole value.  (Compressed
+		 * marker will get set automatically either way.)
+		 */
+		if (prefixlen >= 0 &&
+			VARATT_EXTERNAL_GET_COMPRESS_METHOD(toast_pointer) ==
+			TOAST_PGLZ_COMPRESSION_ID)
+		{
+			int32		max_size;
+
+			/* the stored data starts with the compression header */
+			max_size = pglz_maximum_compressed_size(prefixlen,
+													VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer) -
+													TOAST_COMPRESS_HDRSZ) +
+				TOAST_COMPRESS_HDRSZ;
+			preslice = toast_fetch_datum_slice(attr, 0, max_size);
+		}
+		else
+			preslice = toast_fetch_datum(attr);
 	}
 	else if (VARATT_IS_EXTERNAL_INDIRECT(attr))
 	{
@@ -302,7 +415,11 @@ heap_tuple_untoast_attr_slice(struct varlena *attr,
 	{
 		struct varlena *tmp = preslice;
 
-		preslice = toast_decompress_datum(tmp);
+		/* Decompress only as much as the slice requires */
+		if (prefixlen >= 0)
+			preslice = toast_decompress_datum_slice(tmp, prefixlen);
+		else
+			preslice = toast_decompress_datum(tmp);
 
 		if (tmp != attr)
 			pfree(tmp);
@@ -421,7 +538,7 @@ toast_datum_size(Datum value)
 		struct varatt_external toast_pointer;
 
 		VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
-		result = toast_pointer.va_extsize;
+		result = VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer);
 	}
 	else if (VARATT_IS_EXTERNAL_INDIRECT(attr))
 	{
@@ -773,7 +890,8 @@ toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtup,
 		if (TupleDescAttr(tupleDesc, i)->attstorage == 'x')
 		{
 			old_value = toast_values[i];
-			new_value = toast_compress_datum(old_value);
+			new_value = toast_compress_datum(old_value,
+											 TupleDescAttr(tupleDesc, i)->attcompression);
 
 			if (DatumGetPointer(new_value) != NULL)
 			{
@@ -914,7 +1032,8 @@ toast_insert_or_update(Relation rel, HeapTuple newtup, HeapTuple oldtup,
 		 */
 		i = biggest_attno;
 		old_value = toast_values[i];
-		new_value = toast_compress_datum(old_value);
+		new_value = toast_compress_datum(old_value,
+										 TupleDescAttr(tupleDesc, i)->attcompression);
 
 		if (DatumGetPointer(new_value) != NULL)
 		{
@@ -1357,7 +1476,9 @@ toast_build_flattened_tuple(TupleDesc tupleDesc,
 /* ----------
  * toast_compress_datum -
  *
- *	Create a compressed version of a varlena datum
+ *	Create a compressed version of a varlena datum, using the given
+ *	compression method, or default_toast_compression if that is
+ *	InvalidCompressionMethod.
  *
  *	If we fail (ie, compressed result is actually bigger than original)
  *	then return NULL.  We must not use compressed data if it'd expand
@@ -1368,28 +1489,63 @@ toast_build_flattened_tuple(TupleDesc tupleDesc,
  * ----------
  */
 Datum
-toast_compress_datum(Datum value)
+toast_compress_datum(Datum value, char cmethod)
 {
 	struct varlena *tmp;
-	int32		valsize = VARSIZE_ANY_EXHDR(DatumGetPointer(value));
+	struct varlena *val = (struct varlena *) DatumGetPointer(value);
+	int32		valsize = VARSIZE_ANY_EXHDR(val);
 	int32		len;
+	ToastCompressionId cmid;
+
+	Assert(!VARATT_IS_EXTERNAL(val));
+	Assert(!VARATT_IS_COMPRESSED(val));
 
-	Assert(!VARATT_IS_EXTERNAL(DatumGetPointer(value)));
-	Assert(!VARATT_IS_COMPRESSED(DatumGetPointer(value)));
+	if (!CompressionMethodIsValid(cmethod))
+		cmethod = default_toast_compression;
 
 	/*
-	 * No point in wasting a palloc cycle if value size is out of the allowed
-	 * range for compression
+	 * Compress into a buffer large enough for the worst case of the method
+	 * in use.  For pglz, there's no point in wasting a palloc cycle if value
+	 * size is out of the allowed range for compression.
 	 */
-	if (valsize < PGLZ_strategy_default->min_input_size ||
-		valsize > PGLZ_strategy_default->max_input_size)
-		return PointerGetDatum(NULL);
-
-	tmp = (struct varlena *) palloc(PGLZ_MAX_OUTPUT(valsize) +
-									TOAST_COMPRESS_HDRSZ);
+	switch (cmethod)
+	{
+		case TOAST_PGLZ_COMPRESSION:
+			if (valsize < PGLZ_strategy_default->min_input_size ||
+				valsize > PGLZ_strategy_default->max_input_size)
+				return PointerGetDatum(NULL);
+			tmp = (struct varlena *) palloc(PGLZ_MAX_OUTPUT(valsize) +
+											TOAST_COMPRESS_HDRSZ);
+			len = pglz_compress(VARDATA_ANY(val), valsize,
+								TOAST_COMPRESS_RAWDATA(tmp),
+								PGLZ_strategy_default);
+			cmid = TOAST_PGLZ_COMPRESSION_ID;
+			break;
+		case TOAST_LZ4_COMPRESSION:
+#ifndef USE_LZ4
+			NO_LZ4_SUPPORT();
+			return PointerGetDatum(NULL);	/* keep compiler quiet */
+#else
+			{
+				int32		max_size = LZ4_compressBound(valsize);
+
+				tmp = (struct varlena *) palloc(max_size + TOAST_COMPRESS_HDRSZ);
+				len = LZ4_compress_default(VARDATA_ANY(val),
+										   TOAST_COMPRESS_RAWDATA(tmp),
+										   valsize, max_size);
+				if (len <= 0)
+					elog(ERROR, "lz4 compression failed");
+				cmid = TOAST_LZ4_COMPRESSION_ID;
+			}
+			break;
+#endif
+		default:
+			elog(ERROR, "invalid compression method %c", cmethod);
+			return PointerGetDatum(NULL);	/* keep compiler quiet */
+	}
 
 	/*
-	 * We recheck the actual size even if pglz_compress() reports success,
+	 * We recheck the actual size even if compression reports success,
 	 * because it might be satisfied with having saved as little as one byte
 	 * in the compressed data --- which could turn into a net loss once you
 	 * consider header and alignment padding.  Worst case, the compressed
@@ -1398,14 +1554,10 @@ toast_compress_datum(Datum value)
 	 * only one header byte and no padding if the value is short enough.  So
 	 * we insist on a savings of more than 2 bytes to ensure we have a gain.
 	 */
-	len = pglz_compress(VARDATA_ANY(DatumGetPointer(value)),
-						valsize,
-						TOAST_COMPRESS_RAWDATA(tmp),
-						PGLZ_strategy_default);
 	if (len >= 0 &&
 		len + TOAST_COMPRESS_HDRSZ < valsize - 2)
 	{
-		TOAST_COMPRESS_SET_RAWSIZE(tmp, valsize);
+		TOAST_COMPRESS_SET_SIZE_AND_METHOD(tmp, valsize, cmid);
 		SET_VARSIZE_COMPRESSED(tmp, len + TOAST_COMPRESS_HDRSZ);
 		/* successful compression */
 		return PointerGetDatum(tmp);
@@ -1418,6 +1570,79 @@ toast_compress_datum(Datum value)
 	}
 }
 
+/* ----------
+ * toast_get_compression_id -
+ *
+ *	Returns the ID of the method a varlena was compressed with, looking at
+ *	the TOAST pointer rather than fetching the value if it is stored
+ *	externally.  Returns TOAST_INVALID_COMPRESSION_ID if it isn't compressed.
+ * ----------
+ */
+ToastCompressionId
+toast_get_compression_id(struct varlena *attr)
+{
+	ToastCompressionId cmid = TOAST_INVALID_COMPRESSION_ID;
+
+	if (VARATT_IS_EXTERNAL_ONDISK(attr))
+	{
+		struct varatt_external toast_pointer;
+
+		VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
+
+		if (VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer))
+			cmid = VARATT_EXTERNAL_GET_COMPRESS_METHOD(toast_pointer);
+	}
+	else if (VARATT_IS_COMPRESSED(attr))
+		cmid = VARCOMPRESSMETHOD_4B_C(attr);
+
+	return cmid;
+}
+
+/* ----------
+ * CompressionNameToMethod -
+ *
+ *	Returns the attcompression value for a compression method name, or
+ *	InvalidCompressionMethod if there's no such method.  Raises an error for
+ *	methods this build doesn't support.
+ * ----------
+ */
+char
+CompressionNameToMethod(const char *compression)
+{
+	if (strcmp(compression, "pglz") == 0)
+		return TOAST_PGLZ_COMPRESSION;
+	else if (strcmp(compression, "lz4") == 0)
+	{
+#ifndef USE_LZ4
+		NO_LZ4_SUPPORT();
+#endif
+		return TOAST_LZ4_COMPRESSION;
+	}
+
+	return InvalidCompressionMethod;
+}
+
+/* ----------
+ * GetCompressionMethodName -
+ *
+ *	Returns the name of a (valid) attcompression value
+ * ----------
+ */
+const char *
+GetCompressionMethodName(char method)
+{
+	switch (method)
+	{
+		case TOAST_PGLZ_COMPRESSION:
+			return "pglz";
+		case TOAST_LZ4_COMPRESSION:
+			return "lz4";
+		default:
+			elog(ERROR, "invalid compression method %c", method);
+			return NULL;		/* keep compiler quiet */
+	}
+}
+
 
 /* ----------
  * toast_get_valid_index
@@ -1510,19 +1735,20 @@ toast_save_datum(Relation rel, Datum value,
 									&num_indexes);
 
 	/*
-	 * Get the data pointer and length, and compute va_rawsize and va_extsize.
+	 * Get the data pointer and length, and compute va_rawsize and va_extinfo.
 	 *
 	 * va_rawsize is the size of the equivalent fully uncompressed datum, so
 	 * we have to adjust for short headers.
 	 *
-	 * va_extsize is the actual size of the data payload in the toast records.
+	 * va_extinfo stores the actual size of the data payload in the toast
+	 * records and the compression method, if the data is compressed.
 	 */
 	if (VARATT_IS_SHORT(dval))
 	{
 		data_p = VARDATA_SHORT(dval);
 		data_todo = VARSIZE_SHORT(dval) - VARHDRSZ_SHORT;
 		toast_pointer.va_rawsize = data_todo + VARHDRSZ;	/* as if not short */
-		toast_pointer.va_extsize = data_todo;
+		toast_pointer.va_extinfo = data_todo;
 	}
 	else if (VARATT_IS_COMPRESSED(dval))
 	{
@@ -1530,7 +1756,8 @@ toast_save_datum(Relation rel, Datum value,
 		data_todo = VARSIZE(dval) - VARHDRSZ;
 		/* rawsize in a compressed datum is just the size of the payload */
 		toast_pointer.va_rawsize = VARRAWSIZE_4B_C(dval) + VARHDRSZ;
-		toast_pointer.va_extsize = data_todo;
+		VARATT_EXTERNAL_SET_SIZE_AND_COMPRESS_METHOD(toast_pointer, data_todo,
+													 VARCOMPRESSMETHOD_4B_C(dval));
 		/* Assert that the numbers look like it's compressed */
 		Assert(VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer));
 	}
@@ -1539,7 +1766,7 @@ toast_save_datum(Relation rel, Datum value,
 		data_p = VARDATA(dval);
 		data_todo = VARSIZE(dval) - VARHDRSZ;
 		toast_pointer.va_rawsize = VARSIZE(dval);
-		toast_pointer.va_extsize = data_todo;
+		toast_pointer.va_extinfo = data_todo;
 	}
 
 	/*
@@ -1633,6 +1860,9 @@ toast_save_datum(Relation rel, Datum value,
 		}
 	}
 
+	/* Make sure no stale copy of a value by this OID lingers in the cache */
+	toast_cache_forget(toast_pointer.va_toastrelid, toast_pointer.va_valueid);
+
 	/*
 	 * Initialize constant parts of the tuple data
 	 */
@@ -1899,7 +2129,7 @@ toast_fetch_datum(struct varlena *attr)
 	/* Must copy to access aligned fields */
 	VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
 
-	ressize = toast_pointer.va_extsize;
+	ressize = VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer);
 	numchunks = ((ressize - 1) / TOAST_MAX_CHUNK_SIZE) + 1;
 
 	result = (struct varlena *) palloc(ressize + VARHDRSZ);
@@ -2079,12 +2309,13 @@ toast_fetch_datum_slice(struct varlena *attr, int32 sliceoffset, int32 length)
 	VARATT_EXTERNAL_GET_POINTER(toast_pointer, attr);
 
 	/*
-	 * It's nonsense to fetch slices of a compressed datum -- this isn't lo_*
-	 * we can't return a compressed datum which is meaningful to toast later
+	 * It's nonsense to fetch slices of a compressed datum unless the slice
+	 * starts at the beginning: the result is then a truncated compressed
+	 * datum, which toast_decompress_datum_slice can expand a prefix of.
 	 */
-	Assert(!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer));
+	Assert(!VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer) || sliceoffset == 0);
 
-	attrsize = toast_pointer.va_extsize;
+	attrsize = VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer);
 	totalchunks = ((attrsize - 1) / TOAST_MAX_CHUNK_SIZE) + 1;
 
 	if (sliceoffset >= attrsize)
@@ -2271,12 +2502,14 @@ toast_fetch_datum_slice(struct varlena *attr, int32 sliceoffset, int32 length)
 /* ----------
  * toast_decompress_datum -
  *
- * Decompress a compressed version of a varlena datum
+ * Decompress a compressed version of a varlena datum, with the method
+ * recorded in its header
  */
 static struct varlena *
 toast_decompress_datum(struct varlena *attr)
 {
 	struct varlena *result;
+	int32		rawsize;
 
 	Assert(VARATT_IS_COMPRESSED(attr));
 
@@ -2284,15 +2517,269 @@ toast_decompress_datum(struct varlena *attr)
 		palloc(TOAST_COMPRESS_RAWSIZE(attr) + VARHDRSZ);
 	SET_VARSIZE(result, TOAST_COMPRESS_RAWSIZE(attr) + VARHDRSZ);
 
-	if (pglz_decompress(TOAST_COMPRESS_RAWDATA(attr),
-						VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
-						VARDATA(result),
-						TOAST_COMPRESS_RAWSIZE(attr)) < 0)
+	switch (TOAST_COMPRESS_METHOD(attr))
+	{
+		case TOAST_PGLZ_COMPRESSION_ID:
+			rawsize = pglz_decompress(TOAST_COMPRESS_RAWDATA(attr),
+									  VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+									  VARDATA(result),
+									  TOAST_COMPRESS_RAWSIZE(attr), true);
+			break;
+		case TOAST_LZ4_COMPRESSION_ID:
+#ifndef USE_LZ4
+			NO_LZ4_SUPPORT();
+			rawsize = -1;		/* keep compiler quiet */
+#else
+			rawsize = LZ4_decompress_safe(TOAST_COMPRESS_RAWDATA(attr),
+										  VARDATA(result),
+										  VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+										  TOAST_COMPRESS_RAWSIZE(attr));
+#endif
+			break;
+		default:
+			elog(ERROR, "invalid compression method id %d",
+				 TOAST_COMPRESS_METHOD(attr));
+			rawsize = -1;		/* keep compiler quiet */
+	}
+
+	if (rawsize != (int32) TOAST_COMPRESS_RAWSIZE(attr))
+		elog(ERROR, "compressed data is corrupted");
+
+	return result;
+}
+
+
+/* ----------
+ * toast_decompress_datum_slice -
+ *
+ * Decompress only the first slicelength bytes of a compressed varlena
+ * datum.  Decompression stops as soon as that much output has been
+ * produced, so the input may be a truncated copy of the compressed data,
+ * as long as it's long enough to produce the requested prefix.
+ */
+static struct varlena *
+toast_decompress_datum_slice(struct varlena *attr, int32 slicelength)
+{
+	struct varlena *result;
+	int32		rawsize;
+
+	Assert(VARATT_IS_COMPRESSED(attr));
+
+	if (slicelength >= (int32) TOAST_COMPRESS_RAWSIZE(attr))
+		return toast_decompress_datum(attr);
+
+	result = (struct varlena *) palloc(slicelength + VARHDRSZ);
+
+	switch (TOAST_COMPRESS_METHOD(attr))
+	{
+		case TOAST_PGLZ_COMPRESSION_ID:
+			rawsize = pglz_decompress(TOAST_COMPRESS_RAWDATA(attr),
+									  VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+									  VARDATA(result),
+									  slicelength, false);
+			break;
+		case TOAST_LZ4_COMPRESSION_ID:
+#ifndef USE_LZ4
+			NO_LZ4_SUPPORT();
+			rawsize = -1;		/* keep compiler quiet */
+#else
+			rawsize = LZ4_decompress_safe_partial(TOAST_COMPRESS_RAWDATA(attr),
+												  VARDATA(result),
+												  VARSIZE(attr) - TOAST_COMPRESS_HDRSZ,
+												  slicelength,
+												  slicelength);
+#endif
+			break;
+		default:
+			elog(ERROR, "invalid compression method id %d",
+				 TOAST_COMPRESS_METHOD(attr));
+			rawsize = -1;		/* keep compiler quiet */
+	}
+
+	if (rawsize != slicelength)
 		elog(ERROR, "compressed data is corrupted");
 
+	SET_VARSIZE(result, rawsize + VARHDRSZ);
+
+	return result;
+}
+
+
+/* ----------
+ * toast_cache_lookup -
+ *
+ *	Return a palloc'd copy of a slice of the cached detoasted value for the
+ *	given toast pointer, or NULL if it's not in the cache.  A negative
+ *	slicelength means the rest of the value.
+ * ----------
+ */
+static struct varlena *
+toast_cache_lookup(struct varatt_external *toast_pointer,
+				   int32 sliceoffset, int32 slicelength)
+{
+	ToastCacheKey key;
+	ToastCacheEntry *entry;
+	struct varlena *result;
+	int32		attrsize;
+
+	if (ToastCacheHash == NULL)
+		return NULL;
+
+	key.toastrelid = toast_pointer->va_toastrelid;
+	key.valueid = toast_pointer->va_valueid;
+	entry = (ToastCacheEntry *) hash_search(ToastCacheHash, &key,
+											HASH_FIND, NULL);
+	if (entry == NULL)
+		return NULL;
+
+	/* Most recently used goes to the front */
+	dlist_move_head(&ToastCacheLRU, &entry->lru_node);
+
+	attrsize = VARSIZE(entry->value) - VARHDRSZ;
+	if (sliceoffset >= attrsize)
+	{
+		sliceoffset = 0;
+		slicelength = 0;
+	}
+	if (slicelength < 0 || (int64) sliceoffset + slicelength > attrsize)
+		slicelength = attrsize - sliceoffset;
+
+	result = (struct varlena *) palloc(slicelength + VARHDRSZ);
+	SET_VARSIZE(result, slicelength + VARHDRSZ);
+	memcpy(VARDATA(result), VARDATA(entry->value) + sliceoffset, slicelength);
+
 	return result;
 }
 
+/* ----------
+ * toast_cache_insert -
+ *
+ *	Remember a copy of a freshly detoasted value, evicting the least
+ *	recently used values if needed to stay within toast_cache_size
+ * ----------
+ */
+static void
+toast_cache_insert(struct varatt_external *toast_pointer,
+				   struct varlena *value)
+{
+	Size		budget = (Size) toast_cache_size * 1024;
+	Size		size = VARSIZE(value);
+	ToastCacheKey key;
+	ToastCacheEntry *entry;
+	struct varlena *copy;
+	bool		found;
+
+	/*
+	 * Don't bother with values that would take up the whole cache, and
+	 * don't cache anything unless our xmin protects it from being replaced
+	 * (see comments at the top of the file).
+	 */
+	if (size > budget || !TransactionIdIsValid(MyPgXact->xmin))
+		return;
+
+	if (ToastCacheHash == NULL)
+	{
+		HASHCTL		ctl;
+
+		if (ToastCacheContext == NULL)
+			ToastCacheContext = AllocSetContextCreate(TopMemoryContext,
+													  "TOAST value cache",
+													  ALLOCSET_DEFAULT_SIZES);
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(ToastCacheKey);
+		ctl.entrysize = sizeof(ToastCacheEntry);
+		ctl.hcxt = ToastCacheContext;
+		ToastCacheHash = hash_create("TOAST value cache", 64, &ctl,
+									 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	/* Make room */
+	while (ToastCacheBytes + size > budget)
+	{
+		ToastCacheEntry *victim;
+
+		Assert(!dlist_is_empty(&ToastCacheLRU));
+		victim = dlist_tail_element(ToastCacheEntry, lru_node, &ToastCacheLRU);
+		toast_cache_forget(victim->key.toastrelid, victim->key.valueid);
+	}
+
+	/*
+	 * Copy the value before making the hash entry, so that running out of
+	 * memory can't leave an entry without a value behind.  The cache is
+	 * just an optimization, so don't fail the query if the copy doesn't
+	 * fit.  If hash_search fails, the copy is wasted only until the cache is
+	 * next reset.
+	 */
+	copy = (struct varlena *) MemoryContextAllocExtended(ToastCacheContext,
+														 size,
+														 MCXT_ALLOC_NO_OOM);
+	if (copy == NULL)
+		return;
+	memcpy(copy, value, size);
+
+	key.toastrelid = toast_pointer->va_toastrelid;
+	key.valueid = toast_pointer->va_valueid;
+	entry = (ToastCacheEntry *) hash_search(ToastCacheHash, &key,
+											HASH_ENTER, &found);
+	if (found)
+	{
+		pfree(copy);
+		return;
+	}
+
+	entry->value = copy;
+	dlist_push_head(&ToastCacheLRU, &entry->lru_node);
+	ToastCacheBytes += size;
+}
+
+/* ----------
+ * toast_cache_forget -
+ *
+ *	Remove a value from the cache, if it's there
+ * ----------
+ */
+static void
+toast_cache_forget(Oid toastrelid, Oid valueid)
+{
+	ToastCacheKey key;
+	ToastCacheEntry *entry;
+
+	if (ToastCacheHash == NULL)
+		return;
+
+	key.toastrelid = toastrelid;
+	key.valueid = valueid;
+	entry = (ToastCacheEntry *) hash_search(ToastCacheHash, &key,
+											HASH_FIND, NULL);
+	if (entry == NULL)
+		return;
+
+	ToastCacheBytes -= VARSIZE(entry->value);
+	pfree(entry->value);
+	dlist_delete(&entry->lru_node);
+	hash_search(ToastCacheHash, &key, HASH_REMOVE, NULL);
+}
+
+/* ----------
+ * ResetToastCache -
+ *
+ *	Discard all cached detoasted values
+ * ----------
+ */
+void
+ResetToastCache(void)
+{
+	if (ToastCacheHash == NULL)
+		return;
+
+	/* This frees the hash table as well as the values */
+	MemoryContextReset(ToastCacheContext);
+	ToastCacheHash = NULL;
+	dlist_init(&ToastCacheLRU);
+	ToastCacheBytes = 0;
+}
+
 
 /* ----------
  * toast_open_indexes
@@ -140,6 +140,7 @@ bthandler(PG_FUNCTION_ARGS)
 	amroutine->amclusterable = true;
 	amroutine->ampredlocks = true;
 	amroutine->amcanparallel = true;
+	amroutine->amcanbuildparallel = false;
 	amroutine->amkeytype = InvalidOid;
 
 	amroutine->ambuild = btbuild;
@@ -156,6 +157,7 @@ bthandler(PG_FUNCTION_ARGS)
 	amroutine->amrescan = btrescan;
 	amroutine->amgettuple = btgettuple;
 	amroutine->amgetbitmap = btgetbitmap;
+	amroutine->amskip = btskip;
 	amroutine->amendscan = btendscan;
 	amroutine->ammarkpos = btmarkpos;
 	amroutine->amrestrpos = btrestrpos;
@@ -360,7 +362,20 @@ btgettuple(IndexScanDesc scan, ScanDirection dir)
 		_bt_start_array_keys(scan, dir);
 	}
 
-	/* This loop handles advancing to the next array elements, if any */
+	/*
+	 * Likewise, if this is a skip scan, find the first prefix to scan for
+	 * during the first call.
+	 */
+	if (so->skipPrefix > 0 && !so->skipStarted)
+	{
+		if (!_bt_skip_advance(scan, dir))
+			return false;
+	}
+
+	/*
+	 * This loop handles advancing to the next array elements or skip scan
+	 * prefix, if any
+	 */
 	do
 	{
 		/*
@@ -402,8 +417,10 @@ btgettuple(IndexScanDesc scan, ScanDirection dir)
 		/* If we have a tuple, return it ... */
 		if (res)
 			break;
-		/* ... otherwise see if we have more array keys to deal with */
-	} while (so->numArrayKeys && _bt_advance_array_keys(scan, dir));
+		/* ... otherwise see if we have more array keys or prefixes to scan */
+	} while ((so->numArrayKeys && _bt_advance_array_keys(scan, dir)) ||
+			 (so->skipPrefix > 0 && so->qual_ok &&
+			  _bt_skip_advance(scan, dir)));
 
 	return res;
 }
@@ -430,7 +447,17 @@ btgetbitmap(IndexScanDesc scan, TIDBitmap *tbm)
 		_bt_start_array_keys(scan, ForwardScanDirection);
 	}
 
-	/* This loop handles advancing to the next array elements, if any */
+	/* Likewise, find the first prefix to scan for in a skip scan */
+	if (so->skipPrefix > 0)
+	{
+		if (!_bt_skip_advance(scan, ForwardScanDirection))
+			return ntids;
+	}
+
+	/*
+	 * This loop handles advancing to the next array elements or skip scan
+	 * prefix, if any
+	 */
 	do
 	{
 		/* Fetch the first page & tuple */
@@ -460,12 +487,56 @@ btgetbitmap(IndexScanDesc scan, TIDBitmap *tbm)
 				ntids++;
 			}
 		}
-		/* Now see if we have more array keys to deal with */
-	} while (so->numArrayKeys && _bt_advance_array_keys(scan, ForwardScanDirection));
+		/* Now see if we have more array keys or prefixes to deal with */
+	} while ((so->numArrayKeys &&
+			  _bt_advance_array_keys(scan, ForwardScanDirection)) ||
+			 (so->skipPrefix > 0 && so->qual_ok &&
+			  _bt_skip_advance(scan, ForwardScanDirection)));
 
 	return ntids;
 }
 
+/*
+ * btskip() -- skip past the current tuple's prefix in a skip scan
+ *
+ * In a skip scan, each prefix is handled by its own primitive index scan,
+ * so skipping the rest of the current prefix just means ending that scan and
+ * advancing to the next prefix; the next btgettuple call then starts the
+ * primitive scan for it.  For any other scan we can't do better than the
+ * caller reading through the duplicates, so we ignore the request.
+ */
+bool
+btskip(IndexScanDesc scan, ScanDirection dir, int prefix)
+{
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+
+	if (so->skipPrefix == 0 || prefix != so->skipPrefix)
+		return true;
+
+	/* Nothing to do if we're not positioned on a prefix */
+	if (!BTScanPosIsValid(so->currPos))
+		return true;
+
+	/* Check to see if we should kill the previously-fetched tuple */
+	if (scan->kill_prior_tuple)
+	{
+		/* See btgettuple for comments about this */
+		if (so->killedItems == NULL)
+			so->killedItems = (int *)
+				palloc(MaxIndexTuplesPerPage * sizeof(int));
+		if (so->numKilled < MaxIndexTuplesPerPage)
+			so->killedItems[so->numKilled++] = so->currPos.itemIndex;
+	}
+
+	/* Before leaving current page, deal with any killed items */
+	if (so->numKilled > 0)
+		_bt_killitems(scan);
+	BTScanPosUnpinIfPinned(so->currPos);
+	BTScanPosInvalidate(so->currPos);
+
+	return _bt_skip_advance(scan, dir);
+}
+
 /*
  *	btbeginscan() -- start a scan on a btree index
  */
@@ -495,6 +566,12 @@ btbeginscan(Relation rel, int nkeys, int norderbys)
 	so->arrayKeys = NULL;
 	so->arrayContext = NULL;
 
+	so->skipPrefix = 0;			/* assume not a skip scan for now */
+	so->skipStarted = false;
+	so->skipKeyData = NULL;
+	so->skipProcs = NULL;
+	so->skipContext = NULL;
+
 	so->killedItems = NULL;		/* until needed */
 	so->numKilled = 0;
 
@@ -570,6 +647,9 @@ btrescan(IndexScanDesc scan, ScanKey scankey, int nscankeys,
 
 	/* If any keys are SK_SEARCHARRAY type, set up array-key info */
 	_bt_preprocess_array_keys(scan);
+
+	/* If caller requested a skip scan, set up skip-key info */
+	_bt_preprocess_skip_keys(scan);
 }
 
 /*
@@ -600,6 +680,9 @@ btendscan(IndexScanDesc scan)
 	/* so->arrayKeyData and so->arrayKeys are in arrayContext */
 	if (so->arrayContext != NULL)
 		MemoryContextDelete(so->arrayContext);
+	/* so->skipKeyData and so->skipProcs are in skipContext */
+	if (so->skipContext != NULL)
+		MemoryContextDelete(so->skipContext);
 	if (so->killedItems != NULL)
 		pfree(so->killedItems);
 	if (so->currTuples != NULL)
@@ -1161,6 +1161,170 @@ _bt_next(IndexScanDesc scan, ScanDirection dir)
 	return true;
 }
 
+/*
+ *	_bt_skip_advance() -- Advance a skip scan to its next prefix
+ *
+ *		A skip scan is run as a series of primitive index scans, one for
+ *		each distinct prefix (combination of values of the first
+ *		so->skipPrefix index columns) present in the index.  The prefix of
+ *		the current primitive scan is held in the skip keys at the front of
+ *		so->skipKeyData, where _bt_first and _bt_checkkeys treat them like
+ *		any other equality keys; see _bt_preprocess_skip_keys.
+ *
+ *		Here we find the next prefix in the given scan direction, by
+ *		descending to the first leaf item beyond the current prefix, or to
+ *		the start of the index if we don't have a prefix yet.  The leading
+ *		columns of that item are loaded into the skip keys.  Note that the
+ *		item need not satisfy the other scan keys; if no item with the new
+ *		prefix does, the primitive scan for it will simply find nothing.
+ *
+ *		Returns FALSE if there are no more prefixes.  In either case we
+ *		return with no pins or locks held, and so->currPos still invalid.
+ */
+bool
+_bt_skip_advance(IndexScanDesc scan, ScanDirection dir)
+{
+	Relation	rel = scan->indexRelation;
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	int			prefix = so->skipPrefix;
+	Buffer		buf;
+	Page		page;
+	BTPageOpaque opaque;
+	OffsetNumber offnum;
+	IndexTuple	itup;
+	int			i;
+
+	Assert(prefix > 0);
+	Assert(!BTScanPosIsValid(so->currPos));
+
+	if (!so->skipStarted)
+	{
+		/* Start at the first or last leaf page, as for _bt_endpoint */
+		buf = _bt_get_endpoint(rel, 0, ScanDirectionIsBackward(dir),
+							   scan->xs_snapshot);
+		offnum = ScanDirectionIsForward(dir) ?
+			InvalidOffsetNumber : MaxOffsetNumber;
+	}
+	else
+	{
+		ScanKeyData scankeys[INDEX_MAX_KEYS];
+		bool		nextkey;
+		BTStack		stack;
+
+		/*
+		 * Build an insertion scankey from the current prefix.  The order
+		 * procs can be the cached ones, since the prefix values were taken
+		 * from the index itself.
+		 */
+		for (i = 0; i < prefix; i++)
+		{
+			ScanKey		skey = &so->skipKeyData[i];
+			int			flags;
+
+			flags = (skey->sk_flags & SK_ISNULL) |
+				(rel->rd_indoption[i] << SK_BT_INDOPTION_SHIFT);
+			ScanKeyEntryInitializeWithInfo(&scankeys[i],
+										   flags,
+										   (AttrNumber) (i + 1),
+										   InvalidStrategy,
+										   InvalidOid,
+										   rel->rd_indcollation[i],
+										   index_getprocinfo(rel, i + 1,
+															 BTORDER_PROC),
+										   skey->sk_argument);
+		}
+
+		/*
+		 * For a forward scan we want the first item > prefix.  For a
+		 * backward scan we want the last item < prefix, which is the one
+		 * just before the first item >= prefix.
+		 */
+		nextkey = ScanDirectionIsForward(dir);
+		stack = _bt_search(rel, prefix, scankeys, nextkey, &buf, BT_READ,
+						   scan->xs_snapshot);
+		_bt_freestack(stack);
+
+		if (BufferIsValid(buf))
+		{
+			offnum = _bt_binsrch(rel, buf, prefix, scankeys, nextkey);
+			if (!nextkey)
+				offnum = OffsetNumberPrev(offnum);
+		}
+		else
+			offnum = InvalidOffsetNumber;	/* keep compiler quiet */
+	}
+
+	if (!BufferIsValid(buf))
+	{
+		/* The index is completely empty, so lock the whole relation */
+		PredicateLockRelation(rel, scan->xs_snapshot);
+		return false;
+	}
+
+	/*
+	 * The target item may be off either end of the page we landed on, in
+	 * which case it is the first (or last) item of the next page in the scan
+	 * direction that has any.  Predicate-lock every page we look at, since
+	 * we're effectively scanning the whole key range between the prefixes.
+	 */
+	for (;;)
+	{
+		page = BufferGetPage(buf);
+		TestForOldSnapshot(scan->xs_snapshot, rel, page);
+		opaque = (BTPageOpaque) PageGetSpecialPointer(page);
+
+		if (!P_IGNORE(opaque))
+			PredicateLockPage(rel, BufferGetBlockNumber(buf),
+							  scan->xs_snapshot);
+
+		if (ScanDirectionIsForward(dir))
+		{
+			if (!P_IGNORE(opaque))
+			{
+				offnum = Max(offnum, P_FIRSTDATAKEY(opaque));
+				if (offnum <= PageGetMaxOffsetNumber(page))
+					break;
+			}
+			if (P_RIGHTMOST(opaque))
+			{
+				_bt_relbuf(rel, buf);
+				return false;
+			}
+			buf = _bt_relandgetbuf(rel, buf, opaque->btpo_next, BT_READ);
+			offnum = InvalidOffsetNumber;
+		}
+		else
+		{
+			if (!P_IGNORE(opaque))
+			{
+				offnum = Min(offnum, PageGetMaxOffsetNumber(page));
+				if (offnum >= P_FIRSTDATAKEY(opaque))
+					break;
+			}
+			buf = _bt_walk_left(rel, buf, scan->xs_snapshot);
+			if (!BufferIsValid(buf))
+				return false;
+			offnum = MaxOffsetNumber;
+		}
+	}
+
+	/* Got it; load its leading columns into the skip keys */
+	itup = (IndexTuple) PageGetItem(page, PageGetItemId(page, offnum));
+	for (i = 0; i < prefix; i++)
+	{
+		Datum		datum;
+		bool		isnull;
+
+		datum = index_getattr(itup, i + 1, RelationGetDescr(rel), &isnull);
+		_bt_set_skip_key(scan, i, datum, isnull);
+	}
+	so->skipStarted = true;
+
+	_bt_relbuf(rel, buf);
+
+	return true;
+}
+
 /*
  *	_bt_readpage() -- Load data from current index page into so->currPos
  *
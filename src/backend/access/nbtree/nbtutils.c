@@ -22,6 +22,7 @@
 #include "access/relscan.h"
 #include "miscadmin.h"
 #include "utils/array.h"
+#include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
@@ -657,13 +658,168 @@ _bt_restore_array_keys(IndexScanDesc scan)
 }
 
 
+/*
+ *	_bt_preprocess_skip_keys() -- Set up a skip scan, if requested
+ *
+ * If the caller set scan->xs_skipprefix, the scan is to be run as a series
+ * of primitive index scans, one per distinct combination of values of the
+ * first xs_skipprefix index columns (a "prefix").  We implement that by
+ * prepending an equality key for each prefix column to the scan keys; the
+ * current prefix values are stored into those keys by _bt_skip_advance.
+ * With those in place, any keys on later columns become usable as
+ * positioning and required keys, so _bt_first can descend directly to the
+ * first matching item of each prefix.
+ *
+ * That only works if the scan has no keys of its own on the prefix columns.
+ * We also don't try to combine skipping with array keys or parallel scans.
+ * In all those cases we leave so->skipPrefix at zero: the scan is then just
+ * an ordinary scan, and btskip requests are ignored.
+ */
+void
+_bt_preprocess_skip_keys(IndexScanDesc scan)
+{
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	Relation	rel = scan->indexRelation;
+	int			prefix = scan->xs_skipprefix;
+	int			numberOfKeys = scan->numberOfKeys;
+	MemoryContext oldContext;
+	int			i;
+
+	so->skipPrefix = 0;
+	so->skipStarted = false;
+
+	/* Quit if caller didn't ask for a skip scan, or it can't be done */
+	if (prefix <= 0 ||
+		prefix > RelationGetNumberOfAttributes(rel) ||
+		so->numArrayKeys != 0 ||
+		scan->parallel_scan != NULL)
+		return;
+
+	for (i = 0; i < numberOfKeys; i++)
+	{
+		if (scan->keyData[i].sk_attno <= prefix)
+			return;
+	}
+
+	/*
+	 * Make a scan-lifespan context to hold skip-associated data, or reset it
+	 * if we already have one from a previous rescan cycle.  The first time
+	 * through, we must also enlarge so->keyData to make room for the skip
+	 * keys; that doesn't need repeating since neither the number of keys nor
+	 * the prefix length can change across rescans.
+	 */
+	if (so->skipContext == NULL)
+	{
+		so->skipContext = AllocSetContextCreate(CurrentMemoryContext,
+												"BTree skip context",
+												ALLOCSET_SMALL_SIZES);
+		if (so->keyData != NULL)
+			so->keyData = (ScanKey)
+				repalloc(so->keyData,
+						 (numberOfKeys + prefix) * sizeof(ScanKeyData));
+		else
+			so->keyData = (ScanKey)
+				palloc((numberOfKeys + prefix) * sizeof(ScanKeyData));
+	}
+	else
+		MemoryContextReset(so->skipContext);
+
+	oldContext = MemoryContextSwitchTo(so->skipContext);
+
+	/* Look up the equality operator of each prefix column's opfamily */
+	so->skipProcs = (FmgrInfo *) palloc(prefix * sizeof(FmgrInfo));
+	for (i = 0; i < prefix; i++)
+	{
+		Oid			opcintype = rel->rd_opcintype[i];
+		Oid			eq_op;
+
+		eq_op = get_opfamily_member(rel->rd_opfamily[i],
+									opcintype,
+									opcintype,
+									BTEqualStrategyNumber);
+		if (!OidIsValid(eq_op))
+			elog(ERROR, "missing operator %d(%u,%u) in opfamily %u",
+				 BTEqualStrategyNumber, opcintype, opcintype,
+				 rel->rd_opfamily[i]);
+		fmgr_info_cxt(get_opcode(eq_op), &so->skipProcs[i], so->skipContext);
+	}
+
+	/*
+	 * The skip keys go first, since the keys must be sorted by attribute;
+	 * then a copy of the caller's keys.  The skip keys get their values
+	 * later, in _bt_skip_advance.
+	 */
+	so->skipKeyData = (ScanKey)
+		palloc0((numberOfKeys + prefix) * sizeof(ScanKeyData));
+	if (numberOfKeys > 0)
+		memcpy(so->skipKeyData + prefix,
+			   scan->keyData,
+			   numberOfKeys * sizeof(ScanKeyData));
+
+	MemoryContextSwitchTo(oldContext);
+
+	so->skipPrefix = prefix;
+}
+
+/*
+ * _bt_set_skip_key() -- Store a prefix value into a skip scankey
+ *
+ * keyno is the zero-based prefix column number.  The value is copied into
+ * the skip context, so the caller may release the index page it came from.
+ */
+void
+_bt_set_skip_key(IndexScanDesc scan, int keyno, Datum value, bool isnull)
+{
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	Relation	rel = scan->indexRelation;
+	Form_pg_attribute att = TupleDescAttr(RelationGetDescr(rel), keyno);
+	ScanKey		skey = &so->skipKeyData[keyno];
+
+	Assert(keyno < so->skipPrefix);
+
+	/* Release the previous value, if it's one we copied */
+	if (so->skipStarted && !(skey->sk_flags & SK_ISNULL) && !att->attbyval)
+		pfree(DatumGetPointer(skey->sk_argument));
+
+	if (isnull)
+	{
+		/* An "IS NULL" key selects the prefix having a null in this column */
+		ScanKeyEntryInitialize(skey,
+							   SK_ISNULL | SK_SEARCHNULL,
+							   (AttrNumber) (keyno + 1),
+							   InvalidStrategy,
+							   InvalidOid,
+							   InvalidOid,
+							   InvalidOid,
+							   (Datum) 0);
+	}
+	else
+	{
+		MemoryContext oldContext;
+
+		oldContext = MemoryContextSwitchTo(so->skipContext);
+		ScanKeyEntryInitializeWithInfo(skey,
+									   0,
+									   (AttrNumber) (keyno + 1),
+									   BTEqualStrategyNumber,
+									   rel->rd_opcintype[keyno],
+									   rel->rd_indcollation[keyno],
+									   &so->skipProcs[keyno],
+									   datumCopy(value, att->attbyval,
+												 att->attlen));
+		MemoryContextSwitchTo(oldContext);
+	}
+}
+
+
 /*
  *	_bt_preprocess_keys() -- Preprocess scan keys
  *
- * The given search-type keys (in scan->keyData[] or so->arrayKeyData[])
- * are copied to so->keyData[] with possible transformation.
- * scan->numberOfKeys is the number of input keys, so->numberOfKeys gets
- * the number of output keys (possibly less, never greater).
+ * The given search-type keys (in scan->keyData[], so->arrayKeyData[] or
+ * so->skipKeyData[]) are copied to so->keyData[] with possible
+ * transformation.  scan->numberOfKeys (plus so->skipPrefix, in a skip scan)
+ * is the number of input keys, so->numberOfKeys gets the number of output
+ * keys (possibly less, never greater).
  *
  * The output keys are marked with additional sk_flag bits beyond the
  * system-standard bits supplied by the caller.  The DESC and NULLS_FIRST
@@ -697,7 +853,8 @@ _bt_restore_array_keys(IndexScanDesc scan)
  * This can be seen to be correct by considering the above example.  Note
  * in particular that if there are no keys for a given attribute, the keys for
  * subsequent attributes can never be required; for instance "WHERE y = 4"
- * requires a full-index scan.
+ * requires a full-index scan, unless it is run as a skip scan (see
+ * _bt_preprocess_skip_keys).
  *
  * If possible, redundant keys are eliminated: we keep only the tightest
  * >/>= bound and the tightest </<= bound, and if there's an = key then
@@ -762,17 +919,23 @@ _bt_preprocess_keys(IndexScanDesc scan)
 	so->qual_ok = true;
 	so->numberOfKeys = 0;
 
-	if (numberOfKeys < 1)
-		return;					/* done if qual-less scan */
-
 	/*
-	 * Read so->arrayKeyData if array keys are present, else scan->keyData
+	 * Read so->skipKeyData if this is a skip scan, else so->arrayKeyData if
+	 * array keys are present, else scan->keyData
 	 */
-	if (so->arrayKeyData != NULL)
+	if (so->skipPrefix > 0)
+	{
+		inkeys = so->skipKeyData;
+		numberOfKeys += so->skipPrefix;
+	}
+	else if (so->arrayKeyData != NULL)
 		inkeys = so->arrayKeyData;
 	else
 		inkeys = scan->keyData;
 
+	if (numberOfKeys < 1)
+		return;					/* done if qual-less scan */
+
 	outkeys = so->keyData;
 	cur = &inkeys[0];
 	/* we check that input keys are correctly ordered */
@@ -14,11 +14,13 @@
 
 #include "postgres.h"
 
+#include "access/gin.h"
 #include "access/parallel.h"
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "catalog/namespace.h"
 #include "commands/async.h"
+#include "commands/copy.h"
 #include "executor/execParallel.h"
 #include "libpq/libpq.h"
 #include "libpq/pqformat.h"
@@ -99,6 +101,12 @@ volatile bool ParallelMessagePending = false;
 /* Are we initializing a parallel worker? */
 bool		InitializingParallelWorker = false;
 
+/*
+ * May this parallel worker insert tuples?  Parallel operations are normally
+ * strictly read-only, but the workers of a parallel COPY FROM set this.
+ */
+bool		ParallelWorkerMayInsert = false;
+
 /* Pointer to our fixed parallel state. */
 static FixedParallelState *MyFixedParallelState;
 
@@ -118,6 +126,12 @@ static const struct
 {
 	{
 		"ParallelQueryMain", ParallelQueryMain
+	},
+	{
+		"ginParallelBuildMain", ginParallelBuildMain
+	},
+	{
+		"ParallelCopyMain", ParallelCopyMain
 	}
 };
 
@@ -34,6 +34,7 @@
 #include "access/xact.h"
 #include "access/xlog_internal.h"
 #include "access/xloginsert.h"
+#include "access/xlogprefetch.h"
 #include "access/xlogreader.h"
 #include "access/xlogutils.h"
 #include "catalog/catversion.h"
@@ -96,7 +97,7 @@ char	   *XLogArchiveCommand = NULL;
 bool		EnableHotStandby = false;
 bool		fullPageWrites = true;
 bool		wal_log_hints = false;
-bool		wal_compression = false;
+int			wal_compression = WAL_COMPRESSION_NONE;
 char	   *wal_consistency_checking_string = NULL;
 bool	   *wal_consistency_checking = NULL;
 bool		log_checkpoints = false;
@@ -111,11 +112,12 @@ bool		XLOG_DEBUG = false;
 #endif
 
 /*
- * Number of WAL insertion locks to use. A higher value allows more insertions
- * to happen concurrently, but adds some CPU overhead to flushing the WAL,
- * which needs to iterate all the locks.
+ * Number of WAL insertion locks to use (wal_insert_locks). A higher value
+ * allows more insertions to happen concurrently, but adds some CPU overhead
+ * to flushing the WAL, which needs to iterate all the locks.  -1 means
+ * choose based on MaxBackends; see XLOGChooseNumInsertLocks().
  */
-#define NUM_XLOGINSERT_LOCKS  8
+int			NumXLogInsertLocks = -1;
 
 /*
  * Max distance from last checkpoint, before triggering a new xlog-based
@@ -480,6 +482,31 @@ typedef union WALInsertLockPadded
 	char		pad[PG_CACHE_LINE_SIZE];
 } WALInsertLockPadded;
 
+/*
+ * Every WAL record carries a pointer to the start of the previous record
+ * (xl_prev), so reserving WAL space has to produce both the start of the new
+ * record and the start of the one before it.  Rather than serializing
+ * reservations with a spinlock to keep those two positions in step, space is
+ * reserved with an atomic fetch-and-add on CurrBytePos, and each inserter
+ * then leaves a "prev-link" behind in a small shared hash table, mapping the
+ * end of its record to its start.  The inserter that reserved the following
+ * record finds its xl_prev by looking up the link keyed by its own start
+ * position, and frees the slot.
+ *
+ * Reservations are made while holding a WAL insertion lock, so there are at
+ * most wal_insert_locks reservations in progress at a time, and at most one
+ * more link outstanding, for the latest record, whose successor hasn't
+ * arrived yet.  The table is sized to at least twice that, so there's always
+ * a free slot to be found by linear probing.  Both fields are byte positions
+ * (see XLogBytePosToRecPtr()); endpos is 0 in a free slot, and startpos is
+ * stored plus one, so that 0 means "not filled in yet".
+ */
+typedef struct XLogPrevLink
+{
+	pg_atomic_uint64 endpos;
+	pg_atomic_uint64 startpos;
+} XLogPrevLink;
+
 /*
  * State of an exclusive backup, necessary to control concurrent activities
  * across sessions when working on exclusive backups.
@@ -514,24 +541,24 @@ static SessionBackupState sessionBackupState = SESSION_BACKUP_NONE;
  */
 typedef struct XLogCtlInsert
 {
-	slock_t		insertpos_lck;	/* protects CurrBytePos and PrevBytePos */
-
 	/*
 	 * CurrBytePos is the end of reserved WAL. The next record will be
-	 * inserted at that position. PrevBytePos is the start position of the
-	 * previously inserted (or rather, reserved) record - it is copied to the
-	 * prev-link of the next record. These are stored as "usable byte
-	 * positions" rather than XLogRecPtrs (see XLogBytePosToRecPtr()).
+	 * inserted at that position.  It is stored as a "usable byte position"
+	 * rather than an XLogRecPtr (see XLogBytePosToRecPtr()), so that space
+	 * can be reserved with a single atomic fetch-and-add.
+	 *
+	 * The start position of the previous record, which goes into the
+	 * prev-link of the next record, is passed along through the prevLinks
+	 * table instead; see ReserveXLogInsertLocation().
 	 */
-	uint64		CurrBytePos;
-	uint64		PrevBytePos;
+	pg_atomic_uint64 CurrBytePos;
 
 	/*
-	 * Make sure the above heavily-contended spinlock and byte positions are
-	 * on their own cache line. In particular, the RedoRecPtr and full page
-	 * write variables below should be on a different cache line. They are
-	 * read on every WAL insertion, but updated rarely, and we don't want
-	 * those reads to steal the cache line containing Curr/PrevBytePos.
+	 * Make sure the above heavily-contended byte position is on its own
+	 * cache line. In particular, the RedoRecPtr and full page write variables
+	 * below should be on a different cache line. They are read on every WAL
+	 * insertion, but updated rarely, and we don't want those reads to steal
+	 * the cache line containing CurrBytePos.
 	 */
 	char		pad[PG_CACHE_LINE_SIZE];
 
@@ -562,9 +589,10 @@ typedef struct XLogCtlInsert
 	XLogRecPtr	lastBackupStart;
 
 	/*
-	 * WAL insertion locks.
+	 * WAL insertion locks, and the table of prev-links.
 	 */
 	WALInsertLockPadded *WALInsertLocks;
+	XLogPrevLink *prevLinks;
 } XLogCtlInsert;
 
 /*
@@ -700,6 +728,19 @@ typedef struct XLogCtlData
 	XLogRecPtr	lastFpwDisableRecPtr;
 
 	slock_t		info_lck;		/* locks shared variables shown above */
+
+	/*
+	 * State for the adaptive commit delay (commit_delay = -1).  flushRequests
+	 * counts XLogFlush calls that found their record not yet flushed; the
+	 * rest is only touched while holding WALWriteLock.  groupFlushTime is a
+	 * moving average of how long a flush takes, and groupArrivalRate of how
+	 * many flush requests arrive per microsecond.
+	 */
+	pg_atomic_uint64 flushRequests;
+	double		groupFlushTime;
+	double		groupArrivalRate;
+	TimestampTz groupLastFlush;
+	uint64		groupLastRequests;
 } XLogCtlData;
 
 static XLogCtlData *XLogCtl = NULL;
@@ -707,6 +748,10 @@ static XLogCtlData *XLogCtl = NULL;
 /* a private copy of XLogCtl->Insert.WALInsertLocks, for convenience */
 static WALInsertLockPadded *WALInsertLocks = NULL;
 
+/* likewise for XLogCtl->Insert.prevLinks, and its size minus one */
+static XLogPrevLink *XLogPrevLinks = NULL;
+static uint32 XLogPrevLinkMask = 0;
+
 /*
  * We maintain an image of pg_control in shared memory.
  */
@@ -848,6 +893,7 @@ static bool recoveryStopsBefore(XLogReaderState *record);
 static bool recoveryStopsAfter(XLogReaderState *record);
 static void recoveryPausesHere(void);
 static bool recoveryApplyDelay(XLogReaderState *record);
+static void RecoveryReadAhead(XLogPrefetcher *prefetcher);
 static void SetLatestXTime(TimestampTz xtime);
 static void SetCurrentChunkStartTime(TimestampTz xtime);
 static void CheckRequiredParameterValues(void);
@@ -863,6 +909,8 @@ static XLogRecPtr XLogGetReplicationSlotMinimumLSN(void);
 static void AdvanceXLInsertBuffer(XLogRecPtr upto, bool opportunistic);
 static bool XLogCheckpointNeeded(XLogSegNo new_segno);
 static void XLogWrite(XLogwrtRqst WriteRqst, bool flexible);
+static int	AdaptiveCommitDelay(void);
+static void AdaptiveCommitDelayUpdate(TimestampTz writeStart);
 static bool InstallXLogFileSegment(XLogSegNo *segno, char *tmppath,
 					   bool find_free, XLogSegNo max_segno,
 					   bool use_lock);
@@ -981,8 +1029,8 @@ XLogInsertRecord(XLogRecData *rdata,
 	 * record to the shared WAL buffer cache is a two-step process:
 	 *
 	 * 1. Reserve the right amount of space from the WAL. The current head of
-	 *	  reserved space is kept in Insert->CurrBytePos, and is protected by
-	 *	  insertpos_lck.
+	 *	  reserved space is kept in Insert->CurrBytePos, and is advanced
+	 *	  atomically.
 	 *
 	 * 2. Copy the record to the reserved WAL space. This involves finding the
 	 *	  correct WAL buffer containing the reserved space, and copying the
@@ -991,8 +1039,8 @@ XLogInsertRecord(XLogRecData *rdata,
 	 * To keep track of which insertions are still in-progress, each concurrent
 	 * inserter acquires an insertion lock. In addition to just indicating that
 	 * an insertion is in progress, the lock tells others how far the inserter
-	 * has progressed. There is a small fixed number of insertion locks,
-	 * determined by NUM_XLOGINSERT_LOCKS. When an inserter crosses a page
+	 * has progressed. There is a fixed number of insertion locks, determined
+	 * by wal_insert_locks. When an inserter crosses a page
 	 * boundary, it updates the value stored in the lock to the how far it has
 	 * inserted, to allow the previous buffer to be flushed.
 	 *
@@ -1204,16 +1252,86 @@ XLogInsertRecord(XLogRecData *rdata,
 	return EndPos;
 }
 
+/*
+ * Home slot in the prev-link table for a record ending at 'endbytepos'.
+ * Records are MAXALIGN'd, so the low bits carry no information.
+ */
+static inline uint32
+XLogPrevLinkSlot(uint64 endbytepos)
+{
+	return (uint32) (endbytepos / MAXIMUM_ALIGNOF) & XLogPrevLinkMask;
+}
+
+/*
+ * Record that the record ending at 'endbytepos' starts at 'startbytepos',
+ * for the benefit of whoever reserves the record after it.
+ */
+static void
+XLogPublishPrevLink(uint64 endbytepos, uint64 startbytepos)
+{
+	uint32		slot = XLogPrevLinkSlot(endbytepos);
+
+	/* There's always a free slot; see comments at XLogPrevLink */
+	for (;;)
+	{
+		uint64		expected = 0;
+
+		if (pg_atomic_compare_exchange_u64(&XLogPrevLinks[slot].endpos,
+										   &expected, endbytepos))
+			break;
+		slot = (slot + 1) & XLogPrevLinkMask;
+	}
+	pg_atomic_write_u64(&XLogPrevLinks[slot].startpos, startbytepos + 1);
+}
+
+/*
+ * Find the start of the record that ends at 'endbytepos', and free its
+ * prev-link.  The inserter of that record might not have published the link
+ * yet, but it has already reserved its space, so it won't be long.
+ */
+static uint64
+XLogConsumePrevLink(uint64 endbytepos)
+{
+	uint32		slot = XLogPrevLinkSlot(endbytepos);
+	uint32		probes = 0;
+	uint64		startbytepos;
+	SpinDelayStatus delayStatus;
+
+	init_local_spin_delay(&delayStatus);
+
+	while (pg_atomic_read_u64(&XLogPrevLinks[slot].endpos) != endbytepos)
+	{
+		slot = (slot + 1) & XLogPrevLinkMask;
+		if (++probes > XLogPrevLinkMask)
+		{
+			/* scanned the whole table without finding it; back off */
+			perform_spin_delay(&delayStatus);
+			probes = 0;
+		}
+	}
+
+	pg_read_barrier();
+	while ((startbytepos = pg_atomic_read_u64(&XLogPrevLinks[slot].startpos)) == 0)
+		perform_spin_delay(&delayStatus);
+	finish_spin_delay(&delayStatus);
+
+	/* Free the slot; startpos must read as unset before anyone can claim it */
+	pg_atomic_write_u64(&XLogPrevLinks[slot].startpos, 0);
+	pg_write_barrier();
+	pg_atomic_write_u64(&XLogPrevLinks[slot].endpos, 0);
+
+	return startbytepos - 1;
+}
+
 /*
  * Reserves the right amount of space for a record of given size from the WAL.
  * *StartPos is set to the beginning of the reserved section, *EndPos to
  * its end+1. *PrevPtr is set to the beginning of the previous record; it is
  * used to set the xl_prev of this record.
  *
- * This is the performance critical part of XLogInsert that must be serialized
- * across backends. The rest can happen mostly in parallel. Try to keep this
- * section as short as possible, insertpos_lck can be heavily contended on a
- * busy system.
+ * This is the performance critical part of XLogInsert that is ordered across
+ * backends. The rest can happen mostly in parallel.  The caller must hold a
+ * WAL insertion lock.
  *
  * NB: The space calculation here must match the code in CopyXLogRecordToWAL,
  * where we actually copy the record to the reserved space.
@@ -1233,24 +1351,21 @@ ReserveXLogInsertLocation(int size, XLogRecPtr *StartPos, XLogRecPtr *EndPos,
 	Assert(size > SizeOfXLogRecord);
 
 	/*
-	 * The duration the spinlock needs to be held is minimized by minimizing
-	 * the calculations that have to be done while holding the lock. The
-	 * current tip of reserved WAL is kept in CurrBytePos, as a byte position
-	 * that only counts "usable" bytes in WAL, that is, it excludes all WAL
-	 * page headers. The mapping between "usable" byte positions and physical
-	 * positions (XLogRecPtrs) can be done outside the locked region, and
-	 * because the usable byte position doesn't include any headers, reserving
-	 * X bytes from WAL is almost as simple as "CurrBytePos += X".
+	 * The current tip of reserved WAL is kept in CurrBytePos, as a byte
+	 * position that only counts "usable" bytes in WAL, that is, it excludes
+	 * all WAL page headers. The mapping between "usable" byte positions and
+	 * physical positions (XLogRecPtrs) can be done afterwards, and because
+	 * the usable byte position doesn't include any headers, reserving X
+	 * bytes from WAL is simply an atomic "CurrBytePos += X".
+	 *
+	 * We publish our own prev-link before looking for our predecessor's, so
+	 * that nobody ever waits for an inserter that is itself waiting.
 	 */
-	SpinLockAcquire(&Insert->insertpos_lck);
-
-	startbytepos = Insert->CurrBytePos;
+	startbytepos = pg_atomic_fetch_add_u64(&Insert->CurrBytePos, size);
 	endbytepos = startbytepos + size;
-	prevbytepos = Insert->PrevBytePos;
-	Insert->CurrBytePos = endbytepos;
-	Insert->PrevBytePos = startbytepos;
 
-	SpinLockRelease(&Insert->insertpos_lck);
+	XLogPublishPrevLink(endbytepos, startbytepos);
+	prevbytepos = XLogConsumePrevLink(startbytepos);
 
 	*StartPos = XLogBytePosToRecPtr(startbytepos);
 	*EndPos = XLogBytePosToEndRecPtr(endbytepos);
@@ -1286,25 +1401,21 @@ ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr)
 	uint32		segleft;
 
 	/*
-	 * These calculations are a bit heavy-weight to be done while holding a
-	 * spinlock, but since we're holding all the WAL insertion locks, there
-	 * are no other inserters competing for it. GetXLogInsertRecPtr() does
-	 * compete for it, but that's not called very frequently.
+	 * We're holding all the WAL insertion locks, so there are no other
+	 * inserters competing with us, and CurrBytePos can't move under us.
 	 */
-	SpinLockAcquire(&Insert->insertpos_lck);
+	Assert(holdingAllLocks);
 
-	startbytepos = Insert->CurrBytePos;
+	startbytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 
 	ptr = XLogBytePosToEndRecPtr(startbytepos);
 	if (ptr % XLOG_SEG_SIZE == 0)
 	{
-		SpinLockRelease(&Insert->insertpos_lck);
 		*EndPos = *StartPos = ptr;
 		return false;
 	}
 
 	endbytepos = startbytepos + size;
-	prevbytepos = Insert->PrevBytePos;
 
 	*StartPos = XLogBytePosToRecPtr(startbytepos);
 	*EndPos = XLogBytePosToEndRecPtr(endbytepos);
@@ -1316,10 +1427,9 @@ ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr)
 		*EndPos += segleft;
 		endbytepos = XLogRecPtrToBytePos(*EndPos);
 	}
-	Insert->CurrBytePos = endbytepos;
-	Insert->PrevBytePos = startbytepos;
-
-	SpinLockRelease(&Insert->insertpos_lck);
+	prevbytepos = XLogConsumePrevLink(startbytepos);
+	XLogPublishPrevLink(endbytepos, startbytepos);
+	pg_atomic_write_u64(&Insert->CurrBytePos, endbytepos);
 
 	*PrevPtr = XLogBytePosToRecPtr(prevbytepos);
 
@@ -1586,7 +1696,7 @@ WALInsertLockAcquire(void)
 	static int	lockToTry = -1;
 
 	if (lockToTry == -1)
-		lockToTry = MyProc->pgprocno % NUM_XLOGINSERT_LOCKS;
+		lockToTry = MyProc->pgprocno % NumXLogInsertLocks;
 	MyLockNo = lockToTry;
 
 	/*
@@ -1604,7 +1714,7 @@ WALInsertLockAcquire(void)
 		 * than locks, it still helps to distribute the inserters evenly
 		 * across the locks.
 		 */
-		lockToTry = (lockToTry + 1) % NUM_XLOGINSERT_LOCKS;
+		lockToTry = (lockToTry + 1) % NumXLogInsertLocks;
 	}
 }
 
@@ -1622,7 +1732,7 @@ WALInsertLockAcquireExclusive(void)
 	 * indicator is set to 0xFFFFFFFFFFFFFFFF, which is higher than any real
 	 * XLogRecPtr value, to make sure that no-one blocks waiting on those.
 	 */
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS - 1; i++)
+	for (i = 0; i < NumXLogInsertLocks - 1; i++)
 	{
 		LWLockAcquire(&WALInsertLocks[i].l.lock, LW_EXCLUSIVE);
 		LWLockUpdateVar(&WALInsertLocks[i].l.lock,
@@ -1648,7 +1758,7 @@ WALInsertLockRelease(void)
 	{
 		int			i;
 
-		for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+		for (i = 0; i < NumXLogInsertLocks; i++)
 			LWLockReleaseClearVar(&WALInsertLocks[i].l.lock,
 								  &WALInsertLocks[i].l.insertingAt,
 								  0);
@@ -1676,8 +1786,8 @@ WALInsertLockUpdateInsertingAt(XLogRecPtr insertingAt)
 		 * We use the last lock to mark our actual position, see comments in
 		 * WALInsertLockAcquireExclusive.
 		 */
-		LWLockUpdateVar(&WALInsertLocks[NUM_XLOGINSERT_LOCKS - 1].l.lock,
-						&WALInsertLocks[NUM_XLOGINSERT_LOCKS - 1].l.insertingAt,
+		LWLockUpdateVar(&WALInsertLocks[NumXLogInsertLocks - 1].l.lock,
+						&WALInsertLocks[NumXLogInsertLocks - 1].l.insertingAt,
 						insertingAt);
 	}
 	else
@@ -1713,9 +1823,7 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 		elog(PANIC, "cannot wait without a PGPROC structure");
 
 	/* Read the current insert position */
-	SpinLockAcquire(&Insert->insertpos_lck);
-	bytepos = Insert->CurrBytePos;
-	SpinLockRelease(&Insert->insertpos_lck);
+	bytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 	reservedUpto = XLogBytePosToEndRecPtr(bytepos);
 
 	/*
@@ -1744,7 +1852,7 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 	 * out for any insertion that's still in progress.
 	 */
 	finishedUpto = reservedUpto;
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		XLogRecPtr	insertingat = InvalidXLogRecPtr;
 
@@ -2747,6 +2855,67 @@ UpdateMinRecoveryPoint(XLogRecPtr lsn, bool force)
 	LWLockRelease(ControlFileLock);
 }
 
+/*
+ * Choose how long to wait before a group commit flush, when commit_delay is
+ * -1.  Must be called with WALWriteLock held.
+ *
+ * Waiting only pays off if other transactions become ready to commit in the
+ * meantime, and it's only worth delaying a flush by a fraction of what the
+ * flush itself costs.  So we wait half the recent average flush time (capped
+ * at ADAPTIVE_COMMIT_DELAY_MAX), provided the recent rate of flush requests
+ * predicts at least one more arriving in that window.  On fast storage or
+ * with few concurrent committers this comes out as no delay at all.
+ */
+#define ADAPTIVE_COMMIT_DELAY_MAX	10000	/* microseconds */
+
+static int
+AdaptiveCommitDelay(void)
+{
+	XLogCtlData *ctl = XLogCtl;
+	uint64		requests = pg_atomic_read_u64(&ctl->flushRequests);
+	TimestampTz now = GetCurrentTimestamp();
+	double		delay;
+
+	/* Update the arrival rate with what happened since the last flush */
+	if (ctl->groupLastFlush != 0 && now > ctl->groupLastFlush)
+	{
+		double		rate;
+
+		rate = (double) (requests - ctl->groupLastRequests) /
+			(double) (now - ctl->groupLastFlush);
+		if (ctl->groupArrivalRate == 0)
+			ctl->groupArrivalRate = rate;
+		else
+			ctl->groupArrivalRate = 0.875 * ctl->groupArrivalRate + 0.125 * rate;
+	}
+	ctl->groupLastFlush = now;
+	ctl->groupLastRequests = requests;
+
+	delay = ctl->groupFlushTime / 2;
+	if (delay > ADAPTIVE_COMMIT_DELAY_MAX)
+		delay = ADAPTIVE_COMMIT_DELAY_MAX;
+	if (ctl->groupArrivalRate * delay < 1.0)
+		return 0;
+
+	return (int) delay;
+}
+
+/*
+ * Fold the duration of the flush that began at 'writeStart' into the moving
+ * average used by AdaptiveCommitDelay.  Must be called with WALWriteLock held.
+ */
+static void
+AdaptiveCommitDelayUpdate(TimestampTz writeStart)
+{
+	XLogCtlData *ctl = XLogCtl;
+	double		elapsed = (double) (GetCurrentTimestamp() - writeStart);
+
+	if (ctl->groupFlushTime == 0)
+		ctl->groupFlushTime = elapsed;
+	else
+		ctl->groupFlushTime = 0.875 * ctl->groupFlushTime + 0.125 * elapsed;
+}
+
 /*
  * Ensure that all XLOG data through the given position is flushed to disk.
  *
@@ -2758,6 +2927,7 @@ XLogFlush(XLogRecPtr record)
 {
 	XLogRecPtr	WriteRqstPtr;
 	XLogwrtRqst WriteRqst;
+	int			delay;
 
 	/*
 	 * During REDO, we are reading not writing WAL.  Therefore, instead of
@@ -2776,6 +2946,10 @@ XLogFlush(XLogRecPtr record)
 	if (record <= LogwrtResult.Flush)
 		return;
 
+	/* Count the request, for the adaptive commit delay */
+	if (CommitDelay < 0)
+		pg_atomic_fetch_add_u64(&XLogCtl->flushRequests, 1);
+
 #ifdef WAL_DEBUG
 	if (XLOG_DEBUG)
 		elog(LOG, "xlog flush request %X/%X; write %X/%X; flush %X/%X",
@@ -2856,10 +3030,15 @@ XLogFlush(XLogRecPtr record)
 		 * We do not sleep if enableFsync is not turned on, nor if there are
 		 * fewer than CommitSiblings other backends with active transactions.
 		 */
-		if (CommitDelay > 0 && enableFsync &&
+		if (CommitDelay < 0)
+			delay = enableFsync ? AdaptiveCommitDelay() : 0;
+		else
+			delay = CommitDelay;
+
+		if (delay > 0 && enableFsync &&
 			MinimumActiveBackends(CommitSiblings))
 		{
-			pg_usleep(CommitDelay);
+			pg_usleep(delay);
 
 			/*
 			 * Re-check how far we can now flush the WAL. It's generally not
@@ -2878,7 +3057,15 @@ XLogFlush(XLogRecPtr record)
 		WriteRqst.Write = insertpos;
 		WriteRqst.Flush = insertpos;
 
-		XLogWrite(WriteRqst, false);
+		if (CommitDelay < 0 && enableFsync)
+		{
+			TimestampTz writeStart = GetCurrentTimestamp();
+
+			XLogWrite(WriteRqst, false);
+			AdaptiveCommitDelayUpdate(writeStart);
+		}
+		else
+			XLogWrite(WriteRqst, false);
 
 		LWLockRelease(WALWriteLock);
 		/* done */
@@ -4799,6 +4986,70 @@ check_wal_buffers(int *newval, void **extra, GucSource source)
 	return true;
 }
 
+/*
+ * Auto-tune the number of WAL insertion locks.
+ *
+ * Eight locks have long been enough to keep insertions from queuing up on
+ * a typical server; beyond a few dozen concurrent inserters, though, they
+ * become the bottleneck.  We use one lock per 16 possible backends, with
+ * the historical 8 as the minimum, and cap the result because every WAL
+ * flush has to look at every lock.
+ *
+ * This should not be called until MaxBackends has received its final value.
+ */
+static int
+XLOGChooseNumInsertLocks(void)
+{
+	int			nlocks;
+
+	nlocks = MaxBackends / 16;
+	if (nlocks > 128)
+		nlocks = 128;
+	if (nlocks < 8)
+		nlocks = 8;
+	return nlocks;
+}
+
+/*
+ * GUC check_hook for wal_insert_locks
+ */
+bool
+check_wal_insert_locks(int *newval, void **extra, GucSource source)
+{
+	/*
+	 * -1 indicates a request for auto-tune.  As with wal_buffers, leave the
+	 * boot_val alone until XLOGShmemSize has been called.
+	 */
+	if (*newval == -1)
+	{
+		if (NumXLogInsertLocks == -1)
+			return true;
+
+		*newval = XLOGChooseNumInsertLocks();
+	}
+	else if (*newval == 0)
+	{
+		GUC_check_errdetail("\"wal_insert_locks\" must be -1 or at least 1.");
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Number of slots in the prev-link table: a power of two, at least twice the
+ * number of prev-links that can be outstanding at once.
+ */
+static uint32
+XLogNumPrevLinks(void)
+{
+	uint32		nlinks = 1;
+
+	while (nlinks < 2 * (NumXLogInsertLocks + 1))
+		nlinks <<= 1;
+	return nlinks;
+}
+
 /*
  * Initialization of shared memory for XLOG
  */
@@ -4822,11 +5073,24 @@ XLOGShmemSize(void)
 	}
 	Assert(XLOGbuffers > 0);
 
+	/* Likewise for wal_insert_locks, which depends on MaxBackends */
+	if (NumXLogInsertLocks == -1)
+	{
+		char		buf[32];
+
+		snprintf(buf, sizeof(buf), "%d", XLOGChooseNumInsertLocks());
+		SetConfigOption("wal_insert_locks", buf, PGC_POSTMASTER,
+						PGC_S_OVERRIDE);
+	}
+	Assert(NumXLogInsertLocks > 0);
+
 	/* XLogCtl */
 	size = sizeof(XLogCtlData);
 
 	/* WAL insertion locks, plus alignment */
-	size = add_size(size, mul_size(sizeof(WALInsertLockPadded), NUM_XLOGINSERT_LOCKS + 1));
+	size = add_size(size, mul_size(sizeof(WALInsertLockPadded), NumXLogInsertLocks + 1));
+	/* prev-link table */
+	size = add_size(size, mul_size(sizeof(XLogPrevLink), XLogNumPrevLinks()));
 	/* xlblocks array */
 	size = add_size(size, mul_size(sizeof(XLogRecPtr), XLOGbuffers));
 	/* extra alignment padding for XLOG I/O buffers */
@@ -4879,6 +5143,8 @@ XLOGShmemInit(void)
 
 		/* Initialize local copy of WALInsertLocks and register the tranche */
 		WALInsertLocks = XLogCtl->Insert.WALInsertLocks;
+		XLogPrevLinks = XLogCtl->Insert.prevLinks;
+		XLogPrevLinkMask = XLogNumPrevLinks() - 1;
 		LWLockRegisterTranche(LWTRANCHE_WAL_INSERT,
 							  "wal_insert");
 		return;
@@ -4901,16 +5167,28 @@ XLOGShmemInit(void)
 		((uintptr_t) allocptr) % sizeof(WALInsertLockPadded);
 	WALInsertLocks = XLogCtl->Insert.WALInsertLocks =
 		(WALInsertLockPadded *) allocptr;
-	allocptr += sizeof(WALInsertLockPadded) * NUM_XLOGINSERT_LOCKS;
+	allocptr += sizeof(WALInsertLockPadded) * NumXLogInsertLocks;
 
 	LWLockRegisterTranche(LWTRANCHE_WAL_INSERT, "wal_insert");
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		LWLockInitialize(&WALInsertLocks[i].l.lock, LWTRANCHE_WAL_INSERT);
 		WALInsertLocks[i].l.insertingAt = InvalidXLogRecPtr;
 		WALInsertLocks[i].l.lastImportantAt = InvalidXLogRecPtr;
 	}
 
+	/* The prev-link table, initially empty */
+	XLogPrevLinks = XLogCtl->Insert.prevLinks = (XLogPrevLink *) allocptr;
+	XLogPrevLinkMask = XLogNumPrevLinks() - 1;
+	allocptr += sizeof(XLogPrevLink) * XLogNumPrevLinks();
+	for (i = 0; i <= XLogPrevLinkMask; i++)
+	{
+		pg_atomic_init_u64(&XLogPrevLinks[i].endpos, 0);
+		pg_atomic_init_u64(&XLogPrevLinks[i].startpos, 0);
+	}
+	pg_atomic_init_u64(&XLogCtl->Insert.CurrBytePos, 0);
+	pg_atomic_init_u64(&XLogCtl->flushRequests, 0);
+
 	/*
 	 * Align the start of the page buffers to a full xlog block size boundary.
 	 * This simplifies some calculations in XLOG insertion. It is also
@@ -4929,7 +5207,6 @@ XLOGShmemInit(void)
 	XLogCtl->SharedHotStandbyActive = false;
 	XLogCtl->WalWriterSleeping = false;
 
-	SpinLockInit(&XLogCtl->Insert.insertpos_lck);
 	SpinLockInit(&XLogCtl->info_lck);
 	SpinLockInit(&XLogCtl->ulsn_lck);
 	InitSharedLatch(&XLogCtl->recoveryWakeupLatch);
@@ -7023,6 +7300,7 @@ StartupXLOG(void)
 		{
 			ErrorContextCallback errcallback;
 			TimestampTz xtime;
+			XLogPrefetcher *prefetcher;
 
 			InRedo = true;
 
@@ -7030,6 +7308,8 @@ StartupXLOG(void)
 					(errmsg("redo starts at %X/%X",
 							(uint32) (ReadRecPtr >> 32), (uint32) ReadRecPtr)));
 
+			prefetcher = XLogPrefetcherAllocate();
+
 			/*
 			 * main redo apply loop
 			 */
@@ -7059,6 +7339,10 @@ StartupXLOG(void)
 				/* Handle interrupt signals of startup process */
 				HandleStartupProcInterrupts();
 
+				/* Start reading blocks that upcoming records will need */
+				if (prefetcher != NULL)
+					RecoveryReadAhead(prefetcher);
+
 				/*
 				 * Pause WAL replay, if requested by a hot-standby session via
 				 * SetRecoveryPause().
@@ -7257,6 +7541,9 @@ StartupXLOG(void)
 			 * end of main redo apply loop
 			 */
 
+			if (prefetcher != NULL)
+				XLogPrefetcherFree(prefetcher);
+
 			if (reachedStopPoint)
 			{
 				if (!reachedConsistency)
@@ -7477,8 +7764,9 @@ StartupXLOG(void)
 	 * previous incarnation.
 	 */
 	Insert = &XLogCtl->Insert;
-	Insert->PrevBytePos = XLogRecPtrToBytePos(LastRec);
-	Insert->CurrBytePos = XLogRecPtrToBytePos(EndOfLog);
+	pg_atomic_write_u64(&Insert->CurrBytePos, XLogRecPtrToBytePos(EndOfLog));
+	XLogPublishPrevLink(XLogRecPtrToBytePos(EndOfLog),
+						XLogRecPtrToBytePos(LastRec));
 
 	/*
 	 * Tricky point here: readBuf contains the *last* block that the LastRec
@@ -8259,7 +8547,7 @@ GetLastImportantRecPtr(void)
 	XLogRecPtr	res = InvalidXLogRecPtr;
 	int			i;
 
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		XLogRecPtr	last_important;
 
@@ -8642,7 +8930,7 @@ CreateCheckPoint(int flags)
 	 * determine the checkpoint REDO pointer.
 	 */
 	WALInsertLockAcquireExclusive();
-	curInsert = XLogBytePosToRecPtr(Insert->CurrBytePos);
+	curInsert = XLogBytePosToRecPtr(pg_atomic_read_u64(&Insert->CurrBytePos));
 
 	/*
 	 * If this isn't a shutdown or forced checkpoint, and if there has been no
@@ -11131,9 +11419,7 @@ GetXLogInsertRecPtr(void)
 	XLogCtlInsert *Insert = &XLogCtl->Insert;
 	uint64		current_bytepos;
 
-	SpinLockAcquire(&Insert->insertpos_lck);
-	current_bytepos = Insert->CurrBytePos;
-	SpinLockRelease(&Insert->insertpos_lck);
+	current_bytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 
 	return XLogBytePosToRecPtr(current_bytepos);
 }
@@ -11438,6 +11724,33 @@ CancelBackup(void)
 	}
 }
 
+/*
+ * Let the recovery prefetcher read ahead of the record we're about to
+ * replay, telling it how much WAL it may read from pg_wal.
+ *
+ * WAL being streamed is only known to be complete up to receivedUpto.
+ * Segments that were already in pg_wal when we opened them can be read
+ * until their valid contents end.  Segments restored from the archive are
+ * not kept under their own names, so there's nothing to read ahead in.
+ */
+static void
+RecoveryReadAhead(XLogPrefetcher *prefetcher)
+{
+	switch (readSource)
+	{
+		case XLOG_FROM_STREAM:
+			XLogPrefetcherReadAhead(prefetcher, ReadRecPtr, receivedUpto,
+									receiveTLI);
+			break;
+		case XLOG_FROM_PG_WAL:
+			XLogPrefetcherReadAhead(prefetcher, ReadRecPtr, InvalidXLogRecPtr,
+									curFileTLI);
+			break;
+		default:
+			break;
+	}
+}
+
 /*
  * Read the XLOG page containing RecPtr into readBuf (if not read already).
  * Returns number of bytes read, if the page is read successfully, or -1
@@ -32,9 +32,27 @@
 #include "utils/memutils.h"
 #include "pg_trace.h"
 
-/* Buffer size required to store a compressed version of backup block image */
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+/*
+ * Buffer size required to store a compressed version of backup block image.
+ * We never keep a compressed image that isn't smaller than the original, so
+ * this only has to be large enough for pglz, which needs a little slop.
+ */
 #define PGLZ_MAX_BLCKSZ PGLZ_MAX_OUTPUT(BLCKSZ)
 
+/*
+ * Main data at least this long is compressed, if wal_compression selects
+ * lz4 or zstd.  Smaller chunks rarely compress well enough to pay for the
+ * extra header bytes.
+ */
+#define MIN_COMPRESSED_MAIN_DATA	512
+
 /*
  * For each block reference registered with XLogRegisterBuffer, we fill in
  * a registered_buffer struct.
@@ -73,6 +91,15 @@ static XLogRecData *mainrdata_head;
 static XLogRecData *mainrdata_last = (XLogRecData *) &mainrdata_head;
 static uint32 mainrdata_len;	/* total # of bytes in chain */
 
+/*
+ * Working buffers for compressing the main data: the chain is flattened into
+ * 'mainrdata_raw', and compressed into 'mainrdata_compressed'.  Allocated in
+ * InitXLogInsert.
+ */
+static char *mainrdata_raw = NULL;
+static char *mainrdata_compressed = NULL;
+static XLogRecData mainrdata_compressed_rdt;
+
 /* flags for the in-progress insertion */
 static uint8 curinsert_flags = 0;
 
@@ -92,7 +119,8 @@ static char *hdr_scratch = NULL;
 #define HEADER_SCRATCH_SIZE \
 	(SizeOfXLogRecord + \
 	 MaxSizeOfXLogRecordBlockHeader * (XLR_MAX_BLOCK_ID + 1) + \
-	 SizeOfXLogRecordDataHeaderLong + SizeOfXlogOrigin)
+	 Max(SizeOfXLogRecordDataHeaderLong, \
+		 SizeOfXLogRecordDataHeaderCompressed) + SizeOfXlogOrigin)
 
 /*
  * An array of XLogRecData structs, to hold registered data.
@@ -111,6 +139,10 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info,
 				   XLogRecPtr *fpw_lsn);
 static bool XLogCompressBackupBlock(char *page, uint16 hole_offset,
 						uint16 hole_length, char *dest, uint16 *dlen);
+static bool XLogCompressData(int method, const char *source, int32 slen,
+				 char *dest, int32 *dlen);
+static bool XLogCompressMainData(uint32 *dlen);
+static uint8 XLogCompressMethodFlag(int method);
 
 /*
  * Begin constructing a WAL record. This must be called before the
@@ -532,6 +564,7 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 		bool		samerel;
 		bool		is_compressed = false;
 		bool		include_image;
+		uint8		compress_method = 0;
 
 		if (!regbuf->in_use)
 			continue;
@@ -620,13 +653,14 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 			/*
 			 * Try to compress a block image if wal_compression is enabled
 			 */
-			if (wal_compression)
+			if (wal_compression != WAL_COMPRESSION_NONE)
 			{
 				is_compressed =
 					XLogCompressBackupBlock(page, bimg.hole_offset,
 											cbimg.hole_length,
 											regbuf->compressed_page,
 											&compressed_len);
+				compress_method = XLogCompressMethodFlag(wal_compression);
 			}
 
 			/*
@@ -655,7 +689,7 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 			if (is_compressed)
 			{
 				bimg.length = compressed_len;
-				bimg.bimg_info |= BKPIMAGE_IS_COMPRESSED;
+				bimg.bimg_info |= compress_method;
 
 				rdt_datas_last->data = regbuf->compressed_page;
 				rdt_datas_last->len = compressed_len;
@@ -746,20 +780,40 @@ XLogRecordAssemble(RmgrId rmid, uint8 info,
 	/* followed by main data, if any */
 	if (mainrdata_len > 0)
 	{
-		if (mainrdata_len > 255)
+		uint32		compressed_len;
+
+		if (XLogCompressMainData(&compressed_len))
 		{
-			*(scratch++) = (char) XLR_BLOCK_ID_DATA_LONG;
+			*(scratch++) = (char) XLR_BLOCK_ID_DATA_COMPRESSED;
+			*(scratch++) = (char) XLogCompressMethodFlag(wal_compression);
+			memcpy(scratch, &compressed_len, sizeof(uint32));
+			scratch += sizeof(uint32);
 			memcpy(scratch, &mainrdata_len, sizeof(uint32));
 			scratch += sizeof(uint32);
+
+			mainrdata_compressed_rdt.data = mainrdata_compressed;
+			mainrdata_compressed_rdt.len = compressed_len;
+			rdt_datas_last->next = &mainrdata_compressed_rdt;
+			rdt_datas_last = &mainrdata_compressed_rdt;
+			total_len += compressed_len;
 		}
 		else
 		{
-			*(scratch++) = (char) XLR_BLOCK_ID_DATA_SHORT;
-			*(scratch++) = (uint8) mainrdata_len;
+			if (mainrdata_len > 255)
+			{
+				*(scratch++) = (char) XLR_BLOCK_ID_DATA_LONG;
+				memcpy(scratch, &mainrdata_len, sizeof(uint32));
+				scratch += sizeof(uint32);
+			}
+			else
+			{
+				*(scratch++) = (char) XLR_BLOCK_ID_DATA_SHORT;
+				*(scratch++) = (uint8) mainrdata_len;
+			}
+			rdt_datas_last->next = mainrdata_head;
+			rdt_datas_last = mainrdata_last;
+			total_len += mainrdata_len;
 		}
-		rdt_datas_last->next = mainrdata_head;
-		rdt_datas_last = mainrdata_last;
-		total_len += mainrdata_len;
 	}
 	rdt_datas_last->next = NULL;
 
@@ -830,12 +884,11 @@ XLogCompressBackupBlock(char *page, uint16 hole_offset, uint16 hole_length,
 		source = page;
 
 	/*
-	 * We recheck the actual size even if pglz_compress() reports success and
-	 * see if the number of bytes saved by compression is larger than the
-	 * length of extra data needed for the compressed version of block image.
+	 * We recheck the actual size even if compression reports success and see
+	 * if the number of bytes saved by compression is larger than the length
+	 * of extra data needed for the compressed version of block image.
 	 */
-	len = pglz_compress(source, orig_len, dest, PGLZ_strategy_default);
-	if (len >= 0 &&
+	if (XLogCompressData(wal_compression, source, orig_len, dest, &len) &&
 		len + extra_bytes < orig_len)
 	{
 		*dlen = (uint16) len;	/* successful compression */
@@ -844,6 +897,118 @@ XLogCompressBackupBlock(char *page, uint16 hole_offset, uint16 hole_length,
 	return false;
 }
 
+/*
+ * Compress 'slen' bytes at 'source' into 'dest' with the given
+ * wal_compression method.
+ *
+ * 'dest' must have room for PGLZ_MAX_OUTPUT(slen) bytes.  Returns FALSE if
+ * the data couldn't be compressed to less than its original size; otherwise
+ * returns TRUE and sets 'dlen' to the compressed length.
+ */
+static bool
+XLogCompressData(int method, const char *source, int32 slen,
+				 char *dest, int32 *dlen)
+{
+	int32		len = -1;
+
+	switch (method)
+	{
+		case WAL_COMPRESSION_PGLZ:
+			len = pglz_compress(source, slen, dest, PGLZ_strategy_default);
+			break;
+
+		case WAL_COMPRESSION_LZ4:
+#ifdef USE_LZ4
+			len = LZ4_compress_default(source, dest, slen, slen);
+			if (len <= 0)
+				len = -1;
+#endif
+			break;
+
+		case WAL_COMPRESSION_ZSTD:
+#ifdef USE_ZSTD
+			{
+				size_t		zlen;
+
+				zlen = ZSTD_compress(dest, slen, source, slen,
+									 ZSTD_CLEVEL_DEFAULT);
+				if (!ZSTD_isError(zlen))
+					len = (int32) zlen;
+			}
+#endif
+			break;
+
+		default:
+			break;
+	}
+
+	if (len < 0 || len >= slen)
+		return false;
+	*dlen = len;
+	return true;
+}
+
+/*
+ * Map a wal_compression setting to the BKPIMAGE_COMPRESS_* flag that
+ * identifies it in the WAL.
+ */
+static uint8
+XLogCompressMethodFlag(int method)
+{
+	switch (method)
+	{
+		case WAL_COMPRESSION_PGLZ:
+			return BKPIMAGE_COMPRESS_PGLZ;
+		case WAL_COMPRESSION_LZ4:
+			return BKPIMAGE_COMPRESS_LZ4;
+		case WAL_COMPRESSION_ZSTD:
+			return BKPIMAGE_COMPRESS_ZSTD;
+	}
+	elog(ERROR, "invalid wal_compression value: %d", method);
+	return 0;					/* keep compiler quiet */
+}
+
+/*
+ * Try to compress the main data of the record being assembled into
+ * mainrdata_compressed.  Only done with the lz4 and zstd methods: pglz is
+ * too slow to be worth spending on data that isn't a page image.
+ */
+static bool
+XLogCompressMainData(uint32 *dlen)
+{
+	XLogRecData *rdt;
+	char	   *dest;
+	int32		len;
+
+	if (wal_compression != WAL_COMPRESSION_LZ4 &&
+		wal_compression != WAL_COMPRESSION_ZSTD)
+		return false;
+	if (mainrdata_len < MIN_COMPRESSED_MAIN_DATA ||
+		mainrdata_len > XLR_MAX_COMPRESSED_MAIN_DATA)
+		return false;
+
+	/* Flatten the chain into a contiguous buffer */
+	dest = mainrdata_raw;
+	for (rdt = mainrdata_head; rdt != NULL; rdt = rdt->next)
+	{
+		memcpy(dest, rdt->data, rdt->len);
+		dest += rdt->len;
+		if (rdt == mainrdata_last)
+			break;
+	}
+	Assert(dest - mainrdata_raw == mainrdata_len);
+
+	/* Must save more than the extra header bytes to be worthwhile */
+	if (!XLogCompressData(wal_compression, mainrdata_raw, mainrdata_len,
+						  mainrdata_compressed, &len) ||
+		len + (SizeOfXLogRecordDataHeaderCompressed -
+			   SizeOfXLogRecordDataHeaderLong) >= mainrdata_len)
+		return false;
+
+	*dlen = (uint32) len;
+	return true;
+}
+
 /*
  * Determine whether the buffer referenced has to be backed up.
  *
@@ -1055,4 +1220,17 @@ InitXLogInsert(void)
 	if (hdr_scratch == NULL)
 		hdr_scratch = MemoryContextAllocZero(xloginsert_cxt,
 											 HEADER_SCRATCH_SIZE);
+
+	/*
+	 * And buffers for compressing the main data.  These are only needed with
+	 * some wal_compression settings, but that can change at any time.
+	 */
+	if (mainrdata_raw == NULL)
+	{
+		mainrdata_raw = MemoryContextAlloc(xloginsert_cxt,
+										   XLR_MAX_COMPRESSED_MAIN_DATA);
+		mainrdata_compressed =
+			MemoryContextAlloc(xloginsert_cxt,
+							   PGLZ_MAX_OUTPUT(XLR_MAX_COMPRESSED_MAIN_DATA));
+	}
 }
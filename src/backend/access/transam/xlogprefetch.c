@@ -0,0 +1,345 @@
+/*-------------------------------------------------------------------------
+ *
+ * xlogprefetch.c
+ *		Prefetching support for recovery.
+ *
+ * During recovery, the startup process replays one WAL record at a time,
+ * and each data block a record touches that is not already in shared
+ * buffers must be read synchronously before the record can be applied.
+ * On a busy primary that stream of random reads is what makes standbys
+ * fall behind and crash recovery slow.
+ *
+ * To hide that latency, the startup process runs a second xlogreader a
+ * bounded distance ahead of the record being replayed.  For each record
+ * decoded this way, any referenced block that is neither in shared buffers
+ * nor going to be overwritten wholesale (by a full-page image, or because
+ * redo re-initializes the page) is handed to smgrprefetch(), so that the
+ * kernel can start reading it while earlier records are being replayed.
+ * Replay itself is unchanged: it still runs strictly in WAL order in the
+ * startup process, and the look-ahead reader never influences what gets
+ * applied.
+ *
+ * The look-ahead reader only reads WAL that is already present in pg_wal
+ * (segments written by the walreceiver, or left over from before a crash),
+ * and never blocks.  When it runs out of WAL that is known to be valid it
+ * simply stops, and tries again once the caller reports that more WAL has
+ * arrived.  Anything it reads that turns out to be garbage is likewise just
+ * a reason to stop prefetching; errors are never raised from here.
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * IDENTIFICATION
+ *		src/backend/access/transam/xlogprefetch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "access/xlog_internal.h"
+#include "access/xlogprefetch.h"
+#include "access/xlogreader.h"
+#include "access/xlogrecord.h"
+#include "storage/bufmgr.h"
+#include "storage/fd.h"
+#include "storage/smgr.h"
+
+/* GUC variable */
+int			recovery_prefetch_distance = DEFAULT_RECOVERY_PREFETCH_DISTANCE;
+
+struct XLogPrefetcher
+{
+	/*
+	 * Look-ahead reader, and the start of the record it must read next if it
+	 * can't just continue from its EndRecPtr.  restartLSN is always the start
+	 * of a real record: EndRecPtr may point at a page or segment boundary,
+	 * which isn't a valid place to start reading.
+	 */
+	XLogReaderState *reader;
+	XLogRecPtr	restartLSN;		/* Invalid if reader can just continue */
+
+	/* Timeline and upper bound of the WAL we may read */
+	TimeLineID	tli;
+	XLogRecPtr	readUpto;		/* Invalid means "until end of WAL" */
+
+	/*
+	 * If the last read attempt failed, the readUpto value in effect at the
+	 * time.  We don't try again until the caller reports a different one.
+	 */
+	bool		stalled;
+	XLogRecPtr	stalledUpto;
+
+	/* Currently open WAL segment */
+	int			readFile;
+	XLogSegNo	readSegNo;
+	TimeLineID	readFileTLI;
+
+	/* Statistics, reported by XLogPrefetcherFree */
+	uint64		prefetch;		/* prefetches initiated */
+	uint64		skip_hit;		/* already in shared buffers */
+	uint64		skip_new;		/* page will be initialized or restored */
+	uint64		skip_missing;	/* relation or block doesn't exist (yet) */
+};
+
+static int XLogPrefetcherReadPage(XLogReaderState *state,
+					   XLogRecPtr targetPagePtr, int reqLen,
+					   XLogRecPtr targetRecPtr, char *readBuf,
+					   TimeLineID *pageTLI);
+static void XLogPrefetcherCloseFile(XLogPrefetcher *prefetcher);
+static void XLogPrefetcherScanBlocks(XLogPrefetcher *prefetcher);
+
+/*
+ * Create a prefetcher.  The look-ahead reader starts at the record passed
+ * to the first XLogPrefetcherReadAhead call.  Returns NULL if we can't get
+ * the memory for it, in which case the caller should just do without.
+ */
+XLogPrefetcher *
+XLogPrefetcherAllocate(void)
+{
+	XLogPrefetcher *prefetcher;
+
+	prefetcher = palloc0(sizeof(XLogPrefetcher));
+	prefetcher->reader = XLogReaderAllocate(&XLogPrefetcherReadPage,
+											prefetcher);
+	if (prefetcher->reader == NULL)
+	{
+		/* out of memory for the read buffer; just don't prefetch */
+		pfree(prefetcher);
+		return NULL;
+	}
+	prefetcher->readFile = -1;
+
+	return prefetcher;
+}
+
+/*
+ * Release a prefetcher, reporting what it achieved.
+ */
+void
+XLogPrefetcherFree(XLogPrefetcher *prefetcher)
+{
+	elog(DEBUG1,
+		 "recovery prefetch: " UINT64_FORMAT " blocks prefetched, "
+		 UINT64_FORMAT " already buffered, " UINT64_FORMAT " new or restored, "
+		 UINT64_FORMAT " missing",
+		 prefetcher->prefetch, prefetcher->skip_hit,
+		 prefetcher->skip_new, prefetcher->skip_missing);
+
+	XLogPrefetcherCloseFile(prefetcher);
+	XLogReaderFree(prefetcher->reader);
+	pfree(prefetcher);
+}
+
+/*
+ * Read ahead of the record at 'replayLSN', which is about to be replayed,
+ * until we are recovery_prefetch_distance bytes ahead of it or run out of
+ * WAL, and initiate prefetches for the blocks referenced by the records
+ * read.
+ *
+ * 'readUpto' is the end of the WAL that is known to be safe to read on
+ * timeline 'tli', or InvalidXLogRecPtr if the caller doesn't know, in which
+ * case we read until we find something that isn't a valid record.
+ */
+void
+XLogPrefetcherReadAhead(XLogPrefetcher *prefetcher, XLogRecPtr replayLSN,
+						XLogRecPtr readUpto, TimeLineID tli)
+{
+	XLogReaderState *reader = prefetcher->reader;
+	XLogRecPtr	distance;
+
+	/* recovery_prefetch_distance can be changed by SIGHUP */
+	if (recovery_prefetch_distance <= 0)
+		return;
+	distance = (XLogRecPtr) recovery_prefetch_distance * 1024;
+
+	/* If we're reading the wrong timeline (or none yet), start at replayLSN */
+	if (tli != prefetcher->tli)
+	{
+		XLogPrefetcherCloseFile(prefetcher);
+		XLogReaderInvalReadState(reader);
+		prefetcher->tli = tli;
+		prefetcher->restartLSN = replayLSN;
+		prefetcher->stalled = false;
+	}
+
+	/* Don't retry a failed read until there's more WAL to read */
+	if (prefetcher->stalled)
+	{
+		if (readUpto == prefetcher->stalledUpto)
+			return;
+		prefetcher->stalled = false;
+	}
+	prefetcher->readUpto = readUpto;
+
+	for (;;)
+	{
+		XLogRecPtr	nextLSN;
+		XLogRecord *record;
+		char	   *errormsg;
+
+		nextLSN = XLogRecPtrIsInvalid(prefetcher->restartLSN) ?
+			reader->EndRecPtr : prefetcher->restartLSN;
+
+		/*
+		 * If replay has caught up with us (for example because we stalled
+		 * waiting for WAL), skip ahead; there's no point in prefetching
+		 * blocks that have already been read by replay.
+		 */
+		if (nextLSN < replayLSN)
+			prefetcher->restartLSN = nextLSN = replayLSN;
+
+		/* Far enough ahead? */
+		if (nextLSN >= replayLSN + distance)
+			break;
+
+		record = XLogReadRecord(reader, prefetcher->restartLSN, &errormsg);
+		if (record == NULL)
+		{
+			/*
+			 * We've reached the end of the WAL available to us, or found
+			 * something that isn't a valid record.  Either way, wait for the
+			 * caller to tell us that more WAL has arrived.  Replay will report
+			 * any real problem.  A failed read leaves the reader positioned
+			 * after the last record it returned, so we can try again from
+			 * the same place: sequentially if restartLSN is invalid, or from
+			 * the record start it holds otherwise.
+			 */
+			prefetcher->stalled = true;
+			prefetcher->stalledUpto = readUpto;
+			break;
+		}
+		prefetcher->restartLSN = InvalidXLogRecPtr;
+
+		XLogPrefetcherScanBlocks(prefetcher);
+	}
+}
+
+/*
+ * Initiate prefetches for the blocks referenced by the record the
+ * look-ahead reader has just decoded.
+ */
+static void
+XLogPrefetcherScanBlocks(XLogPrefetcher *prefetcher)
+{
+	XLogReaderState *reader = prefetcher->reader;
+	DecodedBkpBlock *last = NULL;
+	BlockNumber lastNblocks = InvalidBlockNumber;
+	int			block_id;
+
+	for (block_id = 0; block_id <= reader->max_block_id; block_id++)
+	{
+		DecodedBkpBlock *block = &reader->blocks[block_id];
+		SMgrRelation reln;
+
+		if (!block->in_use)
+			continue;
+
+		/*
+		 * Redo will overwrite the whole page without reading it if the
+		 * record carries a full-page image to restore, or if it rebuilds the
+		 * page from scratch.
+		 */
+		if (block->apply_image || (block->flags & BKPBLOCK_WILL_INIT) != 0)
+		{
+			prefetcher->skip_new++;
+			continue;
+		}
+
+		reln = smgropen(block->rnode, InvalidBackendId);
+
+		/*
+		 * The relation might have been created or extended by WAL we haven't
+		 * replayed yet, or dropped by WAL that has been replayed already.
+		 * Prefetching a block that doesn't exist would raise an error, so
+		 * check, remembering the answer for consecutive references to the
+		 * same fork within this record.
+		 */
+		if (last == NULL || last->forknum != block->forknum ||
+			!RelFileNodeEquals(last->rnode, block->rnode))
+		{
+			last = block;
+			if (smgrexists(reln, block->forknum))
+				lastNblocks = smgrnblocks(reln, block->forknum);
+			else
+				lastNblocks = 0;
+		}
+		if (block->blkno >= lastNblocks)
+		{
+			prefetcher->skip_missing++;
+			continue;
+		}
+
+		if (PrefetchSharedBuffer(reln, block->forknum, block->blkno))
+			prefetcher->prefetch++;
+		else
+			prefetcher->skip_hit++;
+	}
+}
+
+/*
+ * xlogreader page-read callback for the look-ahead reader.
+ *
+ * Reads straight from the segment files in pg_wal, and never waits: if the
+ * requested data is beyond readUpto, or can't be read, we report failure
+ * and let XLogPrefetcherReadAhead try again later.
+ */
+static int
+XLogPrefetcherReadPage(XLogReaderState *state, XLogRecPtr targetPagePtr,
+					   int reqLen, XLogRecPtr targetRecPtr, char *readBuf,
+					   TimeLineID *pageTLI)
+{
+	XLogPrefetcher *prefetcher = (XLogPrefetcher *) state->private_data;
+	XLogRecPtr	readUpto = prefetcher->readUpto;
+	uint32		startoff;
+	int			count;
+
+	if (XLogRecPtrIsInvalid(readUpto) ||
+		targetPagePtr + XLOG_BLCKSZ <= readUpto)
+		count = XLOG_BLCKSZ;
+	else if (targetPagePtr + reqLen > readUpto)
+		return -1;
+	else
+		count = readUpto - targetPagePtr;
+
+	/* Switch to the right segment, if necessary */
+	if (prefetcher->readFile < 0 ||
+		!XLByteInSeg(targetPagePtr, prefetcher->readSegNo) ||
+		prefetcher->readFileTLI != prefetcher->tli)
+	{
+		char		path[MAXPGPATH];
+
+		XLogPrefetcherCloseFile(prefetcher);
+
+		XLByteToSeg(targetPagePtr, prefetcher->readSegNo);
+		XLogFilePath(path, prefetcher->tli, prefetcher->readSegNo);
+
+		prefetcher->readFile = BasicOpenFile(path, O_RDONLY | PG_BINARY, 0);
+		if (prefetcher->readFile < 0)
+			return -1;
+		prefetcher->readFileTLI = prefetcher->tli;
+	}
+
+	startoff = targetPagePtr % XLogSegSize;
+	if (lseek(prefetcher->readFile, (off_t) startoff, SEEK_SET) < 0 ||
+		read(prefetcher->readFile, readBuf, XLOG_BLCKSZ) != XLOG_BLCKSZ)
+	{
+		XLogPrefetcherCloseFile(prefetcher);
+		return -1;
+	}
+
+	*pageTLI = prefetcher->tli;
+	return count;
+}
+
+static void
+XLogPrefetcherCloseFile(XLogPrefetcher *prefetcher)
+{
+	if (prefetcher->readFile >= 0)
+	{
+		close(prefetcher->readFile);
+		prefetcher->readFile = -1;
+	}
+}
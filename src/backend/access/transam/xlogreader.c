@@ -25,6 +25,13 @@
 #include "common/pg_lzcompress.h"
 #include "replication/origin.h"
 
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
 static bool allocate_recordbuf(XLogReaderState *state, uint32 reclength);
 
 static bool ValidXLogPageHeader(XLogReaderState *state, XLogRecPtr recptr,
@@ -38,6 +45,8 @@ static int ReadPageInternal(XLogReaderState *state, XLogRecPtr pageptr,
 static void report_invalid_record(XLogReaderState *state, const char *fmt,...) pg_attribute_printf(2, 3);
 
 static void ResetDecoder(XLogReaderState *state);
+static const char *XLogDecompressData(uint8 method, const char *source,
+				   int32 slen, char *dest, int32 rawlen);
 
 /* size of the buffer allocated for error message. */
 #define MAX_ERRORMSG_LEN 1000
@@ -1028,6 +1037,8 @@ DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errormsg)
 	uint32		datatotal;
 	RelFileNode *rnode = NULL;
 	uint8		block_id;
+	uint8		main_data_method = 0;
+	uint32		main_data_stored_len = 0;
 
 	ResetDecoder(state);
 
@@ -1067,6 +1078,33 @@ DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errormsg)
 			break;				/* by convention, the main data fragment is
 								 * always last */
 		}
+		else if (block_id == XLR_BLOCK_ID_DATA_COMPRESSED)
+		{
+			/* XLogRecordDataHeaderCompressed */
+			uint32		main_data_len;
+
+			COPY_HEADER_FIELD(&main_data_method, sizeof(uint8));
+			COPY_HEADER_FIELD(&main_data_stored_len, sizeof(uint32));
+			COPY_HEADER_FIELD(&main_data_len, sizeof(uint32));
+
+			if (!BKPIMAGE_COMPRESSED(main_data_method) ||
+				main_data_len == 0 ||
+				main_data_len > XLR_MAX_COMPRESSED_MAIN_DATA ||
+				main_data_stored_len >= main_data_len)
+			{
+				report_invalid_record(state,
+									  "invalid compressed main data method %u length %u raw length %u at %X/%X",
+									  (unsigned int) main_data_method,
+									  main_data_stored_len,
+									  main_data_len,
+									  (uint32) (state->ReadRecPtr >> 32), (uint32) state->ReadRecPtr);
+				goto err;
+			}
+			state->main_data_len = main_data_len;
+			datatotal += main_data_stored_len;
+			break;				/* by convention, the main data fragment is
+								 * always last */
+		}
 		else if (block_id == XLR_BLOCK_ID_ORIGIN)
 		{
 			COPY_HEADER_FIELD(&state->record_origin, sizeof(RepOriginId));
@@ -1125,7 +1163,7 @@ DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errormsg)
 
 				blk->apply_image = ((blk->bimg_info & BKPIMAGE_APPLY) != 0);
 
-				if (blk->bimg_info & BKPIMAGE_IS_COMPRESSED)
+				if (BKPIMAGE_COMPRESSED(blk->bimg_info))
 				{
 					if (blk->bimg_info & BKPIMAGE_HAS_HOLE)
 						COPY_HEADER_FIELD(&blk->hole_length, sizeof(uint16));
@@ -1170,14 +1208,14 @@ DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errormsg)
 				}
 
 				/*
-				 * cross-check that bimg_len < BLCKSZ if the IS_COMPRESSED
-				 * flag is set.
+				 * cross-check that bimg_len < BLCKSZ if one of the
+				 * COMPRESS flags is set.
 				 */
-				if ((blk->bimg_info & BKPIMAGE_IS_COMPRESSED) &&
+				if (BKPIMAGE_COMPRESSED(blk->bimg_info) &&
 					blk->bimg_len == BLCKSZ)
 				{
 					report_invalid_record(state,
-										  "BKPIMAGE_IS_COMPRESSED set, but block image length %u at %X/%X",
+										  "BKPIMAGE_COMPRESSED set, but block image length %u at %X/%X",
 										  (unsigned int) blk->bimg_len,
 										  (uint32) (state->ReadRecPtr >> 32), (uint32) state->ReadRecPtr);
 					goto err;
@@ -1185,14 +1223,14 @@ DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errormsg)
 
 				/*
 				 * cross-check that bimg_len = BLCKSZ if neither HAS_HOLE nor
-				 * IS_COMPRESSED flag is set.
+				 * any of the COMPRESS flags is set.
 				 */
 				if (!(blk->bimg_info & BKPIMAGE_HAS_HOLE) &&
-					!(blk->bimg_info & BKPIMAGE_IS_COMPRESSED) &&
+					!BKPIMAGE_COMPRESSED(blk->bimg_info) &&
 					blk->bimg_len != BLCKSZ)
 				{
 					report_invalid_record(state,
-										  "neither BKPIMAGE_HAS_HOLE nor BKPIMAGE_IS_COMPRESSED set, but block image length is %u at %X/%X",
+										  "neither BKPIMAGE_HAS_HOLE nor BKPIMAGE_COMPRESSED set, but block image length is %u at %X/%X",
 										  (unsigned int) blk->data_len,
 										  (uint32) (state->ReadRecPtr >> 32), (uint32) state->ReadRecPtr);
 					goto err;
@@ -1280,8 +1318,30 @@ DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errormsg)
 			state->main_data_bufsz = state->main_data_len;
 			state->main_data = palloc(state->main_data_bufsz);
 		}
-		memcpy(state->main_data, ptr, state->main_data_len);
-		ptr += state->main_data_len;
+		if (main_data_method != 0)
+		{
+			const char *detail;
+
+			detail = XLogDecompressData(main_data_method,
+										ptr, main_data_stored_len,
+										state->main_data,
+										state->main_data_len);
+			if (detail != NULL)
+			{
+				report_invalid_record(state,
+									  "invalid compressed main data at %X/%X: %s",
+									  (uint32) (state->ReadRecPtr >> 32),
+									  (uint32) state->ReadRecPtr,
+									  detail);
+				goto err;
+			}
+			ptr += main_data_stored_len;
+		}
+		else
+		{
+			memcpy(state->main_data, ptr, state->main_data_len);
+			ptr += state->main_data_len;
+		}
 	}
 
 	return true;
@@ -1371,16 +1431,21 @@ RestoreBlockImage(XLogReaderState *record, uint8 block_id, char *page)
 	bkpb = &record->blocks[block_id];
 	ptr = bkpb->bkp_image;
 
-	if (bkpb->bimg_info & BKPIMAGE_IS_COMPRESSED)
+	if (BKPIMAGE_COMPRESSED(bkpb->bimg_info))
 	{
+		const char *detail;
+
 		/* If a backup block image is compressed, decompress it */
-		if (pglz_decompress(ptr, bkpb->bimg_len, tmp,
-							BLCKSZ - bkpb->hole_length) < 0)
+		detail = XLogDecompressData(bkpb->bimg_info & BKPIMAGE_COMPRESS_MASK,
+									ptr, bkpb->bimg_len, tmp,
+									BLCKSZ - bkpb->hole_length);
+		if (detail != NULL)
 		{
-			report_invalid_record(record, "invalid compressed image at %X/%X, block %d",
+			report_invalid_record(record, "invalid compressed image at %X/%X, block %d: %s",
 								  (uint32) (record->ReadRecPtr >> 32),
 								  (uint32) record->ReadRecPtr,
-								  block_id);
+								  block_id,
+								  detail);
 			return false;
 		}
 		ptr = tmp;
@@ -1403,3 +1468,52 @@ RestoreBlockImage(XLogReaderState *record, uint8 block_id, char *page)
 
 	return true;
 }
+
+/*
+ * Decompress 'slen' bytes at 'source', compressed with the method given by
+ * a BKPIMAGE_COMPRESS_* flag, into exactly 'rawlen' bytes at 'dest'.
+ *
+ * Returns NULL on success, or a description of the problem.
+ */
+static const char *
+XLogDecompressData(uint8 method, const char *source, int32 slen,
+				   char *dest, int32 rawlen)
+{
+	int32		len = -1;
+
+	switch (method)
+	{
+		case BKPIMAGE_COMPRESS_PGLZ:
+			len = pglz_decompress(source, slen, dest, rawlen, true);
+			break;
+
+		case BKPIMAGE_COMPRESS_LZ4:
+#ifdef USE_LZ4
+			len = LZ4_decompress_safe(source, dest, slen, rawlen);
+#else
+			return "LZ4 is not supported by this build";
+#endif
+			break;
+
+		case BKPIMAGE_COMPRESS_ZSTD:
+#ifdef USE_ZSTD
+			{
+				size_t		zlen;
+
+				zlen = ZSTD_decompress(dest, rawlen, source, slen);
+				if (!ZSTD_isError(zlen))
+					len = (int32) zlen;
+			}
+#else
+			return "Zstandard is not supported by this build";
+#endif
+			break;
+
+		default:
+			return "unknown compression method";
+	}
+
+	if (len != rawlen)
+		return "decompression failed";
+	return NULL;
+}
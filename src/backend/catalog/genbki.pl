@@ -444,6 +444,7 @@ sub emit_pgattr_row
 	my %PGATTR_DEFAULTS = (
 		attcacheoff   => '-1',
 		atttypmod     => '-1',
+		attcompression => '',
 		atthasdef     => 'f',
 		attidentity   => '',
 		attisdropped  => 'f',
@@ -475,12 +476,14 @@ sub emit_schemapg_row
 
 	# Replace empty string by zero char constant
 	$row->{attidentity} ||= '\0';
+	$row->{attcompression} ||= '\0';
 
 	# Supply appropriate quoting for these fields.
 	$row->{attname}     = q|{"| . $row->{attname} . q|"}|;
 	$row->{attstorage}  = q|'| . $row->{attstorage} . q|'|;
 	$row->{attalign}    = q|'| . $row->{attalign} . q|'|;
 	$row->{attidentity} = q|'| . $row->{attidentity} . q|'|;
+	$row->{attcompression} = q|'| . $row->{attcompression} . q|'|;
 
 	# We don't emit initializers for the variable length fields at all.
 	# Only the fixed-size portions of the descriptors are ever used.
@@ -20,11 +20,14 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
+#include "access/genam.h"
 #include "access/heapam.h"
 #include "access/htup_details.h"
+#include "access/parallel.h"
 #include "access/sysattr.h"
 #include "access/xact.h"
 #include "access/xlog.h"
+#include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
 #include "commands/copy.h"
 #include "commands/defrem.h"
@@ -38,16 +41,22 @@
 #include "optimizer/planner.h"
 #include "nodes/makefuncs.h"
 #include "parser/parse_relation.h"
+#include "port/simd.h"
+#include "postmaster/bgworker_internals.h"
 #include "rewrite/rewriteHandler.h"
 #include "storage/fd.h"
+#include "storage/shm_mq.h"
+#include "storage/spin.h"
 #include "tcop/tcopprot.h"
 #include "utils/builtins.h"
+#include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/portal.h"
 #include "utils/rel.h"
 #include "utils/rls.h"
 #include "utils/snapmgr.h"
+#include "utils/typcache.h"
 
 
 #define ISOCTAL(c) (((c) >= '0') && ((c) <= '7'))
@@ -65,6 +74,27 @@ typedef enum CopyDest
 	COPY_CALLBACK				/* to/from callback function */
 } CopyDest;
 
+/* COPY TO a file writes its output out in pieces of about this size */
+#define COPY_FILE_WRITE_SIZE 65536
+
+/*
+ * How binary COPY TO sends each attribute.  The send functions of the
+ * common fixed-width types just put the value into network byte order, so
+ * for those CopyOneRowTo does the same itself, straight into the output
+ * buffer, rather than calling the function and copying its bytea result.
+ */
+typedef enum CopyBinaryOut
+{
+	COPY_BINARY_OUT_FUNCTION,	/* call the type's send function */
+	COPY_BINARY_OUT_BOOL,		/* boolsend */
+	COPY_BINARY_OUT_CHAR,		/* charsend */
+	COPY_BINARY_OUT_INT16,		/* int2send */
+	COPY_BINARY_OUT_INT32,		/* int4send, oidsend, date_send */
+	COPY_BINARY_OUT_INT64,		/* int8send, timestamp_send, etc */
+	COPY_BINARY_OUT_FLOAT4,		/* float4send */
+	COPY_BINARY_OUT_FLOAT8		/* float8send */
+} CopyBinaryOut;
+
 /*
  *	Represents the end-of-line terminator type of the input
  */
@@ -104,6 +134,7 @@ typedef struct CopyStateData
 	int			file_encoding;	/* file or remote side's character encoding */
 	bool		need_transcoding;	/* file encoding diff from server? */
 	bool		encoding_embeds_ascii;	/* ASCII can be non-first byte? */
+	bool		parallel_leader;	/* only splitting input for workers? */
 
 	/* parameters from the COPY command */
 	Relation	rel;			/* relation to copy to or from */
@@ -115,6 +146,7 @@ typedef struct CopyStateData
 	bool		binary;			/* binary format? */
 	bool		oids;			/* include OIDs? */
 	bool		freeze;			/* freeze rows on loading? */
+	int			parallel_workers;	/* number of workers to load with */
 	bool		csv_mode;		/* Comma Separated Value format? */
 	bool		header_line;	/* CSV header line? */
 	char	   *null_print;		/* NULL marker string (server encoding!) */
@@ -149,6 +181,7 @@ typedef struct CopyStateData
 	 * Working state for COPY TO
 	 */
 	FmgrInfo   *out_functions;	/* lookup info for output functions */
+	CopyBinaryOut *binary_out;	/* how to send each attr in binary mode */
 	MemoryContext rowcontext;	/* per-row evaluation context */
 
 	/*
@@ -200,6 +233,15 @@ typedef struct CopyStateData
 	bool		line_buf_converted; /* converted to server encoding? */
 	bool		line_buf_valid; /* contains the row being processed? */
 
+	/*
+	 * The characters the parsing loops have to stop at, in text and CSV
+	 * mode; everything in between is skipped over many bytes at a time.
+	 * quoted_scan is used only for quoted CSV fields.
+	 */
+	ByteScan	line_scan;		/* for CopyReadLineText */
+	ByteScan	attr_scan;		/* for CopyReadAttributes{Text,CSV} */
+	ByteScan	quoted_scan;
+
 	/*
 	 * Finally, raw_buf holds raw data read from the data source (file or
 	 * client connection).  CopyReadLine parses this data sufficiently to
@@ -221,6 +263,32 @@ typedef struct
 	uint64		processed;		/* # of tuples processed */
 } DR_copy;
 
+/*
+ * Tuples buffered by CopyFrom, for insertion with heap_multi_insert.
+ *
+ * When loading a partitioned table, the buffered tuples can belong to
+ * different partitions; rels[] holds the partitions, and relnos[] which of
+ * them each tuple is for.  The buffer is flushed once it holds
+ * MAX_BUFFERED_TUPLES tuples or MAX_BUFFERED_BYTES bytes of them, or when a
+ * tuple arrives for a partition that would be the (MAX_BUFFERED_RELS + 1)th
+ * one, so that the work done and memory used per flush are bounded however
+ * the rows are spread over the partitions.
+ */
+#define MAX_BUFFERED_TUPLES		1000
+#define MAX_BUFFERED_BYTES		65535
+#define MAX_BUFFERED_RELS		32
+
+typedef struct CopyMultiInsertBuffer
+{
+	int			ntuples;		/* # of tuples buffered */
+	Size		nbytes;			/* their total size */
+	HeapTuple	tuples[MAX_BUFFERED_TUPLES];
+	int			linenos[MAX_BUFFERED_TUPLES];	/* input line of each tuple */
+	int			relnos[MAX_BUFFERED_TUPLES];	/* rels[] index of each tuple */
+	int			nrels;			/* # of relations with tuples buffered */
+	ResultRelInfo *rels[MAX_BUFFERED_RELS];
+} CopyMultiInsertBuffer;
+
 
 /*
  * These macros centralize code used to process line_buf and raw_buf buffers.
@@ -302,6 +370,7 @@ static CopyState BeginCopyTo(ParseState *pstate, Relation rel, RawStmt *query,
 static void EndCopyTo(CopyState cstate);
 static uint64 DoCopyTo(CopyState cstate);
 static uint64 CopyTo(CopyState cstate);
+static CopyBinaryOut CopyGetBinaryOut(Oid send_func_oid);
 static void CopyOneRowTo(CopyState cstate, Oid tupleOid,
 			 Datum *values, bool *nulls);
 static void CopyFromInsertBatch(CopyState cstate, EState *estate,
@@ -309,7 +378,19 @@ static void CopyFromInsertBatch(CopyState cstate, EState *estate,
 					ResultRelInfo *resultRelInfo, TupleTableSlot *myslot,
 					BulkInsertState bistate,
 					int nBufferedTuples, HeapTuple *bufferedTuples,
-					int firstBufferedLineNo);
+					int *bufferedLineNos);
+static bool CopyMultiInsertBufferAdd(CopyMultiInsertBuffer *buffer,
+						 ResultRelInfo *resultRelInfo, HeapTuple tuple,
+						 int lineno);
+static void CopyMultiInsertBufferFlush(CopyState cstate, EState *estate,
+						   CommandId mycid, int hi_options,
+						   TupleTableSlot *batchslot,
+						   BulkInsertState bistate,
+						   CopyMultiInsertBuffer *buffer);
+static bool CopyFromParallelOK(CopyState cstate);
+static uint64 ParallelCopyFrom(CopyState cstate, List *attnamelist,
+				 List *options);
+static int	parallel_copy_read_chunk(void *outbuf, int minread, int maxread);
 static bool CopyReadLine(CopyState cstate);
 static bool CopyReadLineText(CopyState cstate);
 static int	CopyReadAttributesText(CopyState cstate);
@@ -333,12 +414,15 @@ static void CopySendData(CopyState cstate, const void *databuf, int datasize);
 static void CopySendString(CopyState cstate, const char *str);
 static void CopySendChar(CopyState cstate, char c);
 static void CopySendEndOfRow(CopyState cstate);
+static void CopyWriteFile(CopyState cstate);
 static int CopyGetData(CopyState cstate, void *databuf,
 			int minread, int maxread);
 static void CopySendInt32(CopyState cstate, int32 val);
 static bool CopyGetInt32(CopyState cstate, int32 *val);
 static void CopySendInt16(CopyState cstate, int16 val);
 static bool CopyGetInt16(CopyState cstate, int16 *val);
+static inline void CopySendBinaryFixed(CopyState cstate, CopyBinaryOut how,
+					Datum value);
 
 
 /*
@@ -439,6 +523,7 @@ SendCopyEnd(CopyState cstate)
  * CopySendChar does the same for single characters
  * CopySendEndOfRow does the appropriate thing at end of each data row
  *	(data is not actually flushed except by CopySendEndOfRow)
+ * CopyWriteFile writes out the rows collected for a file destination
  *
  * NB: no data conversion is applied by these functions
  *----------
@@ -479,39 +564,14 @@ CopySendEndOfRow(CopyState cstate)
 #endif
 			}
 
-			if (fwrite(fe_msgbuf->data, fe_msgbuf->len, 1,
-					   cstate->copy_file) != 1 ||
-				ferror(cstate->copy_file))
-			{
-				if (cstate->is_program)
-				{
-					if (errno == EPIPE)
-					{
-						/*
-						 * The pipe will be closed automatically on error at
-						 * the end of transaction, but we might get a better
-						 * error message from the subprocess' exit code than
-						 * just "Broken Pipe"
-						 */
-						ClosePipeToProgram(cstate);
-
-						/*
-						 * If ClosePipeToProgram() didn't throw an error, the
-						 * program terminated normally, but closed the pipe
-						 * first. Restore errno, and throw an error.
-						 */
-						errno = EPIPE;
-					}
-					ereport(ERROR,
-							(errcode_for_file_access(),
-							 errmsg("could not write to COPY program: %m")));
-				}
-				else
-					ereport(ERROR,
-							(errcode_for_file_access(),
-							 errmsg("could not write to COPY file: %m")));
-			}
-			break;
+			/*
+			 * Nothing cares where the row boundaries fall in a file, so
+			 * collect rows until there's enough for a large write.  CopyTo
+			 * writes out the remainder at the end.
+			 */
+			if (fe_msgbuf->len >= COPY_FILE_WRITE_SIZE)
+				CopyWriteFile(cstate);
+			return;
 		case COPY_OLD_FE:
 			/* The FE/BE protocol uses \n as newline for all platforms */
 			if (!cstate->binary)
@@ -541,6 +601,51 @@ CopySendEndOfRow(CopyState cstate)
 	resetStringInfo(fe_msgbuf);
 }
 
+static void
+CopyWriteFile(CopyState cstate)
+{
+	StringInfo	fe_msgbuf = cstate->fe_msgbuf;
+
+	Assert(cstate->copy_dest == COPY_FILE);
+
+	if (fe_msgbuf->len == 0)
+		return;
+
+	if (fwrite(fe_msgbuf->data, fe_msgbuf->len, 1,
+			   cstate->copy_file) != 1 ||
+		ferror(cstate->copy_file))
+	{
+		if (cstate->is_program)
+		{
+			if (errno == EPIPE)
+			{
+				/*
+				 * The pipe will be closed automatically on error at the end
+				 * of transaction, but we might get a better error message
+				 * from the subprocess' exit code than just "Broken Pipe"
+				 */
+				ClosePipeToProgram(cstate);
+
+				/*
+				 * If ClosePipeToProgram() didn't throw an error, the program
+				 * terminated normally, but closed the pipe first. Restore
+				 * errno, and throw an error.
+				 */
+				errno = EPIPE;
+			}
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not write to COPY program: %m")));
+		}
+		else
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not write to COPY file: %m")));
+	}
+
+	resetStringInfo(fe_msgbuf);
+}
+
 /*
  * CopyGetData reads data from the source (file or frontend)
  *
@@ -723,6 +828,88 @@ CopyGetInt16(CopyState cstate, int16 *val)
 	return true;
 }
 
+/*
+ * CopySendBinaryFixed sends a non-null attribute in binary format, length
+ * word included, the same way as the send function that "how" stands for
+ */
+static inline void
+CopySendBinaryFixed(CopyState cstate, CopyBinaryOut how, Datum value)
+{
+	StringInfo	fe_msgbuf = cstate->fe_msgbuf;
+	char	   *ptr;
+	uint32		len;
+	uint32		n32;
+	uint16		n16;
+	int64		i64;
+	union
+	{
+		float4		f;
+		uint32		i;
+	}			swap4;
+	union
+	{
+		float8		f;
+		int64		i;
+	}			swap8;
+
+	/* room for the length word and the widest value */
+	enlargeStringInfo(fe_msgbuf, sizeof(uint32) + sizeof(int64));
+	ptr = fe_msgbuf->data + fe_msgbuf->len + sizeof(uint32);
+
+	switch (how)
+	{
+		case COPY_BINARY_OUT_BOOL:
+			len = 1;
+			*ptr = DatumGetBool(value) ? 1 : 0;
+			break;
+		case COPY_BINARY_OUT_CHAR:
+			len = 1;
+			*ptr = DatumGetChar(value);
+			break;
+		case COPY_BINARY_OUT_INT16:
+			len = sizeof(uint16);
+			n16 = htons((uint16) DatumGetInt16(value));
+			memcpy(ptr, &n16, sizeof(n16));
+			break;
+		case COPY_BINARY_OUT_INT32:
+			len = sizeof(uint32);
+			n32 = htonl((uint32) DatumGetInt32(value));
+			memcpy(ptr, &n32, sizeof(n32));
+			break;
+		case COPY_BINARY_OUT_FLOAT4:
+			len = sizeof(uint32);
+			swap4.f = DatumGetFloat4(value);
+			n32 = htonl(swap4.i);
+			memcpy(ptr, &n32, sizeof(n32));
+			break;
+		case COPY_BINARY_OUT_INT64:
+		case COPY_BINARY_OUT_FLOAT8:
+			if (how == COPY_BINARY_OUT_INT64)
+				i64 = DatumGetInt64(value);
+			else
+			{
+				swap8.f = DatumGetFloat8(value);
+				i64 = swap8.i;
+			}
+			len = sizeof(int64);
+			/* high order half first, as in pq_sendint64 */
+			n32 = htonl((uint32) (i64 >> 32));
+			memcpy(ptr, &n32, sizeof(n32));
+			n32 = htonl((uint32) i64);
+			memcpy(ptr + sizeof(n32), &n32, sizeof(n32));
+			break;
+		default:
+			elog(ERROR, "unrecognized binary output method: %d", (int) how);
+			len = 0;			/* keep compiler quiet */
+			break;
+	}
+
+	n32 = htonl(len);
+	memcpy(fe_msgbuf->data + fe_msgbuf->len, &n32, sizeof(n32));
+	fe_msgbuf->len += sizeof(uint32) + len;
+	fe_msgbuf->data[fe_msgbuf->len] = '\0';
+}
+
 
 /*
  * CopyLoadRawBuf loads some more data into raw_buf
@@ -974,7 +1161,11 @@ DoCopy(ParseState *pstate, const CopyStmt *stmt,
 
 		cstate = BeginCopyFrom(pstate, rel, stmt->filename, stmt->is_program,
 							   NULL, stmt->attlist, stmt->options);
-		*processed = CopyFrom(cstate);	/* copy from file to database */
+		if (cstate->parallel_workers > 0 && CopyFromParallelOK(cstate))
+			*processed = ParallelCopyFrom(cstate, stmt->attlist,
+										  stmt->options);
+		else
+			*processed = CopyFrom(cstate);	/* copy from file to database */
 		EndCopyFrom(cstate);
 	}
 	else
@@ -1026,6 +1217,7 @@ ProcessCopyOptions(ParseState *pstate,
 		cstate = (CopyStateData *) palloc0(sizeof(CopyStateData));
 
 	cstate->file_encoding = -1;
+	cstate->parallel_workers = -1;
 
 	/* Extract options from the statement node tree */
 	foreach(option, options)
@@ -1203,6 +1395,22 @@ ProcessCopyOptions(ParseState *pstate,
 								defel->defname),
 						 parser_errposition(pstate, defel->location)));
 		}
+		else if (strcmp(defel->defname, "parallel") == 0)
+		{
+			if (cstate->parallel_workers >= 0)
+				ereport(ERROR,
+						(errcode(ERRCODE_SYNTAX_ERROR),
+						 errmsg("conflicting or redundant options"),
+						 parser_errposition(pstate, defel->location)));
+			cstate->parallel_workers = defGetInt32(defel);
+			if (cstate->parallel_workers < 0 ||
+				cstate->parallel_workers > MAX_PARALLEL_WORKER_LIMIT)
+				ereport(ERROR,
+						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+						 errmsg("argument to option \"%s\" must be between %d and %d",
+								defel->defname, 0, MAX_PARALLEL_WORKER_LIMIT),
+						 parser_errposition(pstate, defel->location)));
+		}
 		else
 			ereport(ERROR,
 					(errcode(ERRCODE_SYNTAX_ERROR),
@@ -1226,6 +1434,9 @@ ProcessCopyOptions(ParseState *pstate,
 				 errmsg("cannot specify NULL in BINARY mode")));
 
 	/* Set defaults for omitted options */
+	if (cstate->parallel_workers < 0)
+		cstate->parallel_workers = 0;
+
 	if (!cstate->delim)
 		cstate->delim = cstate->csv_mode ? "," : "\t";
 
@@ -1341,6 +1552,16 @@ ProcessCopyOptions(ParseState *pstate,
 				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
 				 errmsg("COPY force null only available using COPY FROM")));
 
+	/* Check parallel */
+	if (cstate->parallel_workers > 0 && !is_from)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("COPY parallel only available using COPY FROM")));
+	if (cstate->parallel_workers > 0 && cstate->binary)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("COPY parallel not available in BINARY mode")));
+
 	/* Don't allow the delimiter to appear in the null string. */
 	if (strchr(cstate->null_print, cstate->delim[0]) != NULL)
 		ereport(ERROR,
@@ -1938,6 +2159,9 @@ CopyTo(CopyState cstate)
 
 	/* Get info about the columns we need to process. */
 	cstate->out_functions = (FmgrInfo *) palloc(num_phys_attrs * sizeof(FmgrInfo));
+	if (cstate->binary)
+		cstate->binary_out = (CopyBinaryOut *)
+			palloc(num_phys_attrs * sizeof(CopyBinaryOut));
 	foreach(cur, cstate->attnumlist)
 	{
 		int			attnum = lfirst_int(cur);
@@ -1946,9 +2170,12 @@ CopyTo(CopyState cstate)
 		Form_pg_attribute attr = TupleDescAttr(tupDesc, attnum - 1);
 
 		if (cstate->binary)
+		{
 			getTypeBinaryOutputInfo(attr->atttypid,
 									&out_func_oid,
 									&isvarlena);
+			cstate->binary_out[attnum - 1] = CopyGetBinaryOut(out_func_oid);
+		}
 		else
 			getTypeOutputInfo(attr->atttypid,
 							  &out_func_oid,
@@ -2062,11 +2289,50 @@ CopyTo(CopyState cstate)
 		CopySendEndOfRow(cstate);
 	}
 
+	/* Write out whatever rows are still buffered */
+	if (cstate->copy_dest == COPY_FILE)
+		CopyWriteFile(cstate);
+
 	MemoryContextDelete(cstate->rowcontext);
 
 	return processed;
 }
 
+/*
+ * Decide how binary COPY TO should send an attribute whose type's send
+ * function is send_func_oid.  Types with a send function of their own get
+ * it called; a domain has the same send function as its base type.
+ */
+static CopyBinaryOut
+CopyGetBinaryOut(Oid send_func_oid)
+{
+	switch (send_func_oid)
+	{
+		case F_BOOLSEND:
+			return COPY_BINARY_OUT_BOOL;
+		case F_CHARSEND:
+			return COPY_BINARY_OUT_CHAR;
+		case F_INT2SEND:
+			return COPY_BINARY_OUT_INT16;
+		case F_INT4SEND:
+		case F_OIDSEND:
+		case F_DATE_SEND:
+			return COPY_BINARY_OUT_INT32;
+		case F_INT8SEND:
+		case F_CASH_SEND:
+		case F_TIME_SEND:
+		case F_TIMESTAMP_SEND:
+		case F_TIMESTAMPTZ_SEND:
+			return COPY_BINARY_OUT_INT64;
+		case F_FLOAT4SEND:
+			return COPY_BINARY_OUT_FLOAT4;
+		case F_FLOAT8SEND:
+			return COPY_BINARY_OUT_FLOAT8;
+		default:
+			return COPY_BINARY_OUT_FUNCTION;
+	}
+}
+
 /*
  * Emit one row during CopyTo().
  */
@@ -2140,6 +2406,9 @@ CopyOneRowTo(CopyState cstate, Oid tupleOid, Datum *values, bool *nulls)
 				else
 					CopyAttributeOutText(cstate, string);
 			}
+			else if (cstate->binary_out[attnum - 1] != COPY_BINARY_OUT_FUNCTION)
+				CopySendBinaryFixed(cstate, cstate->binary_out[attnum - 1],
+									value);
 			else
 			{
 				bytea	   *outputbytes;
@@ -2284,19 +2553,15 @@ CopyFrom(CopyState cstate)
 	MemoryContext oldcontext = CurrentMemoryContext;
 
 	ErrorContextCallback errcallback;
-	CommandId	mycid = GetCurrentCommandId(true);
+	CommandId	mycid;
 	int			hi_options = 0; /* start with default heap_insert options */
 	BulkInsertState bistate;
 	uint64		processed = 0;
 	bool		useHeapMultiInsert;
-	int			nBufferedTuples = 0;
+	CopyMultiInsertBuffer *buffer = NULL;
+	TupleTableSlot *batchslot = NULL;
 	int			prev_leaf_part_index = -1;
 
-#define MAX_BUFFERED_TUPLES 1000
-	HeapTuple  *bufferedTuples = NULL;	/* initialize to silence warning */
-	Size		bufferedTuplesSize = 0;
-	int			firstBufferedLineNo = 0;
-
 	Assert(cstate->rel);
 
 	/*
@@ -2339,6 +2604,12 @@ CopyFrom(CopyState cstate)
 
 	tupDesc = RelationGetDescr(cstate->rel);
 
+	/*
+	 * A parallel COPY worker can't mark the command ID used, but the leader
+	 * has already done so before entering parallel mode.
+	 */
+	mycid = GetCurrentCommandId(!IsParallelWorker());
+
 	/*----------
 	 * Check to see if we can avoid writing WAL
 	 *
@@ -2496,13 +2767,17 @@ CopyFrom(CopyState cstate)
 	 * BEFORE/INSTEAD OF triggers, or we need to evaluate volatile default
 	 * expressions. Such triggers or expressions might query the table we're
 	 * inserting to, and act differently if the tuples that have already been
-	 * processed and prepared for insertion are not there.  We also can't do
-	 * it if the table is partitioned.
+	 * processed and prepared for insertion are not there.  For a partitioned
+	 * table, the same goes for the triggers of each partition, which are
+	 * checked as rows are routed to it.  We also can't do it when capturing
+	 * transition tuples from a partitioned table, since the capture state
+	 * has to be set up anew for each row.
 	 */
 	if ((resultRelInfo->ri_TrigDesc != NULL &&
 		 (resultRelInfo->ri_TrigDesc->trig_insert_before_row ||
 		  resultRelInfo->ri_TrigDesc->trig_insert_instead_row)) ||
-		cstate->partition_dispatch_info != NULL ||
+		(cstate->partition_dispatch_info != NULL &&
+		 cstate->transition_capture != NULL) ||
 		cstate->volatile_defexprs)
 	{
 		useHeapMultiInsert = false;
@@ -2510,7 +2785,13 @@ CopyFrom(CopyState cstate)
 	else
 	{
 		useHeapMultiInsert = true;
-		bufferedTuples = palloc(MAX_BUFFERED_TUPLES * sizeof(HeapTuple));
+		buffer = (CopyMultiInsertBuffer *) palloc(sizeof(CopyMultiInsertBuffer));
+		buffer->ntuples = 0;
+		buffer->nbytes = 0;
+		buffer->nrels = 0;
+		/* separate from myslot, which can hold a row not yet buffered */
+		batchslot = ExecInitExtraTupleSlot(estate);
+		ExecSetSlotDescriptor(batchslot, tupDesc);
 	}
 
 	/* Prepare to catch AFTER triggers. */
@@ -2544,7 +2825,7 @@ CopyFrom(CopyState cstate)
 
 		CHECK_FOR_INTERRUPTS();
 
-		if (nBufferedTuples == 0)
+		if (buffer == NULL || buffer->ntuples == 0)
 		{
 			/*
 			 * Reset the per-tuple exprcontext. We can only do this if the
@@ -2668,7 +2949,13 @@ CopyFrom(CopyState cstate)
 			{
 				Relation	partrel = resultRelInfo->ri_RelationDesc;
 
+				/*
+				 * Convert the tuple in the per-tuple context, like the one it
+				 * was formed from, so that it can be buffered too.
+				 */
+				MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
 				tuple = do_convert_tuple(tuple, map);
+				MemoryContextSwitchTo(oldcontext);
 
 				/*
 				 * We must use the partition's tuple descriptor from this
@@ -2678,10 +2965,24 @@ CopyFrom(CopyState cstate)
 				slot = cstate->partition_tuple_slot;
 				Assert(slot != NULL);
 				ExecSetSlotDescriptor(slot, RelationGetDescr(partrel));
-				ExecStoreTuple(tuple, slot, InvalidBuffer, true);
+				ExecStoreTuple(tuple, slot, InvalidBuffer, false);
 			}
 
 			tuple->t_tableOid = RelationGetRelid(resultRelInfo->ri_RelationDesc);
+
+			/*
+			 * Rows for a partition with BEFORE or INSTEAD OF row triggers are
+			 * inserted one at a time, and only once the rows buffered so far
+			 * have been inserted, as the triggers might look for them.
+			 */
+			if (useHeapMultiInsert && buffer->ntuples > 0 &&
+				resultRelInfo->ri_TrigDesc &&
+				(resultRelInfo->ri_TrigDesc->trig_insert_before_row ||
+				 resultRelInfo->ri_TrigDesc->trig_insert_instead_row))
+			{
+				CopyMultiInsertBufferFlush(cstate, estate, mycid, hi_options,
+										   batchslot, bistate, buffer);
+			}
 		}
 
 		skip_tuple = false;
@@ -2728,13 +3029,25 @@ CopyFrom(CopyState cstate)
 				if (cstate->rel->rd_att->constr || check_partition_constr)
 					ExecConstraints(resultRelInfo, slot, estate);
 
-				if (useHeapMultiInsert)
+				if (useHeapMultiInsert &&
+					!(resultRelInfo->ri_TrigDesc &&
+					  (resultRelInfo->ri_TrigDesc->trig_insert_before_row ||
+					   resultRelInfo->ri_TrigDesc->trig_insert_instead_row)))
 				{
-					/* Add this tuple to the tuple buffer */
-					if (nBufferedTuples == 0)
-						firstBufferedLineNo = cstate->cur_lineno;
-					bufferedTuples[nBufferedTuples++] = tuple;
-					bufferedTuplesSize += tuple->t_len;
+					/*
+					 * Add this tuple to the tuple buffer, first making room
+					 * for its partition if need be.
+					 */
+					if (!CopyMultiInsertBufferAdd(buffer, resultRelInfo, tuple,
+												  cstate->cur_lineno))
+					{
+						CopyMultiInsertBufferFlush(cstate, estate, mycid,
+												   hi_options, batchslot,
+												   bistate, buffer);
+						if (!CopyMultiInsertBufferAdd(buffer, resultRelInfo,
+													  tuple, cstate->cur_lineno))
+							elog(ERROR, "could not buffer tuple for multi-insert");
+					}
 
 					/*
 					 * If the buffer filled up, flush it.  Also flush if the
@@ -2742,15 +3055,12 @@ CopyFrom(CopyState cstate)
 					 * large, to avoid using large amounts of memory for the
 					 * buffer when the tuples are exceptionally wide.
 					 */
-					if (nBufferedTuples == MAX_BUFFERED_TUPLES ||
-						bufferedTuplesSize > 65535)
+					if (buffer->ntuples == MAX_BUFFERED_TUPLES ||
+						buffer->nbytes > MAX_BUFFERED_BYTES)
 					{
-						CopyFromInsertBatch(cstate, estate, mycid, hi_options,
-											resultRelInfo, myslot, bistate,
-											nBufferedTuples, bufferedTuples,
-											firstBufferedLineNo);
-						nBufferedTuples = 0;
-						bufferedTuplesSize = 0;
+						CopyMultiInsertBufferFlush(cstate, estate, mycid,
+												   hi_options, batchslot,
+												   bistate, buffer);
 					}
 				}
 				else
@@ -2793,11 +3103,9 @@ CopyFrom(CopyState cstate)
 	}
 
 	/* Flush any remaining buffered tuples */
-	if (nBufferedTuples > 0)
-		CopyFromInsertBatch(cstate, estate, mycid, hi_options,
-							resultRelInfo, myslot, bistate,
-							nBufferedTuples, bufferedTuples,
-							firstBufferedLineNo);
+	if (buffer != NULL && buffer->ntuples > 0)
+		CopyMultiInsertBufferFlush(cstate, estate, mycid, hi_options,
+								   batchslot, bistate, buffer);
 
 	/* Done, clean up */
 	error_context_stack = errcallback.previous;
@@ -2872,34 +3180,45 @@ CopyFrom(CopyState cstate)
 }
 
 /*
- * A subroutine of CopyFrom, to write the current batch of buffered heap
- * tuples to the heap. Also updates indexes and runs AFTER ROW INSERT
- * triggers.
+ * A subroutine of CopyFrom, to write a batch of buffered heap tuples to the
+ * heap of the relation described by resultRelInfo. Also updates indexes and
+ * runs AFTER ROW INSERT triggers.
  */
 static void
 CopyFromInsertBatch(CopyState cstate, EState *estate, CommandId mycid,
 					int hi_options, ResultRelInfo *resultRelInfo,
 					TupleTableSlot *myslot, BulkInsertState bistate,
 					int nBufferedTuples, HeapTuple *bufferedTuples,
-					int firstBufferedLineNo)
+					int *bufferedLineNos)
 {
 	MemoryContext oldcontext;
 	int			i;
 	int			save_cur_lineno;
+	bool		save_line_buf_valid;
+	ResultRelInfo *save_resultRelInfo;
 
 	/*
 	 * Print error context information correctly, if one of the operations
 	 * below fail.
 	 */
+	save_line_buf_valid = cstate->line_buf_valid;
 	cstate->line_buf_valid = false;
 	save_cur_lineno = cstate->cur_lineno;
 
+	/* For ExecInsertIndexTuples() to work on the relation's indexes */
+	save_resultRelInfo = estate->es_result_relation_info;
+	estate->es_result_relation_info = resultRelInfo;
+	if (myslot->tts_tupleDescriptor !=
+		RelationGetDescr(resultRelInfo->ri_RelationDesc))
+		ExecSetSlotDescriptor(myslot,
+							  RelationGetDescr(resultRelInfo->ri_RelationDesc));
+
 	/*
 	 * heap_multi_insert leaks memory, so switch to short-lived memory context
 	 * before calling it.
 	 */
 	oldcontext = MemoryContextSwitchTo(GetPerTupleMemoryContext(estate));
-	heap_multi_insert(cstate->rel,
+	heap_multi_insert(resultRelInfo->ri_RelationDesc,
 					  bufferedTuples,
 					  nBufferedTuples,
 					  mycid,
@@ -2917,7 +3236,7 @@ CopyFromInsertBatch(CopyState cstate, EState *estate, CommandId mycid,
 		{
 			List	   *recheckIndexes;
 
-			cstate->cur_lineno = firstBufferedLineNo + i;
+			cstate->cur_lineno = bufferedLineNos[i];
 			ExecStoreTuple(bufferedTuples[i], myslot, InvalidBuffer, false);
 			recheckIndexes =
 				ExecInsertIndexTuples(myslot, &(bufferedTuples[i]->t_self),
@@ -2939,15 +3258,586 @@ CopyFromInsertBatch(CopyState cstate, EState *estate, CommandId mycid,
 	{
 		for (i = 0; i < nBufferedTuples; i++)
 		{
-			cstate->cur_lineno = firstBufferedLineNo + i;
+			cstate->cur_lineno = bufferedLineNos[i];
 			ExecARInsertTriggers(estate, resultRelInfo,
 								 bufferedTuples[i],
 								 NIL, cstate->transition_capture);
 		}
 	}
 
-	/* reset cur_lineno to where we were */
+	/* reset cur_lineno and the rest to where we were */
 	cstate->cur_lineno = save_cur_lineno;
+	cstate->line_buf_valid = save_line_buf_valid;
+	estate->es_result_relation_info = save_resultRelInfo;
+}
+
+/*
+ * Add a tuple for the relation described by resultRelInfo to the
+ * multi-insert buffer.  Returns false, without adding it, if the buffer
+ * already holds tuples for as many other relations as it can; the caller
+ * must flush the buffer and try again.
+ */
+static bool
+CopyMultiInsertBufferAdd(CopyMultiInsertBuffer *buffer,
+						 ResultRelInfo *resultRelInfo, HeapTuple tuple,
+						 int lineno)
+{
+	int			relno;
+
+	Assert(buffer->ntuples < MAX_BUFFERED_TUPLES);
+
+	/* Usually the tuple is for the same relation as the last one */
+	if (buffer->ntuples > 0 &&
+		buffer->rels[buffer->relnos[buffer->ntuples - 1]] == resultRelInfo)
+		relno = buffer->relnos[buffer->ntuples - 1];
+	else
+	{
+		for (relno = 0; relno < buffer->nrels; relno++)
+		{
+			if (buffer->rels[relno] == resultRelInfo)
+				break;
+		}
+		if (relno == buffer->nrels)
+		{
+			if (buffer->nrels == MAX_BUFFERED_RELS)
+				return false;
+			buffer->rels[buffer->nrels++] = resultRelInfo;
+		}
+	}
+
+	buffer->tuples[buffer->ntuples] = tuple;
+	buffer->linenos[buffer->ntuples] = lineno;
+	buffer->relnos[buffer->ntuples] = relno;
+	buffer->ntuples++;
+	buffer->nbytes += tuple->t_len;
+
+	return true;
+}
+
+/*
+ * Insert all the tuples in the multi-insert buffer, one batch per relation,
+ * and empty it.
+ */
+static void
+CopyMultiInsertBufferFlush(CopyState cstate, EState *estate, CommandId mycid,
+						   int hi_options, TupleTableSlot *batchslot,
+						   BulkInsertState bistate,
+						   CopyMultiInsertBuffer *buffer)
+{
+	bool		partitioned = (cstate->partition_dispatch_info != NULL);
+	HeapTuple	tuples[MAX_BUFFERED_TUPLES];
+	int			linenos[MAX_BUFFERED_TUPLES];
+	int			relno;
+
+	for (relno = 0; relno < buffer->nrels; relno++)
+	{
+		HeapTuple  *reltuples;
+		int		   *rellinenos;
+		int			ntuples;
+
+		if (buffer->nrels == 1)
+		{
+			/* the common case: all the tuples are for the same relation */
+			reltuples = buffer->tuples;
+			rellinenos = buffer->linenos;
+			ntuples = buffer->ntuples;
+		}
+		else
+		{
+			int			i;
+
+			reltuples = tuples;
+			rellinenos = linenos;
+			ntuples = 0;
+			for (i = 0; i < buffer->ntuples; i++)
+			{
+				if (buffer->relnos[i] == relno)
+				{
+					tuples[ntuples] = buffer->tuples[i];
+					linenos[ntuples] = buffer->linenos[i];
+					ntuples++;
+				}
+			}
+		}
+
+		/*
+		 * The bulk insert state must not be left holding a buffer of another
+		 * partition, whether from another batch or from CopyFrom.
+		 */
+		if (partitioned)
+			ReleaseBulkInsertStatePin(bistate);
+		CopyFromInsertBatch(cstate, estate, mycid, hi_options,
+							buffer->rels[relno], batchslot, bistate,
+							ntuples, reltuples, rellinenos);
+	}
+	if (partitioned)
+		ReleaseBulkInsertStatePin(bistate);
+
+	buffer->ntuples = 0;
+	buffer->nbytes = 0;
+	buffer->nrels = 0;
+}
+
+/*
+ * Parallel COPY FROM
+ *
+ * With the PARALLEL option, the leader only reads the input and splits it
+ * into lines, using the same CopyReadLine code as a serial COPY, so that
+ * quoted newlines in CSV mode and the end-of-data marker are handled
+ * exactly as usual.  It passes the lines on, in chunks of about
+ * PARALLEL_COPY_CHUNK_SIZE bytes, to the workers round-robin, through one
+ * shm_mq per worker.  Each worker runs an ordinary CopyFrom, reading its
+ * chunks through a callback data source, so that parsing the fields,
+ * running the input functions, and inserting the tuples and their index
+ * entries all happen in the workers.
+ *
+ * Every line is sent in the file's encoding and terminated by a newline,
+ * and each chunk is prefixed with the number of its first line, so that
+ * the workers can report errors against the right input line.
+ *
+ * All the participants share the leader's transaction ID and command ID,
+ * so the tuples inserted by the workers look to everyone just like the
+ * ones a serial COPY would have inserted.  There is no ordering among the
+ * workers, though, so the rows end up in the table in no particular order.
+ */
+#define PARALLEL_KEY_COPY_SHARED		UINT64CONST(0xA000000000000001)
+#define PARALLEL_KEY_COPY_OPTIONS		UINT64CONST(0xA000000000000002)
+#define PARALLEL_KEY_COPY_QUEUES		UINT64CONST(0xA000000000000003)
+
+/* Chunks of input are sent once they reach this size */
+#define PARALLEL_COPY_CHUNK_SIZE		65536
+
+/* Size of the queue to each worker; room for a few chunks */
+#define PARALLEL_COPY_QUEUE_SIZE		(4 * PARALLEL_COPY_CHUNK_SIZE)
+
+/*
+ * Status for a parallel COPY FROM, in shared memory.
+ */
+typedef struct ParallelCopyShared
+{
+	Oid			relid;			/* target relation */
+
+	/* mutex protects the fields below */
+	slock_t		mutex;
+
+	uint64		processed;		/* # of tuples inserted by workers */
+} ParallelCopyShared;
+
+/*
+ * State of the data source callback in a parallel COPY worker.  The data
+ * source callback doesn't get any argument, so this has to be static.
+ */
+static struct
+{
+	CopyState	cstate;
+	shm_mq_handle *mqh;
+	char	   *data;			/* unread data of the current chunk */
+	Size		len;			/* # of unread bytes */
+} ParallelCopyInput;
+
+/*
+ * Can the COPY FROM described by cstate be done by parallel workers?
+ *
+ * Workers can only insert into a plain table with no triggers, and only if
+ * everything they need to run to do so is parallel safe.  Anything else
+ * makes us do the COPY serially, as if PARALLEL hadn't been given.
+ */
+static bool
+CopyFromParallelOK(CopyState cstate)
+{
+	Relation	rel = cstate->rel;
+	TupleDesc	tupDesc = RelationGetDescr(rel);
+	List	   *indexoidlist;
+	ListCell   *lc;
+	int			attnum;
+	bool		result = true;
+
+	if (rel->rd_rel->relkind != RELKIND_RELATION ||
+		RelationUsesLocalBuffers(rel) ||
+		rel->trigdesc != NULL)
+		return false;
+
+	/*
+	 * COPY FREEZE has requirements the workers can't check, and serializable
+	 * transactions can't use parallel mode at all.  With the old protocol
+	 * there's no way to find the end of the data before parsing it.
+	 */
+	if (cstate->freeze || IsolationIsSerializable() ||
+		cstate->copy_dest == COPY_OLD_FE)
+		return false;
+
+	/* The input functions, and the defaults for columns not copied */
+	for (attnum = 1; attnum <= tupDesc->natts; attnum++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupDesc, attnum - 1);
+		Oid			in_func_oid;
+		Oid			typioparam;
+
+		if (att->attisdropped)
+			continue;
+
+		getTypeInputInfo(att->atttypid, &in_func_oid, &typioparam);
+		if (func_parallel(in_func_oid) != PROPARALLEL_SAFE)
+			return false;
+		if (get_typtype(att->atttypid) == TYPTYPE_DOMAIN &&
+			DomainHasConstraints(att->atttypid))
+			return false;
+
+		if (!list_member_int(cstate->attnumlist, attnum))
+		{
+			Node	   *defexpr = build_column_default(rel, attnum);
+
+			if (defexpr != NULL && !is_parallel_safe_expr(defexpr))
+				return false;
+		}
+	}
+
+	/* CHECK constraints */
+	if (tupDesc->constr != NULL)
+	{
+		int			i;
+
+		for (i = 0; i < tupDesc->constr->num_check; i++)
+		{
+			Node	   *checkexpr;
+
+			checkexpr = stringToNode(tupDesc->constr->check[i].ccbin);
+			if (!is_parallel_safe_expr(checkexpr))
+				return false;
+		}
+	}
+
+	/* Index expressions and predicates */
+	indexoidlist = RelationGetIndexList(rel);
+	foreach(lc, indexoidlist)
+	{
+		Relation	indexRel;
+
+		indexRel = index_open(lfirst_oid(lc), RowExclusiveLock);
+		if (!is_parallel_safe_expr((Node *) RelationGetIndexExpressions(indexRel)) ||
+			!is_parallel_safe_expr((Node *) RelationGetIndexPredicate(indexRel)))
+			result = false;
+		index_close(indexRel, RowExclusiveLock);
+
+		if (!result)
+			break;
+	}
+	list_free(indexoidlist);
+
+	return result;
+}
+
+/*
+ * Do a COPY FROM using parallel workers.
+ *
+ * cstate has been set up by BeginCopyFrom with the COPY's attnamelist and
+ * options, which are passed on to the workers.  Returns the number of rows
+ * inserted.
+ */
+static uint64
+ParallelCopyFrom(CopyState cstate, List *attnamelist, List *options)
+{
+	ParallelContext *pcxt;
+	ParallelCopyShared *pcshared;
+	List	   *workeroptions = NIL;
+	char	   *encoding;
+	char	   *serialized;
+	Size		serializedlen;
+	char	   *sharedoptions;
+	char	   *queuespace;
+	shm_mq_handle **queues;
+	int			nworkers;
+	int			nextworker = 0;
+	StringInfoData chunk;
+	ErrorContextCallback errcallback;
+	bool		done = false;
+	uint64		processed;
+	ListCell   *lc;
+	int			i;
+
+	/*
+	 * The workers can't assign a transaction ID, or mark the command ID as
+	 * used, so do both here before entering parallel mode.
+	 */
+	(void) GetCurrentTransactionId();
+	(void) GetCurrentCommandId(true);
+
+	/*
+	 * The workers get the lines without the header, and in the file's
+	 * encoding, which BeginCopyFrom has already worked out.
+	 */
+	foreach(lc, options)
+	{
+		DefElem    *defel = lfirst_node(DefElem, lc);
+
+		if (strcmp(defel->defname, "header") == 0 ||
+			strcmp(defel->defname, "parallel") == 0 ||
+			strcmp(defel->defname, "encoding") == 0)
+			continue;
+		workeroptions = lappend(workeroptions, defel);
+	}
+	encoding = pstrdup(pg_encoding_to_char(cstate->file_encoding));
+	workeroptions = lappend(workeroptions,
+							makeDefElem("encoding",
+										(Node *) makeString(encoding), -1));
+	serialized = nodeToString(list_make2(attnamelist, workeroptions));
+	serializedlen = strlen(serialized) + 1;
+
+	EnterParallelMode();
+	pcxt = CreateParallelContext("postgres", "ParallelCopyMain",
+								 cstate->parallel_workers);
+
+	shm_toc_estimate_chunk(&pcxt->estimator, sizeof(ParallelCopyShared));
+	shm_toc_estimate_chunk(&pcxt->estimator, serializedlen);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(PARALLEL_COPY_QUEUE_SIZE,
+									cstate->parallel_workers));
+	shm_toc_estimate_keys(&pcxt->estimator, 3);
+
+	InitializeParallelDSM(pcxt);
+
+	pcshared = (ParallelCopyShared *)
+		shm_toc_allocate(pcxt->toc, sizeof(ParallelCopyShared));
+	pcshared->relid = RelationGetRelid(cstate->rel);
+	SpinLockInit(&pcshared->mutex);
+	pcshared->processed = 0;
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_COPY_SHARED, pcshared);
+
+	sharedoptions = shm_toc_allocate(pcxt->toc, serializedlen);
+	memcpy(sharedoptions, serialized, serializedlen);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_COPY_OPTIONS, sharedoptions);
+
+	/* Create a queue for each worker, with ourselves as the sender */
+	queuespace = shm_toc_allocate(pcxt->toc,
+								  mul_size(PARALLEL_COPY_QUEUE_SIZE,
+										   cstate->parallel_workers));
+	for (i = 0; i < cstate->parallel_workers; i++)
+	{
+		shm_mq	   *mq;
+
+		mq = shm_mq_create(queuespace + ((Size) i) * PARALLEL_COPY_QUEUE_SIZE,
+						   (Size) PARALLEL_COPY_QUEUE_SIZE);
+		shm_mq_set_sender(mq, MyProc);
+	}
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_COPY_QUEUES, queuespace);
+
+	LaunchParallelWorkers(pcxt);
+
+	/* If no workers were successfully launched, back out (do serial copy) */
+	if (pcxt->nworkers_launched == 0)
+	{
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return CopyFrom(cstate);
+	}
+
+	nworkers = pcxt->nworkers_launched;
+	queues = (shm_mq_handle **) palloc(nworkers * sizeof(shm_mq_handle *));
+	for (i = 0; i < nworkers; i++)
+	{
+		shm_mq	   *mq;
+
+		mq = (shm_mq *) (queuespace + ((Size) i) * PARALLEL_COPY_QUEUE_SIZE);
+		queues[i] = shm_mq_attach(mq, pcxt->seg, pcxt->worker[i].bgwhandle);
+	}
+
+	/*
+	 * Errors found while splitting the input are reported as usual.  (The
+	 * workers' errors are reported with the context stack of the time the
+	 * parallel context was created, so they don't get this too.)
+	 */
+	errcallback.callback = CopyFromErrorCallback;
+	errcallback.arg = (void *) cstate;
+	errcallback.previous = error_context_stack;
+	error_context_stack = &errcallback;
+
+	cstate->parallel_leader = true;
+
+	/* On input just throw the header line away. */
+	if (cstate->header_line)
+	{
+		cstate->cur_lineno++;
+		done = CopyReadLine(cstate);
+	}
+
+	initStringInfo(&chunk);
+	while (!done)
+	{
+		CHECK_FOR_INTERRUPTS();
+
+		/* Start a new chunk with the number of its first line */
+		if (chunk.len == 0)
+		{
+			int			firstlineno = cstate->cur_lineno + 1;
+
+			appendBinaryStringInfo(&chunk, (char *) &firstlineno,
+								   sizeof(firstlineno));
+		}
+
+		cstate->cur_lineno++;
+		done = CopyReadLine(cstate);
+
+		/* The last line may be missing its newline, or be just the EOF */
+		if (!done || cstate->line_buf.len > 0)
+		{
+			appendBinaryStringInfo(&chunk, cstate->line_buf.data,
+								   cstate->line_buf.len);
+			appendStringInfoChar(&chunk, '\n');
+		}
+
+		if (done || chunk.len >= PARALLEL_COPY_CHUNK_SIZE)
+		{
+			if (chunk.len > sizeof(int))
+			{
+				shm_mq_result res;
+
+				res = shm_mq_send(queues[nextworker], chunk.len, chunk.data,
+								  false);
+				if (res != SHM_MQ_SUCCESS)
+				{
+					/*
+					 * The worker has gone away, presumably because of an
+					 * error.  Wait for them all, which rethrows it.
+					 */
+					for (i = 0; i < nworkers; i++)
+						shm_mq_detach(queues[i]);
+					WaitForParallelWorkersToFinish(pcxt);
+					elog(ERROR, "parallel COPY worker exited unexpectedly");
+				}
+				nextworker = (nextworker + 1) % nworkers;
+			}
+			resetStringInfo(&chunk);
+		}
+	}
+
+	cstate->parallel_leader = false;
+	error_context_stack = errcallback.previous;
+
+	/* Tell the workers there's no more input, and wait for them to finish */
+	for (i = 0; i < nworkers; i++)
+		shm_mq_detach(queues[i]);
+	WaitForParallelWorkersToFinish(pcxt);
+
+	processed = pcshared->processed;
+
+	DestroyParallelContext(pcxt);
+	ExitParallelMode();
+
+	pfree(chunk.data);
+	pfree(queues);
+
+	return processed;
+}
+
+/*
+ * Data source callback for a parallel COPY worker: return the next part of
+ * the current chunk, reading a new chunk from the queue when the current
+ * one is exhausted.  Returns 0 once the leader has detached from the queue,
+ * which means there's no more input.
+ */
+static int
+parallel_copy_read_chunk(void *outbuf, int minread, int maxread)
+{
+	int			bytesread;
+
+	if (ParallelCopyInput.len == 0)
+	{
+		shm_mq_result res;
+		Size		nbytes;
+		void	   *data;
+		int			firstlineno;
+
+		res = shm_mq_receive(ParallelCopyInput.mqh, &nbytes, &data, false);
+		if (res == SHM_MQ_DETACHED)
+			return 0;
+		if (res != SHM_MQ_SUCCESS || nbytes <= sizeof(int))
+			elog(ERROR, "unexpected result from parallel COPY queue");
+
+		/*
+		 * A chunk always starts at the beginning of a line, whose number the
+		 * caller has just advanced cur_lineno to count.
+		 */
+		memcpy(&firstlineno, data, sizeof(int));
+		ParallelCopyInput.cstate->cur_lineno = firstlineno;
+		ParallelCopyInput.data = (char *) data + sizeof(int);
+		ParallelCopyInput.len = nbytes - sizeof(int);
+	}
+
+	bytesread = Min(ParallelCopyInput.len, maxread);
+	memcpy(outbuf, ParallelCopyInput.data, bytesread);
+	ParallelCopyInput.data += bytesread;
+	ParallelCopyInput.len -= bytesread;
+
+	return bytesread;
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+ParallelCopyMain(dsm_segment *seg, shm_toc *toc)
+{
+	ParallelCopyShared *pcshared;
+	List	   *copyargs;
+	List	   *attnamelist;
+	List	   *options;
+	Relation	rel;
+	ParseState *pstate;
+	RangeTblEntry *rte;
+	ListCell   *cur;
+	char	   *queuespace;
+	shm_mq	   *mq;
+	CopyState	cstate;
+	uint64		processed;
+
+	pcshared = shm_toc_lookup(toc, PARALLEL_KEY_COPY_SHARED, false);
+	copyargs = (List *) stringToNode(shm_toc_lookup(toc,
+													PARALLEL_KEY_COPY_OPTIONS,
+													false));
+	attnamelist = (List *) linitial(copyargs);
+	options = (List *) lsecond(copyargs);
+
+	ParallelWorkerMayInsert = true;
+
+	/* Open the relation using the lock mode DoCopy obtained */
+	rel = heap_open(pcshared->relid, RowExclusiveLock);
+
+	/* Set up the range table entry ExecConstraints needs, as DoCopy does */
+	pstate = make_parsestate(NULL);
+	rte = addRangeTableEntryForRelation(pstate, rel, NULL, false, false);
+	rte->requiredPerms = ACL_INSERT;
+	foreach(cur, CopyGetAttnums(RelationGetDescr(rel), rel, attnamelist))
+	{
+		int			attno = lfirst_int(cur) -
+		FirstLowInvalidHeapAttributeNumber;
+
+		rte->insertedCols = bms_add_member(rte->insertedCols, attno);
+	}
+
+	/* Attach to our queue from the leader */
+	queuespace = shm_toc_lookup(toc, PARALLEL_KEY_COPY_QUEUES, false);
+	mq = (shm_mq *) (queuespace +
+					 ((Size) ParallelWorkerNumber) * PARALLEL_COPY_QUEUE_SIZE);
+	shm_mq_set_receiver(mq, MyProc);
+
+	cstate = BeginCopyFrom(pstate, rel, NULL, false,
+						   parallel_copy_read_chunk, attnamelist, options);
+
+	ParallelCopyInput.cstate = cstate;
+	ParallelCopyInput.mqh = shm_mq_attach(mq, seg, NULL);
+	ParallelCopyInput.data = NULL;
+	ParallelCopyInput.len = 0;
+
+	processed = CopyFrom(cstate);
+	EndCopyFrom(cstate);
+
+	shm_mq_detach(ParallelCopyInput.mqh);
+
+	SpinLockAcquire(&pcshared->mutex);
+	pcshared->processed += processed;
+	SpinLockRelease(&pcshared->mutex);
+
+	heap_close(rel, RowExclusiveLock);
 }
 
 /*
@@ -3001,6 +3891,27 @@ BeginCopyFrom(ParseState *pstate,
 	cstate->raw_buf = (char *) palloc(RAW_BUF_SIZE + 1);
 	cstate->raw_buf_index = cstate->raw_buf_len = 0;
 
+	if (cstate->csv_mode)
+	{
+		char		line_chars[] = {'\n', '\r', cstate->quote[0],
+									cstate->escape[0]};
+		char		attr_chars[] = {cstate->delim[0], cstate->quote[0]};
+		char		quoted_chars[] = {cstate->quote[0], cstate->escape[0]};
+
+		byte_scan_init(&cstate->line_scan, line_chars, lengthof(line_chars));
+		byte_scan_init(&cstate->attr_scan, attr_chars, lengthof(attr_chars));
+		byte_scan_init(&cstate->quoted_scan, quoted_chars,
+					   lengthof(quoted_chars));
+	}
+	else if (!cstate->binary)
+	{
+		char		line_chars[] = {'\n', '\r', '\\'};
+		char		attr_chars[] = {cstate->delim[0], '\\'};
+
+		byte_scan_init(&cstate->line_scan, line_chars, lengthof(line_chars));
+		byte_scan_init(&cstate->attr_scan, attr_chars, lengthof(attr_chars));
+	}
+
 	/* Assign range table, we'll need it in CopyFrom. */
 	if (pstate)
 		cstate->range_table = pstate->p_rtable;
@@ -3591,6 +4502,13 @@ CopyReadLine(CopyState cstate)
 		}
 	}
 
+	/*
+	 * In the leader of a parallel COPY, the line is only passed on to a
+	 * worker, which does the conversion.
+	 */
+	if (cstate->parallel_leader)
+		return result;
+
 	/* Done reading the line.  Convert it to server encoding. */
 	if (cstate->need_transcoding)
 	{
@@ -3711,6 +4629,31 @@ CopyReadLineText(CopyState cstate)
 			need_data = false;
 		}
 
+		/*
+		 * Skip over any run of characters that need no processing here, many
+		 * at a time.  In CSV mode a backslash is special at the start of a
+		 * line, so that character has to be looked at the slow way.  So does
+		 * everything in encodings that can embed ASCII bytes in multibyte
+		 * characters.
+		 */
+		if (!cstate->encoding_embeds_ascii &&
+			(!cstate->csv_mode || !first_char_in_line))
+		{
+			int			nskip;
+
+			nskip = byte_scan_find(&cstate->line_scan,
+								   copy_raw_buf + raw_buf_ptr,
+								   copy_buf_len - raw_buf_ptr);
+			if (nskip > 0)
+			{
+				raw_buf_ptr += nskip;
+				first_char_in_line = false;
+				last_was_esc = false;
+				if (raw_buf_ptr >= copy_buf_len)
+					continue;
+			}
+		}
+
 		/* OK to fetch a character */
 		prev_raw_ptr = raw_buf_ptr;
 		c = copy_raw_buf[raw_buf_ptr++];
@@ -4079,6 +5022,14 @@ CopyReadAttributesText(CopyState cstate)
 		for (;;)
 		{
 			char		c;
+			int			nplain;
+
+			/* Copy any run of characters that aren't special in one go */
+			nplain = byte_scan_find(&cstate->attr_scan, cur_ptr,
+									line_end_ptr - cur_ptr);
+			memcpy(output_ptr, cur_ptr, nplain);
+			output_ptr += nplain;
+			cur_ptr += nplain;
 
 			end_ptr = cur_ptr;
 			if (cur_ptr >= line_end_ptr)
@@ -4305,10 +5256,18 @@ CopyReadAttributesCSV(CopyState cstate)
 		for (;;)
 		{
 			char		c;
+			int			nplain;
 
 			/* Not in quote */
 			for (;;)
 			{
+				/* Copy any run of characters that aren't special in one go */
+				nplain = byte_scan_find(&cstate->attr_scan, cur_ptr,
+										line_end_ptr - cur_ptr);
+				memcpy(output_ptr, cur_ptr, nplain);
+				output_ptr += nplain;
+				cur_ptr += nplain;
+
 				end_ptr = cur_ptr;
 				if (cur_ptr >= line_end_ptr)
 					goto endfield;
@@ -4332,6 +5291,12 @@ CopyReadAttributesCSV(CopyState cstate)
 			/* In quote */
 			for (;;)
 			{
+				nplain = byte_scan_find(&cstate->quoted_scan, cur_ptr,
+										line_end_ptr - cur_ptr);
+				memcpy(output_ptr, cur_ptr, nplain);
+				output_ptr += nplain;
+				cur_ptr += nplain;
+
 				end_ptr = cur_ptr;
 				if (cur_ptr >= line_end_ptr)
 					ereport(ERROR,
@@ -1382,6 +1382,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (((IndexScan *) plan)->indexqualorig)
 				show_instrumentation_count("Rows Removed by Index Recheck", 2,
 										   planstate, es);
+			if (((IndexScan *) plan)->indexskipprefix > 0)
+				ExplainPropertyInteger("Skip Prefix",
+									   ((IndexScan *) plan)->indexskipprefix, es);
 			show_scan_qual(((IndexScan *) plan)->indexorderbyorig,
 						   "Order By", planstate, ancestors, es);
 			show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
@@ -1395,6 +1398,9 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			if (((IndexOnlyScan *) plan)->indexqual)
 				show_instrumentation_count("Rows Removed by Index Recheck", 2,
 										   planstate, es);
+			if (((IndexOnlyScan *) plan)->indexskipprefix > 0)
+				ExplainPropertyInteger("Skip Prefix",
+									   ((IndexOnlyScan *) plan)->indexskipprefix, es);
 			show_scan_qual(((IndexOnlyScan *) plan)->indexorderby,
 						   "Order By", planstate, ancestors, es);
 			show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
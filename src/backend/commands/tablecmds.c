@@ -21,6 +21,7 @@
 #include "access/relscan.h"
 #include "access/sysattr.h"
 #include "access/tupconvert.h"
+#include "access/tuptoaster.h"
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "catalog/catalog.h"
@@ -385,6 +386,8 @@ static ObjectAddress ATExecSetOptions(Relation rel, const char *colName,
 				 Node *options, bool isReset, LOCKMODE lockmode);
 static ObjectAddress ATExecSetStorage(Relation rel, const char *colName,
 				 Node *newValue, LOCKMODE lockmode);
+static ObjectAddress ATExecSetCompression(Relation rel, const char *colName,
+					 Node *newValue, LOCKMODE lockmode);
 static void ATPrepDropColumn(List **wqueue, Relation rel, bool recurse, bool recursing,
 				 AlterTableCmd *cmd, LOCKMODE lockmode);
 static ObjectAddress ATExecDropColumn(List **wqueue, Relation rel, const char *colName,
@@ -462,6 +465,8 @@ static void ATExecForceNoForceRowSecurity(Relation rel, bool force_rls);
 static void copy_relation_data(SMgrRelation rel, SMgrRelation dst,
 				   ForkNumber forkNum, char relpersistence);
 static const char *storage_name(char c);
+static char GetAttributeCompression(Form_pg_attribute att,
+						const char *compression);
 
 static void RangeVarCallbackForDropRelation(const RangeVar *rel, Oid relOid,
 								Oid oldRelOid, void *arg);
@@ -691,6 +696,10 @@ DefineRelation(CreateStmt *stmt, char relkind, Oid ownerId,
 		attnum++;
 		attr = TupleDescAttr(descriptor, attnum - 1);
 
+		if (colDef->compression != NULL)
+			attr->attcompression = GetAttributeCompression(attr,
+														   colDef->compression);
+
 		if (colDef->raw_default != NULL)
 		{
 			RawColumnDefault *rawEnt;
@@ -1609,6 +1618,35 @@ storage_name(char c)
 	}
 }
 
+/*
+ * GetAttributeCompression
+ *	  returns the attcompression value for a compression method named in
+ *	  CREATE TABLE or ALTER TABLE, checking that the column can use it
+ */
+static char
+GetAttributeCompression(Form_pg_attribute att, const char *compression)
+{
+	char		cmethod;
+
+	/* "default" means to follow default_toast_compression */
+	if (pg_strcasecmp(compression, "default") == 0)
+		return InvalidCompressionMethod;
+
+	if (!TypeIsToastable(att->atttypid))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("column data type %s does not support compression",
+						format_type_be(att->atttypid))));
+
+	cmethod = CompressionNameToMethod(compression);
+	if (!CompressionMethodIsValid(cmethod))
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("invalid compression method \"%s\"", compression)));
+
+	return cmethod;
+}
+
 /*----------
  * MergeAttributes
  *		Returns new schema given initial schema and superclasses.
@@ -1943,6 +1981,23 @@ MergeAttributes(List *schema, List *supers, char relpersistence,
 									   storage_name(def->storage),
 									   storage_name(attribute->attstorage))));
 
+				/* Copy compression method */
+				if (CompressionMethodIsValid(attribute->attcompression))
+				{
+					const char *compression =
+					GetCompressionMethodName(attribute->attcompression);
+
+					if (def->compression == NULL)
+						def->compression = pstrdup(compression);
+					else if (strcmp(def->compression, compression) != 0)
+						ereport(ERROR,
+								(errcode(ERRCODE_DATATYPE_MISMATCH),
+								 errmsg("inherited column \"%s\" has a compression method conflict",
+										attributeName),
+								 errdetail("%s versus %s",
+										   def->compression, compression)));
+				}
+
 				def->inhcount++;
 				/* Merge of NOT NULL constraints = OR 'em together */
 				def->is_not_null |= attribute->attnotnull;
@@ -1964,6 +2019,9 @@ MergeAttributes(List *schema, List *supers, char relpersistence,
 				def->is_from_type = false;
 				def->is_from_parent = true;
 				def->storage = attribute->attstorage;
+				if (CompressionMethodIsValid(attribute->attcompression))
+					def->compression =
+						pstrdup(GetCompressionMethodName(attribute->attcompression));
 				def->raw_default = NULL;
 				def->cooked_default = NULL;
 				def->collClause = NULL;
@@ -2179,6 +2237,18 @@ MergeAttributes(List *schema, List *supers, char relpersistence,
 									   storage_name(def->storage),
 									   storage_name(newdef->storage))));
 
+				/* Copy compression method */
+				if (def->compression == NULL)
+					def->compression = newdef->compression;
+				else if (newdef->compression != NULL &&
+						 strcmp(def->compression, newdef->compression) != 0)
+					ereport(ERROR,
+							(errcode(ERRCODE_DATATYPE_MISMATCH),
+							 errmsg("column \"%s\" has a compression method conflict",
+									attributeName),
+							 errdetail("%s versus %s",
+									   def->compression, newdef->compression)));
+
 				/* Mark the column as locally defined */
 				def->is_local = true;
 				/* Merge of NOT NULL constraints = OR 'em together */
@@ -3244,6 +3314,14 @@ AlterTableGetLockLevel(List *cmds)
 				cmd_lockmode = AccessExclusiveLock;
 				break;
 
+				/*
+				 * Changing the compression method changes the tuple
+				 * descriptor; keep everyone else out while we do it.
+				 */
+			case AT_SetCompression:
+				cmd_lockmode = AccessExclusiveLock;
+				break;
+
 				/*
 				 * Removing constraints can affect SELECTs that have been
 				 * optimised assuming the constraint holds true.
@@ -3584,6 +3662,12 @@ ATPrepCmd(List **wqueue, Relation rel, AlterTableCmd *cmd,
 			/* No command-specific prep needed */
 			pass = AT_PASS_MISC;
 			break;
+		case AT_SetCompression: /* ALTER COLUMN SET COMPRESSION */
+			ATSimplePermissions(rel, ATT_TABLE | ATT_MATVIEW);
+			ATSimpleRecursion(wqueue, rel, cmd, recurse, lockmode);
+			/* No command-specific prep needed */
+			pass = AT_PASS_MISC;
+			break;
 		case AT_DropColumn:		/* DROP COLUMN */
 			ATSimplePermissions(rel,
 								ATT_TABLE | ATT_COMPOSITE_TYPE | ATT_FOREIGN_TABLE);
@@ -3903,6 +3987,9 @@ ATExecCmd(List **wqueue, AlteredTableInfo *tab, Relation rel,
 		case AT_SetStorage:		/* ALTER COLUMN SET STORAGE */
 			address = ATExecSetStorage(rel, cmd->name, cmd->def, lockmode);
 			break;
+		case AT_SetCompression: /* ALTER COLUMN SET COMPRESSION */
+			address = ATExecSetCompression(rel, cmd->name, cmd->def, lockmode);
+			break;
 		case AT_DropColumn:		/* DROP COLUMN */
 			address = ATExecDropColumn(wqueue, rel, cmd->name,
 									   cmd->behavior, false, false,
@@ -5317,6 +5404,7 @@ ATExecAddColumn(List **wqueue, AlteredTableInfo *tab, Relation rel,
 	attribute.attbyval = tform->typbyval;
 	attribute.attndims = list_length(colDef->typeName->arrayBounds);
 	attribute.attstorage = tform->typstorage;
+	attribute.attcompression = InvalidCompressionMethod;
 	attribute.attalign = tform->typalign;
 	attribute.attnotnull = colDef->is_not_null;
 	attribute.atthasdef = false;
@@ -5325,6 +5413,9 @@ ATExecAddColumn(List **wqueue, AlteredTableInfo *tab, Relation rel,
 	attribute.attislocal = colDef->is_local;
 	attribute.attinhcount = colDef->inhcount;
 	attribute.attcollation = collOid;
+	if (colDef->compression != NULL)
+		attribute.attcompression = GetAttributeCompression(&attribute,
+														   colDef->compression);
 	/* attribute.attacl is handled by InsertPgAttributeTuple */
 
 	ReleaseSysCache(typeTuple);
@@ -6452,6 +6543,106 @@ ATExecSetStorage(Relation rel, const char *colName, Node *newValue, LOCKMODE loc
 	return address;
 }
 
+/*
+ * ALTER TABLE ALTER COLUMN SET COMPRESSION
+ *
+ * Only values compressed from now on use the new method; existing ones keep
+ * the method they were compressed with, which is recorded in each datum.
+ * Indexes on the column follow the table, as they do at index creation.
+ *
+ * Return value is the address of the modified column
+ */
+static ObjectAddress
+ATExecSetCompression(Relation rel, const char *colName, Node *newValue,
+					 LOCKMODE lockmode)
+{
+	Relation	attrelation;
+	HeapTuple	tuple;
+	Form_pg_attribute attrtuple;
+	AttrNumber	attnum;
+	char		cmethod;
+	List	   *indexoidlist;
+	ListCell   *lc;
+	ObjectAddress address;
+
+	Assert(IsA(newValue, String));
+
+	attrelation = heap_open(AttributeRelationId, RowExclusiveLock);
+
+	tuple = SearchSysCacheCopyAttName(RelationGetRelid(rel), colName);
+
+	if (!HeapTupleIsValid(tuple))
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_COLUMN),
+				 errmsg("column \"%s\" of relation \"%s\" does not exist",
+						colName, RelationGetRelationName(rel))));
+	attrtuple = (Form_pg_attribute) GETSTRUCT(tuple);
+
+	attnum = attrtuple->attnum;
+	if (attnum <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("cannot alter system column \"%s\"",
+						colName)));
+
+	cmethod = GetAttributeCompression(attrtuple, strVal(newValue));
+	attrtuple->attcompression = cmethod;
+
+	CatalogTupleUpdate(attrelation, &tuple->t_self, tuple);
+
+	InvokeObjectPostAlterHook(RelationRelationId,
+							  RelationGetRelid(rel),
+							  attnum);
+
+	heap_freetuple(tuple);
+
+	/* Apply the change to simple index columns on this column as well */
+	indexoidlist = RelationGetIndexList(rel);
+	foreach(lc, indexoidlist)
+	{
+		Oid			indexoid = lfirst_oid(lc);
+		HeapTuple	indexTuple;
+		Form_pg_index indexForm;
+		int			i;
+
+		indexTuple = SearchSysCache1(INDEXRELID, ObjectIdGetDatum(indexoid));
+		if (!HeapTupleIsValid(indexTuple))
+			elog(ERROR, "cache lookup failed for index %u", indexoid);
+		indexForm = (Form_pg_index) GETSTRUCT(indexTuple);
+
+		for (i = 0; i < indexForm->indnatts; i++)
+		{
+			if (indexForm->indkey.values[i] != attnum)
+				continue;
+
+			tuple = SearchSysCacheCopy2(ATTNUM,
+										ObjectIdGetDatum(indexoid),
+										Int16GetDatum(i + 1));
+			if (!HeapTupleIsValid(tuple))
+				elog(ERROR, "cache lookup failed for attribute %d of relation %u",
+					 i + 1, indexoid);
+			attrtuple = (Form_pg_attribute) GETSTRUCT(tuple);
+
+			/* the index may store a different, uncompressible type */
+			if (attrtuple->attstorage != 'p')
+			{
+				attrtuple->attcompression = cmethod;
+				CatalogTupleUpdate(attrelation, &tuple->t_self, tuple);
+			}
+			heap_freetuple(tuple);
+		}
+
+		ReleaseSysCache(indexTuple);
+	}
+	list_free(indexoidlist);
+
+	heap_close(attrelation, RowExclusiveLock);
+
+	ObjectAddressSubSet(address, RelationRelationId,
+						RelationGetRelid(rel), attnum);
+	return address;
+}
+
 
 /*
  * ALTER TABLE DROP COLUMN
@@ -9416,6 +9607,9 @@ ATExecAlterColumnType(AlteredTableInfo *tab, Relation rel,
 	attTup->attbyval = tform->typbyval;
 	attTup->attalign = tform->typalign;
 	attTup->attstorage = tform->typstorage;
+	/* a compression method makes no sense for a plain-storage type */
+	if (tform->typstorage == 'p')
+		attTup->attcompression = InvalidCompressionMethod;
 
 	ReleaseSysCache(typeTuple);
 
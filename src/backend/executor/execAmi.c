@@ -413,6 +413,13 @@ ExecSupportsMarkRestore(Path *pathnode)
 	{
 		case T_IndexScan:
 		case T_IndexOnlyScan:
+
+			/*
+			 * Skip scans can't restore the prefix they were working on, so
+			 * don't allow them.
+			 */
+			return castNode(IndexPath, pathnode)->indexskipprefix == 0;
+
 		case T_Material:
 		case T_Sort:
 			return true;
@@ -0,0 +1,428 @@
+/*-------------------------------------------------------------------------
+ *
+ * execBatch.c
+ *	  Support for batch-at-a-time execution of scans, quals and aggregates.
+ *
+ * Normally the executor processes one tuple at a time: each ExecProcNode
+ * call returns one slot, and quals and aggregate transition functions are
+ * evaluated once per row through the expression interpreter and fmgr.  For
+ * the simplest and most common shape of reporting query, an ungrouped
+ * aggregate over a sequential scan with simple filter conditions, that
+ * per-row overhead dominates the actual work.
+ *
+ * In batch mode, the scan instead fills a TupleBatch with the columns the
+ * consumer needs for up to BATCH_SIZE rows, and evaluates quals of the form
+ * "integer column <op> constant" over the whole batch in tight loops,
+ * producing a selection vector of the rows that pass.  The consumer then
+ * processes the selected rows of each column in another tight loop.
+ *
+ * Currently only nodeAgg uses this, for plain aggregation of count(), and
+ * of sum(), min() and max() over integer and date columns; see
+ * ExecInitAggBatch.  Anything a batch can't handle makes the plan run in
+ * the ordinary way.
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/executor/execBatch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "catalog/pg_type.h"
+#include "executor/execBatch.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/fmgroids.h"
+
+/* GUC variable */
+bool		enable_batch_execution = true;
+
+static bool batch_cmp_for_func(Oid funcid, BatchCmp *cmp);
+
+
+/*
+ * ExecBatchSupportsType
+ *		Can values of the given type be processed as integers in a batch?
+ */
+bool
+ExecBatchSupportsType(Oid typid, BatchType *type)
+{
+	switch (typid)
+	{
+		case INT2OID:
+			*type = BATCH_INT2;
+			return true;
+		case INT4OID:
+		case DATEOID:
+			*type = BATCH_INT4;
+			return true;
+		case INT8OID:
+			/* batch columns must be pass-by-value */
+			*type = BATCH_INT8;
+			return FLOAT8PASSBYVAL;
+		default:
+			return false;
+	}
+}
+
+/*
+ * ExecBatchCreate
+ *		Create an empty batch descriptor, with no columns or quals.
+ *
+ * Columns and quals are added with ExecBatchAddColumn and ExecBatchAddQual,
+ * then the arrays holding the rows are allocated by ExecBatchAllocate.
+ */
+TupleBatch *
+ExecBatchCreate(void)
+{
+	return (TupleBatch *) palloc0(sizeof(TupleBatch));
+}
+
+/*
+ * ExecBatchAddColumn
+ *		Make sure the given scan attribute is loaded into the batch, and
+ *		return its column index.
+ */
+int
+ExecBatchAddColumn(TupleBatch *batch, AttrNumber attnum, BatchType type)
+{
+	int			col;
+
+	Assert(attnum > 0);
+	Assert(batch->values == NULL);
+
+	for (col = 0; col < batch->ncols; col++)
+	{
+		if (batch->attnums[col] == attnum)
+		{
+			/* a typed use of a column subsumes a nullness-only one */
+			if (batch->types[col] == BATCH_ANY)
+				batch->types[col] = type;
+			return col;
+		}
+	}
+
+	if (batch->ncols == 0)
+	{
+		batch->attnums = (AttrNumber *) palloc(sizeof(AttrNumber));
+		batch->types = (BatchType *) palloc(sizeof(BatchType));
+	}
+	else
+	{
+		batch->attnums = (AttrNumber *)
+			repalloc(batch->attnums, (batch->ncols + 1) * sizeof(AttrNumber));
+		batch->types = (BatchType *)
+			repalloc(batch->types, (batch->ncols + 1) * sizeof(BatchType));
+	}
+	batch->attnums[col] = attnum;
+	batch->types[col] = type;
+	batch->ncols++;
+	batch->maxattnum = Max(batch->maxattnum, attnum);
+
+	return col;
+}
+
+/*
+ * ExecBatchAddQual
+ *		Add a qual clause, given as a plan expression over the scan relation,
+ *		to the batch.
+ *
+ * Returns false if the clause isn't one we can evaluate over a batch, in
+ * which case the batch is left unchanged.
+ */
+bool
+ExecBatchAddQual(TupleBatch *batch, Expr *qual, Index scanrelid)
+{
+	OpExpr	   *opexpr;
+	Node	   *leftop;
+	Node	   *rightop;
+	Var		   *var;
+	Const	   *con;
+	BatchType	type;
+	BatchType	consttype;
+	BatchCmp	cmp;
+	BatchQualClause *clause;
+
+	if (!IsA(qual, OpExpr))
+		return false;
+	opexpr = (OpExpr *) qual;
+	if (list_length(opexpr->args) != 2)
+		return false;
+
+	set_opfuncid(opexpr);
+	if (!batch_cmp_for_func(opexpr->opfuncid, &cmp))
+		return false;
+
+	leftop = (Node *) linitial(opexpr->args);
+	rightop = (Node *) lsecond(opexpr->args);
+	if (IsA(leftop, Var) && IsA(rightop, Const))
+	{
+		var = (Var *) leftop;
+		con = (Const *) rightop;
+	}
+	else if (IsA(leftop, Const) && IsA(rightop, Var))
+	{
+		var = (Var *) rightop;
+		con = (Const *) leftop;
+
+		/* commute the comparison, so the column is on the left */
+		switch (cmp)
+		{
+			case BATCH_LT:
+				cmp = BATCH_GT;
+				break;
+			case BATCH_LE:
+				cmp = BATCH_GE;
+				break;
+			case BATCH_GE:
+				cmp = BATCH_LE;
+				break;
+			case BATCH_GT:
+				cmp = BATCH_LT;
+				break;
+			default:
+				break;
+		}
+	}
+	else
+		return false;
+
+	if (var->varno != scanrelid || var->varlevelsup != 0 ||
+		var->varattno <= 0)
+		return false;
+	if (!ExecBatchSupportsType(var->vartype, &type) ||
+		!ExecBatchSupportsType(con->consttype, &consttype))
+		return false;
+
+	/* the operators are strict; leave null comparisons to the planner */
+	if (con->constisnull)
+		return false;
+
+	if (batch->nquals == 0)
+		batch->quals = (BatchQualClause *) palloc(sizeof(BatchQualClause));
+	else
+		batch->quals = (BatchQualClause *)
+			repalloc(batch->quals,
+					 (batch->nquals + 1) * sizeof(BatchQualClause));
+	clause = &batch->quals[batch->nquals++];
+
+	clause->col = ExecBatchAddColumn(batch, var->varattno, type);
+	clause->cmp = cmp;
+	switch (consttype)
+	{
+		case BATCH_INT2:
+			clause->constval = DatumGetInt16(con->constvalue);
+			break;
+		case BATCH_INT4:
+			clause->constval = DatumGetInt32(con->constvalue);
+			break;
+		case BATCH_INT8:
+			clause->constval = DatumGetInt64(con->constvalue);
+			break;
+		case BATCH_ANY:
+			Assert(false);
+			break;
+	}
+
+	return true;
+}
+
+/*
+ * Map an integer or date comparison function to the comparison it makes.
+ * The cross-type integer comparisons are included; we compare everything
+ * as int64 anyway.
+ */
+static bool
+batch_cmp_for_func(Oid funcid, BatchCmp *cmp)
+{
+	switch (funcid)
+	{
+		case F_INT2LT:
+		case F_INT4LT:
+		case F_INT8LT:
+		case F_INT24LT:
+		case F_INT42LT:
+		case F_INT28LT:
+		case F_INT82LT:
+		case F_INT48LT:
+		case F_INT84LT:
+		case F_DATE_LT:
+			*cmp = BATCH_LT;
+			return true;
+
+		case F_INT2LE:
+		case F_INT4LE:
+		case F_INT8LE:
+		case F_INT24LE:
+		case F_INT42LE:
+		case F_INT28LE:
+		case F_INT82LE:
+		case F_INT48LE:
+		case F_INT84LE:
+		case F_DATE_LE:
+			*cmp = BATCH_LE;
+			return true;
+
+		case F_INT2EQ:
+		case F_INT4EQ:
+		case F_INT8EQ:
+		case F_INT24EQ:
+		case F_INT42EQ:
+		case F_INT28EQ:
+		case F_INT82EQ:
+		case F_INT48EQ:
+		case F_INT84EQ:
+		case F_DATE_EQ:
+			*cmp = BATCH_EQ;
+			return true;
+
+		case F_INT2NE:
+		case F_INT4NE:
+		case F_INT8NE:
+		case F_INT24NE:
+		case F_INT42NE:
+		case F_INT28NE:
+		case F_INT82NE:
+		case F_INT48NE:
+		case F_INT84NE:
+		case F_DATE_NE:
+			*cmp = BATCH_NE;
+			return true;
+
+		case F_INT2GE:
+		case F_INT4GE:
+		case F_INT8GE:
+		case F_INT24GE:
+		case F_INT42GE:
+		case F_INT28GE:
+		case F_INT82GE:
+		case F_INT48GE:
+		case F_INT84GE:
+		case F_DATE_GE:
+			*cmp = BATCH_GE;
+			return true;
+
+		case F_INT2GT:
+		case F_INT4GT:
+		case F_INT8GT:
+		case F_INT24GT:
+		case F_INT42GT:
+		case F_INT28GT:
+		case F_INT82GT:
+		case F_INT48GT:
+		case F_INT84GT:
+		case F_DATE_GT:
+			*cmp = BATCH_GT;
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * ExecBatchAllocate
+ *		Allocate space for the rows of a batch, once all its columns have
+ *		been added.
+ */
+void
+ExecBatchAllocate(TupleBatch *batch)
+{
+	int			col;
+
+	batch->values = (Datum **) palloc(batch->ncols * sizeof(Datum *));
+	batch->isnull = (bool **) palloc(batch->ncols * sizeof(bool *));
+	for (col = 0; col < batch->ncols; col++)
+	{
+		batch->values[col] = (Datum *) palloc(BATCH_SIZE * sizeof(Datum));
+		batch->isnull[col] = (bool *) palloc(BATCH_SIZE * sizeof(bool));
+	}
+	batch->sel = (uint16 *) palloc(BATCH_SIZE * sizeof(uint16));
+	batch->nrows = 0;
+	batch->nsel = 0;
+}
+
+/*
+ * Filter the selection vector by one clause.  The comparison is made in
+ * int64 arithmetic, whatever the column type.  Every selected row number is
+ * written back unconditionally, and kept only if it passed, to avoid a
+ * hard-to-predict branch per row.
+ */
+#define BATCH_FILTER_LOOP(getvalue, op) \
+	for (i = 0; i < nsel; i++) \
+	{ \
+		int			row = sel[i]; \
+		\
+		sel[n] = row; \
+		n += (!isnull[row] && (int64) getvalue(values[row]) op constval); \
+	}
+
+#define BATCH_FILTER_TYPE(getvalue) \
+	switch (clause->cmp) \
+	{ \
+		case BATCH_LT: \
+			BATCH_FILTER_LOOP(getvalue, <); \
+			break; \
+		case BATCH_LE: \
+			BATCH_FILTER_LOOP(getvalue, <=); \
+			break; \
+		case BATCH_EQ: \
+			BATCH_FILTER_LOOP(getvalue, ==); \
+			break; \
+		case BATCH_NE: \
+			BATCH_FILTER_LOOP(getvalue, !=); \
+			break; \
+		case BATCH_GE: \
+			BATCH_FILTER_LOOP(getvalue, >=); \
+			break; \
+		case BATCH_GT: \
+			BATCH_FILTER_LOOP(getvalue, >); \
+			break; \
+	}
+
+/*
+ * ExecBatchFilter
+ *		Apply the batch's quals to the rows loaded, setting up the selection
+ *		vector.
+ */
+void
+ExecBatchFilter(TupleBatch *batch)
+{
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nrows;
+	int			i;
+	int			q;
+
+	for (i = 0; i < nsel; i++)
+		sel[i] = i;
+
+	for (q = 0; q < batch->nquals && nsel > 0; q++)
+	{
+		BatchQualClause *clause = &batch->quals[q];
+		Datum	   *values = batch->values[clause->col];
+		bool	   *isnull = batch->isnull[clause->col];
+		int64		constval = clause->constval;
+		int			n = 0;
+
+		switch (batch->types[clause->col])
+		{
+			case BATCH_INT2:
+				BATCH_FILTER_TYPE(DatumGetInt16);
+				break;
+			case BATCH_INT4:
+				BATCH_FILTER_TYPE(DatumGetInt32);
+				break;
+			case BATCH_INT8:
+				BATCH_FILTER_TYPE(DatumGetInt64);
+				break;
+			case BATCH_ANY:
+				elog(ERROR, "cannot filter on an untyped batch column");
+				break;
+		}
+		nsel = n;
+	}
+
+	batch->nsel = nsel;
+}
@@ -194,6 +194,16 @@
  *	  transition values.  hashcontext is the single context created to support
  *	  all hash tables.
  *
+ *	  Batch execution:
+ *
+ *	  A plain aggregation reading directly from a sequential scan, whose
+ *	  aggregates are all simple counts, sums, minimums or maximums of integer
+ *	  columns, can be run a batch of rows at a time (see execBatch.c).  The
+ *	  scan then fills a TupleBatch with just the input columns and applies
+ *	  its quals to the whole batch, and we advance the transition values over
+ *	  the qualifying rows in tight loops, without calling the transition
+ *	  functions.  ExecInitAggBatch decides whether that's possible.
+ *
  *
  * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -213,6 +223,7 @@
 #include "catalog/pg_type.h"
 #include "executor/executor.h"
 #include "executor/nodeAgg.h"
+#include "executor/nodeSeqscan.h"
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
 #include "nodes/nodeFuncs.h"
@@ -220,8 +231,10 @@
 #include "optimizer/tlist.h"
 #include "parser/parse_agg.h"
 #include "parser/parse_coerce.h"
+#include "parser/parsetree.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
+#include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/syscache.h"
@@ -517,6 +530,35 @@ typedef struct AggStatePerHashData
 	Agg		   *aggnode;		/* original Agg node, for numGroups etc. */
 }			AggStatePerHashData;
 
+/*
+ * AggStateBatchData - state for batch execution
+ *
+ * For each transition state, we record which of the transition functions
+ * ExecInitAggBatch knows how to emulate it uses, and which batch column
+ * holds its input.
+ */
+typedef enum AggBatchKind
+{
+	AGG_BATCH_COUNT_STAR,		/* count(*) */
+	AGG_BATCH_COUNT,			/* count(expr) */
+	AGG_BATCH_SUM,				/* sum() of int2 or int4, as int8 */
+	AGG_BATCH_MIN,				/* min() of an integer or date */
+	AGG_BATCH_MAX				/* max() of an integer or date */
+} AggBatchKind;
+
+typedef struct AggBatchTrans
+{
+	AggBatchKind kind;
+	int			col;			/* input column in batch, or -1 */
+	BatchType	type;			/* type of input column */
+} AggBatchTrans;
+
+typedef struct AggStateBatchData
+{
+	TupleBatch *batch;			/* batch filled by the outer SeqScan */
+	AggBatchTrans *trans;		/* array of numtrans entries */
+}			AggStateBatchData;
+
 
 static void select_current_set(AggState *aggstate, int setno, bool is_hash);
 static void initialize_phase(AggState *aggstate, int newphase);
@@ -560,6 +602,10 @@ static void build_hash_table(AggState *aggstate);
 static TupleHashEntryData *lookup_hash_entry(AggState *aggstate);
 static AggStatePerGroup *lookup_hash_entries(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
+static TupleTableSlot *agg_retrieve_batch(AggState *aggstate);
+static void advance_aggregates_batch(AggState *aggstate,
+						 AggStatePerGroup pergroup);
+static AggStateBatch ExecInitAggBatch(AggState *aggstate);
 static void agg_fill_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static Datum GetAggInitVal(Datum textInitVal, Oid transtype);
@@ -2124,6 +2170,12 @@ ExecAgg(PlanState *pstate)
 				result = agg_retrieve_hash_table(node);
 				break;
 			case AGG_PLAIN:
+				if (node->batch)
+				{
+					result = agg_retrieve_batch(node);
+					break;
+				}
+				/* FALLTHROUGH */
 			case AGG_SORTED:
 				result = agg_retrieve_direct(node);
 				break;
@@ -2489,6 +2541,185 @@ agg_retrieve_direct(AggState *aggstate)
 	return NULL;
 }
 
+/*
+ * ExecAgg for plain aggregation in batch mode
+ *
+ * This is the AGG_PLAIN case of agg_retrieve_direct, reading the input a
+ * batch at a time.
+ */
+static TupleTableSlot *
+agg_retrieve_batch(AggState *aggstate)
+{
+	ExprContext *econtext = aggstate->ss.ps.ps_ExprContext;
+	SeqScanState *outerstate = (SeqScanState *) outerPlanState(aggstate);
+	TupleBatch *batch = aggstate->batch->batch;
+	AggStatePerGroup pergroup = aggstate->pergroup;
+
+	ReScanExprContext(econtext);
+	ReScanExprContext(aggstate->aggcontexts[0]);
+
+	initialize_aggregates(aggstate, pergroup, 1);
+
+	for (;;)
+	{
+		bool		more = ExecSeqScanBatch(outerstate, batch);
+
+		if (batch->nsel > 0)
+			advance_aggregates_batch(aggstate, pergroup);
+
+		if (!more)
+			break;
+
+		CHECK_FOR_INTERRUPTS();
+	}
+	aggstate->agg_done = true;
+
+	/*
+	 * There can't be any references to non-aggregated input columns, so just
+	 * use the (empty) scan slot as the representative input tuple.
+	 */
+	econtext->ecxt_outertuple = aggstate->ss.ss_ScanTupleSlot;
+
+	prepare_projection_slot(aggstate, econtext->ecxt_outertuple, 0);
+
+	select_current_set(aggstate, 0, false);
+
+	finalize_aggregates(aggstate, aggstate->peragg, pergroup);
+
+	return project_aggregates(aggstate);
+}
+
+/*
+ * Loops for advance_aggregates_batch.  The sum of a batch of int2 or int4
+ * values can't overflow an int64, and neither can the running total in any
+ * realistic case; int4_sum and int2_sum don't check for it either.
+ */
+#define AGG_BATCH_SUM_LOOP(getvalue) \
+	do { \
+		int64		sum = 0; \
+		int			count = 0; \
+		\
+		for (i = 0; i < nsel; i++) \
+		{ \
+			int			row = sel[i]; \
+			\
+			sum += isnull[row] ? 0 : (int64) getvalue(values[row]); \
+			count += !isnull[row]; \
+		} \
+		if (count > 0) \
+		{ \
+			if (!pergroupstate->transValueIsNull) \
+				sum += DatumGetInt64(pergroupstate->transValue); \
+			pergroupstate->transValue = Int64GetDatum(sum); \
+			pergroupstate->transValueIsNull = false; \
+		} \
+	} while (0)
+
+#define AGG_BATCH_MINMAX_LOOP(getvalue, op) \
+	do { \
+		bool		found = !pergroupstate->transValueIsNull; \
+		Datum		best = pergroupstate->transValue; \
+		\
+		for (i = 0; i < nsel; i++) \
+		{ \
+			int			row = sel[i]; \
+			\
+			if (!isnull[row] && \
+				(!found || getvalue(values[row]) op getvalue(best))) \
+			{ \
+				best = values[row]; \
+				found = true; \
+			} \
+		} \
+		if (found) \
+		{ \
+			pergroupstate->transValue = best; \
+			pergroupstate->transValueIsNull = false; \
+			pergroupstate->noTransValue = false; \
+		} \
+	} while (0)
+
+#define AGG_BATCH_MINMAX(op) \
+	switch (bt->type) \
+	{ \
+		case BATCH_INT2: \
+			AGG_BATCH_MINMAX_LOOP(DatumGetInt16, op); \
+			break; \
+		case BATCH_INT4: \
+			AGG_BATCH_MINMAX_LOOP(DatumGetInt32, op); \
+			break; \
+		case BATCH_INT8: \
+			AGG_BATCH_MINMAX_LOOP(DatumGetInt64, op); \
+			break; \
+		case BATCH_ANY: \
+			elog(ERROR, "unexpected batch column type"); \
+			break; \
+	}
+
+/*
+ * Advance all the transition states over the selected rows of the current
+ * batch.  This has the same effect as calling advance_aggregates for each
+ * row, for the transition functions accepted by ExecInitAggBatch.
+ */
+static void
+advance_aggregates_batch(AggState *aggstate, AggStatePerGroup pergroup)
+{
+	AggStateBatch batchstate = aggstate->batch;
+	TupleBatch *batch = batchstate->batch;
+	uint16	   *sel = batch->sel;
+	int			nsel = batch->nsel;
+	int			transno;
+
+	for (transno = 0; transno < aggstate->numtrans; transno++)
+	{
+		AggBatchTrans *bt = &batchstate->trans[transno];
+		AggStatePerGroup pergroupstate = &pergroup[transno];
+		Datum	   *values = NULL;
+		bool	   *isnull = NULL;
+		int			i;
+
+		if (bt->col >= 0)
+		{
+			values = batch->values[bt->col];
+			isnull = batch->isnull[bt->col];
+		}
+
+		switch (bt->kind)
+		{
+			case AGG_BATCH_COUNT_STAR:
+				pergroupstate->transValue =
+					Int64GetDatum(DatumGetInt64(pergroupstate->transValue) + nsel);
+				break;
+
+			case AGG_BATCH_COUNT:
+				{
+					int			count = 0;
+
+					for (i = 0; i < nsel; i++)
+						count += !isnull[sel[i]];
+					pergroupstate->transValue =
+						Int64GetDatum(DatumGetInt64(pergroupstate->transValue) + count);
+				}
+				break;
+
+			case AGG_BATCH_SUM:
+				if (bt->type == BATCH_INT2)
+					AGG_BATCH_SUM_LOOP(DatumGetInt16);
+				else
+					AGG_BATCH_SUM_LOOP(DatumGetInt32);
+				break;
+
+			case AGG_BATCH_MIN:
+				AGG_BATCH_MINMAX(<);
+				break;
+
+			case AGG_BATCH_MAX:
+				AGG_BATCH_MINMAX(>);
+				break;
+		}
+	}
+}
+
 /*
  * ExecAgg for hashed case: read input and build hash table
  */
@@ -3395,9 +3626,135 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 												 NULL);
 	ExecSetSlotDescriptor(aggstate->evalslot, aggstate->evaldesc);
 
+	/*
+	 * Finally, see if we can read the input in batches.
+	 */
+	if (enable_batch_execution)
+		aggstate->batch = ExecInitAggBatch(aggstate);
+
 	return aggstate;
 }
 
+/*
+ * Set up for batch execution (see agg_retrieve_batch), if the plan allows it.
+ *
+ * That requires a plain aggregation, without grouping sets, reading straight
+ * from a SeqScan whose quals can all be evaluated by ExecBatchFilter.  Each
+ * aggregate's transition function must be one of the few we can emulate,
+ * taking a plain column of the scan relation as its argument, and there can
+ * be no DISTINCT, ORDER BY or FILTER.  The transition functions accepted
+ * can't fail (int8inc's overflow check can't be reached in practice), so
+ * skipping them doesn't change behavior.
+ *
+ * Returns NULL if batch execution isn't possible.
+ */
+static AggStateBatch
+ExecInitAggBatch(AggState *aggstate)
+{
+	Agg		   *node = (Agg *) aggstate->ss.ps.plan;
+	PlanState  *outerstate = outerPlanState(aggstate);
+	Plan	   *outerplan;
+	Index		scanrelid;
+	AggStateBatch batchstate;
+	TupleBatch *batch;
+	int			transno;
+
+	if (node->aggstrategy != AGG_PLAIN ||
+		node->groupingSets != NIL ||
+		node->chain != NIL ||
+		DO_AGGSPLIT_COMBINE(aggstate->aggsplit) ||
+		aggstate->numtrans == 0)
+		return NULL;
+
+	if (!IsA(outerstate, SeqScanState))
+		return NULL;
+	outerplan = outerstate->plan;
+	scanrelid = ((Scan *) outerplan)->scanrelid;
+
+	batch = ExecBatchCreate();
+	batchstate = (AggStateBatch) palloc(sizeof(AggStateBatchData));
+	batchstate->trans = (AggBatchTrans *)
+		palloc(aggstate->numtrans * sizeof(AggBatchTrans));
+
+	for (transno = 0; transno < aggstate->numtrans; transno++)
+	{
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+		AggBatchTrans *bt = &batchstate->trans[transno];
+		TargetEntry *tle;
+		Var		   *var;
+
+		if (pertrans->numSortCols > 0 ||
+			pertrans->aggfilter != NULL ||
+			!pertrans->transtypeByVal)
+			return NULL;
+
+		switch (pertrans->transfn_oid)
+		{
+			case F_INT8INC:
+				bt->kind = AGG_BATCH_COUNT_STAR;
+				break;
+			case F_INT8INC_ANY:
+				bt->kind = AGG_BATCH_COUNT;
+				break;
+			case F_INT2_SUM:
+			case F_INT4_SUM:
+				bt->kind = AGG_BATCH_SUM;
+				break;
+			case F_INT2SMALLER:
+			case F_INT4SMALLER:
+			case F_INT8SMALLER:
+			case F_DATE_SMALLER:
+				bt->kind = AGG_BATCH_MIN;
+				break;
+			case F_INT2LARGER:
+			case F_INT4LARGER:
+			case F_INT8LARGER:
+			case F_DATE_LARGER:
+				bt->kind = AGG_BATCH_MAX;
+				break;
+			default:
+				return NULL;
+		}
+
+		bt->col = -1;
+		bt->type = BATCH_ANY;
+		if (bt->kind == AGG_BATCH_COUNT_STAR)
+		{
+			if (pertrans->aggref->args != NIL)
+				return NULL;
+			continue;
+		}
+
+		/* find the scan column the aggregate's argument comes from */
+		if (list_length(pertrans->aggref->args) != 1)
+			return NULL;
+		tle = (TargetEntry *) linitial(pertrans->aggref->args);
+		var = (Var *) tle->expr;
+		if (!IsA(var, Var) || var->varno != OUTER_VAR)
+			return NULL;
+		tle = get_tle_by_resno(outerplan->targetlist, var->varattno);
+		if (tle == NULL || !IsA(tle->expr, Var))
+			return NULL;
+		var = (Var *) tle->expr;
+		if (var->varno != scanrelid || var->varattno <= 0)
+			return NULL;
+
+		if (bt->kind != AGG_BATCH_COUNT &&
+			!ExecBatchSupportsType(var->vartype, &bt->type))
+			return NULL;
+
+		bt->col = ExecBatchAddColumn(batch, var->varattno, bt->type);
+	}
+
+	if (!ExecSeqScanInitBatch((SeqScanState *) outerstate, batch))
+		return NULL;
+
+	ExecBatchAllocate(batch);
+	batchstate->batch = batch;
+
+	return batchstate;
+}
+
 /*
  * Build the state needed to calculate a state value for an aggregate.
  *
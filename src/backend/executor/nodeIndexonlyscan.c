@@ -62,6 +62,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 	IndexScanDesc scandesc;
 	TupleTableSlot *slot;
 	ItemPointer tid;
+	IndexOnlyScan *plan = (IndexOnlyScan *) node->ss.ps.plan;
 
 	/*
 	 * extract necessary information from index scan node
@@ -69,7 +70,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 	estate = node->ss.ps.state;
 	direction = estate->es_direction;
 	/* flip direction if this is an overall backward scan */
-	if (ScanDirectionIsBackward(((IndexOnlyScan *) node->ss.ps.plan)->indexorderdir))
+	if (ScanDirectionIsBackward(plan->indexorderdir))
 	{
 		if (ScanDirectionIsForward(direction))
 			direction = BackwardScanDirection;
@@ -98,6 +99,7 @@ IndexOnlyNext(IndexOnlyScanState *node)
 
 		/* Set it up for index-only scan */
 		node->ioss_ScanDesc->xs_want_itup = true;
+		node->ioss_ScanDesc->xs_skipprefix = plan->indexskipprefix;
 		node->ioss_VMBuffer = InvalidBuffer;
 
 		/*
@@ -112,6 +114,18 @@ IndexOnlyNext(IndexOnlyScanState *node)
 						 node->ioss_NumOrderByKeys);
 	}
 
+	/*
+	 * In a skip scan for DISTINCT, once we've returned a tuple the rest of
+	 * its prefix group is of no interest, so ask the AM to move on to the
+	 * next one.
+	 */
+	if (node->ioss_SkipNext)
+	{
+		node->ioss_SkipNext = false;
+		if (!index_skip(scandesc, direction, plan->indexskipprefix))
+			return ExecClearTuple(slot);
+	}
+
 	/*
 	 * OK, now that we have what we need, fetch the next tuple.
 	 */
@@ -248,6 +262,13 @@ IndexOnlyNext(IndexOnlyScanState *node)
 							  ItemPointerGetBlockNumber(tid),
 							  estate->es_snapshot);
 
+		/*
+		 * We can only skip the rest of the group if nothing above us in this
+		 * node could reject the tuple we're returning.
+		 */
+		if (plan->indexskipdistinct && node->ss.ps.qual == NULL)
+			node->ioss_SkipNext = true;
+
 		return slot;
 	}
 
@@ -354,6 +375,7 @@ ExecReScanIndexOnlyScan(IndexOnlyScanState *node)
 								 node->ioss_NumRuntimeKeys);
 	}
 	node->ioss_RuntimeKeysReady = true;
+	node->ioss_SkipNext = false;
 
 	/* reset index scan */
 	if (node->ioss_ScanDesc)
@@ -466,6 +488,7 @@ ExecInitIndexOnlyScan(IndexOnlyScan *node, EState *estate, int eflags)
 	indexstate->ss.ps.state = estate;
 	indexstate->ss.ps.ExecProcNode = ExecIndexOnlyScan;
 	indexstate->ioss_HeapFetches = 0;
+	indexstate->ioss_SkipNext = false;
 
 	/*
 	 * Miscellaneous initialization
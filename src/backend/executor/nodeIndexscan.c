@@ -117,6 +117,8 @@ IndexNext(IndexScanState *node)
 								   node->iss_NumOrderByKeys);
 
 		node->iss_ScanDesc = scandesc;
+		scandesc->xs_skipprefix =
+			((IndexScan *) node->ss.ps.plan)->indexskipprefix;
 
 		/*
 		 * If no run-time keys to calculate or they are ready, go ahead and
@@ -224,6 +226,8 @@ IndexNextWithReorder(IndexScanState *node)
 								   node->iss_NumOrderByKeys);
 
 		node->iss_ScanDesc = scandesc;
+		scandesc->xs_skipprefix =
+			((IndexScan *) node->ss.ps.plan)->indexskipprefix;
 
 		/*
 		 * If no run-time keys to calculate or they are ready, go ahead and
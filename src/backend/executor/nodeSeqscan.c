@@ -20,6 +20,9 @@
  *		ExecEndSeqScan			releases any storage allocated.
  *		ExecReScanSeqScan		rescans the relation
  *
+ *		ExecSeqScanInitBatch	sets up batch-at-a-time scanning
+ *		ExecSeqScanBatch		retrieve next batch of rows
+ *
  *		ExecSeqScanEstimate		estimates DSM space needed for parallel scan
  *		ExecSeqScanInitializeDSM initialize DSM for parallel scan
  *		ExecSeqScanReInitializeDSM reinitialize DSM for fresh parallel scan
@@ -28,6 +31,7 @@
 #include "postgres.h"
 
 #include "access/relscan.h"
+#include "executor/execBatch.h"
 #include "executor/execdebug.h"
 #include "executor/nodeSeqscan.h"
 #include "utils/rel.h"
@@ -132,6 +136,92 @@ ExecSeqScan(PlanState *pstate)
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanInitBatch
+ *
+ *		Prepare to return the scan's rows in batches, for a parent node
+ *		that has added the columns it needs to the batch.  The scan's
+ *		quals are added to the batch, to be evaluated a whole batch at a
+ *		time.
+ *
+ *		Returns false if the scan can't be done in batches, because
+ *		some qual isn't a simple comparison that the batch code knows
+ *		how to evaluate, or because we're doing EvalPlanQual or
+ *		collecting per-node instrumentation.  The batch may then have
+ *		been partially set up, and should be discarded.
+ * ----------------------------------------------------------------
+ */
+bool
+ExecSeqScanInitBatch(SeqScanState *node, TupleBatch *batch)
+{
+	SeqScan    *plan = (SeqScan *) node->ss.ps.plan;
+	ListCell   *l;
+
+	if (node->ss.ps.state->es_epqTuple != NULL ||
+		node->ss.ps.instrument != NULL)
+		return false;
+
+	foreach(l, plan->plan.qual)
+	{
+		if (!ExecBatchAddQual(batch, (Expr *) lfirst(l), plan->scanrelid))
+			return false;
+	}
+
+	return true;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecSeqScanBatch
+ *
+ *		Fill the batch with the next BATCH_SIZE rows of the relation,
+ *		or as many as are left, and apply the batch's quals to them.
+ *		This is used instead of ExecProcNode, so the scan's own quals
+ *		and projection are bypassed.
+ *
+ *		Returns false when the scan has reached its end; the batch then
+ *		holds the last rows, if any, and this mustn't be called again,
+ *		since the heap scan would start over.  A batch in which no row
+ *		passed the quals is not an indication of the end.
+ * ----------------------------------------------------------------
+ */
+bool
+ExecSeqScanBatch(SeqScanState *node, TupleBatch *batch)
+{
+	int			nrows = 0;
+	int			col;
+	bool		more = true;
+
+	/* as in ExecProcNode, handle a rescan postponed until first use */
+	if (node->ss.ps.chgParam != NULL)
+		ExecReScan((PlanState *) node);
+
+	while (nrows < BATCH_SIZE)
+	{
+		TupleTableSlot *slot = SeqNext(node);
+
+		if (TupIsNull(slot))
+		{
+			more = false;
+			break;
+		}
+
+		slot_getsomeattrs(slot, batch->maxattnum);
+		for (col = 0; col < batch->ncols; col++)
+		{
+			int			attno = batch->attnums[col] - 1;
+
+			batch->values[col][nrows] = slot->tts_values[attno];
+			batch->isnull[col][nrows] = slot->tts_isnull[attno];
+		}
+		nrows++;
+	}
+
+	batch->nrows = nrows;
+	ExecBatchFilter(batch);
+
+	return more;
+}
+
 /* ----------------------------------------------------------------
  *		InitScanRelation
  *
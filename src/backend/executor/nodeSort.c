@@ -21,6 +21,12 @@
 #include "miscadmin.h"
 #include "utils/tuplesort.h"
 
+/*
+ * A Sort's shm_toc key for its instrumentation is its plan_node_id; for the
+ * shared state of a shared sort, it's this plus the plan_node_id.
+ */
+#define PARALLEL_KEY_SHARED_SORT	UINT64CONST(0xD000000000000000)
+
 
 /* ----------------------------------------------------------------
  *		ExecSort
@@ -29,6 +35,10 @@
  *		which saves the results in a temporary file or memory. After the
  *		initial call, returns a tuple from the file with each call.
  *
+ *		Just below a Gather Merge, the leader and workers share one sort
+ *		of all their tuples, if they can, rather than each sorting its own;
+ *		each then returns its own range of the sorted tuples.
+ *
  *		Conditions:
  *		  -- none.
  *
@@ -96,6 +106,14 @@ ExecSort(PlanState *pstate)
 											  node->randomAccess);
 		if (node->bounded)
 			tuplesort_set_bound(tuplesortstate, node->bound);
+		else if (node->shared_sort != NULL && !node->randomAccess)
+		{
+			/*
+			 * If the shared sort is already done with its input, we just
+			 * sort whatever we get, which is probably nothing.
+			 */
+			(void) tuplesort_attach_shared(tuplesortstate, node->shared_sort);
+		}
 		node->tuplesortstate = (void *) tuplesortstate;
 
 		/*
@@ -190,6 +208,7 @@ ExecInitSort(Sort *node, EState *estate, int eflags)
 	sortstate->bounded = false;
 	sortstate->sort_Done = false;
 	sortstate->tuplesortstate = NULL;
+	sortstate->shared_sort = NULL;
 
 	/*
 	 * Miscellaneous initialization
@@ -353,7 +372,8 @@ ExecReScanSort(SortState *node)
 /* ----------------------------------------------------------------
  *		ExecSortEstimate
  *
- *		Estimate space required to propagate sort statistics.
+ *		Estimate space required to propagate sort statistics, and
+ *		for the shared state of a shared sort.
  * ----------------------------------------------------------------
  */
 void
@@ -361,39 +381,71 @@ ExecSortEstimate(SortState *node, ParallelContext *pcxt)
 {
 	Size		size;
 
-	/* don't need this if not instrumenting or no workers */
-	if (!node->ss.ps.instrument || pcxt->nworkers == 0)
+	/* don't need any of this if no workers */
+	if (pcxt->nworkers == 0)
 		return;
 
-	size = mul_size(pcxt->nworkers, sizeof(TuplesortInstrumentation));
-	size = add_size(size, offsetof(SharedSortInfo, sinstrument));
-	shm_toc_estimate_chunk(&pcxt->estimator, size);
-	shm_toc_estimate_keys(&pcxt->estimator, 1);
+	if (node->ss.ps.instrument)
+	{
+		size = mul_size(pcxt->nworkers, sizeof(TuplesortInstrumentation));
+		size = add_size(size, offsetof(SharedSortInfo, sinstrument));
+		shm_toc_estimate_chunk(&pcxt->estimator, size);
+		shm_toc_estimate_keys(&pcxt->estimator, 1);
+	}
+
+	if (((Sort *) node->ss.ps.plan)->shared)
+	{
+		/* the workers and the leader may all participate */
+		size = tuplesort_estimate_shared(pcxt->nworkers + 1);
+		shm_toc_estimate_chunk(&pcxt->estimator, size);
+		shm_toc_estimate_keys(&pcxt->estimator, 1);
+	}
 }
 
 /* ----------------------------------------------------------------
  *		ExecSortInitializeDSM
  *
- *		Initialize DSM space for sort statistics.
+ *		Initialize DSM space for sort statistics, and for the shared
+ *		state of a shared sort.
  * ----------------------------------------------------------------
  */
 void
 ExecSortInitializeDSM(SortState *node, ParallelContext *pcxt)
 {
+	int			plan_node_id = node->ss.ps.plan->plan_node_id;
 	Size		size;
 
-	/* don't need this if not instrumenting or no workers */
-	if (!node->ss.ps.instrument || pcxt->nworkers == 0)
+	/* forget any shared sort of a previous parallel context */
+	node->shared_sort = NULL;
+
+	/* don't need any of this if no workers */
+	if (pcxt->nworkers == 0)
 		return;
 
-	size = offsetof(SharedSortInfo, sinstrument)
-		+ pcxt->nworkers * sizeof(TuplesortInstrumentation);
-	node->shared_info = shm_toc_allocate(pcxt->toc, size);
-	/* ensure any unfilled slots will contain zeroes */
-	memset(node->shared_info, 0, size);
-	node->shared_info->num_workers = pcxt->nworkers;
-	shm_toc_insert(pcxt->toc, node->ss.ps.plan->plan_node_id,
-				   node->shared_info);
+	if (node->ss.ps.instrument)
+	{
+		size = offsetof(SharedSortInfo, sinstrument)
+			+ pcxt->nworkers * sizeof(TuplesortInstrumentation);
+		node->shared_info = shm_toc_allocate(pcxt->toc, size);
+		/* ensure any unfilled slots will contain zeroes */
+		memset(node->shared_info, 0, size);
+		node->shared_info->num_workers = pcxt->nworkers;
+		shm_toc_insert(pcxt->toc, plan_node_id, node->shared_info);
+	}
+
+	/*
+	 * The runs of a shared sort are deleted when we detach from the DSM
+	 * segment, so we can't share the sort if there isn't one.
+	 */
+	if (((Sort *) node->ss.ps.plan)->shared && pcxt->seg != NULL)
+	{
+		size = tuplesort_estimate_shared(pcxt->nworkers + 1);
+		node->shared_sort = shm_toc_allocate(pcxt->toc, size);
+		tuplesort_initialize_shared(node->shared_sort, pcxt->nworkers + 1,
+									pcxt->seg);
+		shm_toc_insert(pcxt->toc, PARALLEL_KEY_SHARED_SORT + plan_node_id,
+					   node->shared_sort);
+	}
 }
 
 /* ----------------------------------------------------------------
@@ -411,19 +463,28 @@ ExecSortReInitializeDSM(SortState *node, ParallelContext *pcxt)
 		memset(node->shared_info->sinstrument, 0,
 			   node->shared_info->num_workers * sizeof(TuplesortInstrumentation));
 	}
+
+	/* Likewise any shared sort, deleting the runs of the last one */
+	if (node->shared_sort != NULL)
+		tuplesort_reinitialize_shared(node->shared_sort);
 }
 
 /* ----------------------------------------------------------------
  *		ExecSortInitializeWorker
  *
- *		Attach worker to DSM space for sort statistics.
+ *		Attach worker to DSM space for sort statistics, and to the
+ *		shared state of a shared sort.
  * ----------------------------------------------------------------
  */
 void
 ExecSortInitializeWorker(SortState *node, shm_toc *toc)
 {
-	node->shared_info =
-		shm_toc_lookup(toc, node->ss.ps.plan->plan_node_id, true);
+	int			plan_node_id = node->ss.ps.plan->plan_node_id;
+
+	node->shared_info = shm_toc_lookup(toc, plan_node_id, true);
+	node->shared_sort = shm_toc_lookup(toc,
+									   PARALLEL_KEY_SHARED_SORT + plan_node_id,
+									   true);
 	node->am_worker = true;
 }
 
@@ -490,6 +490,7 @@ makeColumnDef(const char *colname, Oid typeOid, int32 typmod, Oid collOid)
 
 	n->colname = pstrdup(colname);
 	n->typeName = makeTypeNameFromOid(typeOid, typmod);
+	n->compression = NULL;
 	n->inhcount = 0;
 	n->is_local = true;
 	n->is_not_null = false;
@@ -791,7 +791,9 @@ get_index_paths(PlannerInfo *root, RelOptInfo *rel,
 		if (index->amhasgettuple)
 			add_path(rel, (Path *) ipath);
 
+		/* Bitmap scans have no way to do skip scans */
 		if (index->amhasgetbitmap &&
+			ipath->indexskipprefix == 0 &&
 			(ipath->path.pathkeys == NIL ||
 			 ipath->indexselectivity < 1.0))
 			*bitindexpaths = lappend(*bitindexpaths, ipath);
@@ -874,9 +876,11 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 	List	   *index_pathkeys;
 	List	   *useful_pathkeys;
 	bool		found_lower_saop_clause;
+	bool		found_saop_clause;
 	bool		pathkeys_possibly_useful;
 	bool		index_is_ordered;
 	bool		index_only_scan;
+	int			skip_prefix;
 	int			indexcol;
 
 	/*
@@ -917,10 +921,15 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 	 * We also build a Relids set showing which outer rels are required by the
 	 * selected clauses.  Any lateral_relids are included in that, but not
 	 * otherwise accounted for.
+	 *
+	 * skip_prefix is set to the number of leading index columns that have no
+	 * clauses, which is what a skip scan would have to skip over.
 	 */
 	index_clauses = NIL;
 	clause_columns = NIL;
 	found_lower_saop_clause = false;
+	found_saop_clause = false;
+	skip_prefix = 0;
 	outer_relids = bms_copy(rel->lateral_relids);
 	for (indexcol = 0; indexcol < index->ncolumns; indexcol++)
 	{
@@ -953,6 +962,7 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 					}
 					found_lower_saop_clause = true;
 				}
+				found_saop_clause = true;
 			}
 			index_clauses = lappend(index_clauses, rinfo);
 			clause_columns = lappend_int(clause_columns, indexcol);
@@ -970,6 +980,9 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 		 */
 		if (index_clauses == NIL && !index->amoptionalkey)
 			return NIL;
+
+		if (index_clauses == NIL)
+			skip_prefix = indexcol + 1;
 	}
 
 	/* We do not want the index's rel itself listed in outer_relids */
@@ -1045,6 +1058,7 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 								  ForwardScanDirection :
 								  NoMovementScanDirection,
 								  index_only_scan,
+								  0,
 								  outer_relids,
 								  loop_count,
 								  false);
@@ -1068,6 +1082,7 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 									  ForwardScanDirection :
 									  NoMovementScanDirection,
 									  index_only_scan,
+									  0,
 									  outer_relids,
 									  loop_count,
 									  true);
@@ -1081,6 +1096,35 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 			else
 				pfree(ipath);
 		}
+
+		/*
+		 * If there are clauses only on later index columns, a skip scan can
+		 * use them to avoid visiting most of the index, provided there are
+		 * not too many distinct values in the leading columns.  The cost
+		 * estimate decides whether that's so.  Skip scans preserve the
+		 * index ordering, so the pathkeys are the same as before.  We don't
+		 * attempt this with ScalarArrayOpExpr clauses, nor in parallel.
+		 */
+		if (enable_indexskipscan && index->amcanskip &&
+			index_clauses != NIL && skip_prefix > 0 &&
+			!found_saop_clause && scantype != ST_BITMAPSCAN)
+		{
+			ipath = create_index_path(root, index,
+									  index_clauses,
+									  clause_columns,
+									  orderbyclauses,
+									  orderbyclausecols,
+									  useful_pathkeys,
+									  index_is_ordered ?
+									  ForwardScanDirection :
+									  NoMovementScanDirection,
+									  index_only_scan,
+									  skip_prefix,
+									  outer_relids,
+									  loop_count,
+									  false);
+			result = lappend(result, ipath);
+		}
 	}
 
 	/*
@@ -1102,6 +1146,7 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 									  useful_pathkeys,
 									  BackwardScanDirection,
 									  index_only_scan,
+									  0,
 									  outer_relids,
 									  loop_count,
 									  false);
@@ -1120,6 +1165,7 @@ build_index_paths(PlannerInfo *root, RelOptInfo *rel,
 										  useful_pathkeys,
 										  BackwardScanDirection,
 										  index_only_scan,
+										  0,
 										  outer_relids,
 										  loop_count,
 										  true);
@@ -19,6 +19,7 @@
 #include <limits.h>
 #include <math.h>
 
+#include "access/htup_details.h"
 #include "access/stratnum.h"
 #include "access/sysattr.h"
 #include "catalog/pg_class.h"
@@ -171,12 +172,13 @@ static IndexScan *make_indexscan(List *qptlist, List *qpqual, Index scanrelid,
 			   Oid indexid, List *indexqual, List *indexqualorig,
 			   List *indexorderby, List *indexorderbyorig,
 			   List *indexorderbyops,
-			   ScanDirection indexscandir);
+			   ScanDirection indexscandir, int indexskipprefix);
 static IndexOnlyScan *make_indexonlyscan(List *qptlist, List *qpqual,
 				   Index scanrelid, Oid indexid,
 				   List *indexqual, List *indexorderby,
 				   List *indextlist,
-				   ScanDirection indexscandir);
+				   ScanDirection indexscandir,
+				   int indexskipprefix, bool indexskipdistinct);
 static BitmapIndexScan *make_bitmap_indexscan(Index scanrelid, Oid indexid,
 					  List *indexqual,
 					  List *indexqualorig);
@@ -282,6 +284,7 @@ static ModifyTable *make_modifytable(PlannerInfo *root,
 				 List *rowMarks, OnConflictExpr *onconflict, int epqParam);
 static GatherMerge *create_gather_merge_plan(PlannerInfo *root,
 						 GatherMergePath *best_path);
+static bool use_shared_sort(GatherMerge *gm_plan, Sort *sort);
 
 
 /*
@@ -1532,6 +1535,15 @@ create_gather_merge_plan(PlannerInfo *root, GatherMergePath *best_path)
 									 gm_plan->collations,
 									 gm_plan->nullsFirst);
 
+	/*
+	 * Since we merge whatever sorted streams the participants return, a Sort
+	 * just below us can be shared by them all, rather than each sorting its
+	 * own tuples; see nodeSort.c.
+	 */
+	if (IsA(subplan, Sort) &&
+		use_shared_sort(gm_plan, (Sort *) subplan))
+		((Sort *) subplan)->shared = true;
+
 	/* Now insert the subplan under GatherMerge. */
 	gm_plan->plan.lefttree = subplan;
 
@@ -1541,6 +1553,49 @@ create_gather_merge_plan(PlannerInfo *root, GatherMergePath *best_path)
 	return gm_plan;
 }
 
+/*
+ * use_shared_sort
+ *	  Decide whether the participants of a Gather Merge should share the
+ *	  Sort just below it.
+ *
+ * Only participants whose sorts spill to disk share them (see tuplesort.c),
+ * so there's nothing to gain unless the Sort is expected to spill.  Each of
+ * them then writes its sorted tuples out once more and reads them back, to
+ * trade key ranges with the others; in return, the streams reaching Gather
+ * Merge don't overlap, and it needs about one comparison per tuple rather
+ * than the log2(N) that cost_gather_merge charges.  Weigh the two, costing
+ * the extra pass over the data like cost_sort costs sequential I/O.
+ */
+static bool
+use_shared_sort(GatherMerge *gm_plan, Sort *sort)
+{
+	double		input_bytes;
+	double		npages;
+	double		N;
+	Cost		exchange_cost;
+	Cost		merge_saving;
+
+	if (gm_plan->num_workers <= 0)
+		return false;
+
+	/* The Sort's row estimate is per participant, as for any partial plan */
+	input_bytes = sort->plan.plan_rows *
+		(MAXALIGN(sort->plan.plan_width) + MAXALIGN(SizeofHeapTupleHeader));
+	if (input_bytes <= work_mem * 1024L)
+		return false;
+
+	/* Write and read back each participant's tuples */
+	npages = ceil(input_bytes / BLCKSZ);
+	exchange_cost = 2.0 * npages * seq_page_cost;
+
+	/* Comparisons saved in Gather Merge, which only the leader does */
+	N = (double) gm_plan->num_workers + 1;
+	merge_saving = gm_plan->plan.plan_rows * 2.0 * cpu_operator_cost *
+		(log(N) / log(2.0) - 1.0);
+
+	return exchange_cost < merge_saving;
+}
+
 /*
  * create_projection_plan
  *
@@ -2653,7 +2708,9 @@ create_indexscan_plan(PlannerInfo *root,
 												fixed_indexquals,
 												fixed_indexorderbys,
 												best_path->indexinfo->indextlist,
-												best_path->indexscandir);
+												best_path->indexscandir,
+												best_path->indexskipprefix,
+												best_path->indexskipdistinct);
 	else
 		scan_plan = (Scan *) make_indexscan(tlist,
 											qpqual,
@@ -2664,7 +2721,8 @@ create_indexscan_plan(PlannerInfo *root,
 											fixed_indexorderbys,
 											indexorderbys,
 											indexorderbyops,
-											best_path->indexscandir);
+											best_path->indexscandir,
+											best_path->indexskipprefix);
 
 	copy_generic_path_info(&scan_plan->plan, &best_path->path);
 
@@ -4993,7 +5051,8 @@ make_indexscan(List *qptlist,
 			   List *indexorderby,
 			   List *indexorderbyorig,
 			   List *indexorderbyops,
-			   ScanDirection indexscandir)
+			   ScanDirection indexscandir,
+			   int indexskipprefix)
 {
 	IndexScan  *node = makeNode(IndexScan);
 	Plan	   *plan = &node->scan.plan;
@@ -5010,6 +5069,7 @@ make_indexscan(List *qptlist,
 	node->indexorderbyorig = indexorderbyorig;
 	node->indexorderbyops = indexorderbyops;
 	node->indexorderdir = indexscandir;
+	node->indexskipprefix = indexskipprefix;
 
 	return node;
 }
@@ -5022,7 +5082,9 @@ make_indexonlyscan(List *qptlist,
 				   List *indexqual,
 				   List *indexorderby,
 				   List *indextlist,
-				   ScanDirection indexscandir)
+				   ScanDirection indexscandir,
+				   int indexskipprefix,
+				   bool indexskipdistinct)
 {
 	IndexOnlyScan *node = makeNode(IndexOnlyScan);
 	Plan	   *plan = &node->scan.plan;
@@ -5037,6 +5099,8 @@ make_indexonlyscan(List *qptlist,
 	node->indexorderby = indexorderby;
 	node->indextlist = indextlist;
 	node->indexorderdir = indexscandir;
+	node->indexskipprefix = indexskipprefix;
+	node->indexskipdistinct = indexskipdistinct;
 
 	return node;
 }
@@ -18,10 +18,13 @@
 #include <limits.h>
 #include <math.h>
 
+#include "access/genam.h"
+#include "access/heapam.h"
 #include "access/htup_details.h"
 #include "access/parallel.h"
 #include "access/sysattr.h"
 #include "access/xact.h"
+#include "catalog/pg_class.h"
 #include "catalog/pg_constraint_fn.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
@@ -164,6 +167,8 @@ static void create_one_window_path(PlannerInfo *root,
 					   List *activeWindows);
 static RelOptInfo *create_distinct_paths(PlannerInfo *root,
 					  RelOptInfo *input_rel);
+static Path *create_skip_distinct_path(PlannerInfo *root, Path *path,
+						  int prefix);
 static RelOptInfo *create_ordered_paths(PlannerInfo *root,
 					 RelOptInfo *input_rel,
 					 PathTarget *target,
@@ -4768,11 +4773,27 @@ create_distinct_paths(PlannerInfo *root,
 
 			if (pathkeys_contained_in(needed_pathkeys, path->pathkeys))
 			{
+				Path	   *skippath;
+
 				add_path(distinct_rel, (Path *)
 						 create_upper_unique_path(root, distinct_rel,
 												  path,
 												  list_length(root->distinct_pathkeys),
 												  numDistinctRows));
+
+				/*
+				 * An index that supports skip scans can also jump straight
+				 * from one distinct value to the next.  We still need the
+				 * Unique node, since the skipping is only an optimization.
+				 */
+				skippath = create_skip_distinct_path(root, path,
+													 list_length(root->distinct_pathkeys));
+				if (skippath)
+					add_path(distinct_rel, (Path *)
+							 create_upper_unique_path(root, distinct_rel,
+													  skippath,
+													  list_length(root->distinct_pathkeys),
+													  numDistinctRows));
 			}
 		}
 
@@ -4876,6 +4897,60 @@ create_distinct_paths(PlannerInfo *root,
 	return distinct_rel;
 }
 
+/*
+ * create_skip_distinct_path
+ *
+ * If 'path' is an index-only scan that could return just the first tuple for
+ * each distinct value of the leading 'prefix' index columns, make a copy of
+ * it that does so, else return NULL.  'path' must already be known to be
+ * sorted suitably for the DISTINCT.
+ *
+ * We insist that there be no quals on the prefix columns (the index AM
+ * couldn't skip over them) and none that would have to be checked by the
+ * executor (we mustn't skip over a group after a tuple that fails them).
+ */
+static Path *
+create_skip_distinct_path(PlannerInfo *root, Path *path, int prefix)
+{
+	IndexPath  *ipath;
+	IndexPath  *skippath;
+	ListCell   *lc;
+
+	if (!enable_indexskipscan || !IsA(path, IndexPath) ||
+		path->pathtype != T_IndexOnlyScan || path->param_info != NULL)
+		return NULL;
+
+	ipath = (IndexPath *) path;
+	if (!ipath->indexinfo->amcanskip ||
+		ipath->indexinfo->ncolumns < prefix ||
+		ipath->indexorderbys != NIL)
+		return NULL;
+
+	foreach(lc, ipath->indexqualcols)
+	{
+		if (lfirst_int(lc) < prefix)
+			return NULL;
+	}
+
+	foreach(lc, ipath->indexinfo->indrestrictinfo)
+	{
+		RestrictInfo *rinfo = (RestrictInfo *) lfirst(lc);
+
+		if (rinfo->pseudoconstant)
+			continue;
+		if (!list_member_ptr(ipath->indexquals, rinfo))
+			return NULL;
+	}
+
+	skippath = makeNode(IndexPath);
+	memcpy(skippath, ipath, sizeof(IndexPath));
+	skippath->indexskipprefix = prefix;
+	skippath->indexskipdistinct = true;
+	cost_index(skippath, root, 1.0, false);
+
+	return (Path *) skippath;
+}
+
 /*
  * create_ordered_paths
  *
@@ -6065,12 +6140,147 @@ plan_cluster_use_sort(Oid tableOid, Oid indexOid)
 	/* Estimate the cost of index scan */
 	indexScanPath = create_index_path(root, indexInfo,
 									  NIL, NIL, NIL, NIL, NIL,
-									  ForwardScanDirection, false,
+									  ForwardScanDirection, false, 0,
 									  NULL, 1.0, false);
 
 	return (seqScanAndSortPath.total_cost < indexScanPath->path.total_cost);
 }
 
+/*
+ * plan_create_index_workers
+ *		Use the planner to decide how many parallel worker processes
+ *		CREATE INDEX should request for use
+ *
+ * tableOid is the table on which the index is to be built.  indexOid is the
+ * OID of an index to be created or reindexed (which must be an index whose
+ * access method supports parallel builds).
+ *
+ * Return value is the number of parallel worker processes to request.  It
+ * may be unsafe to proceed if this is 0.  Note that this does not include the
+ * leader participating as a worker (value is always a number of parallel
+ * worker processes).
+ *
+ * Note: caller had better already hold some type of lock on the table and
+ * index.
+ */
+int
+plan_create_index_workers(Oid tableOid, Oid indexOid)
+{
+	PlannerInfo *root;
+	Query	   *query;
+	PlannerGlobal *glob;
+	RangeTblEntry *rte;
+	Relation	heap;
+	Relation	index;
+	RelOptInfo *rel;
+	int			parallel_workers;
+	BlockNumber heap_blocks;
+	double		reltuples;
+	double		allvisfrac;
+
+	/*
+	 * Return immediately when parallelism is disabled, or can't be used for
+	 * the same reasons standard_planner() wouldn't use it for a query.
+	 */
+	if (max_parallel_maintenance_workers == 0 ||
+		!IsUnderPostmaster ||
+		dynamic_shared_memory_type == DSM_IMPL_NONE ||
+		IsParallelWorker() ||
+		IsolationIsSerializable())
+		return 0;
+
+	/* Set up largely-dummy planner state */
+	query = makeNode(Query);
+	query->commandType = CMD_SELECT;
+
+	glob = makeNode(PlannerGlobal);
+
+	root = makeNode(PlannerInfo);
+	root->parse = query;
+	root->glob = glob;
+	root->query_level = 1;
+	root->planner_cxt = CurrentMemoryContext;
+	root->wt_param_id = -1;
+
+	/* Build a minimal RTE for the rel */
+	rte = makeNode(RangeTblEntry);
+	rte->rtekind = RTE_RELATION;
+	rte->relid = tableOid;
+	rte->relkind = RELKIND_RELATION;	/* Don't be too picky. */
+	rte->lateral = false;
+	rte->inh = true;
+	rte->inFromCl = true;
+	query->rtable = list_make1(rte);
+
+	/* Set up RTE/RelOptInfo arrays */
+	setup_simple_rel_arrays(root);
+
+	/* Build RelOptInfo */
+	rel = build_simple_rel(root, 1, NULL);
+
+	heap = heap_open(tableOid, NoLock);
+	index = index_open(indexOid, NoLock);
+
+	/*
+	 * Determine if it's safe to proceed.
+	 *
+	 * Currently, parallel workers can't access the leader's temporary tables.
+	 * Furthermore, any index predicate or index expressions must be parallel
+	 * safe.
+	 */
+	if (heap->rd_rel->relpersistence == RELPERSISTENCE_TEMP ||
+		!is_parallel_safe(root, (Node *) RelationGetIndexExpressions(index)) ||
+		!is_parallel_safe(root, (Node *) RelationGetIndexPredicate(index)))
+	{
+		parallel_workers = 0;
+		goto done;
+	}
+
+	/*
+	 * If parallel_workers storage parameter is set for the table, accept that
+	 * as the number of parallel worker processes to launch (though still cap
+	 * at max_parallel_maintenance_workers).
+	 */
+	if (rel->rel_parallel_workers != -1)
+	{
+		parallel_workers = Min(rel->rel_parallel_workers,
+							   max_parallel_maintenance_workers);
+		goto done;
+	}
+
+	/*
+	 * Estimate heap relation size ourselves, since rel->pages cannot be
+	 * trusted (heap RTE was marked as inheritance parent)
+	 */
+	estimate_rel_size(heap, NULL, &heap_blocks, &reltuples, &allvisfrac);
+
+	/*
+	 * Determine number of workers to scan the heap relation using generic
+	 * model
+	 */
+	parallel_workers = compute_parallel_worker(rel, heap_blocks, -1,
+											   max_parallel_maintenance_workers);
+
+	/*
+	 * Cap workers based on available maintenance_work_mem as needed.
+	 *
+	 * Each participant (including the leader) receives an even share of the
+	 * total maintenance_work_mem budget.  Aim to leave participants with no
+	 * less than 32MB of memory, so that the per-participant accumulation
+	 * buffers don't become so small that workers spend most of their time
+	 * flushing tiny runs.
+	 */
+	while (parallel_workers > 0 &&
+		   maintenance_work_mem / (parallel_workers + 1) < 32768L)
+		parallel_workers--;
+
+done:
+	index_close(index, NoLock);
+	heap_close(heap, NoLock);
+
+	return parallel_workers;
+}
+
 /*
  * get_partitioned_child_rels
  *		Returns a list of the RT indexes of the partitioned child relations
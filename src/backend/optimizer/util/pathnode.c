@@ -997,6 +997,8 @@ create_samplescan_path(PlannerInfo *root, RelOptInfo *rel, Relids required_outer
  *			for an ordered index, or NoMovementScanDirection for
  *			an unordered index.
  * 'indexonly' is true if an index-only scan is wanted.
+ * 'skipprefix' is the number of leading index columns to skip over,
+ *			or zero if a skip scan is not wanted.
  * 'required_outer' is the set of outer relids for a parameterized path.
  * 'loop_count' is the number of repetitions of the indexscan to factor into
  *		estimates of caching behavior.
@@ -1014,6 +1016,7 @@ create_index_path(PlannerInfo *root,
 				  List *pathkeys,
 				  ScanDirection indexscandir,
 				  bool indexonly,
+				  int skipprefix,
 				  Relids required_outer,
 				  double loop_count,
 				  bool partial_path)
@@ -1045,6 +1048,8 @@ create_index_path(PlannerInfo *root,
 	pathnode->indexorderbys = indexorderbys;
 	pathnode->indexorderbycols = indexorderbycols;
 	pathnode->indexscandir = indexscandir;
+	pathnode->indexskipprefix = skipprefix;
+	pathnode->indexskipdistinct = false;
 
 	cost_index(pathnode, root, loop_count, partial_path);
 
@@ -29,6 +29,7 @@
 #include "access/amapi.h"
 #include "access/htup_details.h"
 #include "access/reloptions.h"
+#include "access/tuptoaster.h"
 #include "catalog/dependency.h"
 #include "catalog/heap.h"
 #include "catalog/index.h"
@@ -1062,9 +1063,14 @@ transformTableLikeClause(CreateStmtContext *cxt, TableLikeClause *table_like_cla
 			def->identity = attribute->attidentity;
 		}
 
-		/* Likewise, copy storage if requested */
+		/* Likewise, copy storage and compression method if requested */
 		if (table_like_clause->options & CREATE_TABLE_LIKE_STORAGE)
+		{
 			def->storage = attribute->attstorage;
+			if (CompressionMethodIsValid(attribute->attcompression))
+				def->compression =
+					pstrdup(GetCompressionMethodName(attribute->attcompression));
+		}
 		else
 			def->storage = 0;
 
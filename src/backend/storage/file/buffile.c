@@ -31,6 +31,11 @@
  * BufFile also supports temporary files that exceed the OS file size limit
  * (by opening multiple fd.c temporary files).  This is an essential feature
  * for sorts and hashjoins on large amounts of data.
+ *
+ * A "shared" BufFile is a temporary BufFile with a name, written by one
+ * backend and then read by any number of backends cooperating in a parallel
+ * operation.  Its segment files are named name.0, name.1, and so on, and are
+ * only deleted by BufFileDeleteShared.
  *-------------------------------------------------------------------------
  */
 
@@ -72,6 +77,10 @@ struct BufFile
 	bool		isInterXact;	/* keep open over transactions? */
 	bool		dirty;			/* does buffer need to be written? */
 
+	/* for a shared BufFile, where its segments are and what they're called */
+	Oid			tblspcOid;
+	char	   *name;			/* NULL if not shared */
+
 	/*
 	 * resowner is the ResourceOwner to use for underlying temp files.  (We
 	 * don't need to remember the memory context we're using explicitly,
@@ -91,6 +100,7 @@ struct BufFile
 };
 
 static BufFile *makeBufFile(File firstfile);
+static void SharedSegmentName(char *segname, const char *name, int segno);
 static void extendBufFile(BufFile *file);
 static void BufFileLoadBuffer(BufFile *file);
 static void BufFileDumpBuffer(BufFile *file);
@@ -114,6 +124,8 @@ makeBufFile(File firstfile)
 	file->isTemp = false;
 	file->isInterXact = false;
 	file->dirty = false;
+	file->tblspcOid = InvalidOid;
+	file->name = NULL;
 	file->resowner = CurrentResourceOwner;
 	file->curFile = 0;
 	file->curOffset = 0L;
@@ -137,7 +149,15 @@ extendBufFile(BufFile *file)
 	CurrentResourceOwner = file->resowner;
 
 	Assert(file->isTemp);
-	pfile = OpenTemporaryFile(file->isInterXact);
+	if (file->name != NULL)
+	{
+		char		segname[MAXPGPATH];
+
+		SharedSegmentName(segname, file->name, file->numFiles);
+		pfile = CreateSharedTemporaryFile(file->tblspcOid, segname);
+	}
+	else
+		pfile = OpenTemporaryFile(file->isInterXact);
 	Assert(pfile >= 0);
 
 	CurrentResourceOwner = oldowner;
@@ -179,6 +199,99 @@ BufFileCreateTemp(bool interXact)
 	return file;
 }
 
+/*
+ * Build the name of one segment file of a shared BufFile.
+ */
+static void
+SharedSegmentName(char *segname, const char *name, int segno)
+{
+	snprintf(segname, MAXPGPATH, "%s.%d", name, segno);
+}
+
+/*
+ * Create a shared BufFile, in the given tablespace's temporary file
+ * directory.  The name must be unique within the database instance, and
+ * should begin with PG_TEMP_FILE_PREFIX; see CreateSharedTemporaryFile.
+ *
+ * The file is not deleted when it is closed.  Once the creator has written
+ * it and closed it, other backends may open it with BufFileOpenShared.
+ */
+BufFile *
+BufFileCreateShared(Oid tblspcOid, const char *name)
+{
+	BufFile    *file;
+	File		pfile;
+	char		segname[MAXPGPATH];
+
+	SharedSegmentName(segname, name, 0);
+	pfile = CreateSharedTemporaryFile(tblspcOid, segname);
+
+	file = makeBufFile(pfile);
+	file->isTemp = true;
+	file->tblspcOid = tblspcOid;
+	file->name = pstrdup(name);
+
+	return file;
+}
+
+/*
+ * Open, for reading only, a shared BufFile that has been written and closed
+ * by its creator.
+ */
+BufFile *
+BufFileOpenShared(Oid tblspcOid, const char *name)
+{
+	BufFile    *file = NULL;
+	char		segname[MAXPGPATH];
+	File		pfile;
+	int			segno;
+
+	for (segno = 0;; segno++)
+	{
+		SharedSegmentName(segname, name, segno);
+		pfile = OpenSharedTemporaryFile(tblspcOid, segname, segno > 0);
+		if (pfile < 0)
+			break;
+
+		if (file == NULL)
+			file = makeBufFile(pfile);
+		else
+		{
+			file->files = (File *) repalloc(file->files,
+											(file->numFiles + 1) * sizeof(File));
+			file->offsets = (off_t *) repalloc(file->offsets,
+											   (file->numFiles + 1) * sizeof(off_t));
+			file->files[file->numFiles] = pfile;
+			file->offsets[file->numFiles] = 0L;
+			file->numFiles++;
+		}
+	}
+
+	file->isTemp = true;
+	file->tblspcOid = tblspcOid;
+	file->name = pstrdup(name);
+
+	return file;
+}
+
+/*
+ * Delete all segments of a shared BufFile.  Backends that still have it
+ * open must not try to read it afterwards.
+ */
+void
+BufFileDeleteShared(Oid tblspcOid, const char *name)
+{
+	char		segname[MAXPGPATH];
+	int			segno;
+
+	for (segno = 0;; segno++)
+	{
+		SharedSegmentName(segname, name, segno);
+		if (!DeleteSharedTemporaryFile(tblspcOid, segname))
+			break;
+	}
+}
+
 #ifdef NOT_USED
 /*
  * Create a BufFile and attach it to an already-opened virtual File.
@@ -212,6 +325,8 @@ BufFileClose(BufFile *file)
 	/* release the buffer space */
 	pfree(file->files);
 	pfree(file->offsets);
+	if (file->name)
+		pfree(file->name);
 	pfree(file);
 }
 
@@ -39,6 +39,11 @@
  * for a long time, like relation files. It is the caller's responsibility
  * to close them, there is no automatic mechanism in fd.c for that.
  *
+ * CreateSharedTemporaryFile and OpenSharedTemporaryFile are for temporary
+ * files that several backends cooperating in a parallel operation use.  They
+ * are closed automatically like OpenTemporaryFile's files, but are only
+ * deleted by an explicit DeleteSharedTemporaryFile.
+ *
  * AllocateFile, AllocateDir, OpenPipeStream and OpenTransientFile are
  * wrappers around fopen(3), opendir(3), popen(3) and open(2), respectively.
  * They behave like the corresponding native functions, except that the handle
@@ -172,6 +177,8 @@ int			max_safe_fds = 32;	/* default if not changed */
 /* these are the assigned bits in fdstate below: */
 #define FD_TEMPORARY		(1 << 0)	/* T = delete when closed */
 #define FD_XACT_TEMPORARY	(1 << 1)	/* T = delete at eoXact */
+#define FD_TEMP_FILE_LIMIT	(1 << 2)	/* T = respect temp_file_limit */
+#define FD_SHARED_TEMPORARY	(1 << 3)	/* T = made by CreateSharedTemporaryFile */
 
 typedef struct vfd
 {
@@ -216,6 +223,22 @@ static bool have_xact_temporary_files = false;
  */
 static uint64 temporary_files_size = 0;
 
+/*
+ * Files that this backend made with CreateSharedTemporaryFile and has since
+ * closed, but that haven't been deleted yet.  Their sizes are still included
+ * in temporary_files_size, until DeleteSharedTemporaryFile or the end of the
+ * transaction.  The list is malloc'd, like VFD file names, since it may be
+ * added to during transaction abort.
+ */
+typedef struct SharedTempFileCharge
+{
+	struct SharedTempFileCharge *next;
+	off_t		size;			/* amount included in temporary_files_size */
+	char		path[FLEXIBLE_ARRAY_MEMBER];
+} SharedTempFileCharge;
+
+static SharedTempFileCharge *sharedTempFileCharges = NULL;
+
 /*
  * List of OS handles opened with AllocateFile, AllocateDir and
  * OpenTransientFile.
@@ -301,7 +324,11 @@ static File AllocateVfd(void);
 static void FreeVfd(File file);
 
 static int	FileAccess(File file);
+static void TempTablespacePath(char *path, Oid tblspcOid);
 static File OpenTemporaryFileInTablespace(Oid tblspcOid, bool rejectError);
+static bool DeleteTemporaryFile(const char *path, bool missing_ok);
+static void RememberSharedTempFileCharge(const char *path, off_t size);
+static void ForgetSharedTempFileCharges(const char *path);
 static bool reserveAllocatedDesc(void);
 static int	FreeDesc(AllocateDesc *desc);
 static struct dirent *ReadDirExtended(DIR *dir, const char *dirname, int elevel);
@@ -1400,8 +1427,8 @@ OpenTemporaryFile(bool interXact)
 											 DEFAULTTABLESPACE_OID,
 											 true);
 
-	/* Mark it for deletion at close */
-	VfdCache[file].fdstate |= FD_TEMPORARY;
+	/* Mark it for deletion at close and temporary file size limit */
+	VfdCache[file].fdstate |= FD_TEMPORARY | FD_TEMP_FILE_LIMIT;
 
 	/* Register it with the current resource owner */
 	if (!interXact)
@@ -1420,34 +1447,39 @@ OpenTemporaryFile(bool interXact)
 }
 
 /*
- * Open a temporary file in a specific tablespace.
- * Subroutine for OpenTemporaryFile, which see for details.
+ * Identify the tempfile directory for a tablespace.
+ *
+ * If someone tries to specify pg_global, use pg_default instead.
  */
-static File
-OpenTemporaryFileInTablespace(Oid tblspcOid, bool rejectError)
+static void
+TempTablespacePath(char *path, Oid tblspcOid)
 {
-	char		tempdirpath[MAXPGPATH];
-	char		tempfilepath[MAXPGPATH];
-	File		file;
-
-	/*
-	 * Identify the tempfile directory for this tablespace.
-	 *
-	 * If someone tries to specify pg_global, use pg_default instead.
-	 */
 	if (tblspcOid == DEFAULTTABLESPACE_OID ||
 		tblspcOid == GLOBALTABLESPACE_OID)
 	{
 		/* The default tablespace is {datadir}/base */
-		snprintf(tempdirpath, sizeof(tempdirpath), "base/%s",
-				 PG_TEMP_FILES_DIR);
+		snprintf(path, MAXPGPATH, "base/%s", PG_TEMP_FILES_DIR);
 	}
 	else
 	{
 		/* All other tablespaces are accessed via symlinks */
-		snprintf(tempdirpath, sizeof(tempdirpath), "pg_tblspc/%u/%s/%s",
+		snprintf(path, MAXPGPATH, "pg_tblspc/%u/%s/%s",
 				 tblspcOid, TABLESPACE_VERSION_DIRECTORY, PG_TEMP_FILES_DIR);
 	}
+}
+
+/*
+ * Open a temporary file in a specific tablespace.
+ * Subroutine for OpenTemporaryFile, which see for details.
+ */
+static File
+OpenTemporaryFileInTablespace(Oid tblspcOid, bool rejectError)
+{
+	char		tempdirpath[MAXPGPATH];
+	char		tempfilepath[MAXPGPATH];
+	File		file;
+
+	TempTablespacePath(tempdirpath, tblspcOid);
 
 	/*
 	 * Generate a tempfile name that should be unique within the current
@@ -1486,6 +1518,195 @@ OpenTemporaryFileInTablespace(Oid tblspcOid, bool rejectError)
 	return file;
 }
 
+/*
+ * Create a temporary file with a caller-chosen name, so that other backends
+ * cooperating in a parallel operation can open it by name.
+ *
+ * The name should start with PG_TEMP_FILE_PREFIX, so that the file is
+ * removed at server restart if nothing else removes it, and it must be unique
+ * within the database instance.  Unlike OpenTemporaryFile, the file is not
+ * deleted when closed, since other backends may still want to read it; the
+ * creator arranges for DeleteSharedTemporaryFile to be called once everyone
+ * is done with it.  The File is still closed by the current resource owner,
+ * but what we wrote to it counts against our temp_file_limit until it is
+ * deleted.
+ */
+File
+CreateSharedTemporaryFile(Oid tblspcOid, const char *name)
+{
+	char		tempdirpath[MAXPGPATH];
+	char		tempfilepath[MAXPGPATH];
+	File		file;
+
+	TempTablespacePath(tempdirpath, tblspcOid);
+	snprintf(tempfilepath, sizeof(tempfilepath), "%s/%s", tempdirpath, name);
+
+	file = PathNameOpenFile(tempfilepath,
+							O_RDWR | O_CREAT | O_TRUNC | PG_BINARY,
+							0600);
+	if (file <= 0)
+	{
+		/* As above, the tempfile directory might not exist yet */
+		mkdir(tempdirpath, S_IRWXU);
+
+		file = PathNameOpenFile(tempfilepath,
+								O_RDWR | O_CREAT | O_TRUNC | PG_BINARY,
+								0600);
+		if (file <= 0)
+			elog(ERROR, "could not create temporary file \"%s\": %m",
+				 tempfilepath);
+	}
+
+	VfdCache[file].fdstate |= FD_TEMP_FILE_LIMIT | FD_SHARED_TEMPORARY;
+
+	ResourceOwnerEnlargeFiles(CurrentResourceOwner);
+	ResourceOwnerRememberFile(CurrentResourceOwner, file);
+	VfdCache[file].resowner = CurrentResourceOwner;
+
+	return file;
+}
+
+/*
+ * Open, read-only, a file made by CreateSharedTemporaryFile, possibly in
+ * another backend.  If missing_ok is true, returns -1 if there is no such
+ * file.
+ */
+File
+OpenSharedTemporaryFile(Oid tblspcOid, const char *name, bool missing_ok)
+{
+	char		tempdirpath[MAXPGPATH];
+	char		tempfilepath[MAXPGPATH];
+	File		file;
+
+	TempTablespacePath(tempdirpath, tblspcOid);
+	snprintf(tempfilepath, sizeof(tempfilepath), "%s/%s", tempdirpath, name);
+
+	file = PathNameOpenFile(tempfilepath, O_RDONLY | PG_BINARY, 0);
+	if (file <= 0)
+	{
+		if (missing_ok && errno == ENOENT)
+			return -1;
+		elog(ERROR, "could not open temporary file \"%s\": %m",
+			 tempfilepath);
+	}
+
+	ResourceOwnerEnlargeFiles(CurrentResourceOwner);
+	ResourceOwnerRememberFile(CurrentResourceOwner, file);
+	VfdCache[file].resowner = CurrentResourceOwner;
+
+	return file;
+}
+
+/*
+ * Delete a file made by CreateSharedTemporaryFile.  Returns false if there
+ * was no such file.
+ */
+bool
+DeleteSharedTemporaryFile(Oid tblspcOid, const char *name)
+{
+	char		tempdirpath[MAXPGPATH];
+	char		tempfilepath[MAXPGPATH];
+
+	TempTablespacePath(tempdirpath, tblspcOid);
+	snprintf(tempfilepath, sizeof(tempfilepath), "%s/%s", tempdirpath, name);
+
+	ForgetSharedTempFileCharges(tempfilepath);
+
+	return DeleteTemporaryFile(tempfilepath, true);
+}
+
+/*
+ * Keep the size of a closed shared temporary file charged to this backend.
+ * If we can't remember it, we just stop counting it.
+ */
+static void
+RememberSharedTempFileCharge(const char *path, off_t size)
+{
+	SharedTempFileCharge *charge;
+
+	charge = (SharedTempFileCharge *)
+		malloc(offsetof(SharedTempFileCharge, path) + strlen(path) + 1);
+	if (charge == NULL)
+	{
+		temporary_files_size -= size;
+		return;
+	}
+	charge->size = size;
+	strcpy(charge->path, path);
+	charge->next = sharedTempFileCharges;
+	sharedTempFileCharges = charge;
+}
+
+/*
+ * Stop charging this backend for a shared temporary file, or for all of them
+ * if path is NULL.
+ */
+static void
+ForgetSharedTempFileCharges(const char *path)
+{
+	SharedTempFileCharge **prev = &sharedTempFileCharges;
+
+	while (*prev != NULL)
+	{
+		SharedTempFileCharge *charge = *prev;
+
+		if (path == NULL || strcmp(charge->path, path) == 0)
+		{
+			temporary_files_size -= charge->size;
+			*prev = charge->next;
+			free(charge);
+		}
+		else
+			prev = &charge->next;
+	}
+}
+
+/*
+ * Unlink a temporary file, and report its size to the stats collector and,
+ * if log_temp_files says so, to the log.  Returns false if missing_ok and the
+ * file didn't exist.
+ */
+static bool
+DeleteTemporaryFile(const char *path, bool missing_ok)
+{
+	struct stat filestats;
+	int			stat_errno;
+
+	/* first try the stat() */
+	if (stat(path, &filestats))
+		stat_errno = errno;
+	else
+		stat_errno = 0;
+
+	if (missing_ok && stat_errno == ENOENT)
+		return false;
+
+	/* in any case do the unlink */
+	if (unlink(path))
+		elog(LOG, "could not unlink file \"%s\": %m", path);
+
+	/* and last report the stat results */
+	if (stat_errno == 0)
+	{
+		pgstat_report_tempfile(filestats.st_size);
+
+		if (log_temp_files >= 0)
+		{
+			if ((filestats.st_size / 1024) >= log_temp_files)
+				ereport(LOG,
+						(errmsg("temporary file: path \"%s\", size %lu",
+								path, (unsigned long) filestats.st_size)));
+		}
+	}
+	else
+	{
+		errno = stat_errno;
+		elog(LOG, "could not stat file \"%s\": %m", path);
+	}
+
+	return true;
+}
+
 /*
  * close a file when done with it
  */
@@ -1514,14 +1735,25 @@ FileClose(File file)
 		Delete(file);
 	}
 
+	/*
+	 * Subtract its size from current usage of temporary files, unless it's a
+	 * shared temporary file, which still exists until it's explicitly deleted
+	 */
+	if (vfdP->fdstate & FD_TEMP_FILE_LIMIT)
+	{
+		if ((vfdP->fdstate & FD_SHARED_TEMPORARY) && vfdP->fileSize > 0)
+			RememberSharedTempFileCharge(vfdP->fileName, vfdP->fileSize);
+		else
+			temporary_files_size -= vfdP->fileSize;
+		vfdP->fileSize = 0;
+		vfdP->fdstate &= ~FD_TEMP_FILE_LIMIT;
+	}
+
 	/*
 	 * Delete the file if it was temporary, and make a log entry if wanted
 	 */
 	if (vfdP->fdstate & FD_TEMPORARY)
 	{
-		struct stat filestats;
-		int			stat_errno;
-
 		/*
 		 * If we get an error, as could happen within the ereport/elog calls,
 		 * we'll come right back here during transaction abort.  Reset the
@@ -1531,39 +1763,7 @@ FileClose(File file)
 		 */
 		vfdP->fdstate &= ~FD_TEMPORARY;
 
-		/* Subtract its size from current usage (do first in case of error) */
-		temporary_files_size -= vfdP->fileSize;
-		vfdP->fileSize = 0;
-
-		/* first try the stat() */
-		if (stat(vfdP->fileName, &filestats))
-			stat_errno = errno;
-		else
-			stat_errno = 0;
-
-		/* in any case do the unlink */
-		if (unlink(vfdP->fileName))
-			elog(LOG, "could not unlink file \"%s\": %m", vfdP->fileName);
-
-		/* and last report the stat results */
-		if (stat_errno == 0)
-		{
-			pgstat_report_tempfile(filestats.st_size);
-
-			if (log_temp_files >= 0)
-			{
-				if ((filestats.st_size / 1024) >= log_temp_files)
-					ereport(LOG,
-							(errmsg("temporary file: path \"%s\", size %lu",
-									vfdP->fileName,
-									(unsigned long) filestats.st_size)));
-			}
-		}
-		else
-		{
-			errno = stat_errno;
-			elog(LOG, "could not stat file \"%s\": %m", vfdP->fileName);
-		}
+		(void) DeleteTemporaryFile(vfdP->fileName, false);
 	}
 
 	/* Unregister it from the resource owner */
@@ -1732,7 +1932,7 @@ FileWrite(File file, char *buffer, int amount, uint32 wait_event_info)
 	 * message if we do that.  All current callers would just throw error
 	 * immediately anyway, so this is safe at present.
 	 */
-	if (temp_file_limit >= 0 && (vfdP->fdstate & FD_TEMPORARY))
+	if (temp_file_limit >= 0 && (vfdP->fdstate & FD_TEMP_FILE_LIMIT))
 	{
 		off_t		newPos;
 
@@ -1785,7 +1985,7 @@ retry:
 		 * get here in that state if we're not enforcing temporary_files_size,
 		 * so we don't care.
 		 */
-		if (vfdP->fdstate & FD_TEMPORARY)
+		if (vfdP->fdstate & FD_TEMP_FILE_LIMIT)
 		{
 			off_t		newPos = vfdP->seekPos;
 
@@ -1956,7 +2156,7 @@ FileTruncate(File file, off_t offset, uint32 wait_event_info)
 	if (returnCode == 0 && VfdCache[file].fileSize > offset)
 	{
 		/* adjust our state for truncation of a temp file */
-		Assert(VfdCache[file].fdstate & FD_TEMPORARY);
+		Assert(VfdCache[file].fdstate & FD_TEMP_FILE_LIMIT);
 		temporary_files_size -= VfdCache[file].fileSize - offset;
 		VfdCache[file].fileSize = offset;
 	}
@@ -2611,12 +2811,15 @@ AtEOSubXact_Files(bool isCommit, SubTransactionId mySubid,
  * VFDs are closed, which also causes the underlying files to be deleted
  * (although they should've been closed already by the ResourceOwner
  * cleanup). Furthermore, all "allocated" stdio files are closed. We also
- * forget any transaction-local temp tablespace list.
+ * forget any transaction-local temp tablespace list, and stop charging for
+ * shared temporary files that nobody deleted (they should've been deleted
+ * already by whatever shared memory segment they belonged to).
  */
 void
 AtEOXact_Files(void)
 {
 	CleanupTempFiles(false);
+	ForgetSharedTempFileCharges(NULL);
 	tempTableSpaces = NULL;
 	numTempTableSpaces = -1;
 }
@@ -1353,6 +1353,22 @@ LockCheckConflicts(LockMethod lockMethodTable,
 		return STATUS_FOUND;
 	}
 
+	/*
+	 * Relation extension and page locks protect physical structures, not
+	 * logical state shared by the group, so they conflict even between
+	 * members of a lock group; otherwise two workers inserting into the same
+	 * relation could both extend it with the same block.  They are held only
+	 * briefly, and no other heavyweight lock is awaited while holding one,
+	 * so this can't create a deadlock within the group.
+	 */
+	if ((LockTagType) lock->tag.locktag_type == LOCKTAG_RELATION_EXTEND ||
+		(LockTagType) lock->tag.locktag_type == LOCKTAG_PAGE)
+	{
+		PROCLOCK_PRINT("LockCheckConflicts: conflicting (group)",
+					   proclock);
+		return STATUS_FOUND;
+	}
+
 	/*
 	 * Locks held in conflicting modes by members of our own lock group are
 	 * not real conflicts; we can subtract those out and see if we still have
@@ -494,7 +494,7 @@ RegisterLWLockTranches(void)
 
 	if (LWLockTrancheArray == NULL)
 	{
-		LWLockTranchesAllocated = 64;
+		LWLockTranchesAllocated = 128;
 		LWLockTrancheArray = (char **)
 			MemoryContextAllocZero(TopMemoryContext,
 								   LWLockTranchesAllocated * sizeof(char *));
@@ -512,6 +512,21 @@ RegisterLWLockTranches(void)
 						  "parallel_query_dsa");
 	LWLockRegisterTranche(LWTRANCHE_TBM, "tbm");
 
+	/*
+	 * SLRU bank locks.  These took over the job of the per-SLRU control locks
+	 * that used to be individual LWLocks, so keep the old names for the
+	 * benefit of monitoring tools.
+	 */
+	LWLockRegisterTranche(LWTRANCHE_CLOG_BANK, "CLogControlLock");
+	LWLockRegisterTranche(LWTRANCHE_COMMITTS_BANK, "CommitTsControlLock");
+	LWLockRegisterTranche(LWTRANCHE_SUBTRANS_BANK, "SubtransControlLock");
+	LWLockRegisterTranche(LWTRANCHE_MXACTOFFSET_BANK,
+						  "MultiXactOffsetControlLock");
+	LWLockRegisterTranche(LWTRANCHE_MXACTMEMBER_BANK,
+						  "MultiXactMemberControlLock");
+	LWLockRegisterTranche(LWTRANCHE_ASYNC_BANK, "AsyncCtlLock");
+	LWLockRegisterTranche(LWTRANCHE_OLDSERXID_BANK, "OldSerXidSlruLock");
+
 	/* Register named tranches. */
 	for (i = 0; i < NamedLWLockTrancheRequests; i++)
 		LWLockRegisterTranche(NamedLWLockTrancheArray[i].trancheId,
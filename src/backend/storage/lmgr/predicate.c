@@ -806,8 +806,8 @@ OldSerXidInit(void)
 	 */
 	OldSerXidSlruCtl->PagePrecedes = OldSerXidPagePrecedesLogically;
 	SimpleLruInit(OldSerXidSlruCtl, "oldserxid",
-				  NUM_OLDSERXID_BUFFERS, 0, OldSerXidLock, "pg_serial",
-				  LWTRANCHE_OLDSERXID_BUFFERS);
+				  serializable_buffers, 0, "pg_serial",
+				  LWTRANCHE_OLDSERXID_BUFFERS, LWTRANCHE_OLDSERXID_BANK);
 	/* Override default assumption that writes should be fsync'd */
 	OldSerXidSlruCtl->do_fsync = false;
 
@@ -843,11 +843,16 @@ OldSerXidAdd(TransactionId xid, SerCommitSeqNo minConflictCommitSeqNo)
 	int			slotno;
 	int			firstZeroPage;
 	bool		isNewPage;
+	LWLock	   *lock;
 
 	Assert(TransactionIdIsValid(xid));
 
 	targetPage = OldSerXidPage(xid);
 
+	/*
+	 * OldSerXidLock protects oldSerXidControl; the SLRU pages themselves are
+	 * protected by the bank locks, which we acquire while holding it.
+	 */
 	LWLockAcquire(OldSerXidLock, LW_EXCLUSIVE);
 
 	/*
@@ -925,20 +930,30 @@ OldSerXidAdd(TransactionId xid, SerCommitSeqNo minConflictCommitSeqNo)
 
 	if (isNewPage)
 	{
-		/* Initialize intervening pages. */
+		/* Initialize intervening pages, one bank lock at a time. */
 		while (firstZeroPage != targetPage)
 		{
+			lock = SimpleLruGetBankLock(OldSerXidSlruCtl, firstZeroPage);
+			LWLockAcquire(lock, LW_EXCLUSIVE);
 			(void) SimpleLruZeroPage(OldSerXidSlruCtl, firstZeroPage);
+			LWLockRelease(lock);
 			firstZeroPage = OldSerXidNextPage(firstZeroPage);
 		}
+		lock = SimpleLruGetBankLock(OldSerXidSlruCtl, targetPage);
+		LWLockAcquire(lock, LW_EXCLUSIVE);
 		slotno = SimpleLruZeroPage(OldSerXidSlruCtl, targetPage);
 	}
 	else
+	{
+		lock = SimpleLruGetBankLock(OldSerXidSlruCtl, targetPage);
+		LWLockAcquire(lock, LW_EXCLUSIVE);
 		slotno = SimpleLruReadPage(OldSerXidSlruCtl, targetPage, true, xid);
+	}
 
 	OldSerXidValue(slotno, xid) = minConflictCommitSeqNo;
 	OldSerXidSlruCtl->shared->page_dirty[slotno] = true;
 
+	LWLockRelease(lock);
 	LWLockRelease(OldSerXidLock);
 }
 
@@ -972,13 +987,14 @@ OldSerXidGetMinConflictCommitSeqNo(TransactionId xid)
 		return 0;
 
 	/*
-	 * The following function must be called without holding OldSerXidLock,
-	 * but will return with that lock held, which must then be released.
+	 * The following function must be called without holding the SLRU bank
+	 * lock, but will return with that lock held, which must then be
+	 * released.
 	 */
 	slotno = SimpleLruReadPage_ReadOnly(OldSerXidSlruCtl,
 										OldSerXidPage(xid), xid);
 	val = OldSerXidValue(slotno, xid);
-	LWLockRelease(OldSerXidLock);
+	LWLockRelease(SimpleLruGetBankLock(OldSerXidSlruCtl, OldSerXidPage(xid)));
 	return val;
 }
 
@@ -1351,7 +1367,7 @@ PredicateLockShmemSize(void)
 
 	/* Shared memory structures for SLRU tracking of old committed xids. */
 	size = add_size(size, sizeof(OldSerXidControlData));
-	size = add_size(size, SimpleLruShmemSize(NUM_OLDSERXID_BUFFERS, 0));
+	size = add_size(size, SimpleLruShmemSize(serializable_buffers, 0));
 
 	return size;
 }
@@ -31,6 +31,7 @@
 #include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
+#include "utils/sortsupport.h"
 #include "utils/typcache.h"
 
 
@@ -50,6 +51,16 @@ bool		Array_nulls = true;
 			PG_FREE_IF_COPY(array, n); \
 	} while (0)
 
+/* sortsupport for arrays */
+typedef struct
+{
+	Oid			element_type;	/* InvalidOid until the first comparison */
+	int16		typlen;
+	bool		typbyval;
+	char		typalign;
+	SortSupportData elemssup;	/* how to compare the elements */
+} array_sortsupport_state;
+
 typedef enum
 {
 	ARRAY_NO_LEVEL,
@@ -139,6 +150,9 @@ static void array_insert_slice(ArrayType *destArray, ArrayType *origArray,
 				   int *st, int *endp,
 				   int typlen, bool typbyval, char typalign);
 static int	array_cmp(FunctionCallInfo fcinfo);
+static int	array_cmp_shape(AnyArrayType *array1, AnyArrayType *array2,
+				int nitems1, int nitems2);
+static int	array_fast_cmp(Datum x, Datum y, SortSupport ssup);
 static ArrayType *create_array_envelope(int ndims, int *dimv, int *lbv, int nbytes,
 					  Oid elmtype, int dataoffset);
 static ArrayType *array_fill_internal(ArrayType *dims, ArrayType *lbs,
@@ -3877,46 +3891,178 @@ array_cmp(FunctionCallInfo fcinfo)
 
 	/*
 	 * If arrays contain same data (up to end of shorter one), apply
-	 * additional rules to sort by dimensionality.  The relative significance
-	 * of the different bits of information is historical; mainly we just care
-	 * that we don't say "equal" for arrays of different dimensionality.
+	 * additional rules to sort by dimensionality.
 	 */
 	if (result == 0)
+		result = array_cmp_shape(array1, array2, nitems1, nitems2);
+
+	/* Avoid leaking memory when handed toasted input. */
+	AARR_FREE_IF_COPY(array1, 0);
+	AARR_FREE_IF_COPY(array2, 1);
+
+	return result;
+}
+
+/*
+ * array_cmp_shape()
+ * Compare the dimensionality of two arrays whose elements are equal, up to
+ * the end of the shorter one.
+ *
+ * The relative significance of the different bits of information is
+ * historical; mainly we just care that we don't say "equal" for arrays of
+ * different dimensionality.
+ */
+static int
+array_cmp_shape(AnyArrayType *array1, AnyArrayType *array2,
+				int nitems1, int nitems2)
+{
+	int			ndims1 = AARR_NDIM(array1);
+	int			ndims2 = AARR_NDIM(array2);
+	int		   *dims1 = AARR_DIMS(array1);
+	int		   *dims2 = AARR_DIMS(array2);
+	int		   *lbound1 = AARR_LBOUND(array1);
+	int		   *lbound2 = AARR_LBOUND(array2);
+	int			i;
+
+	if (nitems1 != nitems2)
+		return (nitems1 < nitems2) ? -1 : 1;
+	if (ndims1 != ndims2)
+		return (ndims1 < ndims2) ? -1 : 1;
+	for (i = 0; i < ndims1; i++)
 	{
-		if (nitems1 != nitems2)
-			result = (nitems1 < nitems2) ? -1 : 1;
-		else if (ndims1 != ndims2)
-			result = (ndims1 < ndims2) ? -1 : 1;
-		else
+		if (dims1[i] != dims2[i])
+			return (dims1[i] < dims2[i]) ? -1 : 1;
+	}
+	for (i = 0; i < ndims1; i++)
+	{
+		if (lbound1[i] != lbound2[i])
+			return (lbound1[i] < lbound2[i]) ? -1 : 1;
+	}
+	return 0;
+}
+
+/*
+ * Sort support strategy routine
+ *
+ * The comparator works like array_cmp(), but compares the elements using
+ * the element type's own sort support, rather than calling its comparison
+ * function through fmgr for every pair.  The element type isn't known until
+ * the first comparison.
+ */
+Datum
+array_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+	array_sortsupport_state *ass;
+
+	ass = (array_sortsupport_state *)
+		MemoryContextAllocZero(ssup->ssup_cxt, sizeof(array_sortsupport_state));
+	ass->element_type = InvalidOid;
+
+	ssup->ssup_extra = ass;
+	ssup->comparator = array_fast_cmp;
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * SortSupport comparison func
+ */
+static int
+array_fast_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	array_sortsupport_state *ass = (array_sortsupport_state *) ssup->ssup_extra;
+	AnyArrayType *array1 = DatumGetAnyArray(x);
+	AnyArrayType *array2 = DatumGetAnyArray(y);
+	int			nitems1 = ArrayGetNItems(AARR_NDIM(array1), AARR_DIMS(array1));
+	int			nitems2 = ArrayGetNItems(AARR_NDIM(array2), AARR_DIMS(array2));
+	Oid			element_type = AARR_ELEMTYPE(array1);
+	SortSupport elemssup = &ass->elemssup;
+	int			result = 0;
+	int			min_nitems;
+	array_iter	it1;
+	array_iter	it2;
+	int			i;
+
+	if (element_type != AARR_ELEMTYPE(array2))
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("cannot compare arrays of different element types")));
+
+	/*
+	 * Set up the element comparator.  Only anyarray columns can switch
+	 * element types; we just leak the old element sort support state then.
+	 */
+	if (ass->element_type != element_type)
+	{
+		TypeCacheEntry *typentry;
+
+		typentry = lookup_type_cache(element_type, TYPECACHE_LT_OPR);
+		if (!OidIsValid(typentry->lt_opr))
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_FUNCTION),
+					 errmsg("could not identify a comparison function for type %s",
+							format_type_be(element_type))));
+
+		memset(elemssup, 0, sizeof(SortSupportData));
+		elemssup->ssup_cxt = ssup->ssup_cxt;
+		elemssup->ssup_collation = ssup->ssup_collation;
+		elemssup->ssup_nulls_first = false;
+		elemssup->abbreviate = false;
+		PrepareSortSupportFromOrderingOp(typentry->lt_opr, elemssup);
+
+		ass->typlen = typentry->typlen;
+		ass->typbyval = typentry->typbyval;
+		ass->typalign = typentry->typalign;
+		ass->element_type = element_type;
+	}
+
+	min_nitems = Min(nitems1, nitems2);
+	array_iter_setup(&it1, array1);
+	array_iter_setup(&it2, array2);
+
+	for (i = 0; i < min_nitems; i++)
+	{
+		Datum		elt1;
+		Datum		elt2;
+		bool		isnull1;
+		bool		isnull2;
+
+		elt1 = array_iter_next(&it1, &isnull1, i,
+							   ass->typlen, ass->typbyval, ass->typalign);
+		elt2 = array_iter_next(&it2, &isnull2, i,
+							   ass->typlen, ass->typbyval, ass->typalign);
+
+		/* As in array_cmp(), two NULLs are equal; NULL > not-NULL */
+		if (isnull1 && isnull2)
+			continue;
+		if (isnull1)
 		{
-			for (i = 0; i < ndims1; i++)
-			{
-				if (dims1[i] != dims2[i])
-				{
-					result = (dims1[i] < dims2[i]) ? -1 : 1;
-					break;
-				}
-			}
-			if (result == 0)
-			{
-				int		   *lbound1 = AARR_LBOUND(array1);
-				int		   *lbound2 = AARR_LBOUND(array2);
+			result = 1;
+			break;
+		}
+		if (isnull2)
+		{
+			result = -1;
+			break;
+		}
 
-				for (i = 0; i < ndims1; i++)
-				{
-					if (lbound1[i] != lbound2[i])
-					{
-						result = (lbound1[i] < lbound2[i]) ? -1 : 1;
-						break;
-					}
-				}
-			}
+		result = elemssup->comparator(elt1, elt2, elemssup);
+		if (result != 0)
+		{
+			result = (result < 0) ? -1 : 1;
+			break;
 		}
 	}
 
-	/* Avoid leaking memory when handed toasted input. */
-	AARR_FREE_IF_COPY(array1, 0);
-	AARR_FREE_IF_COPY(array2, 1);
+	if (result == 0)
+		result = array_cmp_shape(array1, array2, nitems1, nitems2);
+
+	/* We can't afford to leak memory here. */
+	if (!VARATT_IS_EXPANDED_HEADER(array1) && PointerGetDatum(array1) != x)
+		pfree(array1);
+	if (!VARATT_IS_EXPANDED_HEADER(array2) && PointerGetDatum(array2) != y)
+		pfree(array2);
 
 	return result;
 }
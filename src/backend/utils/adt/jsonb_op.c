@@ -13,15 +13,36 @@
  */
 #include "postgres.h"
 
+#include "access/hash.h"
+#include "catalog/pg_collation.h"
 #include "catalog/pg_type.h"
+#include "lib/hyperloglog.h"
 #include "miscadmin.h"
 #include "utils/builtins.h"
+#include "utils/guc.h"
 #include "utils/jsonb.h"
+#include "utils/pg_locale.h"
+#include "utils/sortsupport.h"
+
+/* sortsupport for jsonb */
+typedef struct
+{
+	bool		collate_c;		/* can strings be abbreviated? */
+	int64		input_count;	/* number of non-null values seen */
+	bool		estimating;		/* true if estimating cardinality */
+
+	hyperLogLogState abbr_card; /* cardinality estimator */
+} jsonb_sortsupport_state;
+
+static int	jsonb_fast_cmp(Datum x, Datum y, SortSupport ssup);
+#if SIZEOF_DATUM >= 8
+static bool jsonb_abbrev_abort(int memtupcount, SortSupport ssup);
+static Datum jsonb_abbrev_convert(Datum original, SortSupport ssup);
+#endif
 
 Datum
 jsonb_exists(PG_FUNCTION_ARGS)
 {
-	Jsonb	   *jb = PG_GETARG_JSONB(0);
 	text	   *key = PG_GETARG_TEXT_PP(1);
 	JsonbValue	kval;
 	JsonbValue *v = NULL;
@@ -36,9 +57,9 @@ jsonb_exists(PG_FUNCTION_ARGS)
 	kval.val.string.val = VARDATA_ANY(key);
 	kval.val.string.len = VARSIZE_ANY_EXHDR(key);
 
-	v = findJsonbValueFromContainer(&jb->root,
-									JB_FOBJECT | JB_FARRAY,
-									&kval);
+	v = findJsonbValueFromDatum(PG_GETARG_DATUM(0),
+								JB_FOBJECT | JB_FARRAY,
+								&kval);
 
 	PG_RETURN_BOOL(v != NULL);
 }
@@ -247,6 +268,248 @@ jsonb_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(res);
 }
 
+/*
+ * Sort support strategy routine
+ */
+Datum
+jsonb_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+	ssup->comparator = jsonb_fast_cmp;
+	ssup->ssup_extra = NULL;
+
+#if SIZEOF_DATUM >= 8
+	if (ssup->abbreviate)
+	{
+		jsonb_sortsupport_state *jss;
+		MemoryContext oldcontext;
+
+		oldcontext = MemoryContextSwitchTo(ssup->ssup_cxt);
+
+		jss = palloc(sizeof(jsonb_sortsupport_state));
+		jss->collate_c = lc_collate_is_c(DEFAULT_COLLATION_OID);
+		jss->input_count = 0;
+		jss->estimating = true;
+		initHyperLogLog(&jss->abbr_card, 10);
+
+		ssup->ssup_extra = jss;
+
+		ssup->comparator = ssup_datum_unsigned_cmp;
+		ssup->abbrev_converter = jsonb_abbrev_convert;
+		ssup->abbrev_abort = jsonb_abbrev_abort;
+		ssup->abbrev_full_comparator = jsonb_fast_cmp;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+#endif
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * SortSupport comparison func
+ */
+static int
+jsonb_fast_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	Jsonb	   *jba = DatumGetJsonb(x);
+	Jsonb	   *jbb = DatumGetJsonb(y);
+	int			res;
+
+	res = compareJsonbContainers(&jba->root, &jbb->root);
+
+	/* We can't afford to leak memory here. */
+	if (PointerGetDatum(jba) != x)
+		pfree(jba);
+	if (PointerGetDatum(jbb) != y)
+		pfree(jbb);
+
+	return res;
+}
+
+#if SIZEOF_DATUM >= 8
+
+/*
+ * Callback for estimating effectiveness of abbreviated key optimization.
+ *
+ * This works the same way as uuid_abbrev_abort().  Columns of objects that
+ * all have the same number of keys, and the same first key, are common, and
+ * get nothing out of abbreviation.
+ */
+static bool
+jsonb_abbrev_abort(int memtupcount, SortSupport ssup)
+{
+	jsonb_sortsupport_state *jss = ssup->ssup_extra;
+	double		abbr_card;
+
+	if (memtupcount < 10000 || jss->input_count < 10000 || !jss->estimating)
+		return false;
+
+	abbr_card = estimateHyperLogLog(&jss->abbr_card);
+
+	/* Stop counting once there are clearly enough distinct values */
+	if (abbr_card > 100000.0)
+	{
+#ifdef TRACE_SORT
+		if (trace_sort)
+			elog(LOG,
+				 "jsonb_abbrev: estimation ends at cardinality %f"
+				 " after " INT64_FORMAT " values (%d rows)",
+				 abbr_card, jss->input_count, memtupcount);
+#endif
+		jss->estimating = false;
+		return false;
+	}
+
+	/* Target minimum cardinality is 1 per ~2k of non-null inputs */
+	if (abbr_card < jss->input_count / 2000.0 + 0.5)
+	{
+#ifdef TRACE_SORT
+		if (trace_sort)
+			elog(LOG,
+				 "jsonb_abbrev: aborting abbreviation at cardinality %f"
+				 " below threshold %f after " INT64_FORMAT " values (%d rows)",
+				 abbr_card, jss->input_count / 2000.0 + 0.5, jss->input_count,
+				 memtupcount);
+#endif
+		return true;
+	}
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG,
+			 "jsonb_abbrev: cardinality %f after " INT64_FORMAT
+			 " values (%d rows)", abbr_card, jss->input_count, memtupcount);
+#endif
+
+	return false;
+}
+
+/*
+ * Conversion routine for sortsupport.
+ *
+ * The abbreviated key, compared as an unsigned integer, sorts the same way
+ * as compareJsonbContainers() as far as it goes.  That compares the first
+ * tokens returned by iterating over each value, then the next ones, and so
+ * on.  The first token is the top-level array or object: every array sorts
+ * before every object, and otherwise the one with more elements or pairs is
+ * greater.  A scalar is stored as a one-element pseudo-array, which sorts
+ * before a real one-element array.  So the key has, from the top:
+ *
+ *	1 bit	object (1) or array (0)
+ *	28 bits number of elements or pairs
+ *	1 bit	real array (1) or scalar (0)
+ *	2 bits	type of the scalar, which determines the order of scalars of
+ *			different types
+ *	32 bits a prefix of the next token: the scalar itself, or the first key
+ *			of an object
+ *
+ * Strings are compared with the database's collation, so we can only take
+ * a prefix of a string if that is "C".  Numbers become the high half of
+ * their value as a float8, in a form that sorts as an unsigned integer.
+ */
+static Datum
+jsonb_abbrev_convert(Datum original, SortSupport ssup)
+{
+	jsonb_sortsupport_state *jss = ssup->ssup_extra;
+	Jsonb	   *authoritative = DatumGetJsonb(original);
+	uint64		res;
+
+	res = (uint64) JB_ROOT_COUNT(authoritative) << 35;
+
+	if (JB_ROOT_IS_OBJECT(authoritative))
+		res |= UINT64CONST(1) << 63;
+	else if (!JB_ROOT_IS_SCALAR(authoritative))
+		res |= UINT64CONST(1) << 34;
+
+	if (JB_ROOT_IS_SCALAR(authoritative) ||
+		(JB_ROOT_IS_OBJECT(authoritative) && JB_ROOT_COUNT(authoritative) > 0))
+	{
+		JsonbIterator *it;
+		JsonbValue	v;
+		uint32		prefix = 0;
+
+		it = JsonbIteratorInit(&authoritative->root);
+		(void) JsonbIteratorNext(&it, &v, false);	/* WJB_BEGIN_* */
+		(void) JsonbIteratorNext(&it, &v, false);	/* WJB_ELEM or WJB_KEY */
+
+		switch (v.type)
+		{
+			case jbvNull:
+				break;
+			case jbvString:
+				if (jss->collate_c)
+				{
+					int			i;
+
+					/* big-endian, padded with zeroes */
+					for (i = 0; i < sizeof(uint32); i++)
+					{
+						prefix <<= 8;
+						if (i < v.val.string.len)
+							prefix |= (unsigned char) v.val.string.val[i];
+					}
+				}
+				break;
+			case jbvNumeric:
+				{
+					float8		f;
+					uint64		bits;
+
+					f = DatumGetFloat8(DirectFunctionCall1(numeric_float8_no_overflow,
+														   NumericGetDatum(v.val.numeric)));
+					if (f == 0.0)
+						f = 0.0;	/* no negative zero */
+					memcpy(&bits, &f, sizeof(bits));
+					if (bits & (UINT64CONST(1) << 63))
+						bits = ~bits;
+					else
+						bits |= UINT64CONST(1) << 63;
+					prefix = (uint32) (bits >> 32);
+				}
+				break;
+			case jbvBool:
+				prefix = v.val.boolean ? 1 : 0;
+				break;
+			default:
+				elog(ERROR, "invalid jsonb scalar type");
+		}
+
+		if (JB_ROOT_IS_SCALAR(authoritative))
+			res |= (uint64) v.type << 32;
+		res |= prefix;
+
+		/* free the iterator */
+		while (it != NULL)
+		{
+			JsonbIterator *i = it->parent;
+
+			pfree(it);
+			it = i;
+		}
+	}
+
+	jss->input_count += 1;
+
+	if (jss->estimating)
+	{
+		uint32		tmp;
+
+		tmp = (uint32) res ^ (uint32) (res >> 32);
+
+		addHyperLogLog(&jss->abbr_card, DatumGetUInt32(hash_uint32(tmp)));
+	}
+
+	/* We can't afford to leak memory here. */
+	if (PointerGetDatum(authoritative) != original)
+		pfree(authoritative);
+
+	return (Datum) res;
+}
+
+#endif							/* SIZEOF_DATUM >= 8 */
+
 /*
  * Hash operator class jsonb hashing function
  */
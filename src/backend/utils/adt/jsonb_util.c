@@ -14,6 +14,7 @@
 #include "postgres.h"
 
 #include "access/hash.h"
+#include "access/tuptoaster.h"
 #include "catalog/pg_collation.h"
 #include "miscadmin.h"
 #include "utils/builtins.h"
@@ -55,6 +56,8 @@ static JsonbParseState *pushState(JsonbParseState **pstate);
 static void appendKey(JsonbParseState *pstate, JsonbValue *scalarVal);
 static void appendValue(JsonbParseState *pstate, JsonbValue *scalarVal);
 static void appendElement(JsonbParseState *pstate, JsonbValue *scalarVal);
+static struct varlena *fetchJsonbPrefix(Datum jsonb, struct varlena *prefix,
+				 uint32 needed, uint32 wanted);
 static int	lengthCompareJsonbStringValue(const void *a, const void *b);
 static int	lengthCompareJsonbPair(const void *a, const void *b, void *arg);
 static void uniqueifyJsonbObject(JsonbValue *object);
@@ -410,6 +413,205 @@ findJsonbValueFromContainer(JsonbContainer *container, uint32 flags,
 	return NULL;
 }
 
+/*
+ * Like findJsonbValueFromContainer, applied to the root container of a jsonb
+ * datum that may be stored out of line.
+ *
+ * Looking up one key of a big out-of-line object needn't detoast all of it:
+ * the root header and JEntry array come first, followed by all the keys and
+ * then all the values.  So we fetch a prefix of the datum that is long
+ * enough to hold the JEntries and keys, and then just the matching value,
+ * each as a slice of the datum.  A slice reads only the toast chunks holding
+ * the requested bytes, and if the value is compressed, decompresses no more
+ * of it than the prefix ending there; a value that has been detoasted in
+ * full already is sliced from the TOAST cache instead.
+ *
+ * The prefix is fetched at first with some room to spare for the keys, and
+ * fetched again, longer, if that turns out not to be enough.  A value that
+ * lies within the prefix is taken from there.
+ *
+ * Anything else (an array, or a datum that isn't out of line) is detoasted
+ * whole and searched with findJsonbValueFromContainer.  For a compressed
+ * inline datum that's no worse, as all of it is in memory anyway.
+ */
+#define JSONB_PREFIX_SLICE_SIZE		TOAST_MAX_CHUNK_SIZE
+
+JsonbValue *
+findJsonbValueFromDatum(Datum jsonb, uint32 flags, JsonbValue *key)
+{
+	struct varlena *attr = (struct varlena *) DatumGetPointer(jsonb);
+	struct varlena *prefix;
+	JsonbContainer *container;
+	uint32		count;
+	uint32		dataoff;
+	uint32		keysend;
+	char	   *base_addr;
+	uint32		stopLow,
+				stopHigh;
+
+	Assert((flags & ~(JB_FARRAY | JB_FOBJECT)) == 0);
+
+	if (!(flags & JB_FOBJECT) || !VARATT_IS_EXTERNAL_ONDISK(attr))
+		return findJsonbValueFromContainer(&DatumGetJsonb(jsonb)->root,
+										   flags, key);
+
+	prefix = fetchJsonbPrefix(jsonb, NULL, sizeof(uint32),
+							  JSONB_PREFIX_SLICE_SIZE);
+	container = (JsonbContainer *) VARDATA(prefix);
+
+	if (!JsonContainerIsObject(container))
+	{
+		pfree(prefix);
+		return findJsonbValueFromContainer(&DatumGetJsonb(jsonb)->root,
+										   flags, key);
+	}
+
+	/* Object key passed by caller must be a string */
+	Assert(key->type == jbvString);
+
+	count = JsonContainerSize(container);
+	if (count == 0)
+	{
+		pfree(prefix);
+		return NULL;
+	}
+
+	/* Make sure we have the JEntries of the keys and values ... */
+	dataoff = offsetof(JsonbContainer, children) + count * 2 * sizeof(JEntry);
+	prefix = fetchJsonbPrefix(jsonb, prefix, dataoff,
+							  dataoff + JSONB_PREFIX_SLICE_SIZE);
+	container = (JsonbContainer *) VARDATA(prefix);
+
+	/* ... and the keys themselves */
+	keysend = getJsonbOffset(container, count);
+	prefix = fetchJsonbPrefix(jsonb, prefix, dataoff + keysend,
+							  dataoff + keysend);
+	container = (JsonbContainer *) VARDATA(prefix);
+	base_addr = VARDATA(prefix) + dataoff;
+
+	/* Binary search on object/pair keys, as findJsonbValueFromContainer */
+	stopLow = 0;
+	stopHigh = count;
+	while (stopLow < stopHigh)
+	{
+		uint32		stopMiddle;
+		int			difference;
+		JsonbValue	candidate;
+
+		stopMiddle = stopLow + (stopHigh - stopLow) / 2;
+
+		candidate.type = jbvString;
+		candidate.val.string.val =
+			base_addr + getJsonbOffset(container, stopMiddle);
+		candidate.val.string.len = getJsonbLength(container, stopMiddle);
+
+		difference = lengthCompareJsonbStringValue(&candidate, key);
+
+		if (difference == 0)
+		{
+			int			index = stopMiddle + count;
+			JEntry		entry = container->children[index];
+			uint32		offset = getJsonbOffset(container, index);
+			uint32		len = getJsonbLength(container, index);
+			JsonbValue *result = palloc(sizeof(JsonbValue));
+			uint32		padding = 0;
+			char	   *data;
+
+			if (JBE_ISNULL(entry))
+				result->type = jbvNull;
+			else if (JBE_ISBOOL_TRUE(entry) || JBE_ISBOOL_FALSE(entry))
+			{
+				result->type = jbvBool;
+				result->val.boolean = JBE_ISBOOL_TRUE(entry);
+			}
+			else
+			{
+				/*
+				 * Numerics and containers are preceded by alignment padding,
+				 * which we skip.  Since dataoff is int-aligned, the value
+				 * starts int-aligned within a slice, as it would within the
+				 * detoasted datum.
+				 */
+				if (!JBE_ISSTRING(entry))
+					padding = INTALIGN(offset) - offset;
+
+				if (dataoff + offset + len <= VARSIZE(prefix) - VARHDRSZ)
+				{
+					/* it's in the prefix already, which we hand over */
+					data = base_addr + offset + padding;
+				}
+				else
+				{
+					struct varlena *value;
+
+					value = PG_DETOAST_DATUM_SLICE(jsonb,
+												   dataoff + offset + padding,
+												   len - padding);
+					if (VARSIZE(value) - VARHDRSZ < len - padding)
+						elog(ERROR, "unexpected end of jsonb datum");
+					data = VARDATA(value);
+					pfree(prefix);
+				}
+
+				if (JBE_ISSTRING(entry))
+				{
+					result->type = jbvString;
+					result->val.string.val = data;
+					result->val.string.len = len;
+				}
+				else if (JBE_ISNUMERIC(entry))
+				{
+					result->type = jbvNumeric;
+					result->val.numeric = (Numeric) data;
+				}
+				else
+				{
+					Assert(JBE_ISCONTAINER(entry));
+					result->type = jbvBinary;
+					result->val.binary.data = (JsonbContainer *) data;
+					result->val.binary.len = len - padding;
+				}
+			}
+
+			return result;
+		}
+		else
+		{
+			if (difference < 0)
+				stopLow = stopMiddle + 1;
+			else
+				stopHigh = stopMiddle;
+		}
+	}
+
+	/* Not found */
+	pfree(prefix);
+	return NULL;
+}
+
+/*
+ * Return a prefix of a jsonb datum at least "needed" bytes long, fetching
+ * "wanted" bytes (or as many as there are) if the prefix we have, if any,
+ * is too short.
+ */
+static struct varlena *
+fetchJsonbPrefix(Datum jsonb, struct varlena *prefix, uint32 needed,
+				 uint32 wanted)
+{
+	if (prefix != NULL)
+	{
+		if (VARSIZE(prefix) - VARHDRSZ >= needed)
+			return prefix;
+		pfree(prefix);
+	}
+
+	prefix = PG_DETOAST_DATUM_SLICE(jsonb, 0, wanted);
+	if (VARSIZE(prefix) - VARHDRSZ < needed)
+		elog(ERROR, "unexpected end of jsonb datum");
+
+	return prefix;
+}
+
 /*
  * Get i-th value of a Jsonb array.
  *
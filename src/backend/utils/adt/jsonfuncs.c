@@ -448,6 +448,8 @@ static JsonbValue *findJsonbValueFromContainerLen(JsonbContainer *container,
 							   uint32 flags,
 							   char *key,
 							   uint32 keylen);
+static JsonbValue *findJsonbValueFromDatumLen(Datum jsonb, char *key,
+						   uint32 keylen);
 
 /* functions supporting jsonb_delete, jsonb_set and jsonb_concat */
 static JsonbValue *IteratorConcat(JsonbIterator **it1, JsonbIterator **it2,
@@ -703,16 +705,13 @@ json_object_field(PG_FUNCTION_ARGS)
 Datum
 jsonb_object_field(PG_FUNCTION_ARGS)
 {
-	Jsonb	   *jb = PG_GETARG_JSONB(0);
 	text	   *key = PG_GETARG_TEXT_PP(1);
 	JsonbValue *v;
 
-	if (!JB_ROOT_IS_OBJECT(jb))
-		PG_RETURN_NULL();
-
-	v = findJsonbValueFromContainerLen(&jb->root, JB_FOBJECT,
-									   VARDATA_ANY(key),
-									   VARSIZE_ANY_EXHDR(key));
+	/* returns NULL if the root isn't an object, and may avoid detoasting */
+	v = findJsonbValueFromDatumLen(PG_GETARG_DATUM(0),
+								   VARDATA_ANY(key),
+								   VARSIZE_ANY_EXHDR(key));
 
 	if (v != NULL)
 		PG_RETURN_JSONB(JsonbValueToJsonb(v));
@@ -739,16 +738,13 @@ json_object_field_text(PG_FUNCTION_ARGS)
 Datum
 jsonb_object_field_text(PG_FUNCTION_ARGS)
 {
-	Jsonb	   *jb = PG_GETARG_JSONB(0);
 	text	   *key = PG_GETARG_TEXT_PP(1);
 	JsonbValue *v;
 
-	if (!JB_ROOT_IS_OBJECT(jb))
-		PG_RETURN_NULL();
-
-	v = findJsonbValueFromContainerLen(&jb->root, JB_FOBJECT,
-									   VARDATA_ANY(key),
-									   VARSIZE_ANY_EXHDR(key));
+	/* returns NULL if the root isn't an object, and may avoid detoasting */
+	v = findJsonbValueFromDatumLen(PG_GETARG_DATUM(0),
+								   VARDATA_ANY(key),
+								   VARSIZE_ANY_EXHDR(key));
 
 	if (v != NULL)
 	{
@@ -3767,6 +3763,22 @@ findJsonbValueFromContainerLen(JsonbContainer *container, uint32 flags,
 	return findJsonbValueFromContainer(container, flags, &k);
 }
 
+/*
+ * findJsonbValueFromDatum() wrapper that looks up an object key, given as a
+ * string, in the root of a possibly-toasted jsonb datum.
+ */
+static JsonbValue *
+findJsonbValueFromDatumLen(Datum jsonb, char *key, uint32 keylen)
+{
+	JsonbValue	k;
+
+	k.type = jbvString;
+	k.val.string.val = key;
+	k.val.string.len = keylen;
+
+	return findJsonbValueFromDatum(jsonb, JB_FOBJECT, &k);
+}
+
 /*
  * Semantic actions for json_strip_nulls.
  *
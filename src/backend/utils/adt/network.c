@@ -15,14 +15,31 @@
 #include "access/hash.h"
 #include "catalog/pg_type.h"
 #include "common/ip.h"
+#include "lib/hyperloglog.h"
 #include "libpq/libpq-be.h"
 #include "libpq/pqformat.h"
 #include "miscadmin.h"
 #include "utils/builtins.h"
+#include "utils/guc.h"
 #include "utils/inet.h"
+#include "utils/sortsupport.h"
 
 
+/* sortsupport for inet/cidr */
+typedef struct
+{
+	int64		input_count;	/* number of non-null values seen */
+	bool		estimating;		/* true if estimating cardinality */
+
+	hyperLogLogState abbr_card; /* cardinality estimator */
+} network_sortsupport_state;
+
 static int32 network_cmp_internal(inet *a1, inet *a2);
+static int	network_fast_cmp(Datum x, Datum y, SortSupport ssup);
+#if SIZEOF_DATUM >= 8
+static bool network_abbrev_abort(int memtupcount, SortSupport ssup);
+static Datum network_abbrev_convert(Datum original, SortSupport ssup);
+#endif
 static bool addressOK(unsigned char *a, int bits, int family);
 static inet *internal_inetpl(inet *ip, int64 addend);
 
@@ -389,6 +406,192 @@ network_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(network_cmp_internal(a1, a2));
 }
 
+/*
+ * SortSupport strategy routine
+ */
+Datum
+network_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+	ssup->comparator = network_fast_cmp;
+	ssup->ssup_extra = NULL;
+
+#if SIZEOF_DATUM >= 8
+	if (ssup->abbreviate)
+	{
+		network_sortsupport_state *nss;
+		MemoryContext oldcontext;
+
+		oldcontext = MemoryContextSwitchTo(ssup->ssup_cxt);
+
+		nss = palloc(sizeof(network_sortsupport_state));
+		nss->input_count = 0;
+		nss->estimating = true;
+		initHyperLogLog(&nss->abbr_card, 10);
+
+		ssup->ssup_extra = nss;
+
+		ssup->comparator = ssup_datum_unsigned_cmp;
+		ssup->abbrev_converter = network_abbrev_convert;
+		ssup->abbrev_abort = network_abbrev_abort;
+		ssup->abbrev_full_comparator = network_fast_cmp;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+#endif
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * SortSupport comparison func
+ */
+static int
+network_fast_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	inet	   *arg1 = DatumGetInetPP(x);
+	inet	   *arg2 = DatumGetInetPP(y);
+	int			result;
+
+	result = network_cmp_internal(arg1, arg2);
+
+	/* We can't afford to leak memory here. */
+	if (PointerGetDatum(arg1) != x)
+		pfree(arg1);
+	if (PointerGetDatum(arg2) != y)
+		pfree(arg2);
+
+	return result;
+}
+
+#if SIZEOF_DATUM >= 8
+
+/*
+ * Callback for estimating effectiveness of abbreviated key optimization.
+ *
+ * This works the same way as uuid_abbrev_abort(); many IPv6 addresses in
+ * the same /64 network all get the same abbreviated key, for instance.
+ */
+static bool
+network_abbrev_abort(int memtupcount, SortSupport ssup)
+{
+	network_sortsupport_state *nss = ssup->ssup_extra;
+	double		abbr_card;
+
+	if (memtupcount < 10000 || nss->input_count < 10000 || !nss->estimating)
+		return false;
+
+	abbr_card = estimateHyperLogLog(&nss->abbr_card);
+
+	/* Stop counting once there are clearly enough distinct values */
+	if (abbr_card > 100000.0)
+	{
+#ifdef TRACE_SORT
+		if (trace_sort)
+			elog(LOG,
+				 "network_abbrev: estimation ends at cardinality %f"
+				 " after " INT64_FORMAT " values (%d rows)",
+				 abbr_card, nss->input_count, memtupcount);
+#endif
+		nss->estimating = false;
+		return false;
+	}
+
+	/* Target minimum cardinality is 1 per ~2k of non-null inputs */
+	if (abbr_card < nss->input_count / 2000.0 + 0.5)
+	{
+#ifdef TRACE_SORT
+		if (trace_sort)
+			elog(LOG,
+				 "network_abbrev: aborting abbreviation at cardinality %f"
+				 " below threshold %f after " INT64_FORMAT " values (%d rows)",
+				 abbr_card, nss->input_count / 2000.0 + 0.5, nss->input_count,
+				 memtupcount);
+#endif
+		return true;
+	}
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG,
+			 "network_abbrev: cardinality %f after " INT64_FORMAT
+			 " values (%d rows)", abbr_card, nss->input_count, memtupcount);
+#endif
+
+	return false;
+}
+
+/*
+ * Conversion routine for sortsupport.
+ *
+ * The abbreviated key, compared as an unsigned integer, sorts the same way
+ * as network_cmp_internal() as far as it goes.  Its top bit is 0 for IPv4
+ * and 1 for IPv6.  The rest is the network part of the address, that is the
+ * address with the bits beyond the netmask zeroed; if two network parts
+ * differ within their common netmask length, they are ordered the same way
+ * as their addresses' common bits, and if not, the longer netmask sorts
+ * higher either way.
+ *
+ * An IPv4 network part only takes 32 bits, so we can follow it with the
+ * netmask length (6 bits) and the first 25 bits of the host part, which
+ * decide the order of addresses in the same network.  An IPv6 network part
+ * fills the key by itself, truncated to 63 bits.
+ */
+static Datum
+network_abbrev_convert(Datum original, SortSupport ssup)
+{
+	network_sortsupport_state *nss = ssup->ssup_extra;
+	inet	   *authoritative = DatumGetInetPP(original);
+	unsigned char *addr = ip_addr(authoritative);
+	int			bits = ip_bits(authoritative);
+	uint64		ipaddr = 0;
+	uint64		netmask;
+	uint64		res;
+	int			i;
+
+	if (ip_family(authoritative) == PGSQL_AF_INET)
+	{
+		for (i = 0; i < 4; i++)
+			ipaddr = (ipaddr << 8) | addr[i];
+		netmask = (bits == 0) ? 0 : (~UINT64CONST(0) << (32 - bits));
+		netmask &= UINT64CONST(0xFFFFFFFF);
+
+		res = (ipaddr & netmask) << 31;
+		res |= (uint64) bits << 25;
+		res |= (ipaddr & ~netmask & UINT64CONST(0xFFFFFFFF)) >> 7;
+	}
+	else
+	{
+		/* only the first 64 bits of the address can matter */
+		for (i = 0; i < 8; i++)
+			ipaddr = (ipaddr << 8) | addr[i];
+		netmask = (bits == 0) ? 0 :
+			(bits >= 64) ? ~UINT64CONST(0) : (~UINT64CONST(0) << (64 - bits));
+
+		res = (UINT64CONST(1) << 63) | ((ipaddr & netmask) >> 1);
+	}
+
+	nss->input_count += 1;
+
+	if (nss->estimating)
+	{
+		uint32		tmp;
+
+		tmp = (uint32) res ^ (uint32) (res >> 32);
+
+		addHyperLogLog(&nss->abbr_card, DatumGetUInt32(hash_uint32(tmp)));
+	}
+
+	/* We can't afford to leak memory here. */
+	if (PointerGetDatum(authoritative) != original)
+		pfree(authoritative);
+
+	return (Datum) res;
+}
+
+#endif							/* SIZEOF_DATUM >= 8 */
+
 /*
  *	Boolean ordering tests.
  */
@@ -39,6 +39,7 @@
 #include "utils/int8.h"
 #include "utils/lsyscache.h"
 #include "utils/rangetypes.h"
+#include "utils/sortsupport.h"
 #include "utils/timestamp.h"
 
 
@@ -53,6 +54,13 @@ typedef struct RangeIOData
 	FmgrInfo	proc;			/* lookup result for typiofunc */
 } RangeIOData;
 
+/* ssup_extra of range_sortsupport() */
+typedef struct
+{
+	TypeCacheEntry *typcache;	/* range type's typcache entry, or NULL */
+	SortSupportData subssup;	/* how to compare the bound values */
+} range_sortsupport_state;
+
 
 static RangeIOData *get_range_io_data(FunctionCallInfo fcinfo, Oid rngtypid,
 				  IOFuncSelector func);
@@ -64,6 +72,10 @@ static const char *range_parse_bound(const char *string, const char *ptr,
 static char *range_deparse(char flags, const char *lbound_str,
 			  const char *ubound_str);
 static char *range_bound_escape(const char *value);
+static int	range_fast_cmp(Datum x, Datum y, SortSupport ssup);
+static inline int range_cmp_bounds_internal(TypeCacheEntry *typcache,
+						  SortSupport subssup,
+						  RangeBound *b1, RangeBound *b2);
 static Size datum_compute_size(Size sz, Datum datum, bool typbyval,
 				   char typalign, int16 typlen, char typstorage);
 static Pointer datum_write(Pointer ptr, Datum datum, bool typbyval,
@@ -1182,6 +1194,111 @@ range_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(cmp);
 }
 
+/*
+ * Sort support strategy routine
+ *
+ * The comparator works like range_cmp(), but compares the bound values using
+ * the subtype's sort support, rather than calling the subtype's comparison
+ * function through fmgr.  The range type isn't known until the first
+ * comparison.
+ */
+Datum
+range_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+	ssup->ssup_extra = MemoryContextAllocZero(ssup->ssup_cxt,
+											  sizeof(range_sortsupport_state));
+	ssup->comparator = range_fast_cmp;
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * SortSupport comparison func
+ */
+static int
+range_fast_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	range_sortsupport_state *rss = (range_sortsupport_state *) ssup->ssup_extra;
+	RangeType  *r1 = DatumGetRangeType(x);
+	RangeType  *r2 = DatumGetRangeType(y);
+	TypeCacheEntry *typcache = rss->typcache;
+	RangeBound	lower1,
+				lower2;
+	RangeBound	upper1,
+				upper2;
+	bool		empty1,
+				empty2;
+	int			cmp;
+
+	check_stack_depth();		/* recurses when subtype is a range type */
+
+	/* Different types should be prevented by ANYRANGE matching rules */
+	if (RangeTypeGetOid(r1) != RangeTypeGetOid(r2))
+		elog(ERROR, "range types do not match");
+
+	if (typcache == NULL || typcache->type_id != RangeTypeGetOid(r1))
+	{
+		SortSupport subssup = &rss->subssup;
+		TypeCacheEntry *subtypcache;
+
+		typcache = lookup_type_cache(RangeTypeGetOid(r1), TYPECACHE_RANGE_INFO);
+		if (typcache->rngelemtype == NULL)
+			elog(ERROR, "type %u is not a range type", RangeTypeGetOid(r1));
+
+		memset(subssup, 0, sizeof(SortSupportData));
+		subssup->ssup_cxt = ssup->ssup_cxt;
+		subssup->ssup_collation = typcache->rng_collation;
+		subssup->ssup_nulls_first = false;
+		subssup->abbreviate = false;
+
+		/*
+		 * If the range uses the subtype's default btree operator class, as
+		 * it usually does, we can use the sort support that goes with its
+		 * less-than operator.  Otherwise just use the range's comparison
+		 * function.
+		 */
+		subtypcache = lookup_type_cache(typcache->rngelemtype->type_id,
+										TYPECACHE_LT_OPR | TYPECACHE_CMP_PROC);
+		if (OidIsValid(subtypcache->lt_opr) &&
+			subtypcache->cmp_proc == typcache->rng_cmp_proc_finfo.fn_oid)
+			PrepareSortSupportFromOrderingOp(subtypcache->lt_opr, subssup);
+		else
+			PrepareSortSupportComparisonShim(typcache->rng_cmp_proc_finfo.fn_oid,
+											 subssup);
+
+		rss->typcache = typcache;
+	}
+
+	range_deserialize(typcache, r1, &lower1, &upper1, &empty1);
+	range_deserialize(typcache, r2, &lower2, &upper2, &empty2);
+
+	/* For b-tree use, empty ranges sort before all else */
+	if (empty1 && empty2)
+		cmp = 0;
+	else if (empty1)
+		cmp = -1;
+	else if (empty2)
+		cmp = 1;
+	else
+	{
+		cmp = range_cmp_bounds_internal(typcache, &rss->subssup,
+										&lower1, &lower2);
+		if (cmp == 0)
+			cmp = range_cmp_bounds_internal(typcache, &rss->subssup,
+											&upper1, &upper2);
+	}
+
+	/* We can't afford to leak memory here. */
+	if (PointerGetDatum(r1) != x)
+		pfree(r1);
+	if (PointerGetDatum(r2) != y)
+		pfree(r2);
+
+	return cmp;
+}
+
 /* inequality operators using the range_cmp function */
 Datum
 range_lt(PG_FUNCTION_ARGS)
@@ -1830,6 +1947,17 @@ make_range(TypeCacheEntry *typcache, RangeBound *lower, RangeBound *upper,
  */
 int
 range_cmp_bounds(TypeCacheEntry *typcache, RangeBound *b1, RangeBound *b2)
+{
+	return range_cmp_bounds_internal(typcache, NULL, b1, b2);
+}
+
+/*
+ * Workhorse for range_cmp_bounds().  If subssup isn't NULL, it's used to
+ * compare the held values, instead of the typcache's comparison function.
+ */
+static inline int
+range_cmp_bounds_internal(TypeCacheEntry *typcache, SortSupport subssup,
+						  RangeBound *b1, RangeBound *b2)
 {
 	int32		result;
 
@@ -1856,9 +1984,12 @@ range_cmp_bounds(TypeCacheEntry *typcache, RangeBound *b1, RangeBound *b2)
 	/*
 	 * Both boundaries are finite, so compare the held values.
 	 */
-	result = DatumGetInt32(FunctionCall2Coll(&typcache->rng_cmp_proc_finfo,
-											 typcache->rng_collation,
-											 b1->val, b2->val));
+	if (subssup != NULL)
+		result = subssup->comparator(b1->val, b2->val, subssup);
+	else
+		result = DatumGetInt32(FunctionCall2Coll(&typcache->rng_cmp_proc_finfo,
+												 typcache->rng_collation,
+												 b1->val, b2->val));
 
 	/*
 	 * If the comparison is anything other than equal, we're done. If they
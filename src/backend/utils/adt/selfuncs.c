@@ -6512,9 +6512,10 @@ genericcostestimate(PlannerInfo *root,
 
 	/*
 	 * Check for ScalarArrayOpExpr index quals, and estimate the number of
-	 * index scans that will be performed.
+	 * index scans that will be performed.  The caller may have supplied a
+	 * starting value if the AM performs multiple scans for other reasons.
 	 */
-	num_sa_scans = 1;
+	num_sa_scans = (costs->num_sa_scans > 1) ? costs->num_sa_scans : 1;
 	foreach(l, indexQuals)
 	{
 		RestrictInfo *rinfo = (RestrictInfo *) lfirst(l);
@@ -6739,11 +6740,34 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	bool		found_saop;
 	bool		found_is_null_op;
 	double		num_sa_scans;
+	int			skipPrefix = path->indexskipprefix;
+	double		numSkipGroups = 1;
 	ListCell   *lc;
 
 	/* Do preliminary analysis of indexquals */
 	qinfos = deconstruct_indexquals(path);
 
+	/*
+	 * A skip scan performs one primitive index scan per distinct value of the
+	 * leading skipPrefix columns, which have no quals of their own.  Estimate
+	 * how many there will be.
+	 */
+	if (skipPrefix > 0)
+	{
+		List	   *groupExprs = NIL;
+
+		foreach(lc, index->indextlist)
+		{
+			TargetEntry *tle = (TargetEntry *) lfirst(lc);
+
+			if (list_length(groupExprs) >= skipPrefix)
+				break;
+			groupExprs = lappend(groupExprs, tle->expr);
+		}
+		numSkipGroups = estimate_num_groups(root, groupExprs,
+											index->rel->tuples, NULL);
+	}
+
 	/*
 	 * For a btree scan, only leading '=' quals plus inequality quals for the
 	 * immediately next attribute contribute to index selectivity (these are
@@ -6760,9 +6784,12 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	 * If there's a ScalarArrayOpExpr in the quals, we'll actually perform N
 	 * index scans not one, but the ScalarArrayOpExpr's operator can be
 	 * considered to act the same as it normally does.
+	 *
+	 * In a skip scan, each primitive scan has an '=' qual on every prefix
+	 * column, so the boundary quals begin right after the prefix.
 	 */
 	indexBoundQuals = NIL;
-	indexcol = 0;
+	indexcol = skipPrefix;
 	eqQualHere = false;
 	found_saop = false;
 	found_is_null_op = false;
@@ -6862,17 +6889,30 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 		 * ScalarArrayOpExpr quals included in indexBoundQuals, and then round
 		 * to integer.
 		 */
-		numIndexTuples = rint(numIndexTuples / num_sa_scans);
+		numIndexTuples = rint(numIndexTuples / (num_sa_scans * numSkipGroups));
 	}
 
+	/*
+	 * A skip scan for DISTINCT stops each primitive scan after its first
+	 * tuple.
+	 */
+	if (path->indexskipdistinct && numIndexTuples > 1.0)
+		numIndexTuples = 1.0;
+
 	/*
 	 * Now do generic index cost estimation.
 	 */
 	MemSet(&costs, 0, sizeof(costs));
 	costs.numIndexTuples = numIndexTuples;
+	costs.num_sa_scans = numSkipGroups;
 
 	genericcostestimate(root, path, loop_count, qinfos, &costs);
 
+	/* Likewise, it returns at most one tuple per distinct prefix */
+	if (path->indexskipdistinct && index->rel->tuples > 0)
+		costs.indexSelectivity = Min(costs.indexSelectivity,
+									 numSkipGroups / index->rel->tuples);
+
 	/*
 	 * Add a CPU-cost component to represent the costs of initial btree
 	 * descent.  We don't charge any I/O cost for touching upper btree levels,
@@ -6882,13 +6922,16 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	 *
 	 * If there are ScalarArrayOpExprs, charge this once per SA scan.  The
 	 * ones after the first one are not startup cost so far as the overall
-	 * plan is concerned, so add them only to "total" cost.
+	 * plan is concerned, so add them only to "total" cost.  A skip scan
+	 * needs a second descent per primitive scan to find the next prefix.
 	 */
 	if (index->tuples > 1)		/* avoid computing log(0) */
 	{
 		descentCost = ceil(log(index->tuples) / log(2.0)) * cpu_operator_cost;
 		costs.indexStartupCost += descentCost;
 		costs.indexTotalCost += costs.num_sa_scans * descentCost;
+		if (skipPrefix > 0)
+			costs.indexTotalCost += numSkipGroups * descentCost;
 	}
 
 	/*
@@ -6904,6 +6947,8 @@ btcostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	descentCost = (index->tree_height + 1) * 50.0 * cpu_operator_cost;
 	costs.indexStartupCost += descentCost;
 	costs.indexTotalCost += costs.num_sa_scans * descentCost;
+	if (skipPrefix > 0)
+		costs.indexTotalCost += numSkipGroups * descentCost;
 
 	/*
 	 * If we can get an estimate of the first column's ordering correlation C
@@ -2088,6 +2088,7 @@ timestamp_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(timestamp_cmp_internal(dt1, dt2));
 }
 
+#ifndef USE_FLOAT8_BYVAL
 /* note: this is used for timestamptz also */
 static int
 timestamp_fastcmp(Datum x, Datum y, SortSupport ssup)
@@ -2097,13 +2098,19 @@ timestamp_fastcmp(Datum x, Datum y, SortSupport ssup)
 
 	return timestamp_cmp_internal(a, b);
 }
+#endif
 
 Datum
 timestamp_sortsupport(PG_FUNCTION_ARGS)
 {
 	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
 
+#ifdef USE_FLOAT8_BYVAL
+	/* timestamps are int64s, and so is timestamptz */
+	ssup->comparator = ssup_datum_signed_cmp;
+#else
 	ssup->comparator = timestamp_fastcmp;
+#endif
 	PG_RETURN_VOID();
 }
 
@@ -2399,6 +2406,67 @@ interval_cmp(PG_FUNCTION_ARGS)
 	PG_RETURN_INT32(interval_cmp_internal(interval1, interval2));
 }
 
+static int
+interval_fastcmp(Datum x, Datum y, SortSupport ssup)
+{
+	Interval   *interval1 = DatumGetIntervalP(x);
+	Interval   *interval2 = DatumGetIntervalP(y);
+
+	return interval_cmp_internal(interval1, interval2);
+}
+
+#if SIZEOF_DATUM >= 8
+
+/*
+ * The abbreviated key is the span computed by interval_cmp_value(), clamped
+ * to the range of int64.  That covers intervals of up to some 290,000 years
+ * exactly; longer ones all get the same abbreviated key as each other, and
+ * are told apart by interval_fastcmp().
+ */
+static Datum
+interval_abbrev_convert(Datum original, SortSupport ssup)
+{
+	INT128		span = interval_cmp_value(DatumGetIntervalP(original));
+
+	if (int128_compare(span, int64_to_int128(PG_INT64_MAX)) > 0)
+		return Int64GetDatum(PG_INT64_MAX);
+	if (int128_compare(span, int64_to_int128(PG_INT64_MIN)) < 0)
+		return Int64GetDatum(PG_INT64_MIN);
+	return Int64GetDatum(int128_to_int64(span));
+}
+
+/*
+ * Apart from very long intervals, the abbreviated key is as discriminating
+ * as the full comparison, so there's never a reason to abort.
+ */
+static bool
+interval_abbrev_abort(int memtupcount, SortSupport ssup)
+{
+	return false;
+}
+
+#endif							/* SIZEOF_DATUM >= 8 */
+
+Datum
+interval_sortsupport(PG_FUNCTION_ARGS)
+{
+	SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+
+#if SIZEOF_DATUM >= 8
+	if (ssup->abbreviate)
+	{
+		ssup->comparator = ssup_datum_signed_cmp;
+		ssup->abbrev_converter = interval_abbrev_convert;
+		ssup->abbrev_abort = interval_abbrev_abort;
+		ssup->abbrev_full_comparator = interval_fastcmp;
+	}
+	else
+#endif
+		ssup->comparator = interval_fastcmp;
+
+	PG_RETURN_VOID();
+}
+
 /*
  * Hashing for intervals
  *
@@ -121,9 +121,17 @@ int			replacement_sort_tuples = 150000;
  * register background workers.
  */
 int			NBuffers = 1000;
+int			transaction_buffers = 0;
+int			commit_timestamp_buffers = 0;
+int			subtransaction_buffers = 32;
+int			multixact_offset_buffers = 8;
+int			multixact_member_buffers = 16;
+int			notify_buffers = 8;
+int			serializable_buffers = 16;
 int			MaxConnections = 90;
 int			max_worker_processes = 8;
 int			max_parallel_workers = 8;
+int			max_parallel_maintenance_workers = 2;
 int			MaxBackends = 0;
 
 int			VacuumCostPageHit = 1;	/* GUC parameters for vacuum */
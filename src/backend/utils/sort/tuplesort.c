@@ -111,6 +111,21 @@
  * above.  Nonetheless, with large workMem we can have many tapes (but not
  * too many -- see the comments in tuplesort_merge_order).
  *
+ * A heap sort can also be one participant of a shared sort, in which the
+ * leader and workers of a parallel query together sort the output of a
+ * partial plan (see tuplesort_attach_shared).  Each participant first sorts
+ * the tuples it was given, using all of its own workMem.  A participant that
+ * managed that in memory just returns its own tuples, as an unshared sort
+ * would.  Those that had to spill to tape instead write their sorted tuples
+ * to a run in a shared BufFile, noting the positions of a sample of them.
+ * Once every such participant has written its run, each one merges all the
+ * runs, but only returns the tuples within its own range of keys; the ranges
+ * are chosen from the samples so that they are of about equal size.  That
+ * costs another pass over the spilled data, in exchange for spreading the
+ * final merge of it over the participants: each of them merges only its own
+ * share, and the Gather Merge node above still merges the participants'
+ * outputs, but those overlap only where in-memory participants' do.
+ *
  *
  * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
@@ -125,15 +140,22 @@
 
 #include <limits.h>
 
+#include "access/gin_private.h"
 #include "access/htup_details.h"
 #include "access/nbtree.h"
 #include "access/hash.h"
 #include "catalog/index.h"
 #include "catalog/pg_am.h"
+#include "catalog/pg_tablespace.h"
 #include "commands/tablespace.h"
 #include "executor/executor.h"
 #include "miscadmin.h"
 #include "pg_trace.h"
+#include "pgstat.h"
+#include "storage/buffile.h"
+#include "storage/condition_variable.h"
+#include "storage/fd.h"
+#include "storage/spin.h"
 #include "utils/datum.h"
 #include "utils/logtape.h"
 #include "utils/lsyscache.h"
@@ -149,6 +171,7 @@
 #define INDEX_SORT		1
 #define DATUM_SORT		2
 #define CLUSTER_SORT	3
+#define GIN_SORT		4
 
 /* GUC variables */
 #ifdef TRACE_SORT
@@ -234,7 +257,8 @@ typedef enum
 	TSS_BUILDRUNS,				/* Loading tuples; writing to tape */
 	TSS_SORTEDINMEM,			/* Sort completed entirely in memory */
 	TSS_SORTEDONTAPE,			/* Sort completed, final run is on tape */
-	TSS_FINALMERGE				/* Performing final merge on-the-fly */
+	TSS_FINALMERGE,				/* Performing final merge on-the-fly */
+	TSS_SHAREDMERGE				/* Merging our key range of shared runs */
 } TupSortStatus;
 
 /*
@@ -262,6 +286,75 @@ typedef enum
 #define HEAP_RUN_NEXT	INT_MAX
 #define RUN_SECOND		1
 
+/*
+ * In-memory sorts of at least RADIX_SORT_MIN_TUPLES tuples whose leading key
+ * sorts as an integer are radix sorted; see radix_sort_tuple().  Radix sort
+ * leaves buckets of fewer than RADIX_SORT_MIN_BUCKET tuples to quicksort.
+ * Multi-key quicksort is used for MinimalTuple sorts of at least
+ * MKQS_MIN_SORT_TUPLES tuples, and leaves pieces of fewer than
+ * MKQS_MIN_TUPLES tuples to insertion sort.  Smaller sorts gain little from
+ * it, and using qsort_tuple for them keeps the order in which they return
+ * tuples with equal keys the same as before.
+ */
+#define RADIX_SORT_MIN_TUPLES	1024
+#define RADIX_SORT_MIN_BUCKET	64
+#define MKQS_MIN_SORT_TUPLES	1024
+#define MKQS_MIN_TUPLES			8
+
+/*
+ * Each participant of a shared sort remembers the positions of up to
+ * SHARED_SORT_SAMPLES tuples of its run, evenly spaced through the run.
+ */
+#define SHARED_SORT_SAMPLES		128
+
+/* Position of a tuple in a shared run, as reported by BufFileTell */
+typedef struct SharedSortSample
+{
+	int			fileno;
+	off_t		offset;
+} SharedSortSample;
+
+/* What a shared sort participant tells the others about its run */
+typedef struct SharedSortRun
+{
+	Oid			tblspcOid;		/* where the run's files are, if valid */
+	bool		spilled;		/* did the participant's sort spill? */
+	int64		ntuples;		/* number of tuples in the run */
+	int			nsamples;		/* number of valid samples[] */
+	SharedSortSample samples[SHARED_SORT_SAMPLES];
+} SharedSortRun;
+
+/*
+ * Shared state of a shared sort, in dynamic shared memory.
+ *
+ * Participants attach in turn and are numbered by nattached.  Once all of
+ * the attached participants have sorted their own tuples, runsdone is set,
+ * and no one else may attach.  Only the nspilled participants whose sorts
+ * spilled then write runs, and they begin merging once all nspilled runs
+ * have been written.  The run files are named after the leader's PID,
+ * sortid and generation, so that they're unique, and are deleted when the
+ * leader detaches from the segment, or the shared state is reinitialized.
+ */
+struct Sharedsort
+{
+	slock_t		mutex;			/* protects the counters below */
+	int			nattached;		/* number of participants so far */
+	int			nfinished;		/* number that have sorted their tuples */
+	bool		runsdone;		/* have all the participants finished? */
+	int			nspilled;		/* number whose sorts spilled */
+	int			nwritten;		/* number that have written their runs */
+
+	ConditionVariable cv;		/* broadcast when runsdone is set, and when
+								 * the last run is written */
+
+	int			leader_pid;		/* these three identify the run files */
+	uint32		sortid;
+	uint32		generation;
+
+	int			nparticipants;	/* allocated length of runs[] */
+	SharedSortRun runs[FLEXIBLE_ARRAY_MEMBER];
+};
+
 typedef int (*SortTupleComparator) (const SortTuple *a, const SortTuple *b,
 									Tuplesortstate *state);
 
@@ -478,6 +571,9 @@ struct Tuplesortstate
 	uint32		low_mask;
 	uint32		max_buckets;
 
+	/* This is specific to the index_gin subcase: */
+	GinState   *ginstate;		/* GIN key comparison support */
+
 	/*
 	 * These variables are specific to the Datum case; they are set by
 	 * tuplesort_begin_datum and used only by the DatumTuple routines.
@@ -486,6 +582,20 @@ struct Tuplesortstate
 	/* we need typelen in order to know how to copy the Datums. */
 	int			datumTypeLen;
 
+	/*
+	 * These variables are used by shared sorts; see tuplesort_attach_shared.
+	 * During the merge, the memtuples heap holds the next tuple of each run,
+	 * with its participant number in tupindex, and sharedhi is the first key
+	 * beyond our range, unless sharedhasHi is false.
+	 */
+	Sharedsort *shared;			/* NULL unless a shared sort participant */
+	int			participant;	/* our index in shared->runs[] */
+	long		sharedSpaceUsed;	/* kB written to our run */
+	int			nsharedruns;	/* number of runs being merged */
+	BufFile   **sharedfiles;	/* the runs, NULL if empty */
+	SortTuple	sharedhi;
+	bool		sharedhasHi;
+
 	/*
 	 * Resource snapshot for time of sort start.
 	 */
@@ -593,9 +703,27 @@ static void beginmerge(Tuplesortstate *state);
 static bool mergereadnext(Tuplesortstate *state, int srcTape, SortTuple *stup);
 static void dumptuples(Tuplesortstate *state, bool alltuples);
 static void dumpbatch(Tuplesortstate *state, bool alltuples);
+static void shared_run_name(char *name, Sharedsort *shared, int participant);
+static void shared_sort_exchange(Tuplesortstate *state);
+static void shared_sort_write_run(Tuplesortstate *state);
+static void shared_sort_begin_merge(Tuplesortstate *state);
+static bool shared_sort_readtup(Tuplesortstate *state, BufFile *file,
+					SortTuple *stup);
+static bool shared_sort_readnext(Tuplesortstate *state, int run,
+					 SortTuple *stup);
+static void shared_sort_on_detach(dsm_segment *seg, Datum arg);
 static void make_bounded_heap(Tuplesortstate *state);
 static void sort_bounded_heap(Tuplesortstate *state);
 static void tuplesort_sort_memtuples(Tuplesortstate *state);
+static void quicksort_tuples(Tuplesortstate *state, SortTuple *tuples, int n);
+static bool radix_sort_ok(Tuplesortstate *state);
+static void radix_sort_tuple(Tuplesortstate *state, SortTuple *tuples, int n);
+static void radix_sort_level(Tuplesortstate *state, SortTuple *tuples, int n,
+				 int level, int keybytes);
+static void sort_leading_key_ties(Tuplesortstate *state, SortTuple *tuples,
+					  int n);
+static void mkqsort_heap(Tuplesortstate *state, SortTuple *tuples, int n,
+			 int level);
 static void tuplesort_heap_insert(Tuplesortstate *state, SortTuple *tuple,
 					  bool checkIndex);
 static void tuplesort_heap_replace_top(Tuplesortstate *state, SortTuple *tuple,
@@ -628,6 +756,14 @@ static void writetup_index(Tuplesortstate *state, int tapenum,
 			   SortTuple *stup);
 static void readtup_index(Tuplesortstate *state, SortTuple *stup,
 			  int tapenum, unsigned int len);
+static int comparetup_index_gin(const SortTuple *a, const SortTuple *b,
+					 Tuplesortstate *state);
+static void copytup_index_gin(Tuplesortstate *state, SortTuple *stup,
+				  void *tup);
+static void writetup_index_gin(Tuplesortstate *state, int tapenum,
+				   SortTuple *stup);
+static void readtup_index_gin(Tuplesortstate *state, SortTuple *stup,
+				  int tapenum, unsigned int len);
 static int comparetup_datum(const SortTuple *a, const SortTuple *b,
 				 Tuplesortstate *state);
 static void copytup_datum(Tuplesortstate *state, SortTuple *stup, void *tup);
@@ -991,6 +1127,74 @@ tuplesort_begin_index_btree(Relation heapRel,
 	return state;
 }
 
+/*
+ * Sort GiST index tuples into the order defined by the opclasses'
+ * sortsupport functions, for a sorted GiST index build.  The tuples are
+ * formed from already-compressed key values, so the comparators see the
+ * datums as they are stored in the index.
+ */
+Tuplesortstate *
+tuplesort_begin_index_gist(Relation heapRel,
+						   Relation indexRel,
+						   int workMem, bool randomAccess)
+{
+	Tuplesortstate *state = tuplesort_begin_common(workMem, randomAccess);
+	MemoryContext oldcontext;
+	int			i;
+
+	oldcontext = MemoryContextSwitchTo(state->sortcontext);
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG,
+			 "begin index sort: workMem = %d, randomAccess = %c",
+			 workMem, randomAccess ? 't' : 'f');
+#endif
+
+	state->nKeys = RelationGetNumberOfAttributes(indexRel);
+
+	TRACE_POSTGRESQL_SORT_START(INDEX_SORT,
+								false,	/* no unique check */
+								state->nKeys,
+								workMem,
+								randomAccess);
+
+	state->comparetup = comparetup_index_btree;
+	state->copytup = copytup_index;
+	state->writetup = writetup_index;
+	state->readtup = readtup_index;
+	state->abbrevNext = 10;
+
+	state->heapRel = heapRel;
+	state->indexRel = indexRel;
+	state->enforceUnique = false;
+
+	/* Prepare SortSupport data for each column */
+	state->sortKeys = (SortSupport) palloc0(state->nKeys *
+											sizeof(SortSupportData));
+
+	for (i = 0; i < state->nKeys; i++)
+	{
+		SortSupport sortKey = state->sortKeys + i;
+
+		sortKey->ssup_cxt = CurrentMemoryContext;
+		sortKey->ssup_collation = indexRel->rd_indcollation[i];
+		sortKey->ssup_nulls_first = false;
+		sortKey->ssup_attno = i + 1;
+		/* Convey if abbreviation optimization is applicable in principle */
+		sortKey->abbreviate = (i == 0);
+
+		AssertState(sortKey->ssup_attno != 0);
+
+		/* Look for a sort support function */
+		PrepareSortSupportFromGistIndexRel(indexRel, sortKey);
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return state;
+}
+
 Tuplesortstate *
 tuplesort_begin_index_hash(Relation heapRel,
 						   Relation indexRel,
@@ -1034,6 +1238,44 @@ tuplesort_begin_index_hash(Relation heapRel,
 	return state;
 }
 
+Tuplesortstate *
+tuplesort_begin_index_gin(GinState *ginstate,
+						  int workMem, bool randomAccess)
+{
+	Tuplesortstate *state = tuplesort_begin_common(workMem, randomAccess);
+	MemoryContext oldcontext;
+
+	oldcontext = MemoryContextSwitchTo(state->sortcontext);
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG,
+			 "begin gin index sort: workMem = %d, randomAccess = %c",
+			 workMem, randomAccess ? 't' : 'f');
+#endif
+
+	/* Sort on attribute number, then key, then first TID */
+	state->nKeys = 1;
+
+	TRACE_POSTGRESQL_SORT_START(GIN_SORT,
+								false,	/* no unique check */
+								state->nKeys,
+								workMem,
+								randomAccess);
+
+	state->comparetup = comparetup_index_gin;
+	state->copytup = copytup_index_gin;
+	state->writetup = writetup_index_gin;
+	state->readtup = readtup_index_gin;
+
+	state->indexRel = ginstate->index;
+	state->ginstate = ginstate;
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return state;
+}
+
 Tuplesortstate *
 tuplesort_begin_datum(Oid datumType, Oid sortOperator, Oid sortCollation,
 					  bool nullsFirstFlag,
@@ -1126,6 +1368,7 @@ tuplesort_set_bound(Tuplesortstate *state, int64 bound)
 	Assert(state->status == TSS_INITIAL);
 	Assert(state->memtupcount == 0);
 	Assert(!state->bounded);
+	Assert(state->shared == NULL);
 
 #ifdef DEBUG_BOUNDED_SORT
 	/* Honor GUC setting that disables the feature (for easy testing) */
@@ -1154,6 +1397,104 @@ tuplesort_set_bound(Tuplesortstate *state, int64 bound)
 	state->sortKeys->abbrev_full_comparator = NULL;
 }
 
+/*
+ * tuplesort_estimate_shared - report size of a shared sort's shared state
+ *
+ * nparticipants is the most participants there can be, including the leader.
+ */
+Size
+tuplesort_estimate_shared(int nparticipants)
+{
+	return add_size(offsetof(Sharedsort, runs),
+					mul_size(nparticipants, sizeof(SharedSortRun)));
+}
+
+/*
+ * tuplesort_initialize_shared - initialize a shared sort's shared state
+ *
+ * This is done by the leader, in the dynamic shared memory segment seg.  The
+ * runs are deleted when the leader detaches from seg.
+ */
+void
+tuplesort_initialize_shared(Sharedsort *shared, int nparticipants,
+							dsm_segment *seg)
+{
+	static uint32 next_sortid = 0;
+
+	SpinLockInit(&shared->mutex);
+	shared->nattached = 0;
+	shared->nfinished = 0;
+	shared->runsdone = false;
+	shared->nspilled = 0;
+	shared->nwritten = 0;
+	ConditionVariableInit(&shared->cv);
+	shared->leader_pid = MyProcPid;
+	shared->sortid = next_sortid++;
+	shared->generation = 0;
+	shared->nparticipants = nparticipants;
+	memset(shared->runs, 0, nparticipants * sizeof(SharedSortRun));
+
+	on_dsm_detach(seg, shared_sort_on_detach, PointerGetDatum(shared));
+}
+
+/*
+ * tuplesort_reinitialize_shared - reset a shared sort, to sort again
+ *
+ * This deletes the runs of the previous sort, so no participant may still be
+ * using them.
+ */
+void
+tuplesort_reinitialize_shared(Sharedsort *shared)
+{
+	shared_sort_on_detach(NULL, PointerGetDatum(shared));
+
+	shared->nattached = 0;
+	shared->nfinished = 0;
+	shared->runsdone = false;
+	shared->nspilled = 0;
+	shared->nwritten = 0;
+	shared->generation++;
+	memset(shared->runs, 0, shared->nparticipants * sizeof(SharedSortRun));
+}
+
+/*
+ * tuplesort_attach_shared - make this sort a participant of a shared sort
+ *
+ * This must be done before any tuples are put, and is only possible for heap
+ * sorts that are neither bounded nor random-access.  The sort is only
+ * correct if every input tuple is put to just one participant, and the output
+ * of all participants is merged by the caller, as Gather Merge does.  After
+ * tuplesort_performsort, a participant whose sort fitted in memory returns
+ * its own tuples, and each of the others returns the tuples of all spilled
+ * participants that fall in its share of the key range.
+ *
+ * Returns false, and leaves this an ordinary sort, if the participants of
+ * the shared sort have already finished with their input.  (The caller has
+ * then nothing left to sort, if its input is from a parallel scan.)
+ */
+bool
+tuplesort_attach_shared(Tuplesortstate *state, Sharedsort *shared)
+{
+	int			participant = -1;
+
+	Assert(state->status == TSS_INITIAL);
+	Assert(state->memtupcount == 0);
+	Assert(state->comparetup == comparetup_heap);
+	Assert(!state->bounded && !state->randomAccess);
+
+	SpinLockAcquire(&shared->mutex);
+	if (!shared->runsdone && shared->nattached < shared->nparticipants)
+		participant = shared->nattached++;
+	SpinLockRelease(&shared->mutex);
+
+	if (participant < 0)
+		return false;
+
+	state->shared = shared;
+	state->participant = participant;
+	return true;
+}
+
 /*
  * tuplesort_end
  *
@@ -1186,6 +1527,16 @@ tuplesort_end(Tuplesortstate *state)
 	 */
 	if (state->tapeset)
 		LogicalTapeSetClose(state->tapeset);
+	if (state->sharedfiles)
+	{
+		int			i;
+
+		for (i = 0; i < state->nsharedruns; i++)
+		{
+			if (state->sharedfiles[i])
+				BufFileClose(state->sharedfiles[i]);
+		}
+	}
 
 #ifdef TRACE_SORT
 	if (trace_sort)
@@ -1476,6 +1827,28 @@ tuplesort_putindextuplevalues(Tuplesortstate *state, Relation rel,
 	MemoryContextSwitchTo(oldcontext);
 }
 
+/*
+ * Accept one GinBuildTuple while collecting input data for sort.
+ *
+ * Note that the input data is always copied; the caller need not save it.
+ */
+void
+tuplesort_putgintuple(Tuplesortstate *state, GinBuildTuple *tup)
+{
+	MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+	SortTuple	stup;
+
+	/*
+	 * Copy the given tuple into memory we control, and decrease availMem.
+	 * Then call the common code.
+	 */
+	COPYTUP(state, &stup, (void *) tup);
+
+	puttuple_common(state, &stup);
+
+	MemoryContextSwitchTo(oldcontext);
+}
+
 /*
  * Accept one Datum while collecting input data for sort.
  *
@@ -1832,6 +2205,9 @@ tuplesort_performsort(Tuplesortstate *state)
 			break;
 	}
 
+	if (state->shared)
+		shared_sort_exchange(state);
+
 #ifdef TRACE_SORT
 	if (trace_sort)
 	{
@@ -2084,6 +2460,38 @@ tuplesort_gettuple_common(Tuplesortstate *state, bool forward,
 			}
 			return false;
 
+		case TSS_SHAREDMERGE:
+			Assert(forward);
+
+			/* The tuple we returned last time was palloc'd */
+			if (state->lastReturnedTuple)
+			{
+				pfree(state->lastReturnedTuple);
+				state->lastReturnedTuple = NULL;
+			}
+
+			/* As for TSS_FINALMERGE, but reading from the shared runs */
+			if (state->memtupcount > 0)
+			{
+				int			run = state->memtuples[0].tupindex;
+				SortTuple	newtup;
+
+				*stup = state->memtuples[0];
+				state->lastReturnedTuple = stup->tuple;
+
+				if (!shared_sort_readnext(state, run, &newtup))
+				{
+					tuplesort_heap_delete_top(state, false);
+					BufFileClose(state->sharedfiles[run]);
+					state->sharedfiles[run] = NULL;
+					return true;
+				}
+				newtup.tupindex = run;
+				tuplesort_heap_replace_top(state, &newtup, false);
+				return true;
+			}
+			return false;
+
 		default:
 			elog(ERROR, "invalid tuplesort state");
 			return false;		/* keep compiler quiet */
@@ -2180,6 +2588,26 @@ tuplesort_getindextuple(Tuplesortstate *state, bool forward)
 	return (IndexTuple) stup.tuple;
 }
 
+/*
+ * Fetch the next GinBuildTuple in either forward or back direction.
+ * Returns NULL if no more tuples.  Returned tuple belongs to tuplesort memory
+ * context, and must not be freed by caller.  Caller may not rely on tuple
+ * remaining valid after any further manipulation of tuplesort.
+ */
+GinBuildTuple *
+tuplesort_getgintuple(Tuplesortstate *state, bool forward)
+{
+	MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+	SortTuple	stup;
+
+	if (!tuplesort_gettuple_common(state, forward, &stup))
+		stup.tuple = NULL;
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return (GinBuildTuple *) stup.tuple;
+}
+
 /*
  * Fetch the next Datum in either forward or back direction.
  * Returns FALSE if no more datums.
@@ -2269,6 +2697,7 @@ tuplesort_skiptuples(Tuplesortstate *state, int64 ntuples, bool forward)
 
 		case TSS_SORTEDONTAPE:
 		case TSS_FINALMERGE:
+		case TSS_SHAREDMERGE:
 
 			/*
 			 * We could probably optimize these cases better, but for now it's
@@ -3125,53 +3554,531 @@ dumpbatch(Tuplesortstate *state, bool alltuples)
 }
 
 /*
- * tuplesort_rescan		- rewind and replay the scan
+ * Build the name of a participant's run file of a shared sort.
  */
-void
-tuplesort_rescan(Tuplesortstate *state)
+static void
+shared_run_name(char *name, Sharedsort *shared, int participant)
 {
-	MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+	snprintf(name, MAXPGPATH, "%s%d.sort%u.%u.%d",
+			 PG_TEMP_FILE_PREFIX, shared->leader_pid, shared->sortid,
+			 shared->generation, participant);
+}
 
-	Assert(state->randomAccess);
+/*
+ * Once our own tuples are sorted, swap runs with the other participants of
+ * our shared sort whose sorts also spilled, and get ready to merge our share
+ * of the key range.  If our sort didn't spill, or no one else's did, just
+ * return our own tuples.
+ */
+static void
+shared_sort_exchange(Tuplesortstate *state)
+{
+	Sharedsort *shared = state->shared;
+	bool		spilled = (state->status != TSS_SORTEDINMEM);
+	bool		alone;
+	bool		done;
+	int			nspilled;
 
-	switch (state->status)
+	/*
+	 * If no one else has attached, no one can any more, and our sort is the
+	 * whole sort.  This spares sorts that are done before any workers start
+	 * writing everything out and reading it back.
+	 */
+	SpinLockAcquire(&shared->mutex);
+	alone = (shared->nattached == 1);
+	if (alone)
 	{
-		case TSS_SORTEDINMEM:
-			state->current = 0;
-			state->eof_reached = false;
-			state->markpos_offset = 0;
-			state->markpos_eof = false;
-			break;
-		case TSS_SORTEDONTAPE:
-			LogicalTapeRewindForRead(state->tapeset,
-									 state->result_tape,
-									 0);
-			state->eof_reached = false;
-			state->markpos_block = 0L;
-			state->markpos_offset = 0;
-			state->markpos_eof = false;
-			break;
-		default:
-			elog(ERROR, "invalid tuplesort state");
-			break;
+		shared->nfinished = 1;
+		shared->runsdone = true;
 	}
+	SpinLockRelease(&shared->mutex);
 
-	MemoryContextSwitchTo(oldcontext);
-}
+	if (alone)
+	{
+		state->shared = NULL;
+		return;
+	}
 
-/*
- * tuplesort_markpos	- saves current position in the merged sort file
- */
-void
-tuplesort_markpos(Tuplesortstate *state)
-{
-	MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+	SpinLockAcquire(&shared->mutex);
+	shared->nfinished++;
+	if (spilled)
+	{
+		shared->runs[state->participant].spilled = true;
+		shared->nspilled++;
+	}
+	if (shared->nfinished == shared->nattached)
+		shared->runsdone = true;
+	done = shared->runsdone;
+	SpinLockRelease(&shared->mutex);
 
-	Assert(state->randomAccess);
+	if (done)
+		ConditionVariableBroadcast(&shared->cv);
 
-	switch (state->status)
+	/*
+	 * A sort done in memory has nothing to gain from the others, and
+	 * exchanging with them would cost more than merging in Gather Merge.
+	 */
+	if (!spilled)
 	{
-		case TSS_SORTEDINMEM:
+		state->shared = NULL;
+		return;
+	}
+
+	/* Wait until all the participants have sorted their own tuples */
+	if (!done)
+	{
+		for (;;)
+		{
+			SpinLockAcquire(&shared->mutex);
+			done = shared->runsdone;
+			SpinLockRelease(&shared->mutex);
+			if (done)
+				break;
+			ConditionVariableSleep(&shared->cv, WAIT_EVENT_PARALLEL_SORT);
+		}
+		ConditionVariableCancelSleep();
+	}
+
+	/* nspilled can't change any more */
+	SpinLockAcquire(&shared->mutex);
+	nspilled = shared->nspilled;
+	SpinLockRelease(&shared->mutex);
+
+	if (nspilled == 1)
+	{
+		state->shared = NULL;
+		return;
+	}
+
+	shared_sort_write_run(state);
+
+	/* Wait until all the spilled participants have written their runs */
+	SpinLockAcquire(&shared->mutex);
+	shared->nwritten++;
+	done = (shared->nwritten == shared->nspilled);
+	SpinLockRelease(&shared->mutex);
+
+	if (done)
+		ConditionVariableBroadcast(&shared->cv);
+	else
+	{
+		for (;;)
+		{
+			SpinLockAcquire(&shared->mutex);
+			done = (shared->nwritten == shared->nspilled);
+			SpinLockRelease(&shared->mutex);
+			if (done)
+				break;
+			ConditionVariableSleep(&shared->cv, WAIT_EVENT_PARALLEL_SORT);
+		}
+		ConditionVariableCancelSleep();
+	}
+
+	shared_sort_begin_merge(state);
+}
+
+/*
+ * Write all our sorted tuples to our run, sampling their positions as we go,
+ * and then release the memory and tapes that held them.
+ *
+ * Runs use the same representation as tapes do for heap tuples, when random
+ * access isn't needed.
+ */
+static void
+shared_sort_write_run(Tuplesortstate *state)
+{
+	SharedSortRun *run = &state->shared->runs[state->participant];
+	char		name[MAXPGPATH];
+	BufFile    *file;
+	SortTuple	stup;
+	int64		ntuples = 0;
+	int64		interval = 1;
+	off_t		nbytes = 0;
+	Oid			tblspcOid;
+
+	/* Choose a tablespace the way OpenTemporaryFile does */
+	PrepareTempTablespaces();
+	tblspcOid = GetNextTempTableSpace();
+	if (!OidIsValid(tblspcOid))
+		tblspcOid = MyDatabaseTableSpace ? MyDatabaseTableSpace :
+			DEFAULTTABLESPACE_OID;
+
+	/* Set this first, so the file gets deleted even if we fail */
+	run->tblspcOid = tblspcOid;
+	run->nsamples = 0;
+
+	shared_run_name(name, state->shared, state->participant);
+	file = BufFileCreateShared(tblspcOid, name);
+
+	while (tuplesort_gettuple_common(state, true, &stup))
+	{
+		MinimalTuple tuple = (MinimalTuple) stup.tuple;
+		char	   *tupbody = (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET;
+		unsigned int tupbodylen = tuple->t_len - MINIMAL_TUPLE_DATA_OFFSET;
+		unsigned int tuplen = tupbodylen + sizeof(int);
+
+		CHECK_FOR_INTERRUPTS();
+
+		/*
+		 * Sample every interval'th tuple.  When we run out of room, keep
+		 * every other sample, and sample half as often from then on.
+		 */
+		if (ntuples % interval == 0)
+		{
+			SharedSortSample *sample;
+
+			if (run->nsamples == SHARED_SORT_SAMPLES)
+			{
+				int			i;
+
+				for (i = 1; i < SHARED_SORT_SAMPLES / 2; i++)
+					run->samples[i] = run->samples[2 * i];
+				run->nsamples = SHARED_SORT_SAMPLES / 2;
+				interval *= 2;
+			}
+			sample = &run->samples[run->nsamples++];
+			BufFileTell(file, &sample->fileno, &sample->offset);
+		}
+
+		if (BufFileWrite(file, (void *) &tuplen, sizeof(tuplen)) != sizeof(tuplen) ||
+			BufFileWrite(file, (void *) tupbody, tupbodylen) != tupbodylen)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not write to shared sort temporary file: %m")));
+
+		ntuples++;
+		nbytes += tuplen;
+	}
+
+	/* Flush it, so others can read it */
+	BufFileClose(file);
+
+	run->ntuples = ntuples;
+	state->sharedSpaceUsed = (nbytes + 1023) / 1024;
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG, "participant %d of shared sort wrote run of " INT64_FORMAT " tuples: %s",
+			 state->participant, ntuples, pg_rusage_show(&state->ru_start));
+#endif
+
+	/* We're done with everything our own sort used */
+	if (state->tapeset)
+	{
+		LogicalTapeSetClose(state->tapeset);
+		state->tapeset = NULL;
+	}
+	if (state->tuplecontext)
+		MemoryContextReset(state->tuplecontext);
+	if (state->memtuples)
+	{
+		pfree(state->memtuples);
+		state->memtuples = NULL;
+	}
+	state->memtupcount = 0;
+	state->memtupsize = 0;
+	state->lastReturnedTuple = NULL;
+}
+
+/*
+ * Open all the runs of our shared sort, choose our range of keys from their
+ * samples, and find each run's first tuple in the range, to begin the merge.
+ *
+ * Every spilled participant sees the same samples, so all of them choose the
+ * same splitters, and the ranges are disjoint and cover all the keys.  Our
+ * range includes its lower splitter, but not its upper one.
+ */
+static void
+shared_sort_begin_merge(Tuplesortstate *state)
+{
+	Sharedsort *shared = state->shared;
+	int			nruns = shared->nattached;
+	int			nranges = shared->nspilled;
+	int			range = 0;
+	SortTuple **runsamples;
+	SortTuple  *samples;
+	SortTuple  *sorted;
+	int			nsamples = 0;
+	SortTuple	lo;
+	bool		haslo;
+	int			r;
+
+	/*
+	 * Abbreviated keys aren't stored in the runs, and we don't care to
+	 * regenerate them, just as when merging tapes.
+	 */
+	if (state->sortKeys->abbrev_converter != NULL)
+	{
+		state->sortKeys->abbrev_converter = NULL;
+		state->sortKeys->comparator = state->sortKeys->abbrev_full_comparator;
+
+		/* Not strictly necessary, but be tidy */
+		state->sortKeys->abbrev_abort = NULL;
+		state->sortKeys->abbrev_full_comparator = NULL;
+	}
+
+	state->nsharedruns = nruns;
+	state->sharedfiles = (BufFile **) palloc0(nruns * sizeof(BufFile *));
+	runsamples = (SortTuple **) palloc(nruns * sizeof(SortTuple *));
+	samples = (SortTuple *) palloc(nruns * SHARED_SORT_SAMPLES * sizeof(SortTuple));
+
+	/* Open the runs that have any tuples, and read their samples */
+	for (r = 0; r < nruns; r++)
+	{
+		SharedSortRun *run = &shared->runs[r];
+		char		name[MAXPGPATH];
+		BufFile    *file;
+		int			i;
+
+		runsamples[r] = samples + nsamples;
+		if (run->ntuples == 0)
+			continue;
+
+		shared_run_name(name, shared, r);
+		file = BufFileOpenShared(run->tblspcOid, name);
+		state->sharedfiles[r] = file;
+
+		for (i = 0; i < run->nsamples; i++)
+		{
+			if (BufFileSeek(file, run->samples[i].fileno,
+							run->samples[i].offset, SEEK_SET) != 0 ||
+				!shared_sort_readtup(state, file, &samples[nsamples]))
+				ereport(ERROR,
+						(errcode_for_file_access(),
+						 errmsg("could not read from shared sort temporary file: %m")));
+			nsamples++;
+		}
+	}
+
+	/* Our range is numbered by our place among the spilled participants */
+	for (r = 0; r < state->participant; r++)
+	{
+		if (shared->runs[r].spilled)
+			range++;
+	}
+
+	/* Choose the splitters */
+	sorted = (SortTuple *) palloc(Max(nsamples, 1) * sizeof(SortTuple));
+	memcpy(sorted, samples, nsamples * sizeof(SortTuple));
+	qsort_tuple(sorted, nsamples, state->comparetup, state);
+
+	haslo = (range > 0 && nsamples > 0);
+	if (haslo)
+		lo = sorted[(int64) range * nsamples / nranges];
+	state->sharedhasHi = (range < nranges - 1 && nsamples > 0);
+	if (state->sharedhasHi)
+		state->sharedhi = sorted[(int64) (range + 1) * nsamples / nranges];
+
+	/* The merge heap holds at most one tuple per run */
+	state->memtuples = (SortTuple *) palloc(nruns * sizeof(SortTuple));
+	state->memtupsize = nruns;
+	state->memtupcount = 0;
+
+	for (r = 0; r < nruns; r++)
+	{
+		BufFile    *file = state->sharedfiles[r];
+		int			nrunsamples = shared->runs[r].nsamples;
+		int			first = 0;
+		SortTuple	stup;
+
+		if (file == NULL)
+			continue;
+
+		/*
+		 * Find the first sample that isn't below our range, and start reading
+		 * from the sample before it; we need skip at most one sampling
+		 * interval of tuples.
+		 */
+		if (haslo)
+		{
+			int			last = nrunsamples;
+
+			while (first < last)
+			{
+				int			mid = (first + last) / 2;
+
+				if (COMPARETUP(state, &runsamples[r][mid], &lo) < 0)
+					first = mid + 1;
+				else
+					last = mid;
+			}
+		}
+		if (first > 0)
+		{
+			SharedSortSample *sample = &shared->runs[r].samples[first - 1];
+
+			if (BufFileSeek(file, sample->fileno, sample->offset, SEEK_SET) != 0)
+				ereport(ERROR,
+						(errcode_for_file_access(),
+						 errmsg("could not seek in shared sort temporary file: %m")));
+		}
+		else if (BufFileSeek(file, 0, 0L, SEEK_SET) != 0)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not seek in shared sort temporary file: %m")));
+
+		for (;;)
+		{
+			if (!shared_sort_readnext(state, r, &stup))
+			{
+				BufFileClose(file);
+				state->sharedfiles[r] = NULL;
+				break;
+			}
+			if (haslo && COMPARETUP(state, &stup, &lo) < 0)
+			{
+				pfree(stup.tuple);
+				continue;
+			}
+			stup.tupindex = r;
+			tuplesort_heap_insert(state, &stup, false);
+			break;
+		}
+	}
+
+	state->status = TSS_SHAREDMERGE;
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG, "participant %d of shared sort merging %d runs: %s",
+			 state->participant, nranges, pg_rusage_show(&state->ru_start));
+#endif
+}
+
+/*
+ * Read the next tuple of a shared run into *stup, in memory palloc'd in the
+ * sort context.  Returns false at the end of the run.
+ */
+static bool
+shared_sort_readtup(Tuplesortstate *state, BufFile *file, SortTuple *stup)
+{
+	unsigned int tuplen;
+	unsigned int tupbodylen;
+	MinimalTuple tuple;
+	char	   *tupbody;
+	size_t		nread;
+	HeapTupleData htup;
+
+	nread = BufFileRead(file, (void *) &tuplen, sizeof(tuplen));
+	if (nread == 0)
+		return false;
+	if (nread != sizeof(tuplen))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not read from shared sort temporary file: %m")));
+
+	tupbodylen = tuplen - sizeof(int);
+	tuple = (MinimalTuple) MemoryContextAlloc(state->sortcontext,
+											  tupbodylen + MINIMAL_TUPLE_DATA_OFFSET);
+	tupbody = (char *) tuple + MINIMAL_TUPLE_DATA_OFFSET;
+	tuple->t_len = tupbodylen + MINIMAL_TUPLE_DATA_OFFSET;
+	if (BufFileRead(file, (void *) tupbody, tupbodylen) != tupbodylen)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not read from shared sort temporary file: %m")));
+
+	stup->tuple = (void *) tuple;
+	/* set up first-column key value, as readtup_heap does */
+	htup.t_len = tuple->t_len + MINIMAL_TUPLE_OFFSET;
+	htup.t_data = (HeapTupleHeader) ((char *) tuple - MINIMAL_TUPLE_OFFSET);
+	stup->datum1 = heap_getattr(&htup,
+								state->sortKeys[0].ssup_attno,
+								state->tupDesc,
+								&stup->isnull1);
+	return true;
+}
+
+/*
+ * Read the next tuple of a shared run, if there is one within our range.
+ */
+static bool
+shared_sort_readnext(Tuplesortstate *state, int run, SortTuple *stup)
+{
+	if (!shared_sort_readtup(state, state->sharedfiles[run], stup))
+		return false;
+
+	if (state->sharedhasHi && COMPARETUP(state, stup, &state->sharedhi) >= 0)
+	{
+		pfree(stup->tuple);
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Delete the runs of a shared sort.  This is a dsm_segment detach callback
+ * of the leader, and also used by tuplesort_reinitialize_shared.
+ */
+static void
+shared_sort_on_detach(dsm_segment *seg, Datum arg)
+{
+	Sharedsort *shared = (Sharedsort *) DatumGetPointer(arg);
+	int			nattached;
+	int			i;
+
+	SpinLockAcquire(&shared->mutex);
+	nattached = shared->nattached;
+	SpinLockRelease(&shared->mutex);
+
+	for (i = 0; i < nattached; i++)
+	{
+		char		name[MAXPGPATH];
+
+		if (!OidIsValid(shared->runs[i].tblspcOid))
+			continue;
+		shared_run_name(name, shared, i);
+		BufFileDeleteShared(shared->runs[i].tblspcOid, name);
+	}
+}
+
+/*
+ * tuplesort_rescan		- rewind and replay the scan
+ */
+void
+tuplesort_rescan(Tuplesortstate *state)
+{
+	MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+
+	Assert(state->randomAccess);
+
+	switch (state->status)
+	{
+		case TSS_SORTEDINMEM:
+			state->current = 0;
+			state->eof_reached = false;
+			state->markpos_offset = 0;
+			state->markpos_eof = false;
+			break;
+		case TSS_SORTEDONTAPE:
+			LogicalTapeRewindForRead(state->tapeset,
+									 state->result_tape,
+									 0);
+			state->eof_reached = false;
+			state->markpos_block = 0L;
+			state->markpos_offset = 0;
+			state->markpos_eof = false;
+			break;
+		default:
+			elog(ERROR, "invalid tuplesort state");
+			break;
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+}
+
+/*
+ * tuplesort_markpos	- saves current position in the merged sort file
+ */
+void
+tuplesort_markpos(Tuplesortstate *state)
+{
+	MemoryContext oldcontext = MemoryContextSwitchTo(state->sortcontext);
+
+	Assert(state->randomAccess);
+
+	switch (state->status)
+	{
+		case TSS_SORTEDINMEM:
 			state->markpos_offset = state->current;
 			state->markpos_eof = state->eof_reached;
 			break;
@@ -3241,7 +4148,13 @@ tuplesort_get_stats(Tuplesortstate *state,
 	 * to fix.  Is it worth creating an API for the memory context code to
 	 * tell us how much is actually used in sortcontext?
 	 */
-	if (state->tapeset)
+	if (state->status == TSS_SHAREDMERGE)
+	{
+		/* report the size of our own run */
+		stats->spaceType = SORT_SPACE_TYPE_DISK;
+		stats->spaceUsed = state->sharedSpaceUsed;
+	}
+	else if (state->tapeset)
 	{
 		stats->spaceType = SORT_SPACE_TYPE_DISK;
 		stats->spaceUsed = LogicalTapeSetBlocks(state->tapeset) * (BLCKSZ / 1024);
@@ -3266,6 +4179,9 @@ tuplesort_get_stats(Tuplesortstate *state,
 		case TSS_FINALMERGE:
 			stats->sortMethod = SORT_TYPE_EXTERNAL_MERGE;
 			break;
+		case TSS_SHAREDMERGE:
+			stats->sortMethod = SORT_TYPE_PARALLEL_MERGE;
+			break;
 		default:
 			stats->sortMethod = SORT_TYPE_STILL_IN_PROGRESS;
 			break;
@@ -3290,6 +4206,8 @@ tuplesort_method_name(TuplesortMethod m)
 			return "external sort";
 		case SORT_TYPE_EXTERNAL_MERGE:
 			return "external merge";
+		case SORT_TYPE_PARALLEL_MERGE:
+			return "parallel merge";
 	}
 
 	return "unknown";
@@ -3420,27 +4338,462 @@ sort_bounded_heap(Tuplesortstate *state)
 }
 
 /*
- * Sort all memtuples using specialized qsort() routines.
+ * Sort all memtuples using radix sort or specialized qsort() routines.
  *
  * Quicksort is used for small in-memory sorts.  Quicksort is also generally
  * preferred to replacement selection for generating runs during external sort
  * operations, although replacement selection is sometimes used for the first
- * run.
+ * run.  Larger sorts whose leading key sorts as an integer (including most
+ * abbreviated keys) are radix sorted instead.
  */
 static void
 tuplesort_sort_memtuples(Tuplesortstate *state)
 {
 	if (state->memtupcount > 1)
 	{
-		/* Can we use the single-key sort function? */
-		if (state->onlyKey != NULL)
-			qsort_ssup(state->memtuples, state->memtupcount,
-					   state->onlyKey);
+		if (state->memtupcount >= RADIX_SORT_MIN_TUPLES &&
+			radix_sort_ok(state))
+			radix_sort_tuple(state, state->memtuples, state->memtupcount);
+		else
+			quicksort_tuples(state, state->memtuples, state->memtupcount);
+	}
+}
+
+/*
+ * Sort n tuples by comparing them, using the fastest routine that applies.
+ */
+static void
+quicksort_tuples(Tuplesortstate *state, SortTuple *tuples, int n)
+{
+	/* Can we use the single-key sort function? */
+	if (state->onlyKey != NULL)
+		qsort_ssup(tuples, n, state->onlyKey);
+	else if (state->comparetup == comparetup_heap &&
+			 n >= MKQS_MIN_SORT_TUPLES)
+		mkqsort_heap(state, tuples, n, 0);
+	else
+		qsort_tuple(tuples, n, state->comparetup, state);
+}
+
+/*
+ * Radix sort
+ *
+ * Rather than comparing keys, an MSD radix sort distributes the tuples into
+ * 256 buckets by the most significant byte of their key, then each bucket by
+ * the next byte, and so on.  That only works for keys that sort as unsigned
+ * integers, or can be made to; we recognize the comparators that say a key
+ * is like that (see sortsupport.h), and only when the leading key is in
+ * datum1 and the comparetup routine compares that first.  Tuples whose
+ * datum1 is equal (which, when it's an abbreviated key, need not mean that
+ * the leading keys are) are left to sort_leading_key_ties().
+ *
+ * Distributing is done in place, following the "American flag sort" of
+ * McIlroy, Bostic and McIlroy: count the tuples belonging in each bucket,
+ * then swap each misplaced tuple straight into the next free place of its
+ * bucket.
+ */
+static bool
+radix_sort_ok(Tuplesortstate *state)
+{
+	SortSupport sortKey = state->sortKeys;
+
+	if (sortKey == NULL)
+		return false;
+
+	if (state->comparetup != comparetup_heap &&
+		state->comparetup != comparetup_index_btree &&
+		state->comparetup != comparetup_datum)
+		return false;
+
+	return (sortKey->comparator == ssup_datum_unsigned_cmp ||
+#if SIZEOF_DATUM >= 8
+			sortKey->comparator == ssup_datum_signed_cmp ||
+#endif
+			sortKey->comparator == ssup_datum_int32_cmp);
+}
+
+/*
+ * Get a non-null datum1 as an unsigned integer that sorts the same way
+ */
+static inline uint64
+radix_sort_key(Datum datum, SortSupport sortKey)
+{
+	uint64		key;
+
+	/* Flipping the sign bit makes signed integers sort as unsigned */
+	if (sortKey->comparator == ssup_datum_int32_cmp)
+		key = (uint32) DatumGetInt32(datum) ^ UINT64CONST(0x80000000);
+#if SIZEOF_DATUM >= 8
+	else if (sortKey->comparator == ssup_datum_signed_cmp)
+		key = (uint64) datum ^ (UINT64CONST(1) << 63);
+#endif
+	else
+		key = (uint64) datum;
+
+	/* Complementing the key reverses its order */
+	if (sortKey->ssup_reverse)
+		key = ~key;
+
+	return key;
+}
+
+static void
+radix_sort_tuple(Tuplesortstate *state, SortTuple *tuples, int n)
+{
+	SortSupport sortKey = state->sortKeys;
+	SortTuple  *notnull = tuples;
+	int			nnotnull = n;
+	int			keybytes;
+	int			i;
+
+	/*
+	 * NULLs are all equal as far as datum1 goes, so they just need moving to
+	 * whichever end they sort at.
+	 */
+	if (sortKey->ssup_nulls_first)
+	{
+		for (i = 0; i < n; i++)
+		{
+			if (tuples[i].isnull1)
+			{
+				SortTuple	tmp = tuples[i];
+
+				tuples[i] = *notnull;
+				*notnull++ = tmp;
+				nnotnull--;
+			}
+		}
+		sort_leading_key_ties(state, tuples, n - nnotnull);
+	}
+	else
+	{
+		for (i = n - 1; i >= 0; i--)
+		{
+			if (tuples[i].isnull1)
+			{
+				SortTuple	tmp = tuples[i];
+
+				tuples[i] = tuples[--nnotnull];
+				tuples[nnotnull] = tmp;
+			}
+		}
+		sort_leading_key_ties(state, tuples + nnotnull, n - nnotnull);
+	}
+
+	keybytes = (sortKey->comparator == ssup_datum_int32_cmp) ?
+		sizeof(int32) : SIZEOF_DATUM;
+	radix_sort_level(state, notnull, nnotnull, 0, keybytes);
+}
+
+/*
+ * Sort n tuples, all with non-null datum1 and the same first "level" bytes
+ * of radix_sort_key(), on the rest of the key.
+ */
+static void
+radix_sort_level(Tuplesortstate *state, SortTuple *tuples, int n,
+				 int level, int keybytes)
+{
+	SortSupport sortKey = state->sortKeys;
+	int			counts[256];
+	int			next[256];
+	int			ends[256];
+	int			shift;
+	int			b;
+	int			i;
+
+	CHECK_FOR_INTERRUPTS();
+
+	/* Skip over the bytes that all the tuples have the same */
+	for (;;)
+	{
+		if (level == keybytes)
+		{
+			sort_leading_key_ties(state, tuples, n);
+			return;
+		}
+		if (n < RADIX_SORT_MIN_BUCKET)
+		{
+			if (n > 1)
+				quicksort_tuples(state, tuples, n);
+			return;
+		}
+
+		shift = 8 * (keybytes - 1 - level);
+		memset(counts, 0, sizeof(counts));
+		for (i = 0; i < n; i++)
+			counts[(radix_sort_key(tuples[i].datum1, sortKey) >> shift) & 0xFF]++;
+
+		b = (radix_sort_key(tuples[0].datum1, sortKey) >> shift) & 0xFF;
+		if (counts[b] != n)
+			break;
+		level++;
+	}
+
+	/* Work out where each bucket starts and ends */
+	i = 0;
+	for (b = 0; b < 256; b++)
+	{
+		next[b] = i;
+		i += counts[b];
+		ends[b] = i;
+	}
+
+	/* Swap each tuple into its bucket */
+	for (b = 0; b < 256; b++)
+	{
+		while (next[b] < ends[b])
+		{
+			SortTuple  *tuple = &tuples[next[b]];
+			int			dest;
+
+			dest = (radix_sort_key(tuple->datum1, sortKey) >> shift) & 0xFF;
+			if (dest == b)
+				next[b]++;
+			else
+			{
+				SortTuple	tmp = *tuple;
+
+				*tuple = tuples[next[dest]];
+				tuples[next[dest]++] = tmp;
+			}
+		}
+	}
+
+	/* Sort each bucket on the remaining bytes */
+	for (b = 0; b < 256; b++)
+	{
+		if (counts[b] > 1)
+			radix_sort_level(state, tuples + ends[b] - counts[b], counts[b],
+							 level + 1, keybytes);
+	}
+}
+
+/*
+ * Sort n tuples that have equal datum1 (or are all NULL there) on the rest
+ * of their keys.
+ */
+static void
+sort_leading_key_ties(Tuplesortstate *state, SortTuple *tuples, int n)
+{
+	/* With a single, unabbreviated key, there's nothing more to compare */
+	if (n < 2 || state->onlyKey != NULL)
+		return;
+
+	/*
+	 * Otherwise, comparetup will find datum1 equal and go on to the other
+	 * keys, and for an index, to its uniqueness check and tie-breaker.
+	 */
+	if (state->comparetup == comparetup_heap)
+		mkqsort_heap(state, tuples, n, 1);
+	else
+		qsort_tuple(tuples, n, state->comparetup, state);
+}
+
+/*
+ * Multi-key quicksort
+ *
+ * For a sort on several keys, it's wasteful to compare the leading keys of
+ * every pair of tuples that quicksort compares, once its partitions have all
+ * got the same leading keys.  Multi-key quicksort (Bentley and Sedgewick)
+ * partitions on one key at a time, three ways, into the tuples less than,
+ * equal to and greater than the pivot; the tuples equal to it are then
+ * sorted on the next key only.
+ *
+ * This is only done for MinimalTuple sorts.  The keys are compared in
+ * "levels": level 0 compares datum1, and each later level one further key.
+ * When the leading key is abbreviated, level 1 compares it in full.
+ */
+static inline int
+mkqsort_heap_nlevels(Tuplesortstate *state)
+{
+	return state->nKeys + (state->sortKeys->abbrev_converter ? 1 : 0);
+}
+
+static int
+compare_heap_level(Tuplesortstate *state, const SortTuple *a,
+				   const SortTuple *b, int level)
+{
+	SortSupport sortKey = state->sortKeys;
+	HeapTupleData ltup;
+	HeapTupleData rtup;
+	Datum		datum1,
+				datum2;
+	bool		isnull1,
+				isnull2;
+
+	if (level == 0)
+		return ApplySortComparator(a->datum1, a->isnull1,
+								   b->datum1, b->isnull1,
+								   sortKey);
+
+	ltup.t_len = ((MinimalTuple) a->tuple)->t_len + MINIMAL_TUPLE_OFFSET;
+	ltup.t_data = (HeapTupleHeader) ((char *) a->tuple - MINIMAL_TUPLE_OFFSET);
+	rtup.t_len = ((MinimalTuple) b->tuple)->t_len + MINIMAL_TUPLE_OFFSET;
+	rtup.t_data = (HeapTupleHeader) ((char *) b->tuple - MINIMAL_TUPLE_OFFSET);
+
+	if (sortKey->abbrev_converter)
+	{
+		if (level == 1)
+		{
+			datum1 = heap_getattr(&ltup, sortKey->ssup_attno, state->tupDesc,
+								  &isnull1);
+			datum2 = heap_getattr(&rtup, sortKey->ssup_attno, state->tupDesc,
+								  &isnull2);
+
+			return ApplySortAbbrevFullComparator(datum1, isnull1,
+												 datum2, isnull2,
+												 sortKey);
+		}
+		level--;
+	}
+
+	sortKey += level;
+	datum1 = heap_getattr(&ltup, sortKey->ssup_attno, state->tupDesc, &isnull1);
+	datum2 = heap_getattr(&rtup, sortKey->ssup_attno, state->tupDesc, &isnull2);
+
+	return ApplySortComparator(datum1, isnull1, datum2, isnull2, sortKey);
+}
+
+/* Compare on the given level, then on the later ones if that's a tie */
+static int
+compare_heap_from_level(Tuplesortstate *state, const SortTuple *a,
+						const SortTuple *b, int level)
+{
+	int			nlevels = mkqsort_heap_nlevels(state);
+	int			compare;
+
+	for (; level < nlevels; level++)
+	{
+		compare = compare_heap_level(state, a, b, level);
+		if (compare != 0)
+			return compare;
+	}
+
+	return 0;
+}
+
+/*
+ * Sort n tuples, which are equal on every level before "level", on the
+ * given level and the later ones.
+ */
+static void
+mkqsort_heap(Tuplesortstate *state, SortTuple *tuples, int n, int level)
+{
+	int			nlevels = mkqsort_heap_nlevels(state);
+
+	while (n > 1 && level < nlevels)
+	{
+		SortTuple	pivot;
+		SortTuple	tmp;
+		int			lt;
+		int			gt;
+		int			i;
+		int			j;
+		bool		presorted;
+
+		CHECK_FOR_INTERRUPTS();
+
+		if (n < MKQS_MIN_TUPLES)
+		{
+			for (i = 1; i < n; i++)
+			{
+				for (j = i; j > 0 &&
+					 compare_heap_from_level(state, &tuples[j - 1], &tuples[j],
+											 level) > 0; j--)
+				{
+					tmp = tuples[j];
+					tuples[j] = tuples[j - 1];
+					tuples[j - 1] = tmp;
+				}
+			}
+			return;
+		}
+
+		/* Like qsort_tuple, check first whether the input is sorted already */
+		presorted = true;
+		for (i = 1; i < n; i++)
+		{
+			if (compare_heap_from_level(state, &tuples[i - 1], &tuples[i],
+										level) > 0)
+			{
+				presorted = false;
+				break;
+			}
+		}
+		if (presorted)
+			return;
+
+		/* Median of three */
+		{
+			SortTuple  *a = &tuples[0];
+			SortTuple  *b = &tuples[n / 2];
+			SortTuple  *c = &tuples[n - 1];
+
+			if (compare_heap_level(state, a, b, level) < 0)
+			{
+				if (compare_heap_level(state, b, c, level) < 0)
+					pivot = *b;
+				else if (compare_heap_level(state, a, c, level) < 0)
+					pivot = *c;
+				else
+					pivot = *a;
+			}
+			else
+			{
+				if (compare_heap_level(state, b, c, level) > 0)
+					pivot = *b;
+				else if (compare_heap_level(state, a, c, level) > 0)
+					pivot = *c;
+				else
+					pivot = *a;
+			}
+		}
+
+		/*
+		 * Partition into tuples[0 .. lt-1] less than the pivot, tuples[lt ..
+		 * gt-1] equal to it and tuples[gt .. n-1] greater than it.
+		 */
+		lt = 0;
+		i = 0;
+		gt = n;
+		while (i < gt)
+		{
+			int			compare = compare_heap_level(state, &tuples[i], &pivot,
+													 level);
+
+			if (compare < 0)
+			{
+				tmp = tuples[i];
+				tuples[i++] = tuples[lt];
+				tuples[lt++] = tmp;
+			}
+			else if (compare > 0)
+			{
+				tmp = tuples[i];
+				tuples[i] = tuples[--gt];
+				tuples[gt] = tmp;
+			}
+			else
+				i++;
+		}
+
+		/*
+		 * The tuples equal to the pivot go on to the next level.  Recurse on
+		 * the smaller of the other two partitions and iterate on the larger,
+		 * to bound the stack depth.
+		 */
+		mkqsort_heap(state, tuples + lt, gt - lt, level + 1);
+		if (lt < n - gt)
+		{
+			mkqsort_heap(state, tuples, lt, level);
+			tuples += gt;
+			n -= gt;
+		}
 		else
-			qsort_tuple(state->memtuples,
-						state->memtupcount,
-						state->comparetup,
-						state);
+		{
+			mkqsort_heap(state, tuples + gt, n - gt, level);
+			n = lt;
+		}
 	}
 }
 
@@ -4072,7 +5425,8 @@ readtup_cluster(Tuplesortstate *state, SortTuple *stup,
  *
  * The btree and hash cases require separate comparison functions, but the
  * IndexTuple representation is the same so the copy/write/read support
- * functions can be shared.
+ * functions can be shared.  The GiST case uses the btree comparison
+ * function, with SortSupport obtained from the GiST opclasses.
  */
 
 static int
@@ -4364,6 +5718,77 @@ readtup_index(Tuplesortstate *state, SortTuple *stup,
 								 &stup->isnull1);
 }
 
+/*
+ * Routines specialized for the GIN index build case
+ *
+ * GinBuildTuples are sorted entirely by ginCompareBuildTuples(), which knows
+ * how to compare GIN keys, so datum1 is not used.
+ */
+
+static int
+comparetup_index_gin(const SortTuple *a, const SortTuple *b,
+					 Tuplesortstate *state)
+{
+	return ginCompareBuildTuples(state->ginstate,
+								 (GinBuildTuple *) a->tuple,
+								 (GinBuildTuple *) b->tuple);
+}
+
+static void
+copytup_index_gin(Tuplesortstate *state, SortTuple *stup, void *tup)
+{
+	GinBuildTuple *tuple = (GinBuildTuple *) tup;
+	GinBuildTuple *newtuple;
+
+	/* copy the tuple into sort storage */
+	newtuple = (GinBuildTuple *) MemoryContextAlloc(state->tuplecontext,
+													tuple->tuplen);
+	memcpy(newtuple, tuple, tuple->tuplen);
+	USEMEM(state, GetMemoryChunkSpace(newtuple));
+	stup->tuple = (void *) newtuple;
+	stup->datum1 = (Datum) 0;
+	stup->isnull1 = false;
+}
+
+static void
+writetup_index_gin(Tuplesortstate *state, int tapenum, SortTuple *stup)
+{
+	GinBuildTuple *tuple = (GinBuildTuple *) stup->tuple;
+	unsigned int tuplen;
+
+	tuplen = tuple->tuplen + sizeof(tuplen);
+	LogicalTapeWrite(state->tapeset, tapenum,
+					 (void *) &tuplen, sizeof(tuplen));
+	LogicalTapeWrite(state->tapeset, tapenum,
+					 (void *) tuple, tuple->tuplen);
+	if (state->randomAccess)	/* need trailing length word? */
+		LogicalTapeWrite(state->tapeset, tapenum,
+						 (void *) &tuplen, sizeof(tuplen));
+
+	if (!state->slabAllocatorUsed)
+	{
+		FREEMEM(state, GetMemoryChunkSpace(tuple));
+		pfree(tuple);
+	}
+}
+
+static void
+readtup_index_gin(Tuplesortstate *state, SortTuple *stup,
+				  int tapenum, unsigned int len)
+{
+	unsigned int tuplen = len - sizeof(unsigned int);
+	GinBuildTuple *tuple = (GinBuildTuple *) readtup_alloc(state, tuplen);
+
+	LogicalTapeReadExact(state->tapeset, tapenum,
+						 tuple, tuplen);
+	if (state->randomAccess)	/* need trailing length word? */
+		LogicalTapeReadExact(state->tapeset, tapenum,
+							 &tuplen, sizeof(tuplen));
+	stup->tuple = (void *) tuple;
+	stup->datum1 = (Datum) 0;
+	stup->isnull1 = false;
+}
+
 /*
  * Routines specialized for DatumTuple case
  */
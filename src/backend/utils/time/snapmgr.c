@@ -49,6 +49,7 @@
 #include <unistd.h>
 
 #include "access/transam.h"
+#include "access/tuptoaster.h"
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "catalog/catalog.h"
@@ -982,9 +983,14 @@ SnapshotResetXmin(void)
 	if (ActiveSnapshot != NULL)
 		return;
 
+	/*
+	 * Once our xmin moves, toast values we have cached might be vacuumed
+	 * away and their OIDs reused, so forget them.
+	 */
 	if (pairingheap_is_empty(&RegisteredSnapshots))
 	{
 		MyPgXact->xmin = InvalidTransactionId;
+		ResetToastCache();
 		return;
 	}
 
@@ -992,7 +998,10 @@ SnapshotResetXmin(void)
 										pairingheap_first(&RegisteredSnapshots));
 
 	if (TransactionIdPrecedes(MyPgXact->xmin, minSnapshot->xmin))
+	{
 		MyPgXact->xmin = minSnapshot->xmin;
+		ResetToastCache();
+	}
 }
 
 /*
@@ -1146,6 +1155,9 @@ AtEOXact_Snapshot(bool isCommit, bool resetXmin)
 		SnapshotResetXmin();
 
 	Assert(resetXmin || MyPgXact->xmin == 0);
+
+	/* Our xmin is gone, so cached toast values are no longer safe to use */
+	ResetToastCache();
 }
 
 
@@ -676,11 +676,18 @@ pglz_compress(const char *source, int32 slen, char *dest,
  *		Decompresses source into dest. Returns the number of bytes
  *		decompressed in the destination buffer, or -1 if decompression
  *		fails.
+ *
+ *		If check_complete is true, the data is considered corrupted if we
+ *		don't exactly fill the destination buffer while consuming exactly
+ *		all of the source.  Callers that want only a prefix of the original
+ *		data pass false: decompression then stops as soon as rawsize bytes
+ *		have been produced, and the source may be a truncated copy of the
+ *		compressed data (see pglz_maximum_compressed_size).
  * ----------
  */
 int32
 pglz_decompress(const char *source, int32 slen, char *dest,
-				int32 rawsize)
+				int32 rawsize, bool check_complete)
 {
 	const unsigned char *sp;
 	const unsigned char *srcend;
@@ -701,7 +708,7 @@ pglz_decompress(const char *source, int32 slen, char *dest,
 		unsigned char ctrl = *sp++;
 		int			ctrlc;
 
-		for (ctrlc = 0; ctrlc < 8 && sp < srcend; ctrlc++)
+		for (ctrlc = 0; ctrlc < 8 && sp < srcend && dp < destend; ctrlc++)
 		{
 			if (ctrl & 1)
 			{
@@ -730,8 +737,13 @@ pglz_decompress(const char *source, int32 slen, char *dest,
 				 */
 				if (dp + len > destend)
 				{
-					dp += len;
-					break;
+					if (check_complete)
+					{
+						dp += len;
+						break;
+					}
+					/* caller wants only a prefix; copy what fits */
+					len = destend - dp;
 				}
 
 				/*
@@ -766,13 +778,56 @@ pglz_decompress(const char *source, int32 slen, char *dest,
 	}
 
 	/*
-	 * Check we decompressed the right amount.
+	 * Check we decompressed the right amount.  A truncated source can also
+	 * leave us in the middle of a match tag; make sure we didn't read past
+	 * its end in that case.
 	 */
-	if (dp != destend || sp != srcend)
+	if (check_complete)
+	{
+		if (dp != destend || sp != srcend)
+			return -1;
+	}
+	else if (sp > srcend || dp > destend)
 		return -1;
 
 	/*
 	 * That's it.
 	 */
-	return rawsize;
+	return (char *) dp - dest;
+}
+
+
+/* ----------
+ * pglz_maximum_compressed_size -
+ *
+ *		Calculate the maximum compressed size for a given amount of raw data.
+ *		Returns the maximum size, or total compressed size if the maximum
+ *		size is larger than the total compressed size.
+ *
+ *		This is used to fetch only as much of an out-of-line compressed
+ *		value as is needed to decompress a prefix of it.
+ * ----------
+ */
+int32
+pglz_maximum_compressed_size(int32 rawsize, int32 total_compressed_size)
+{
+	int64		compressed_size;
+
+	/*
+	 * In the worst case every byte of the prefix is a literal, which costs
+	 * nine bits: the byte itself plus its control bit.  Round up to whole
+	 * bytes.
+	 */
+	compressed_size = ((int64) rawsize * 9 + 7) / 8;
+
+	/*
+	 * The prefix could also end just before a match tag that extends past
+	 * it.  Allow for the two further bytes a tag can need.
+	 */
+	compressed_size += 2;
+
+	if (compressed_size > total_compressed_size)
+		compressed_size = total_compressed_size;
+
+	return (int32) compressed_size;
 }
@@ -15,11 +15,27 @@
 #include "access/tupdesc.h"
 
 
+/*
+ * Opclasses that keep a summary in a working representation different from
+ * the on-disk one (see bv_mem_value below) provide a callback to convert it
+ * back to the stored representation.
+ */
+typedef void (*brin_serialize_callback_type) (BrinDesc *bdesc,
+											  Datum src,
+											  Datum *dst);
+
 /*
  * A BRIN index stores one index tuple per page range.  Each index tuple
  * has one BrinValues struct for each indexed column; in turn, each BrinValues
  * has (besides the null flags) an array of Datum whose size is determined by
  * the opclass.
+ *
+ * bv_mem_value is available to opclasses whose summary is expensive to
+ * rebuild from the stored values for every added value; it's reset to zero
+ * whenever the tuple is initialized or deformed.  If an opclass sets it, it
+ * must also set bv_serialize, which brin_form_tuple calls to produce the
+ * stored values.  bv_context is the memory context that holds the values of
+ * the tuple, where such working state must be allocated.
  */
 typedef struct BrinValues
 {
@@ -27,6 +43,9 @@ typedef struct BrinValues
 	bool		bv_hasnulls;	/* are there any nulls in the page range? */
 	bool		bv_allnulls;	/* are all values nulls in the page range? */
 	Datum	   *bv_values;		/* current accumulated values */
+	Datum		bv_mem_value;	/* opclass working state, or 0 */
+	MemoryContext bv_context;	/* memory context holding the values */
+	brin_serialize_callback_type bv_serialize;	/* converts bv_mem_value */
 } BrinValues;
 
 /*
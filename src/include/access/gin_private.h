@@ -117,6 +117,27 @@ extern void ginEntryInsert(GinState *ginstate,
 			   ItemPointerData *items, uint32 nitem,
 			   GinStatsData *buildStats);
 
+/*
+ * GinBuildTuple carries one key and a sorted list of heap TIDs between the
+ * participants of a parallel index build, and through tuplesort.  The key
+ * value (if any) is stored at a MAXALIGN'd offset after the fixed fields,
+ * and the TIDs follow it at a SHORTALIGN'd offset.
+ */
+typedef struct GinBuildTuple
+{
+	int			tuplen;			/* length of the whole tuple */
+	OffsetNumber attrnum;		/* attnum of index key */
+	int16		typlen;			/* typlen of key */
+	bool		typbyval;		/* typbyval of key */
+	signed char category;		/* GinNullCategory of key */
+	int			keylen;			/* bytes in data for key value */
+	int			nitems;			/* number of TIDs in the data */
+	char		data[FLEXIBLE_ARRAY_MEMBER];
+} GinBuildTuple;
+
+extern int ginCompareBuildTuples(GinState *ginstate,
+					  GinBuildTuple *a, GinBuildTuple *b);
+
 /* ginbtree.c */
 
 typedef struct GinBtreeStack
@@ -432,14 +453,15 @@ typedef struct GinTupleCollector
 	uint32		sumsize;
 } GinTupleCollector;
 
-extern void ginHeapTupleFastInsert(GinState *ginstate,
+extern void ginHeapTupleFastInsert(GinState *ginstate, Relation heapRel,
 					   GinTupleCollector *collector);
 extern void ginHeapTupleFastCollect(GinState *ginstate,
 						GinTupleCollector *collector,
 						OffsetNumber attnum, Datum value, bool isNull,
 						ItemPointer ht_ctid);
 extern void ginInsertCleanup(GinState *ginstate, bool full_clean,
-				 bool fill_fsm, IndexBulkDeleteResult *stats);
+				 bool fill_fsm, bool forceCleanup,
+				 IndexBulkDeleteResult *stats);
 
 /* ginpostinglist.c */
 
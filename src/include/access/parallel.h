@@ -48,6 +48,7 @@ typedef struct ParallelContext
 extern volatile bool ParallelMessagePending;
 extern int	ParallelWorkerNumber;
 extern bool InitializingParallelWorker;
+extern bool ParallelWorkerMayInsert;
 
 #define		IsParallelWorker()		(ParallelWorkerNumber >= 0)
 
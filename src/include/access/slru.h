@@ -35,6 +35,19 @@
 /* Maximum length of an SLRU name */
 #define SLRU_MAX_NAME_LENGTH	32
 
+/*
+ * Page buffers are divided into banks of SLRU_BANK_SIZE slots (an SLRU with
+ * fewer slots than that has a single bank).  A page can only be cached in
+ * the bank selected by its page number, so looking up a page or choosing a
+ * victim buffer never examines more than one bank, however large the SLRU
+ * is configured to be.  Each bank is protected by its own LWLock, so that
+ * backends working on pages in different banks don't contend.
+ */
+#define SLRU_BANK_SIZE			16
+
+/* Maximum number of buffers any SLRU may be configured with */
+#define SLRU_MAX_ALLOWED_BUFFERS	((1024 * 1024 * 1024) / BLCKSZ)
+
 /*
  * Page status codes.  Note that these do not include the "dirty" bit.
  * page_dirty can be TRUE only in the VALID or WRITE_IN_PROGRESS states;
@@ -54,11 +67,19 @@ typedef enum
  */
 typedef struct SlruSharedData
 {
-	LWLock	   *ControlLock;
-
 	/* Number of buffers managed by this SLRU structure */
 	int			num_slots;
 
+	/*
+	 * Buffers are grouped into num_banks banks of bank_size slots each; bank
+	 * N holds slots N * bank_size up to (N + 1) * bank_size - 1.  The bank
+	 * lock must be held to examine or modify the state of any slot in the
+	 * bank.
+	 */
+	int			num_banks;
+	int			bank_size;
+	LWLockPadded *bank_locks;
+
 	/*
 	 * Arrays holding info for each buffer slot.  Page number is undefined
 	 * when status is EMPTY, as is page_lru_count.
@@ -82,26 +103,33 @@ typedef struct SlruSharedData
 
 	/*----------
 	 * We mark a page "most recently used" by setting
-	 *		page_lru_count[slotno] = ++cur_lru_count;
-	 * The oldest page is therefore the one with the highest value of
-	 *		cur_lru_count - page_lru_count[slotno]
+	 *		page_lru_count[slotno] = ++bank_cur_lru_count[bankno];
+	 * The oldest page in a bank is therefore the one with the highest value
+	 * of
+	 *		bank_cur_lru_count[bankno] - page_lru_count[slotno]
 	 * The counts will eventually wrap around, but this calculation still
 	 * works as long as no page's age exceeds INT_MAX counts.
 	 *----------
 	 */
-	int			cur_lru_count;
+	int		   *bank_cur_lru_count;
 
 	/*
 	 * latest_page_number is the page number of the current end of the log;
 	 * this is not critical data, since we use it only to avoid swapping out
-	 * the latest page.
+	 * the latest page and to sanity-check truncation.  It is read without
+	 * holding any particular bank lock, relying on int reads and writes
+	 * being atomic.
 	 */
 	int			latest_page_number;
 
+	/* Index of this SLRU in the cumulative statistics, see pgstat.c */
+	int			slru_stats_idx;
+
 	/* LWLocks */
 	int			lwlock_tranche_id;
 	char		lwlock_tranche_name[SLRU_MAX_NAME_LENGTH];
 	LWLockPadded *buffer_locks;
+	int			bank_tranche_id;
 } SlruSharedData;
 
 typedef SlruSharedData *SlruShared;
@@ -136,10 +164,24 @@ typedef struct SlruCtlData
 
 typedef SlruCtlData *SlruCtl;
 
+/*
+ * Get the bank number, and the LWLock protecting the bank, for the given page
+ * number.
+ */
+#define SlruBankNo(shared, pageno) \
+	((int) ((uint32) (pageno) % (uint32) (shared)->num_banks))
+
+static inline LWLock *
+SimpleLruGetBankLock(SlruCtl ctl, int pageno)
+{
+	SlruShared	shared = ctl->shared;
+
+	return &shared->bank_locks[SlruBankNo(shared, pageno)].lock;
+}
 
 extern Size SimpleLruShmemSize(int nslots, int nlsns);
 extern void SimpleLruInit(SlruCtl ctl, const char *name, int nslots, int nlsns,
-			  LWLock *ctllock, const char *subdir, int tranche_id);
+			  const char *subdir, int tranche_id, int bank_tranche_id);
 extern int	SimpleLruZeroPage(SlruCtl ctl, int pageno);
 extern int SimpleLruReadPage(SlruCtl ctl, int pageno, bool write_ok,
 				  TransactionId xid);
@@ -76,6 +76,8 @@ typedef struct tupleDesc
 	bool		tdhasoid;		/* tuple has oid attribute in its header */
 	int			tdrefcount;		/* reference count, or -1 if not counting */
 	TupleConstr *constr;		/* constraints, or NULL if none */
+	int			tdfixedatts;	/* # of leading fixed-width attributes, or
+								 * -1 if not computed yet; see heaptuple.c */
 	/* attrs[N] is the description of Attribute Number N+1 */
 	FormData_pg_attribute attrs[FLEXIBLE_ARRAY_MEMBER];
 }		   *TupleDesc;
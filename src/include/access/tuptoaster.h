@@ -23,6 +23,33 @@
  */
 #define TOAST_INDEX_HACK
 
+/*
+ * Compression methods for inline-compressed values.
+ *
+ * A column's attcompression holds one of the TOAST_*_COMPRESSION characters,
+ * or InvalidCompressionMethod to use default_toast_compression.  A compressed
+ * datum records the ToastCompressionId of the method that produced it in the
+ * high bits of its size word (see VARCOMPRESSMETHOD_4B_C), so changing a
+ * column's method never affects values already stored.  pglz must remain ID
+ * 0, since that is what all data compressed before the choice existed has.
+ */
+typedef enum ToastCompressionId
+{
+	TOAST_PGLZ_COMPRESSION_ID = 0,
+	TOAST_LZ4_COMPRESSION_ID = 1,
+	TOAST_INVALID_COMPRESSION_ID = 2
+} ToastCompressionId;
+
+#define TOAST_PGLZ_COMPRESSION			'p'
+#define TOAST_LZ4_COMPRESSION			'l'
+#define InvalidCompressionMethod		'\0'
+
+#define CompressionMethodIsValid(cm)  ((cm) != InvalidCompressionMethod)
+
+/* GUC variables */
+extern int	default_toast_compression;
+extern int	toast_cache_size;
+
 
 /*
  * Find the maximum size of a tuple if there are to be N tuples per page.
@@ -101,6 +128,22 @@
 /* Size of an EXTERNAL datum that contains an indirection pointer */
 #define INDIRECT_POINTER_SIZE (VARHDRSZ_EXTERNAL + sizeof(varatt_indirect))
 
+/*
+ * va_extinfo in a TOAST pointer holds the size of the external data and,
+ * if it is compressed, the ToastCompressionId of the method used.
+ */
+#define VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer) \
+	((toast_pointer).va_extinfo & VARLENA_EXTSIZE_MASK)
+#define VARATT_EXTERNAL_GET_COMPRESS_METHOD(toast_pointer) \
+	((toast_pointer).va_extinfo >> VARLENA_EXTSIZE_BITS)
+#define VARATT_EXTERNAL_SET_SIZE_AND_COMPRESS_METHOD(toast_pointer, len, cm) \
+	do { \
+		Assert((cm) == TOAST_PGLZ_COMPRESSION_ID || \
+			   (cm) == TOAST_LZ4_COMPRESSION_ID); \
+		((toast_pointer).va_extinfo = \
+			(len) | ((uint32) (cm) << VARLENA_EXTSIZE_BITS)); \
+	} while (0)
+
 /*
  * Testing whether an externally-stored value is compressed now requires
  * comparing extsize (the actual length of the external data) to rawsize
@@ -109,7 +152,8 @@
  * saves space, so we expect either equality or less-than.
  */
 #define VARATT_EXTERNAL_IS_COMPRESSED(toast_pointer) \
-	((toast_pointer).va_extsize < (toast_pointer).va_rawsize - VARHDRSZ)
+	(VARATT_EXTERNAL_GET_EXTSIZE(toast_pointer) < \
+	 (toast_pointer).va_rawsize - VARHDRSZ)
 
 /*
  * Macro to fetch the possibly-unaligned contents of an EXTERNAL datum
@@ -210,7 +254,25 @@ extern HeapTuple toast_build_flattened_tuple(TupleDesc tupleDesc,
  *	Create a compressed version of a varlena datum, if possible
  * ----------
  */
-extern Datum toast_compress_datum(Datum value);
+extern Datum toast_compress_datum(Datum value, char cmethod);
+
+/* ----------
+ * toast_get_compression_id -
+ *
+ *	Return the compression method ID of a varlena datum, or
+ *	TOAST_INVALID_COMPRESSION_ID if it isn't compressed
+ * ----------
+ */
+extern ToastCompressionId toast_get_compression_id(struct varlena *attr);
+
+/* ----------
+ * CompressionNameToMethod, GetCompressionMethodName -
+ *
+ *	Convert between compression method names and attcompression values
+ * ----------
+ */
+extern char CompressionNameToMethod(const char *compression);
+extern const char *GetCompressionMethodName(char method);
 
 /* ----------
  * toast_raw_datum_size -
@@ -236,4 +298,12 @@ extern Size toast_datum_size(Datum value);
  */
 extern Oid	toast_get_valid_index(Oid toastoid, LOCKMODE lock);
 
+/* ----------
+ * ResetToastCache -
+ *
+ *	Discard the cache of detoasted out-of-line values
+ * ----------
+ */
+extern void ResetToastCache(void);
+
 #endif							/* TUPTOASTER_H */
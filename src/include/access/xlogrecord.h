@@ -115,7 +115,9 @@ typedef struct XLogRecordBlockHeader
  * present is BLCKSZ - the length of "hole" bytes.
  *
  * When wal_compression is enabled, a full page image which "hole" was
- * removed is additionally compressed using PGLZ compression algorithm.
+ * removed is additionally compressed using the configured algorithm (PGLZ,
+ * LZ4 or Zstandard), recorded in bimg_info so that replay knows how to
+ * decompress it.
  * This can reduce the WAL volume, but at some extra cost of CPU spent
  * on the compression during WAL logging. In this case, since the "hole"
  * length cannot be calculated by subtracting the number of page image bytes
@@ -135,7 +137,7 @@ typedef struct XLogRecordBlockImageHeader
 	uint8		bimg_info;		/* flag bits, see below */
 
 	/*
-	 * If BKPIMAGE_HAS_HOLE and BKPIMAGE_IS_COMPRESSED, an
+	 * If BKPIMAGE_HAS_HOLE and BKPIMAGE_COMPRESSED(), an
 	 * XLogRecordBlockCompressHeader struct follows.
 	 */
 } XLogRecordBlockImageHeader;
@@ -145,9 +147,16 @@ typedef struct XLogRecordBlockImageHeader
 
 /* Information stored in bimg_info */
 #define BKPIMAGE_HAS_HOLE		0x01	/* page image has "hole" */
-#define BKPIMAGE_IS_COMPRESSED		0x02	/* page image is compressed */
+#define BKPIMAGE_COMPRESS_PGLZ	0x02	/* page image is compressed with PGLZ */
 #define BKPIMAGE_APPLY		0x04	/* page image should be restored during
 									 * replay */
+#define BKPIMAGE_COMPRESS_LZ4	0x08	/* page image is compressed with LZ4 */
+#define BKPIMAGE_COMPRESS_ZSTD	0x10	/* page image is compressed with
+										 * Zstandard */
+
+#define BKPIMAGE_COMPRESS_MASK \
+	(BKPIMAGE_COMPRESS_PGLZ | BKPIMAGE_COMPRESS_LZ4 | BKPIMAGE_COMPRESS_ZSTD)
+#define BKPIMAGE_COMPRESSED(info)	(((info) & BKPIMAGE_COMPRESS_MASK) != 0)
 
 /*
  * Extra header information used when page image has "hole" and
@@ -208,6 +217,25 @@ typedef struct XLogRecordDataHeaderLong
 
 #define SizeOfXLogRecordDataHeaderLong (sizeof(uint8) + sizeof(uint32))
 
+/*
+ * XLogRecordDataHeaderCompressed is used instead when the main data has been
+ * compressed (only done for large main data, with wal_compression set to an
+ * algorithm other than pglz).  The method is one of the BKPIMAGE_COMPRESS_*
+ * flags.  The uncompressed length is never more than
+ * XLR_MAX_COMPRESSED_MAIN_DATA.
+ */
+typedef struct XLogRecordDataHeaderCompressed
+{
+	uint8		id;				/* XLR_BLOCK_ID_DATA_COMPRESSED */
+	uint8		method;			/* BKPIMAGE_COMPRESS_* */
+	/* followed by uint32 compressed length and uint32 raw length, unaligned */
+}			XLogRecordDataHeaderCompressed;
+
+#define SizeOfXLogRecordDataHeaderCompressed \
+	(sizeof(uint8) * 2 + sizeof(uint32) * 2)
+
+#define XLR_MAX_COMPRESSED_MAIN_DATA	(4 * BLCKSZ)
+
 /*
  * Block IDs used to distinguish different kinds of record fragments. Block
  * references are numbered from 0 to XLR_MAX_BLOCK_ID. A rmgr is free to use
@@ -224,5 +252,6 @@ typedef struct XLogRecordDataHeaderLong
 #define XLR_BLOCK_ID_DATA_SHORT		255
 #define XLR_BLOCK_ID_DATA_LONG		254
 #define XLR_BLOCK_ID_ORIGIN			253
+#define XLR_BLOCK_ID_DATA_COMPRESSED	252
 
 #endif							/* XLOGRECORD_H */
@@ -76,6 +76,7 @@ typedef FormData_pg_amproc *Form_pg_amproc;
 
 /* btree */
 DATA(insert (	397   2277 2277 1 382 ));
+DATA(insert (	397   2277 2277 2 4627 ));
 DATA(insert (	421   702 702 1 357 ));
 DATA(insert (	423   1560 1560 1 1596 ));
 DATA(insert (	424   16 16 1 1693 ));
@@ -103,6 +104,7 @@ DATA(insert (	1970   701 701 1 355 ));
 DATA(insert (	1970   701 701 2 3133 ));
 DATA(insert (	1970   701 700 1 2195 ));
 DATA(insert (	1974   869 869 1 926 ));
+DATA(insert (	1974   869 869 2 4625 ));
 DATA(insert (	1976   21 21 1 350 ));
 DATA(insert (	1976   21 21 2 3129 ));
 DATA(insert (	1976   21 23 1 2190 ));
@@ -116,6 +118,7 @@ DATA(insert (	1976   20 20 2 3131 ));
 DATA(insert (	1976   20 23 1 2189 ));
 DATA(insert (	1976   20 21 1 2193 ));
 DATA(insert (	1982   1186 1186 1 1315 ));
+DATA(insert (	1982   1186 1186 2 4624 ));
 DATA(insert (	1984   829 829 1 836 ));
 DATA(insert (	1984   829 829 2 3359 ));
 DATA(insert (	1986   19 19 1 359 ));
@@ -148,7 +151,9 @@ DATA(insert (	3522   3500 3500 1 3514 ));
 DATA(insert (	3626   3614 3614 1 3622 ));
 DATA(insert (	3683   3615 3615 1 3668 ));
 DATA(insert (	3901   3831 3831 1 3870 ));
+DATA(insert (	3901   3831 3831 2 4626 ));
 DATA(insert (	4033   3802 3802 1 4044 ));
+DATA(insert (	4033   3802 3802 2 4628 ));
 
 
 /* hash */
@@ -236,6 +241,7 @@ DATA(insert (	1029   600 600 6 2582 ));
 DATA(insert (	1029   600 600 7 2584 ));
 DATA(insert (	1029   600 600 8 3064 ));
 DATA(insert (	1029   600 600 9 3282 ));
+DATA(insert (	1029   600 600 10 4616 ));
 DATA(insert (	2593   603 603 1 2578 ));
 DATA(insert (	2593   603 603 2 2583 ));
 DATA(insert (	2593   603 603 3 2579 ));
@@ -571,5 +577,106 @@ DATA(insert (	4104   603	 603  3  4107 ));
 DATA(insert (	4104   603	 603  4  4108 ));
 DATA(insert (	4104   603	 603  11 4067 ));
 DATA(insert (	4104   603	 603  13  187 ));
+/* minmax multi integer */
+DATA(insert (	4620    21	  21  1  4600 ));
+DATA(insert (	4620    21	  21  2  4601 ));
+DATA(insert (	4620    21	  21  3  4602 ));
+DATA(insert (	4620    21	  21  4  4603 ));
+DATA(insert (	4620    21	  21  11 4604 ));
+DATA(insert (	4620    23	  23  1  4600 ));
+DATA(insert (	4620    23	  23  2  4601 ));
+DATA(insert (	4620    23	  23  3  4602 ));
+DATA(insert (	4620    23	  23  4  4603 ));
+DATA(insert (	4620    23	  23  11 4605 ));
+DATA(insert (	4620    20	  20  1  4600 ));
+DATA(insert (	4620    20	  20  2  4601 ));
+DATA(insert (	4620    20	  20  3  4602 ));
+DATA(insert (	4620    20	  20  4  4603 ));
+DATA(insert (	4620    20	  20  11 4606 ));
+/* minmax multi float */
+DATA(insert (	4621   700	 700  1  4600 ));
+DATA(insert (	4621   700	 700  2  4601 ));
+DATA(insert (	4621   700	 700  3  4602 ));
+DATA(insert (	4621   700	 700  4  4603 ));
+DATA(insert (	4621   700	 700  11 4607 ));
+DATA(insert (	4621   701	 701  1  4600 ));
+DATA(insert (	4621   701	 701  2  4601 ));
+DATA(insert (	4621   701	 701  3  4602 ));
+DATA(insert (	4621   701	 701  4  4603 ));
+DATA(insert (	4621   701	 701  11 4608 ));
+/* minmax multi numeric */
+DATA(insert (	4622  1700	1700  1  4600 ));
+DATA(insert (	4622  1700	1700  2  4601 ));
+DATA(insert (	4622  1700	1700  3  4602 ));
+DATA(insert (	4622  1700	1700  4  4603 ));
+DATA(insert (	4622  1700	1700  11 4609 ));
+/* minmax multi datetime */
+DATA(insert (	4623  1082	1082  1  4600 ));
+DATA(insert (	4623  1082	1082  2  4601 ));
+DATA(insert (	4623  1082	1082  3  4602 ));
+DATA(insert (	4623  1082	1082  4  4603 ));
+DATA(insert (	4623  1082	1082  11 4610 ));
+DATA(insert (	4623  1114	1114  1  4600 ));
+DATA(insert (	4623  1114	1114  2  4601 ));
+DATA(insert (	4623  1114	1114  3  4602 ));
+DATA(insert (	4623  1114	1114  4  4603 ));
+DATA(insert (	4623  1114	1114  11 4611 ));
+DATA(insert (	4623  1184	1184  1  4600 ));
+DATA(insert (	4623  1184	1184  2  4601 ));
+DATA(insert (	4623  1184	1184  3  4602 ));
+DATA(insert (	4623  1184	1184  4  4603 ));
+DATA(insert (	4623  1184	1184  11 4611 ));
+/* bloom integer */
+DATA(insert (	4630    21	  21  1  4612 ));
+DATA(insert (	4630    21	  21  2  4613 ));
+DATA(insert (	4630    21	  21  3  4614 ));
+DATA(insert (	4630    21	  21  4  4615 ));
+DATA(insert (	4630    21	  21  11  449 ));
+DATA(insert (	4630    23	  23  1  4612 ));
+DATA(insert (	4630    23	  23  2  4613 ));
+DATA(insert (	4630    23	  23  3  4614 ));
+DATA(insert (	4630    23	  23  4  4615 ));
+DATA(insert (	4630    23	  23  11  450 ));
+DATA(insert (	4630    20	  20  1  4612 ));
+DATA(insert (	4630    20	  20  2  4613 ));
+DATA(insert (	4630    20	  20  3  4614 ));
+DATA(insert (	4630    20	  20  4  4615 ));
+DATA(insert (	4630    20	  20  11  949 ));
+/* bloom text */
+DATA(insert (	4631    25	  25  1  4612 ));
+DATA(insert (	4631    25	  25  2  4613 ));
+DATA(insert (	4631    25	  25  3  4614 ));
+DATA(insert (	4631    25	  25  4  4615 ));
+DATA(insert (	4631    25	  25  11  400 ));
+/* bloom numeric */
+DATA(insert (	4632  1700	1700  1  4612 ));
+DATA(insert (	4632  1700	1700  2  4613 ));
+DATA(insert (	4632  1700	1700  3  4614 ));
+DATA(insert (	4632  1700	1700  4  4615 ));
+DATA(insert (	4632  1700	1700  11  432 ));
+/* bloom uuid */
+DATA(insert (	4633  2950	2950  1  4612 ));
+DATA(insert (	4633  2950	2950  2  4613 ));
+DATA(insert (	4633  2950	2950  3  4614 ));
+DATA(insert (	4633  2950	2950  4  4615 ));
+DATA(insert (	4633  2950	2950  11 2963 ));
+/* bloom date */
+DATA(insert (	4634  1082	1082  1  4612 ));
+DATA(insert (	4634  1082	1082  2  4613 ));
+DATA(insert (	4634  1082	1082  3  4614 ));
+DATA(insert (	4634  1082	1082  4  4615 ));
+DATA(insert (	4634  1082	1082  11  450 ));
+/* bloom timestamp */
+DATA(insert (	4635  1114	1114  1  4612 ));
+DATA(insert (	4635  1114	1114  2  4613 ));
+DATA(insert (	4635  1114	1114  3  4614 ));
+DATA(insert (	4635  1114	1114  4  4615 ));
+DATA(insert (	4635  1114	1114  11 2039 ));
+/* bloom timestamptz */
+DATA(insert (	4636  1184	1184  1  4612 ));
+DATA(insert (	4636  1184	1184  2  4613 ));
+DATA(insert (	4636  1184	1184  3  4614 ));
+DATA(insert (	4636  1184	1184  4  4615 ));
+DATA(insert (	4636  1184	1184  11 2039 ));
 
 #endif							/* PG_AMPROC_H */
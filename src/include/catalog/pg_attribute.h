@@ -121,6 +121,15 @@ CATALOG(pg_attribute,1249) BKI_BOOTSTRAP BKI_WITHOUT_OIDS BKI_ROWTYPE_OID(75) BK
 	 */
 	char		attstorage;
 
+	/*
+	 * attcompression is the method used to compress values of this column
+	 * when they are compressed inline, one of the TOAST_*_COMPRESSION
+	 * constants in access/tuptoaster.h, or '\0' to use the current setting
+	 * of default_toast_compression.  Values already stored keep the method
+	 * they were compressed with.
+	 */
+	char		attcompression;
+
 	/*
 	 * attalign is a copy of the typalign field from pg_type for this
 	 * attribute.  See atttypid comments above.
@@ -191,7 +200,7 @@ typedef FormData_pg_attribute *Form_pg_attribute;
  * ----------------
  */
 
-#define Natts_pg_attribute				22
+#define Natts_pg_attribute				23
 #define Anum_pg_attribute_attrelid		1
 #define Anum_pg_attribute_attname		2
 #define Anum_pg_attribute_atttypid		3
@@ -203,17 +212,18 @@ typedef FormData_pg_attribute *Form_pg_attribute;
 #define Anum_pg_attribute_atttypmod		9
 #define Anum_pg_attribute_attbyval		10
 #define Anum_pg_attribute_attstorage	11
-#define Anum_pg_attribute_attalign		12
-#define Anum_pg_attribute_attnotnull	13
-#define Anum_pg_attribute_atthasdef		14
-#define Anum_pg_attribute_attidentity	15
-#define Anum_pg_attribute_attisdropped	16
-#define Anum_pg_attribute_attislocal	17
-#define Anum_pg_attribute_attinhcount	18
-#define Anum_pg_attribute_attcollation	19
-#define Anum_pg_attribute_attacl		20
-#define Anum_pg_attribute_attoptions	21
-#define Anum_pg_attribute_attfdwoptions 22
+#define Anum_pg_attribute_attcompression	12
+#define Anum_pg_attribute_attalign		13
+#define Anum_pg_attribute_attnotnull	14
+#define Anum_pg_attribute_atthasdef		15
+#define Anum_pg_attribute_attidentity	16
+#define Anum_pg_attribute_attisdropped	17
+#define Anum_pg_attribute_attislocal	18
+#define Anum_pg_attribute_attinhcount	19
+#define Anum_pg_attribute_attcollation	20
+#define Anum_pg_attribute_attacl		21
+#define Anum_pg_attribute_attoptions	22
+#define Anum_pg_attribute_attfdwoptions 23
 
 
 /* ----------------
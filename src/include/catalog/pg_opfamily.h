@@ -185,6 +185,17 @@ DATA(insert OID = 4081 (	3580	uuid_minmax_ops			PGNSP PGUID ));
 DATA(insert OID = 4103 (	3580	range_inclusion_ops		PGNSP PGUID ));
 DATA(insert OID = 4082 (	3580	pg_lsn_minmax_ops		PGNSP PGUID ));
 DATA(insert OID = 4104 (	3580	box_inclusion_ops		PGNSP PGUID ));
+DATA(insert OID = 4620 (	3580	integer_minmax_multi_ops	PGNSP PGUID ));
+DATA(insert OID = 4621 (	3580	float_minmax_multi_ops		PGNSP PGUID ));
+DATA(insert OID = 4622 (	3580	numeric_minmax_multi_ops	PGNSP PGUID ));
+DATA(insert OID = 4623 (	3580	datetime_minmax_multi_ops	PGNSP PGUID ));
+DATA(insert OID = 4630 (	3580	integer_bloom_ops			PGNSP PGUID ));
+DATA(insert OID = 4631 (	3580	text_bloom_ops				PGNSP PGUID ));
+DATA(insert OID = 4632 (	3580	numeric_bloom_ops			PGNSP PGUID ));
+DATA(insert OID = 4633 (	3580	uuid_bloom_ops				PGNSP PGUID ));
+DATA(insert OID = 4634 (	3580	date_bloom_ops				PGNSP PGUID ));
+DATA(insert OID = 4635 (	3580	timestamp_bloom_ops			PGNSP PGUID ));
+DATA(insert OID = 4636 (	3580	timestamptz_bloom_ops		PGNSP PGUID ));
 DATA(insert OID = 5000 (	4000	box_ops		PGNSP PGUID ));
 
 #endif							/* PG_OPFAMILY_H */
@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------
+ *
+ * execBatch.h
+ *	  Support for batch-at-a-time execution of scans, quals and aggregates.
+ *
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/execBatch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef EXECBATCH_H
+#define EXECBATCH_H
+
+#include "nodes/primnodes.h"
+
+/* GUC variable */
+extern bool enable_batch_execution;
+
+/* Maximum number of rows in a batch; row numbers must fit in a uint16 */
+#define BATCH_SIZE		1024
+
+/*
+ * Column types that batch quals and aggregates know how to process.  Values
+ * of the integer types are compared and summed as int64; BATCH_ANY columns
+ * are only ever tested for nullness.
+ */
+typedef enum BatchType
+{
+	BATCH_INT2,
+	BATCH_INT4,					/* also used for date */
+	BATCH_INT8,
+	BATCH_ANY
+} BatchType;
+
+typedef enum BatchCmp
+{
+	BATCH_LT,
+	BATCH_LE,
+	BATCH_EQ,
+	BATCH_NE,
+	BATCH_GE,
+	BATCH_GT
+} BatchCmp;
+
+/* A qual clause of the form "column <cmp> constant" */
+typedef struct BatchQualClause
+{
+	int			col;			/* index of column in batch */
+	BatchCmp	cmp;			/* comparison to make */
+	int64		constval;		/* value to compare with */
+} BatchQualClause;
+
+/*
+ * TupleBatch
+ *
+ * A batch of up to BATCH_SIZE rows from a scan, stored column-wise: only the
+ * columns needed by the consumer are kept, each as an array of Datums plus
+ * an array of null flags.  All columns other than BATCH_ANY ones are of
+ * pass-by-value types, so the values stay valid after the scan moves on to
+ * other pages.
+ *
+ * The scan applies the batch's quals once the batch is filled, leaving the
+ * numbers of the rows that passed in the selection vector sel[0..nsel-1],
+ * in ascending order.
+ */
+typedef struct TupleBatch
+{
+	/* Set up once, by ExecBatchAddColumn and ExecBatchAddQual */
+	int			ncols;
+	AttrNumber *attnums;		/* scan attribute number of each column */
+	BatchType  *types;			/* type of each column */
+	AttrNumber	maxattnum;		/* highest attribute number needed */
+	int			nquals;
+	BatchQualClause *quals;		/* implicitly-ANDed quals */
+
+	/* Contents of the current batch */
+	int			nrows;			/* number of rows loaded */
+	Datum	  **values;			/* values[col][row] */
+	bool	  **isnull;			/* isnull[col][row] */
+	int			nsel;			/* number of rows that passed the quals */
+	uint16	   *sel;			/* their row numbers */
+} TupleBatch;
+
+extern bool ExecBatchSupportsType(Oid typid, BatchType *type);
+extern TupleBatch *ExecBatchCreate(void);
+extern int	ExecBatchAddColumn(TupleBatch *batch, AttrNumber attnum,
+				   BatchType type);
+extern bool ExecBatchAddQual(TupleBatch *batch, Expr *qual, Index scanrelid);
+extern void ExecBatchAllocate(TupleBatch *batch);
+extern void ExecBatchFilter(TupleBatch *batch);
+
+#endif							/* EXECBATCH_H */
@@ -155,10 +155,18 @@ extern bool ExitOnAnyError;
 extern PGDLLIMPORT char *DataDir;
 
 extern PGDLLIMPORT int NBuffers;
+extern PGDLLIMPORT int transaction_buffers;
+extern PGDLLIMPORT int commit_timestamp_buffers;
+extern PGDLLIMPORT int subtransaction_buffers;
+extern PGDLLIMPORT int multixact_offset_buffers;
+extern PGDLLIMPORT int multixact_member_buffers;
+extern PGDLLIMPORT int notify_buffers;
+extern PGDLLIMPORT int serializable_buffers;
 extern int	MaxBackends;
 extern int	MaxConnections;
 extern int	max_worker_processes;
 extern int	max_parallel_workers;
+extern int	max_parallel_maintenance_workers;
 
 extern PGDLLIMPORT int MyProcPid;
 extern PGDLLIMPORT pg_time_t MyStartTime;
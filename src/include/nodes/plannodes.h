@@ -381,6 +381,9 @@ typedef struct SampleScan
  *
  * indexorderdir specifies the scan ordering, for indexscans on amcanorder
  * indexes (for other indexes it should be "don't care").
+ *
+ * indexskipprefix, if not zero, asks the index AM to do a skip scan over
+ * that many leading index columns (see amskip).
  * ----------------
  */
 typedef struct IndexScan
@@ -393,6 +396,7 @@ typedef struct IndexScan
 	List	   *indexorderbyorig;	/* the same in original form */
 	List	   *indexorderbyops;	/* OIDs of sort ops for ORDER BY exprs */
 	ScanDirection indexorderdir;	/* forward or backward or don't care */
+	int			indexskipprefix;	/* # leading columns to skip, or 0 */
 } IndexScan;
 
 /* ----------------
@@ -410,6 +414,9 @@ typedef struct IndexScan
  * with one TLE per index column.  Vars appearing in this list reference
  * the base table, and this is the only field in the plan node that may
  * contain such Vars.
+ *
+ * If indexskipdistinct is true, only the first tuple for each distinct value
+ * of the leading indexskipprefix columns need be returned.
  * ----------------
  */
 typedef struct IndexOnlyScan
@@ -420,6 +427,8 @@ typedef struct IndexOnlyScan
 	List	   *indexorderby;	/* list of index ORDER BY exprs */
 	List	   *indextlist;		/* TargetEntry list describing index's cols */
 	ScanDirection indexorderdir;	/* forward or backward or don't care */
+	int			indexskipprefix;	/* # leading columns to skip, or 0 */
+	bool		indexskipdistinct;	/* return one tuple per prefix? */
 } IndexOnlyScan;
 
 /* ----------------
@@ -747,6 +756,7 @@ typedef struct Sort
 	Oid		   *sortOperators;	/* OIDs of operators to sort them by */
 	Oid		   *collations;		/* OIDs of collations */
 	bool	   *nullsFirst;		/* NULLS FIRST/LAST directions */
+	bool		shared;			/* may parallel workers share the sort? */
 } Sort;
 
 /* ---------------
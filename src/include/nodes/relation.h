@@ -674,6 +674,7 @@ typedef struct IndexOptInfo
 	bool		amhasgettuple;	/* does AM have amgettuple interface? */
 	bool		amhasgetbitmap; /* does AM have amgetbitmap interface? */
 	bool		amcanparallel;	/* does AM support parallel scan? */
+	bool		amcanskip;		/* does AM support skip scan? */
 	/* Rather than include amapi.h here, we declare amcostestimate like this */
 	void		(*amcostestimate) ();	/* AM's cost estimator */
 } IndexOptInfo;
@@ -1019,6 +1020,11 @@ typedef struct Path
  * NoMovementScanDirection for an indexscan, but the planner wants to
  * distinguish ordered from unordered indexes for building pathkeys.)
  *
+ * 'indexskipprefix' is the number of leading index columns that a skip scan
+ * should skip over (see amskip), or zero for an ordinary index scan.  If
+ * 'indexskipdistinct' is true as well, the scan only needs to return one
+ * tuple per distinct value of those columns, as for SELECT DISTINCT.
+ *
  * 'indextotalcost' and 'indexselectivity' are saved in the IndexPath so that
  * we need not recompute them when considering using the same index in a
  * bitmap index/heap scan (see BitmapHeapPath).  The costs of the IndexPath
@@ -1035,6 +1041,8 @@ typedef struct IndexPath
 	List	   *indexorderbys;
 	List	   *indexorderbycols;
 	ScanDirection indexscandir;
+	int			indexskipprefix;
+	bool		indexskipdistinct;
 	Cost		indextotalcost;
 	Selectivity indexselectivity;
 } IndexPath;
@@ -46,6 +46,7 @@ extern IndexPath *create_index_path(PlannerInfo *root,
 				  List *pathkeys,
 				  ScanDirection indexscandir,
 				  bool indexonly,
+				  int skipprefix,
 				  Relids required_outer,
 				  double loop_count,
 				  bool partial_path);
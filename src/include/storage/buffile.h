@@ -35,6 +35,9 @@ typedef struct BufFile BufFile;
  */
 
 extern BufFile *BufFileCreateTemp(bool interXact);
+extern BufFile *BufFileCreateShared(Oid tblspcOid, const char *name);
+extern BufFile *BufFileOpenShared(Oid tblspcOid, const char *name);
+extern void BufFileDeleteShared(Oid tblspcOid, const char *name);
 extern void BufFileClose(BufFile *file);
 extern size_t BufFileRead(BufFile *file, void *ptr, size_t size);
 extern size_t BufFileWrite(BufFile *file, void *ptr, size_t size);
@@ -67,6 +67,10 @@ extern int	max_safe_fds;
 /* Operations on virtual Files --- equivalent to Unix kernel file ops */
 extern File PathNameOpenFile(FileName fileName, int fileFlags, int fileMode);
 extern File OpenTemporaryFile(bool interXact);
+extern File CreateSharedTemporaryFile(Oid tblspcOid, const char *name);
+extern File OpenSharedTemporaryFile(Oid tblspcOid, const char *name,
+						bool missing_ok);
+extern bool DeleteSharedTemporaryFile(Oid tblspcOid, const char *name);
 extern void FileClose(File file);
 extern int	FilePrefetch(File file, off_t offset, int amount, uint32 wait_event_info);
 extern int	FileRead(File file, char *buffer, int amount, uint32 wait_event_info);
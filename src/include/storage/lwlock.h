@@ -202,6 +202,13 @@ typedef enum BuiltinTrancheIds
 	LWTRANCHE_MXACTMEMBER_BUFFERS,
 	LWTRANCHE_ASYNC_BUFFERS,
 	LWTRANCHE_OLDSERXID_BUFFERS,
+	LWTRANCHE_CLOG_BANK,
+	LWTRANCHE_COMMITTS_BANK,
+	LWTRANCHE_SUBTRANS_BANK,
+	LWTRANCHE_MXACTOFFSET_BANK,
+	LWTRANCHE_MXACTMEMBER_BANK,
+	LWTRANCHE_ASYNC_BANK,
+	LWTRANCHE_OLDSERXID_BANK,
 	LWTRANCHE_WAL_INSERT,
 	LWTRANCHE_BUFFER_CONTENT,
 	LWTRANCHE_BUFFER_IO_IN_PROGRESS,
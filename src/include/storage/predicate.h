@@ -27,10 +27,6 @@ extern int	max_predicate_locks_per_relation;
 extern int	max_predicate_locks_per_page;
 
 
-/* Number of SLRU buffers to use for predicate locking */
-#define NUM_OLDSERXID_BUFFERS	16
-
-
 /*
  * function prototypes
  */
@@ -121,7 +121,9 @@ typedef struct
  *
  * Callers should initialize all fields of GenericCosts to zero.  In addition,
  * they can set numIndexTuples to some positive value if they have a better
- * than default way of estimating the number of leaf index tuples visited.
+ * than default way of estimating the number of leaf index tuples visited,
+ * and num_sa_scans to a value greater than one if the index scan will be
+ * done as several primitive scans for reasons other than ScalarArrayOps.
  */
 typedef struct
 {
@@ -31,6 +31,18 @@
  */
 typedef struct Tuplesortstate Tuplesortstate;
 
+/*
+ * Sharedsort is the state in dynamic shared memory of a sort shared by the
+ * participants of a parallel query; it too is opaque.
+ */
+typedef struct Sharedsort Sharedsort;
+
+struct dsm_segment;
+
+/* GIN build support structs; see access/gin_private.h */
+struct GinState;
+struct GinBuildTuple;
+
 /*
  * Data structures for reporting sort statistics.  Note that
  * TuplesortInstrumentation can't contain any pointers because we
@@ -42,7 +54,8 @@ typedef enum
 	SORT_TYPE_TOP_N_HEAPSORT,
 	SORT_TYPE_QUICKSORT,
 	SORT_TYPE_EXTERNAL_SORT,
-	SORT_TYPE_EXTERNAL_MERGE
+	SORT_TYPE_EXTERNAL_MERGE,
+	SORT_TYPE_PARALLEL_MERGE
 } TuplesortMethod;
 
 typedef enum
@@ -84,6 +97,10 @@ typedef struct TuplesortInstrumentation
  *
  * The "index_hash" API is similar to index_btree, but the tuples are
  * actually sorted by their hash codes not the raw data.
+ *
+ * The "index_gin" API stores/sorts GinBuildTuples, each holding a GIN key
+ * and a list of heap TIDs, ordered the way the GIN index orders its keys.
+ * It is used to combine partial results during parallel GIN builds.
  */
 
 extern Tuplesortstate *tuplesort_begin_heap(TupleDesc tupDesc,
@@ -104,6 +121,11 @@ extern Tuplesortstate *tuplesort_begin_index_hash(Relation heapRel,
 						   uint32 low_mask,
 						   uint32 max_buckets,
 						   int workMem, bool randomAccess);
+extern Tuplesortstate *tuplesort_begin_index_gist(Relation heapRel,
+						   Relation indexRel,
+						   int workMem, bool randomAccess);
+extern Tuplesortstate *tuplesort_begin_index_gin(struct GinState *ginstate,
+						  int workMem, bool randomAccess);
 extern Tuplesortstate *tuplesort_begin_datum(Oid datumType,
 					  Oid sortOperator, Oid sortCollation,
 					  bool nullsFirstFlag,
@@ -111,12 +133,21 @@ extern Tuplesortstate *tuplesort_begin_datum(Oid datumType,
 
 extern void tuplesort_set_bound(Tuplesortstate *state, int64 bound);
 
+extern Size tuplesort_estimate_shared(int nparticipants);
+extern void tuplesort_initialize_shared(Sharedsort *shared, int nparticipants,
+							struct dsm_segment *seg);
+extern void tuplesort_reinitialize_shared(Sharedsort *shared);
+extern bool tuplesort_attach_shared(Tuplesortstate *state,
+						Sharedsort *shared);
+
 extern void tuplesort_puttupleslot(Tuplesortstate *state,
 					   TupleTableSlot *slot);
 extern void tuplesort_putheaptuple(Tuplesortstate *state, HeapTuple tup);
 extern void tuplesort_putindextuplevalues(Tuplesortstate *state,
 							  Relation rel, ItemPointer self,
 							  Datum *values, bool *isnull);
+extern void tuplesort_putgintuple(Tuplesortstate *state,
+					  struct GinBuildTuple *tup);
 extern void tuplesort_putdatum(Tuplesortstate *state, Datum val,
 				   bool isNull);
 
@@ -126,6 +157,8 @@ extern bool tuplesort_gettupleslot(Tuplesortstate *state, bool forward,
 					   bool copy, TupleTableSlot *slot, Datum *abbrev);
 extern HeapTuple tuplesort_getheaptuple(Tuplesortstate *state, bool forward);
 extern IndexTuple tuplesort_getindextuple(Tuplesortstate *state, bool forward);
+extern struct GinBuildTuple *tuplesort_getgintuple(Tuplesortstate *state,
+					  bool forward);
 extern bool tuplesort_getdatum(Tuplesortstate *state, bool forward,
 				   Datum *val, bool *isNull, Datum *abbrev);
 
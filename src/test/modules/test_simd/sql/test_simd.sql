@@ -0,0 +1,22 @@
+CREATE EXTENSION test_simd;
+
+--
+-- test_byte_scan doesn't produce any interesting output; it fails if
+-- byte_scan_find ever disagrees with the obvious byte-at-a-time search.
+--
+SELECT test_byte_scan(1000);
+
+--
+-- The benchmark's timings vary, but both methods must find the same number
+-- of special bytes.
+--
+SELECT bytewise_found, scan_found
+FROM bench_byte_scan(
+	(SELECT string_agg(g || E'\t' || md5(g::text) || E'\\N', E'\n')
+	 FROM generate_series(1, 1000) g),
+	E'\t\n\\', 10);
+
+SELECT bytewise_found, scan_found
+FROM bench_byte_scan(repeat('a', 100), 'b', 10);
+
+SELECT bytewise_found FROM bench_byte_scan('abc', '', 1);
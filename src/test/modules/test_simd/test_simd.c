@@ -0,0 +1,186 @@
+/*--------------------------------------------------------------------------
+ *
+ * test_simd.c
+ *		Test and benchmark the byte scanning functions in port/simd.h.
+ *
+ * Copyright (c) 2017, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *		src/test/modules/test_simd/test_simd.c
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "port/simd.h"
+#include "portability/instr_time.h"
+#include "utils/builtins.h"
+#include "utils/memutils.h"
+
+PG_MODULE_MAGIC;
+
+
+/*
+ * The obvious way to find the first special byte, to check byte_scan_find()
+ * against and to compare its speed with.  This is how COPY's parsing loops
+ * looked at each byte.
+ */
+static int
+bytewise_find(const char *special, int nspecial, const char *s, int len)
+{
+	int			i;
+	int			j;
+
+	for (i = 0; i < len; i++)
+	{
+		for (j = 0; j < nspecial; j++)
+		{
+			if (s[i] == special[j])
+				return i;
+		}
+	}
+	return len;
+}
+
+/*
+ * Check byte_scan_find() on random strings of every length up to size, with
+ * random sets of special bytes.  Special bytes are planted sparsely, at
+ * random positions, so that both the vectorized loop and the byte-at-a-time
+ * tail of byte_scan_find() find some.
+ */
+PG_FUNCTION_INFO_V1(test_byte_scan);
+
+Datum
+test_byte_scan(PG_FUNCTION_ARGS)
+{
+	int			size = PG_GETARG_INT32(0);
+	char	   *buf;
+	int			len;
+
+	if (size <= 0 || size > MaxAllocSize)
+		elog(ERROR, "invalid size for test_byte_scan: %d", size);
+
+	buf = palloc(size);
+
+	for (len = 0; len <= size; len++)
+	{
+		char		special[BYTE_SCAN_MAX_BYTES];
+		int			nspecial = 1 + random() % BYTE_SCAN_MAX_BYTES;
+		ByteScan	scan;
+		int			i;
+		int			expected;
+		int			found;
+
+		for (i = 0; i < nspecial; i++)
+			special[i] = (char) random();
+		for (i = 0; i < len; i++)
+		{
+			if (random() % 64 == 0)
+				buf[i] = special[random() % nspecial];
+			else
+				buf[i] = (char) random();
+		}
+
+		byte_scan_init(&scan, special, nspecial);
+
+		/* Try every starting point, so as to find every special byte */
+		for (i = 0; i <= len; i++)
+		{
+			expected = i + bytewise_find(special, nspecial, buf + i, len - i);
+			found = i + byte_scan_find(&scan, buf + i, len - i);
+			if (found != expected)
+				elog(ERROR, "byte_scan_find found byte %d of %d, expected %d",
+					 found, len, expected);
+		}
+
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	pfree(buf);
+
+	PG_RETURN_VOID();
+}
+
+/*
+ * Count the special bytes in data, the way COPY does: find the next one,
+ * step over it, and repeat.  Returns the count and the time taken, in
+ * milliseconds, for both bytewise_find() and byte_scan_find().
+ */
+PG_FUNCTION_INFO_V1(bench_byte_scan);
+
+Datum
+bench_byte_scan(PG_FUNCTION_ARGS)
+{
+	text	   *data = PG_GETARG_TEXT_PP(0);
+	text	   *special_text = PG_GETARG_TEXT_PP(1);
+	int			loops = PG_GETARG_INT32(2);
+	const char *s = VARDATA_ANY(data);
+	int			len = VARSIZE_ANY_EXHDR(data);
+	const char *special = VARDATA_ANY(special_text);
+	int			nspecial = VARSIZE_ANY_EXHDR(special_text);
+	ByteScan	scan;
+	int64		bytewise_found = 0;
+	int64		scan_found = 0;
+	instr_time	start;
+	instr_time	bytewise_time;
+	instr_time	scan_time;
+	TupleDesc	tupdesc;
+	Datum		values[4];
+	bool		nulls[4];
+	int			loop;
+	int			i;
+
+	if (nspecial < 1 || nspecial > BYTE_SCAN_MAX_BYTES)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("between 1 and %d special bytes must be given",
+						BYTE_SCAN_MAX_BYTES)));
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	INSTR_TIME_SET_CURRENT(start);
+	for (loop = 0; loop < loops; loop++)
+	{
+		for (i = 0;; i++)
+		{
+			i += bytewise_find(special, nspecial, s + i, len - i);
+			if (i >= len)
+				break;
+			bytewise_found++;
+		}
+		CHECK_FOR_INTERRUPTS();
+	}
+	INSTR_TIME_SET_CURRENT(bytewise_time);
+	INSTR_TIME_SUBTRACT(bytewise_time, start);
+
+	byte_scan_init(&scan, special, nspecial);
+
+	INSTR_TIME_SET_CURRENT(start);
+	for (loop = 0; loop < loops; loop++)
+	{
+		for (i = 0;; i++)
+		{
+			i += byte_scan_find(&scan, s + i, len - i);
+			if (i >= len)
+				break;
+			scan_found++;
+		}
+		CHECK_FOR_INTERRUPTS();
+	}
+	INSTR_TIME_SET_CURRENT(scan_time);
+	INSTR_TIME_SUBTRACT(scan_time, start);
+
+	memset(nulls, 0, sizeof(nulls));
+	values[0] = Int64GetDatum(bytewise_found);
+	values[1] = Float8GetDatum(INSTR_TIME_GET_MILLISEC(bytewise_time));
+	values[2] = Int64GetDatum(scan_found);
+	values[3] = Float8GetDatum(INSTR_TIME_GET_MILLISEC(scan_time));
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
@@ -0,0 +1,73 @@
+# Checks for recovery_prefetch_distance
+#
+# The look-ahead reader used for prefetching runs ahead of replay and often
+# reaches the end of the WAL received so far, including the end of a
+# segment after a WAL switch.  Make sure it picks up again from there.
+use strict;
+use warnings;
+
+use PostgresNode;
+use TestLib;
+use Test::More tests => 2;
+
+# Initialize master node
+my $node_master = get_new_node('master');
+$node_master->init(allows_streaming => 1);
+$node_master->start;
+
+# And some content
+$node_master->safe_psql('postgres',
+	"CREATE TABLE tab_int AS SELECT generate_series(1, 10000) AS a");
+
+# Take backup
+my $backup_name = 'my_backup';
+$node_master->backup($backup_name);
+
+# Create streaming standby from backup.  The apply delay keeps replay
+# behind the look-ahead reader, so that it is the one to hit each
+# segment boundary first.
+my $node_standby = get_new_node('standby');
+$node_standby->init_from_backup($node_master, $backup_name,
+	has_streaming => 1);
+$node_standby->append_conf(
+	'postgresql.conf', qq(
+recovery_prefetch_distance = 64MB
+));
+$node_standby->append_conf(
+	'recovery.conf', qq(
+recovery_min_apply_delay = '1s'
+));
+$node_standby->start;
+
+# Generate WAL spread over several segments
+foreach my $i (1 .. 5)
+{
+	$node_master->safe_psql('postgres',
+		"UPDATE tab_int SET a = a + 1 WHERE a % 7 = $i");
+	$node_master->safe_psql('postgres', "SELECT pg_switch_wal()");
+	$node_master->safe_psql('postgres',
+		"INSERT INTO tab_int SELECT generate_series(1, 500)");
+	$node_master->safe_psql('postgres', "SELECT pg_switch_wal()");
+}
+
+# Wait for replay to complete on standby
+my $until_lsn =
+  $node_master->safe_psql('postgres', "SELECT pg_current_wal_lsn()");
+$node_standby->poll_query_until('postgres',
+	"SELECT (pg_last_wal_replay_lsn() - '$until_lsn'::pg_lsn) >= 0")
+  or die "standby never caught up";
+
+my $query    = "SELECT count(*), sum(a) FROM tab_int";
+my $expected = $node_master->safe_psql('postgres', $query);
+is($node_standby->safe_psql('postgres', $query),
+	$expected, 'standby replays switched segments with prefetching');
+
+# Crash recovery of the master replays the same segments
+$node_master->append_conf(
+	'postgresql.conf', qq(
+recovery_prefetch_distance = 256kB
+));
+$node_master->stop('immediate');
+$node_master->start;
+is($node_master->safe_psql('postgres', $query),
+	$expected, 'crash recovery replays switched segments with prefetching');
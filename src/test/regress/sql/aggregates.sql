@@ -824,3 +824,48 @@ create aggregate my_half_sum(int4)
 select my_sum(one),my_half_sum(one) from (values(1),(2),(3),(4)) t(one);
 
 rollback;
+
+--
+-- Test batch execution of plain aggregates over sequential scans
+--
+create temp table batchagg (i2 int2, i4 int4, i8 int8, d date, t text);
+insert into batchagg
+  select case when g % 7 = 0 then null else (g % 100)::int2 end,
+         case when g % 11 = 0 then null else g end,
+         g * 1000000000::int8,
+         date '2000-01-01' + g % 365,
+         case when g % 5 = 0 then null else g::text end
+  from generate_series(1, 3000) g;
+
+select count(*), count(i2), count(t), sum(i2), sum(i4),
+       min(i4), max(i4), min(i8), max(i8),
+       to_char(min(d), 'YYYY-MM-DD') as min_d,
+       to_char(max(d), 'YYYY-MM-DD') as max_d
+  from batchagg;
+select count(*), sum(i4), max(i2) from batchagg where i4 > 1000 and i2 <> 50;
+select count(*), sum(i4), min(i2) from batchagg
+  where 2000 >= i4 and d < '2000-02-01';
+select count(*), max(i4) from batchagg where i8 = 2000000000000;
+-- no rows qualify
+select count(*), count(t), sum(i4), min(i4), max(i8) from batchagg
+  where i4 > 5000;
+-- quals and aggregates that can't be done in batches
+select count(*), sum(i4) from batchagg where i4 % 2 = 0;
+select count(*), sum(i8), avg(i2) from batchagg where i4 < 100;
+-- HAVING is still applied
+select count(*) from batchagg where i2 < 10 having count(*) > 1000;
+-- rescans
+select x, (select count(*) + x from batchagg where i4 >= 2990)
+  from (values (1), (2)) v(x);
+
+-- results must match those without batch execution
+set enable_batch_execution = off;
+select count(*), count(i2), count(t), sum(i2), sum(i4),
+       min(i4), max(i4), min(i8), max(i8),
+       to_char(min(d), 'YYYY-MM-DD') as min_d,
+       to_char(max(d), 'YYYY-MM-DD') as max_d
+  from batchagg;
+select count(*), sum(i4), max(i2) from batchagg where i4 > 1000 and i2 <> 50;
+reset enable_batch_execution;
+
+drop table batchagg;
@@ -460,3 +460,41 @@ VACUUM ANALYZE brin_test;
 EXPLAIN (COSTS OFF) SELECT * FROM brin_test WHERE a = 1;
 -- Ensure brin index is not used when values are not correlated
 EXPLAIN (COSTS OFF) SELECT * FROM brin_test WHERE b = 1;
+
+-- Test minmax-multi and bloom opclasses
+CREATE TABLE brin_multi_bloom (a int, b bigint, c text, d timestamp, e numeric)
+  WITH (fillfactor=10, autovacuum_enabled=false);
+-- mostly correlated data, with outliers in b
+INSERT INTO brin_multi_bloom
+  SELECT i, CASE WHEN i % 100 = 0 THEN 1000000 ELSE i END, md5(i::text),
+         timestamp '2017-01-01' + i * interval '1 minute', i / 3.0
+  FROM generate_series(1, 2000) i;
+CREATE INDEX brin_multi_idx ON brin_multi_bloom USING brin
+  (a int4_minmax_multi_ops, b int8_minmax_multi_ops,
+   d timestamp_minmax_multi_ops, e numeric_minmax_multi_ops)
+  WITH (pages_per_range = 2);
+CREATE INDEX brin_bloom_idx ON brin_multi_bloom USING brin
+  (a int4_bloom_ops, c text_bloom_ops) WITH (pages_per_range = 2);
+-- values added after the index was built
+INSERT INTO brin_multi_bloom VALUES (5, 5, 'five', '2017-01-01', 5);
+INSERT INTO brin_multi_bloom VALUES (NULL, NULL, NULL, NULL, NULL);
+SET enable_seqscan = off;
+SELECT count(*) FROM brin_multi_bloom WHERE a < 10;
+SELECT count(*) FROM brin_multi_bloom WHERE a = 5;
+SELECT count(*) FROM brin_multi_bloom WHERE a = 1234::int8;
+SELECT count(*) FROM brin_multi_bloom WHERE b > 2000;
+SELECT count(*) FROM brin_multi_bloom WHERE b = 1000000;
+SELECT count(*) FROM brin_multi_bloom WHERE b >= 1900 AND b <= 1950;
+SELECT count(*) FROM brin_multi_bloom WHERE b = 42::int4;
+SELECT count(*) FROM brin_multi_bloom WHERE d <= '2017-01-01 00:10';
+SELECT count(*) FROM brin_multi_bloom WHERE e = 100;
+SELECT count(*) FROM brin_multi_bloom WHERE c = md5('1234');
+SELECT count(*) FROM brin_multi_bloom WHERE c = 'five';
+SELECT count(*) FROM brin_multi_bloom WHERE c = 'nope';
+SELECT count(*) FROM brin_multi_bloom WHERE c IS NULL;
+-- summaries rebuilt from scratch must give the same answers
+SELECT brin_desummarize_range('brin_multi_idx', 0);
+SELECT brin_summarize_range('brin_multi_idx', 0);
+SELECT count(*) FROM brin_multi_bloom WHERE a < 10;
+SELECT count(*) FROM brin_multi_bloom WHERE b = 1000000;
+RESET enable_seqscan;
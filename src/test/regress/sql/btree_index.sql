@@ -92,3 +92,42 @@ vacuum btree_tall_tbl;
 -- need to insert some rows to cause the fast root page to split.
 insert into btree_tall_tbl (id, t)
   select g, repeat('x', 100) from generate_series(1, 500) g;
+
+--
+-- Test B-tree skip scans, which handle quals on only the later columns of
+-- an index by doing one scan per distinct value of the leading columns.
+--
+create table btree_skip_tbl (a int, b int);
+insert into btree_skip_tbl select i % 5, i from generate_series(1, 1000) i;
+insert into btree_skip_tbl values (null, 7), (null, 1001);
+create index btree_skip_idx on btree_skip_tbl (a, b);
+vacuum analyze btree_skip_tbl;
+
+set enable_seqscan to false;
+set enable_indexscan to true;
+set enable_bitmapscan to false;
+set enable_indexskipscan to true;
+
+-- few distinct values of a, so a qual on b alone is done by skipping
+explain (costs off)
+select a, b from btree_skip_tbl where b = 7 order by a, b;
+select a, b from btree_skip_tbl where b = 7 order by a, b;
+select a, b from btree_skip_tbl where b between 3 and 6 order by a desc, b desc;
+select count(*) from btree_skip_tbl where b > 990;
+select distinct a from btree_skip_tbl order by a;
+select distinct a from btree_skip_tbl where b > 995 order by a;
+
+-- but not when the leading column is (nearly) unique
+create table btree_noskip_tbl (a int, b int);
+insert into btree_noskip_tbl select i, i % 5 from generate_series(1, 1000) i;
+create index btree_noskip_idx on btree_noskip_tbl (a, b);
+vacuum analyze btree_noskip_tbl;
+explain (costs off)
+select a, b from btree_noskip_tbl where b = 3;
+drop table btree_noskip_tbl;
+
+reset enable_seqscan;
+reset enable_indexscan;
+reset enable_bitmapscan;
+reset enable_indexskipscan;
+drop table btree_skip_tbl;
@@ -0,0 +1,56 @@
+--
+-- Per-column TOAST compression methods
+--
+
+-- ensure we start from the default
+SET default_toast_compression = 'pglz';
+SHOW default_toast_compression;
+
+CREATE TABLE cmdata (f1 text COMPRESSION pglz, f2 text);
+SELECT attname, attcompression FROM pg_attribute
+  WHERE attrelid = 'cmdata'::regclass AND attnum > 0 ORDER BY attnum;
+
+INSERT INTO cmdata VALUES (repeat('1234567890', 1000), repeat('1234567890', 1000));
+INSERT INTO cmdata VALUES ('short', 'short');
+SELECT pg_column_compression(f1) AS f1, pg_column_compression(f2) AS f2,
+       pg_column_size(f1) < length(f1) AS f1_compressed
+  FROM cmdata ORDER BY length(f1) DESC;
+SELECT length(f1), substr(f1, 9991) FROM cmdata ORDER BY length(f1) DESC;
+
+-- non-varlena and null values
+SELECT pg_column_compression(42) AS int4, pg_column_compression(NULL::text) AS nulltext;
+
+-- invalid settings
+CREATE TABLE cmbad (f1 int COMPRESSION pglz);
+CREATE TABLE cmbad (f1 text COMPRESSION nosuchmethod);
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION nosuchmethod;
+
+-- change and reset the per-column setting
+ALTER TABLE cmdata ALTER COLUMN f2 SET COMPRESSION pglz;
+ALTER TABLE cmdata ALTER COLUMN f1 SET COMPRESSION DEFAULT;
+SELECT attname, attcompression FROM pg_attribute
+  WHERE attrelid = 'cmdata'::regclass AND attnum > 0 ORDER BY attnum;
+
+-- existing values are unaffected
+SELECT pg_column_compression(f1) AS f1, pg_column_compression(f2) AS f2
+  FROM cmdata ORDER BY length(f1) DESC;
+
+-- LIKE INCLUDING STORAGE copies the compression method
+CREATE TABLE cmlike (LIKE cmdata INCLUDING STORAGE);
+CREATE TABLE cmnolike (LIKE cmdata);
+SELECT attrelid::regclass, attname, attcompression FROM pg_attribute
+  WHERE attrelid IN ('cmlike'::regclass, 'cmnolike'::regclass) AND attnum > 0
+  ORDER BY attrelid::regclass::text, attnum;
+
+-- inheritance merges compatible settings and rejects conflicting ones
+CREATE TABLE cmchild (f2 text COMPRESSION pglz) INHERITS (cmdata);
+CREATE TABLE cmchild2 (f2 text COMPRESSION DEFAULT) INHERITS (cmdata);
+
+-- ALTER TYPE to a type that can't be compressed clears the setting
+CREATE TABLE cmint (f1 text COMPRESSION pglz);
+ALTER TABLE cmint ALTER COLUMN f1 TYPE int USING length(f1);
+SELECT attcompression FROM pg_attribute
+  WHERE attrelid = 'cmint'::regclass AND attname = 'f1';
+
+RESET default_toast_compression;
+DROP TABLE cmchild, cmdata, cmlike, cmnolike, cmint;
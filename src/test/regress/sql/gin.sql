@@ -34,3 +34,28 @@ insert into gin_test_tbl select array[1, 3, g] from generate_series(1, 1000) g;
 
 delete from gin_test_tbl where i @> array[2];
 vacuum gin_test_tbl;
+
+-- Test parallel index build.  Whether or not any workers could actually be
+-- launched, the results must match those of a sequential scan.
+create table gin_parallel_tbl(i int4[])
+  with (parallel_workers = 2, autovacuum_enabled = off);
+insert into gin_parallel_tbl select array[g % 100, g % 7, g] from generate_series(1, 20000) g;
+insert into gin_parallel_tbl select '{}' from generate_series(1, 100) g;
+insert into gin_parallel_tbl select null from generate_series(1, 100) g;
+
+set max_parallel_maintenance_workers = 2;
+create index gin_parallel_idx on gin_parallel_tbl using gin (i);
+
+set enable_seqscan = off;
+select count(*) from gin_parallel_tbl where i @> array[5];
+select count(*) from gin_parallel_tbl where i && array[42, 10001];
+select count(*) from gin_parallel_tbl where i <@ array[1, 2, 3, 4, 5, 6, 7, 8, 9];
+
+drop index gin_parallel_idx;
+create index concurrently gin_parallel_idx on gin_parallel_tbl using gin (i);
+select count(*) from gin_parallel_tbl where i @> array[5];
+select count(*) from gin_parallel_tbl where i && array[42, 10001];
+
+reset enable_seqscan;
+reset max_parallel_maintenance_workers;
+drop table gin_parallel_tbl;
@@ -114,6 +114,17 @@ and p <@ box(point(5,5), point(6, 6));
 
 drop index gist_tbl_multi_index;
 
+-- Test sorted build. The point opclass has a sortsupport function, so this
+-- index is built by sorting the tuples and packing them bottom-up. Check
+-- that it finds the same rows as an index built by insertion.
+create index gist_tbl_point_index on gist_tbl using gist (p) with (fillfactor = 50);
+select count(*) from gist_tbl where p <@ box(point(9.99,9.99), point(20.01,20.01));
+drop index gist_tbl_point_index;
+
+create index gist_tbl_point_index on gist_tbl using gist (p) with (buffering = on);
+select count(*) from gist_tbl where p <@ box(point(9.99,9.99), point(20.01,20.01));
+drop index gist_tbl_point_index;
+
 -- Clean up
 reset enable_seqscan;
 reset enable_bitmapscan;
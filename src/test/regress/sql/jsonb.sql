@@ -1056,3 +1056,40 @@ select ts_headline('english', '{"a": "aaa bbb", "b": {"c": "ccc ddd fff", "c1":
 select ts_headline('null'::jsonb, tsquery('aaa & bbb'));
 select ts_headline('{}'::jsonb, tsquery('aaa & bbb'));
 select ts_headline('[]'::jsonb, tsquery('aaa & bbb'));
+
+-- key lookups in toasted objects fetch only the parts they need
+CREATE TABLE testjsonbtoast (c jsonb, e jsonb);
+ALTER TABLE testjsonbtoast ALTER COLUMN e SET STORAGE external;
+INSERT INTO testjsonbtoast
+  SELECT j, j FROM (SELECT jsonb_object_agg('k' || i,
+      CASE i % 4
+        WHEN 0 THEN to_jsonb(repeat(md5(i::text), 3))
+        WHEN 1 THEN to_jsonb(i * 1.5)
+        WHEN 2 THEN jsonb_build_object('n', i, 'a', jsonb_build_array(i, null, true))
+        ELSE 'null'::jsonb
+      END) AS j
+    FROM generate_series(1, 3000) i) s;
+SELECT pg_column_compression(c) AS c, pg_column_compression(e) AS e
+  FROM testjsonbtoast;
+SELECT k, jsonb_typeof(c -> k) AS type, length(c ->> k) AS len,
+       c ? k AS has_key, (c -> k) = (e -> k) AS same_e,
+       (c -> k) = (c::text::jsonb -> k) AS same_full
+  FROM testjsonbtoast,
+       unnest(array['k1', 'k2', 'k3', 'k4', 'k2999', 'k3000', 'k0', 'nokey'])
+       WITH ORDINALITY AS u(k, n)
+  ORDER BY n;
+SELECT c -> 'k2', e ->> 'k3001', e ? 'k1' FROM testjsonbtoast;
+DROP TABLE testjsonbtoast;
+-- few keys, and values both within the first toast chunk and spanning
+-- several of them
+CREATE TABLE testjsonbtoast (e jsonb);
+ALTER TABLE testjsonbtoast ALTER COLUMN e SET STORAGE external;
+INSERT INTO testjsonbtoast
+  SELECT jsonb_build_object('0', 'short', '1', 1.5, 'a', repeat('x', 5000),
+      'b', 2.5, 'c', jsonb_build_array(repeat('y', 6000), 2), 'd', true);
+SELECT pg_column_compression(e), pg_column_size(e) > 11000 AS big
+  FROM testjsonbtoast;
+SELECT e -> '0', e -> '1', length(e ->> 'a'), e -> 'b',
+       length(e -> 'c' ->> 0), e -> 'c' -> 1, e -> 'd', e -> 'e', e ? 'c'
+  FROM testjsonbtoast;
+DROP TABLE testjsonbtoast;
@@ -162,6 +162,19 @@ explain (costs off)
 
 select fivethous from tenk1 order by fivethous limit 4;
 
+-- gather merge test of a sort shared by the workers, with runs on disk
+set work_mem = '64kB';
+explain (costs off)
+  select ten, unique1 from tenk1 order by ten, unique1 desc;
+select count(*),
+  count(*) filter (where prev_ten > ten or
+                   (prev_ten = ten and prev_unique1 < unique1)) as out_of_order
+from (select ten, unique1, lag(ten) over () as prev_ten,
+        lag(unique1) over () as prev_unique1
+      from (select ten, unique1 from tenk1
+            order by ten, unique1 desc offset 0) s) s;
+reset work_mem;
+
 -- gather merge test with 0 worker
 set max_parallel_workers = 0;
 explain (costs off)
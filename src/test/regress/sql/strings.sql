@@ -366,6 +366,36 @@ SELECT substr(f1, 99995) from toasttest;
 -- string length
 SELECT substr(f1, 99995, 10) from toasttest;
 
+-- Slices of compressed values are decompressed only as far as needed
+SELECT substr(f1, 50001, 10), substr(f1, 1, 3) from toasttest;
+
+DROP TABLE toasttest;
+
+-- Values compressed out of line are fetched only as far as needed
+CREATE TABLE toasttest(f1 text);
+INSERT INTO toasttest
+  SELECT string_agg(repeat(md5(i::text), 3), '' ORDER BY i)
+  FROM generate_series(1, 1000) i;
+SELECT pg_column_compression(f1), length(f1) FROM toasttest;
+SELECT substr(f1, 1, 10) = substr(md5('1'), 1, 10) AS start,
+       substr(f1, 48001, 96) = repeat(md5('501'), 3) AS middle,
+       substr(f1, 95905) = repeat(md5('1000'), 3) AS tail
+  FROM toasttest;
+DROP TABLE toasttest;
+
+-- Repeated detoasting of the same value within a query is served from
+-- the TOAST value cache; make sure updates are seen
+CREATE TABLE toasttest(id int, f1 text);
+ALTER TABLE toasttest ALTER COLUMN f1 SET STORAGE external;
+INSERT INTO toasttest VALUES (1, repeat('1234567890', 10000));
+SELECT g, length(f1), right(f1, 3) FROM toasttest, generate_series(1, 3) g;
+BEGIN;
+UPDATE toasttest SET f1 = repeat('abcdefghij', 10000) WHERE id = 1;
+SELECT g, length(f1), right(f1, 3) FROM toasttest, generate_series(1, 3) g;
+ROLLBACK;
+SET toast_cache_size = 0;
+SELECT g, length(f1), right(f1, 3) FROM toasttest, generate_series(1, 3) g;
+RESET toast_cache_size;
 DROP TABLE toasttest;
 
 --
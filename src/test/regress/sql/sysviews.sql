@@ -32,6 +32,10 @@ select count(*) = 0 as ok from pg_prepared_statements;
 -- See also prepared_xacts.sql
 select count(*) >= 0 as ok from pg_prepared_xacts;
 
+-- There will surely be at least one SLRU cache, and only one "other" entry
+select count(*) > 0 as ok from pg_stat_slru;
+select count(*) = 1 as ok from pg_stat_slru where name = 'other';
+
 -- This is to record the prevailing planner enable_foo settings during
 -- a regression test run.
 select name, setting from pg_settings where name like 'enable%';
@@ -0,0 +1,40 @@
+--
+-- TUPLE_DEFORM
+--
+-- Leading fixed-width columns of a tuple are fetched straight from their
+-- cached offsets when the null bitmap allows it.
+--
+
+-- tables with fixed-width leading columns, with and without nulls, and
+-- with dropped and added columns
+create table fixed_prefix (a int2 not null, b int8 not null, c int4, d int8,
+  e float8, f text, g int4);
+insert into fixed_prefix values (1, 2, 3, 4, 5.5, 'six', 7),
+  (1, 2, null, 4, 5.5, 'six', 7), (1, 2, 3, null, null, null, 7);
+select * from fixed_prefix;
+select e, d, a from fixed_prefix;
+alter table fixed_prefix drop column c;
+alter table fixed_prefix add column h int2;
+update fixed_prefix set h = 8 where d is null;
+select * from fixed_prefix;
+select h, d from fixed_prefix;
+drop table fixed_prefix;
+
+-- composite values of a table's rowtype use the table's descriptor, but can
+-- have nulls in its NOT NULL columns
+create table notnull_row (a int4 not null, b int8 not null, c int4);
+select row(null, 2, 3)::notnull_row as r;
+select (row(null, 2, 3)::notnull_row).*;
+select (row(1, null, 3)::notnull_row).c;
+create table notnull_row_holder (r notnull_row);
+insert into notnull_row_holder values (row(null, 2, 3)), (row(4, null, 6)),
+  (row(7, 8, 9));
+select r, (r).a, (r).b, (r).c from notnull_row_holder;
+drop table notnull_row_holder;
+drop table notnull_row;
+
+-- partition routing reads the key before NOT NULL constraints are checked
+create table notnull_parted (a int4 not null, b int4) partition by list (b);
+create table notnull_parted_2 partition of notnull_parted for values in (2);
+insert into notnull_parted values (null, 2);
+drop table notnull_parted;
@@ -0,0 +1,164 @@
+--
+-- TUPLESORT
+--
+-- In-memory sorts of enough tuples on a leading key that sorts as an
+-- integer use radix sort; sorts on several keys use multi-key quicksort.
+-- Check that both put everything in order.
+--
+
+CREATE TEMP TABLE sort_test AS
+SELECT i AS id,
+  CASE WHEN i % 13 = 0 THEN NULL ELSE (i * 7919) % 10007 - 5000 END AS i4,
+  ((i * 7919) % 10007)::int8 * 1000000007 - 5000000000000 AS i8,
+  (i % 3)::int2 AS i2,
+  CASE WHEN i = 20000 THEN 1 ELSE i END AS uniq,
+  (i * 31) % 1000 AS grp,
+  '2017-01-01'::timestamp + ((i * 7919) % 10007) * interval '1 minute' AS ts,
+  substr(md5((i % 3000)::text), 1, 6) || md5(i::text) AS t
+FROM generate_series(1, 20000) i;
+
+-- single key, ascending with NULLs last, and descending with NULLs first
+SELECT count(*),
+  count(*) FILTER (WHERE rn > 1 AND
+    ((prev IS NULL AND i4 IS NOT NULL) OR prev > i4)) AS out_of_order
+FROM (SELECT i4, lag(i4) OVER () AS prev, row_number() OVER () AS rn
+      FROM (SELECT i4 FROM sort_test ORDER BY i4 OFFSET 0) s) s;
+
+SELECT count(*),
+  count(*) FILTER (WHERE rn > 1 AND
+    ((prev IS NOT NULL AND i4 IS NULL) OR prev < i4)) AS out_of_order
+FROM (SELECT i4, lag(i4) OVER () AS prev, row_number() OVER () AS rn
+      FROM (SELECT i4 FROM sort_test ORDER BY i4 DESC OFFSET 0) s) s;
+
+SELECT count(*),
+  count(*) FILTER (WHERE rn > 1 AND
+    ((prev IS NULL AND i4 IS NOT NULL) OR prev < i4)) AS out_of_order
+FROM (SELECT i4, lag(i4) OVER () AS prev, row_number() OVER () AS rn
+      FROM (SELECT i4 FROM sort_test ORDER BY i4 DESC NULLS LAST OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev > i8) AS out_of_order
+FROM (SELECT i8, lag(i8) OVER () AS prev
+      FROM (SELECT i8 FROM sort_test ORDER BY i8 OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev < ts) AS out_of_order
+FROM (SELECT ts, lag(ts) OVER () AS prev
+      FROM (SELECT ts FROM sort_test ORDER BY ts DESC OFFSET 0) s) s;
+
+-- abbreviated keys, many of which are equal
+SELECT count(*), count(*) FILTER (WHERE prev > t) AS out_of_order
+FROM (SELECT t, lag(t) OVER () AS prev
+      FROM (SELECT t COLLATE "C" AS t FROM sort_test ORDER BY 1 OFFSET 0) s) s;
+
+-- Datum sorts
+SELECT count(*),
+  count(*) FILTER (WHERE i > 1 AND a[i - 1] > a[i]) AS out_of_order
+FROM (SELECT array_agg(i8 ORDER BY i8) AS a FROM sort_test) s,
+  generate_subscripts(a, 1) i;
+
+-- several keys, with the leading one radix sorted or not
+SELECT count(*),
+  count(*) FILTER (WHERE rn > 1 AND
+    (prev_i2 > i2 OR (prev_i2 = i2 AND prev_grp < grp) OR
+     (prev_i2 = i2 AND prev_grp = grp AND prev_id > id))) AS out_of_order
+FROM (SELECT i2, grp, id, lag(i2) OVER () AS prev_i2,
+        lag(grp) OVER () AS prev_grp, lag(id) OVER () AS prev_id,
+        row_number() OVER () AS rn
+      FROM (SELECT i2, grp, id FROM sort_test
+            ORDER BY i2, grp DESC, id OFFSET 0) s) s;
+
+SELECT count(*),
+  count(*) FILTER (WHERE rn > 1 AND
+    (prev_t > t OR (prev_t = t AND prev_id < id))) AS out_of_order
+FROM (SELECT t, id, lag(t) OVER () AS prev_t, lag(id) OVER () AS prev_id,
+        row_number() OVER () AS rn
+      FROM (SELECT substr(t, 1, 6) COLLATE "C" AS t, id FROM sort_test
+            ORDER BY 1, id DESC OFFSET 0) s) s;
+
+SELECT count(*),
+  count(*) FILTER (WHERE rn > 1 AND
+    (prev_grp > grp OR (prev_grp = grp AND prev_t > t))) AS out_of_order
+FROM (SELECT grp, t, lag(grp) OVER () AS prev_grp, lag(t) OVER () AS prev_t,
+        row_number() OVER () AS rn
+      FROM (SELECT grp, t COLLATE "C" AS t FROM sort_test
+            ORDER BY 1, 2 OFFSET 0) s) s;
+
+-- index builds; duplicates must still be found
+CREATE INDEX sort_test_i8_idx ON sort_test (i8);
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SELECT count(*), count(*) FILTER (WHERE prev > i8) AS out_of_order
+FROM (SELECT i8, lag(i8) OVER () AS prev
+      FROM (SELECT i8 FROM sort_test WHERE i8 > -10000000000000
+            ORDER BY i8 OFFSET 0) s) s;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+CREATE UNIQUE INDEX sort_test_id_idx ON sort_test (id);
+CREATE UNIQUE INDEX sort_test_uniq_idx ON sort_test (uniq);
+
+-- types with sort support of their own, abbreviated or not
+CREATE TEMP TABLE sort_types AS
+SELECT id,
+  CASE WHEN id % 5 = 0
+    THEN ('2001:db8:' || to_hex(grp) || '::' || to_hex(id) || '/' ||
+          48 + id % 81)::inet
+    ELSE ('10.' || grp % 256 || '.' || id % 256 || '.' || id / 256 || '/' ||
+          id % 33)::inet
+  END AS ip,
+  i4 * interval '1 day' + (id % 1000) * interval '1 second' +
+    (grp % 12) * interval '1 month' AS iv,
+  int4range(i4, i4 + grp) AS r,
+  ARRAY[i2::int, grp % 7, i4] AS a,
+  ARRAY[substr(t, 1, 1), substr(t, 2)] AS ta,
+  CASE id % 6
+    WHEN 0 THEN to_jsonb(i4)
+    WHEN 1 THEN to_jsonb(substr(t, 1, 3))
+    WHEN 2 THEN to_jsonb(i2 = 1)
+    WHEN 3 THEN jsonb_build_object(substr(t, 1, 2), grp)
+    WHEN 4 THEN jsonb_build_object(substr(t, 1, 1), i2, 'x', id)
+    ELSE jsonb_build_array(i2, grp)
+  END AS j
+FROM sort_test;
+
+SELECT count(*), count(*) FILTER (WHERE prev > ip) AS out_of_order
+FROM (SELECT ip, lag(ip) OVER () AS prev
+      FROM (SELECT ip FROM sort_types ORDER BY ip OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev > iv) AS out_of_order
+FROM (SELECT iv, lag(iv) OVER () AS prev
+      FROM (SELECT iv FROM sort_types ORDER BY iv OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev > r) AS out_of_order
+FROM (SELECT r, lag(r) OVER () AS prev
+      FROM (SELECT r FROM sort_types ORDER BY r OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev > a) AS out_of_order
+FROM (SELECT a, lag(a) OVER () AS prev
+      FROM (SELECT a FROM sort_types ORDER BY a OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev > ta) AS out_of_order
+FROM (SELECT ta, lag(ta) OVER () AS prev
+      FROM (SELECT ta FROM sort_types ORDER BY ta OFFSET 0) s) s;
+
+SELECT count(*), count(*) FILTER (WHERE prev > j) AS out_of_order
+FROM (SELECT j, lag(j) OVER () AS prev
+      FROM (SELECT j FROM sort_types ORDER BY j OFFSET 0) s) s;
+
+CREATE INDEX sort_types_ip_idx ON sort_types (ip);
+CREATE INDEX sort_types_r_idx ON sort_types (r);
+CREATE INDEX sort_types_a_idx ON sort_types (a);
+CREATE INDEX sort_types_j_idx ON sort_types (j);
+SET enable_seqscan = off;
+SET enable_bitmapscan = off;
+SELECT count(*), count(*) FILTER (WHERE prev > j) AS out_of_order
+FROM (SELECT j, lag(j) OVER () AS prev
+      FROM (SELECT j FROM sort_types WHERE j IS NOT NULL
+            ORDER BY j OFFSET 0) s) s;
+SELECT count(*), count(*) FILTER (WHERE prev > ip) AS out_of_order
+FROM (SELECT ip, lag(ip) OVER () AS prev
+      FROM (SELECT ip FROM sort_types WHERE ip IS NOT NULL
+            ORDER BY ip OFFSET 0) s) s;
+RESET enable_seqscan;
+RESET enable_bitmapscan;
+DROP TABLE sort_types;
+
+DROP TABLE sort_test;
@@ -0,0 +1,35 @@
+/*-------------------------------------------------------------------------
+ *
+ * xlogprefetch.h
+ *		Declarations for the recovery prefetching module.
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/access/xlogprefetch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef XLOGPREFETCH_H
+#define XLOGPREFETCH_H
+
+#include "access/xlogdefs.h"
+
+/* GUC variable */
+extern int	recovery_prefetch_distance;
+
+#ifdef USE_PREFETCH
+#define DEFAULT_RECOVERY_PREFETCH_DISTANCE	256		/* kB */
+#else
+#define DEFAULT_RECOVERY_PREFETCH_DISTANCE	0
+#endif
+
+typedef struct XLogPrefetcher XLogPrefetcher;
+
+extern XLogPrefetcher *XLogPrefetcherAllocate(void);
+extern void XLogPrefetcherFree(XLogPrefetcher *prefetcher);
+extern void XLogPrefetcherReadAhead(XLogPrefetcher *prefetcher,
+						XLogRecPtr replayLSN, XLogRecPtr readUpto,
+						TimeLineID tli);
+
+#endif							/* XLOGPREFETCH_H */
@@ -0,0 +1,590 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_BASE_YY_GRAM_H_INCLUDED
+# define YY_BASE_YY_GRAM_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int base_yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENT = 258,                   /* IDENT  */
+    FCONST = 259,                  /* FCONST  */
+    SCONST = 260,                  /* SCONST  */
+    BCONST = 261,                  /* BCONST  */
+    XCONST = 262,                  /* XCONST  */
+    Op = 263,                      /* Op  */
+    ICONST = 264,                  /* ICONST  */
+    PARAM = 265,                   /* PARAM  */
+    TYPECAST = 266,                /* TYPECAST  */
+    DOT_DOT = 267,                 /* DOT_DOT  */
+    COLON_EQUALS = 268,            /* COLON_EQUALS  */
+    EQUALS_GREATER = 269,          /* EQUALS_GREATER  */
+    LESS_EQUALS = 270,             /* LESS_EQUALS  */
+    GREATER_EQUALS = 271,          /* GREATER_EQUALS  */
+    NOT_EQUALS = 272,              /* NOT_EQUALS  */
+    ABORT_P = 273,                 /* ABORT_P  */
+    ABSOLUTE_P = 274,              /* ABSOLUTE_P  */
+    ACCESS = 275,                  /* ACCESS  */
+    ACTION = 276,                  /* ACTION  */
+    ADD_P = 277,                   /* ADD_P  */
+    ADMIN = 278,                   /* ADMIN  */
+    AFTER = 279,                   /* AFTER  */
+    AGGREGATE = 280,               /* AGGREGATE  */
+    ALL = 281,                     /* ALL  */
+    ALSO = 282,                    /* ALSO  */
+    ALTER = 283,                   /* ALTER  */
+    ALWAYS = 284,                  /* ALWAYS  */
+    ANALYSE = 285,                 /* ANALYSE  */
+    ANALYZE = 286,                 /* ANALYZE  */
+    AND = 287,                     /* AND  */
+    ANY = 288,                     /* ANY  */
+    ARRAY = 289,                   /* ARRAY  */
+    AS = 290,                      /* AS  */
+    ASC = 291,                     /* ASC  */
+    ASSERTION = 292,               /* ASSERTION  */
+    ASSIGNMENT = 293,              /* ASSIGNMENT  */
+    ASYMMETRIC = 294,              /* ASYMMETRIC  */
+    AT = 295,                      /* AT  */
+    ATTACH = 296,                  /* ATTACH  */
+    ATTRIBUTE = 297,               /* ATTRIBUTE  */
+    AUTHORIZATION = 298,           /* AUTHORIZATION  */
+    BACKWARD = 299,                /* BACKWARD  */
+    BEFORE = 300,                  /* BEFORE  */
+    BEGIN_P = 301,                 /* BEGIN_P  */
+    BETWEEN = 302,                 /* BETWEEN  */
+    BIGINT = 303,                  /* BIGINT  */
+    BINARY = 304,                  /* BINARY  */
+    BIT = 305,                     /* BIT  */
+    BOOLEAN_P = 306,               /* BOOLEAN_P  */
+    BOTH = 307,                    /* BOTH  */
+    BY = 308,                      /* BY  */
+    CACHE = 309,                   /* CACHE  */
+    CALLED = 310,                  /* CALLED  */
+    CASCADE = 311,                 /* CASCADE  */
+    CASCADED = 312,                /* CASCADED  */
+    CASE = 313,                    /* CASE  */
+    CAST = 314,                    /* CAST  */
+    CATALOG_P = 315,               /* CATALOG_P  */
+    CHAIN = 316,                   /* CHAIN  */
+    CHAR_P = 317,                  /* CHAR_P  */
+    CHARACTER = 318,               /* CHARACTER  */
+    CHARACTERISTICS = 319,         /* CHARACTERISTICS  */
+    CHECK = 320,                   /* CHECK  */
+    CHECKPOINT = 321,              /* CHECKPOINT  */
+    CLASS = 322,                   /* CLASS  */
+    CLOSE = 323,                   /* CLOSE  */
+    CLUSTER = 324,                 /* CLUSTER  */
+    COALESCE = 325,                /* COALESCE  */
+    COLLATE = 326,                 /* COLLATE  */
+    COLLATION = 327,               /* COLLATION  */
+    COLUMN = 328,                  /* COLUMN  */
+    COLUMNS = 329,                 /* COLUMNS  */
+    COMMENT = 330,                 /* COMMENT  */
+    COMMENTS = 331,                /* COMMENTS  */
+    COMMIT = 332,                  /* COMMIT  */
+    COMMITTED = 333,               /* COMMITTED  */
+    COMPRESSION = 334,             /* COMPRESSION  */
+    CONCURRENTLY = 335,            /* CONCURRENTLY  */
+    CONFIGURATION = 336,           /* CONFIGURATION  */
+    CONFLICT = 337,                /* CONFLICT  */
+    CONNECTION = 338,              /* CONNECTION  */
+    CONSTRAINT = 339,              /* CONSTRAINT  */
+    CONSTRAINTS = 340,             /* CONSTRAINTS  */
+    CONTENT_P = 341,               /* CONTENT_P  */
+    CONTINUE_P = 342,              /* CONTINUE_P  */
+    CONVERSION_P = 343,            /* CONVERSION_P  */
+    COPY = 344,                    /* COPY  */
+    COST = 345,                    /* COST  */
+    CREATE = 346,                  /* CREATE  */
+    CROSS = 347,                   /* CROSS  */
+    CSV = 348,                     /* CSV  */
+    CUBE = 349,                    /* CUBE  */
+    CURRENT_P = 350,               /* CURRENT_P  */
+    CURRENT_CATALOG = 351,         /* CURRENT_CATALOG  */
+    CURRENT_DATE = 352,            /* CURRENT_DATE  */
+    CURRENT_ROLE = 353,            /* CURRENT_ROLE  */
+    CURRENT_SCHEMA = 354,          /* CURRENT_SCHEMA  */
+    CURRENT_TIME = 355,            /* CURRENT_TIME  */
+    CURRENT_TIMESTAMP = 356,       /* CURRENT_TIMESTAMP  */
+    CURRENT_USER = 357,            /* CURRENT_USER  */
+    CURSOR = 358,                  /* CURSOR  */
+    CYCLE = 359,                   /* CYCLE  */
+    DATA_P = 360,                  /* DATA_P  */
+    DATABASE = 361,                /* DATABASE  */
+    DAY_P = 362,                   /* DAY_P  */
+    DEALLOCATE = 363,              /* DEALLOCATE  */
+    DEC = 364,                     /* DEC  */
+    DECIMAL_P = 365,               /* DECIMAL_P  */
+    DECLARE = 366,                 /* DECLARE  */
+    DEFAULT = 367,                 /* DEFAULT  */
+    DEFAULTS = 368,                /* DEFAULTS  */
+    DEFERRABLE = 369,              /* DEFERRABLE  */
+    DEFERRED = 370,                /* DEFERRED  */
+    DEFINER = 371,                 /* DEFINER  */
+    DELETE_P = 372,                /* DELETE_P  */
+    DELIMITER = 373,               /* DELIMITER  */
+    DELIMITERS = 374,              /* DELIMITERS  */
+    DEPENDS = 375,                 /* DEPENDS  */
+    DESC = 376,                    /* DESC  */
+    DETACH = 377,                  /* DETACH  */
+    DICTIONARY = 378,              /* DICTIONARY  */
+    DISABLE_P = 379,               /* DISABLE_P  */
+    DISCARD = 380,                 /* DISCARD  */
+    DISTINCT = 381,                /* DISTINCT  */
+    DO = 382,                      /* DO  */
+    DOCUMENT_P = 383,              /* DOCUMENT_P  */
+    DOMAIN_P = 384,                /* DOMAIN_P  */
+    DOUBLE_P = 385,                /* DOUBLE_P  */
+    DROP = 386,                    /* DROP  */
+    EACH = 387,                    /* EACH  */
+    ELSE = 388,                    /* ELSE  */
+    ENABLE_P = 389,                /* ENABLE_P  */
+    ENCODING = 390,                /* ENCODING  */
+    ENCRYPTED = 391,               /* ENCRYPTED  */
+    END_P = 392,                   /* END_P  */
+    ENUM_P = 393,                  /* ENUM_P  */
+    ESCAPE = 394,                  /* ESCAPE  */
+    EVENT = 395,                   /* EVENT  */
+    EXCEPT = 396,                  /* EXCEPT  */
+    EXCLUDE = 397,                 /* EXCLUDE  */
+    EXCLUDING = 398,               /* EXCLUDING  */
+    EXCLUSIVE = 399,               /* EXCLUSIVE  */
+    EXECUTE = 400,                 /* EXECUTE  */
+    EXISTS = 401,                  /* EXISTS  */
+    EXPLAIN = 402,                 /* EXPLAIN  */
+    EXTENSION = 403,               /* EXTENSION  */
+    EXTERNAL = 404,                /* EXTERNAL  */
+    EXTRACT = 405,                 /* EXTRACT  */
+    FALSE_P = 406,                 /* FALSE_P  */
+    FAMILY = 407,                  /* FAMILY  */
+    FETCH = 408,                   /* FETCH  */
+    FILTER = 409,                  /* FILTER  */
+    FIRST_P = 410,                 /* FIRST_P  */
+    FLOAT_P = 411,                 /* FLOAT_P  */
+    FOLLOWING = 412,               /* FOLLOWING  */
+    FOR = 413,                     /* FOR  */
+    FORCE = 414,                   /* FORCE  */
+    FOREIGN = 415,                 /* FOREIGN  */
+    FORWARD = 416,                 /* FORWARD  */
+    FREEZE = 417,                  /* FREEZE  */
+    FROM = 418,                    /* FROM  */
+    FULL = 419,                    /* FULL  */
+    FUNCTION = 420,                /* FUNCTION  */
+    FUNCTIONS = 421,               /* FUNCTIONS  */
+    GENERATED = 422,               /* GENERATED  */
+    GLOBAL = 423,                  /* GLOBAL  */
+    GRANT = 424,                   /* GRANT  */
+    GRANTED = 425,                 /* GRANTED  */
+    GREATEST = 426,                /* GREATEST  */
+    GROUP_P = 427,                 /* GROUP_P  */
+    GROUPING = 428,                /* GROUPING  */
+    HANDLER = 429,                 /* HANDLER  */
+    HAVING = 430,                  /* HAVING  */
+    HEADER_P = 431,                /* HEADER_P  */
+    HOLD = 432,                    /* HOLD  */
+    HOUR_P = 433,                  /* HOUR_P  */
+    IDENTITY_P = 434,              /* IDENTITY_P  */
+    IF_P = 435,                    /* IF_P  */
+    ILIKE = 436,                   /* ILIKE  */
+    IMMEDIATE = 437,               /* IMMEDIATE  */
+    IMMUTABLE = 438,               /* IMMUTABLE  */
+    IMPLICIT_P = 439,              /* IMPLICIT_P  */
+    IMPORT_P = 440,                /* IMPORT_P  */
+    IN_P = 441,                    /* IN_P  */
+    INCLUDING = 442,               /* INCLUDING  */
+    INCREMENT = 443,               /* INCREMENT  */
+    INDEX = 444,                   /* INDEX  */
+    INDEXES = 445,                 /* INDEXES  */
+    INHERIT = 446,                 /* INHERIT  */
+    INHERITS = 447,                /* INHERITS  */
+    INITIALLY = 448,               /* INITIALLY  */
+    INLINE_P = 449,                /* INLINE_P  */
+    INNER_P = 450,                 /* INNER_P  */
+    INOUT = 451,                   /* INOUT  */
+    INPUT_P = 452,                 /* INPUT_P  */
+    INSENSITIVE = 453,             /* INSENSITIVE  */
+    INSERT = 454,                  /* INSERT  */
+    INSTEAD = 455,                 /* INSTEAD  */
+    INT_P = 456,                   /* INT_P  */
+    INTEGER = 457,                 /* INTEGER  */
+    INTERSECT = 458,               /* INTERSECT  */
+    INTERVAL = 459,                /* INTERVAL  */
+    INTO = 460,                    /* INTO  */
+    INVOKER = 461,                 /* INVOKER  */
+    IS = 462,                      /* IS  */
+    ISNULL = 463,                  /* ISNULL  */
+    ISOLATION = 464,               /* ISOLATION  */
+    JOIN = 465,                    /* JOIN  */
+    KEY = 466,                     /* KEY  */
+    LABEL = 467,                   /* LABEL  */
+    LANGUAGE = 468,                /* LANGUAGE  */
+    LARGE_P = 469,                 /* LARGE_P  */
+    LAST_P = 470,                  /* LAST_P  */
+    LATERAL_P = 471,               /* LATERAL_P  */
+    LEADING = 472,                 /* LEADING  */
+    LEAKPROOF = 473,               /* LEAKPROOF  */
+    LEAST = 474,                   /* LEAST  */
+    LEFT = 475,                    /* LEFT  */
+    LEVEL = 476,                   /* LEVEL  */
+    LIKE = 477,                    /* LIKE  */
+    LIMIT = 478,                   /* LIMIT  */
+    LISTEN = 479,                  /* LISTEN  */
+    LOAD = 480,                    /* LOAD  */
+    LOCAL = 481,                   /* LOCAL  */
+    LOCALTIME = 482,               /* LOCALTIME  */
+    LOCALTIMESTAMP = 483,          /* LOCALTIMESTAMP  */
+    LOCATION = 484,                /* LOCATION  */
+    LOCK_P = 485,                  /* LOCK_P  */
+    LOCKED = 486,                  /* LOCKED  */
+    LOGGED = 487,                  /* LOGGED  */
+    MAPPING = 488,                 /* MAPPING  */
+    MATCH = 489,                   /* MATCH  */
+    MATERIALIZED = 490,            /* MATERIALIZED  */
+    MAXVALUE = 491,                /* MAXVALUE  */
+    METHOD = 492,                  /* METHOD  */
+    MINUTE_P = 493,                /* MINUTE_P  */
+    MINVALUE = 494,                /* MINVALUE  */
+    MODE = 495,                    /* MODE  */
+    MONTH_P = 496,                 /* MONTH_P  */
+    MOVE = 497,                    /* MOVE  */
+    NAME_P = 498,                  /* NAME_P  */
+    NAMES = 499,                   /* NAMES  */
+    NATIONAL = 500,                /* NATIONAL  */
+    NATURAL = 501,                 /* NATURAL  */
+    NCHAR = 502,                   /* NCHAR  */
+    NEW = 503,                     /* NEW  */
+    NEXT = 504,                    /* NEXT  */
+    NO = 505,                      /* NO  */
+    NONE = 506,                    /* NONE  */
+    NOT = 507,                     /* NOT  */
+    NOTHING = 508,                 /* NOTHING  */
+    NOTIFY = 509,                  /* NOTIFY  */
+    NOTNULL = 510,                 /* NOTNULL  */
+    NOWAIT = 511,                  /* NOWAIT  */
+    NULL_P = 512,                  /* NULL_P  */
+    NULLIF = 513,                  /* NULLIF  */
+    NULLS_P = 514,                 /* NULLS_P  */
+    NUMERIC = 515,                 /* NUMERIC  */
+    OBJECT_P = 516,                /* OBJECT_P  */
+    OF = 517,                      /* OF  */
+    OFF = 518,                     /* OFF  */
+    OFFSET = 519,                  /* OFFSET  */
+    OIDS = 520,                    /* OIDS  */
+    OLD = 521,                     /* OLD  */
+    ON = 522,                      /* ON  */
+    ONLY = 523,                    /* ONLY  */
+    OPERATOR = 524,                /* OPERATOR  */
+    OPTION = 525,                  /* OPTION  */
+    OPTIONS = 526,                 /* OPTIONS  */
+    OR = 527,                      /* OR  */
+    ORDER = 528,                   /* ORDER  */
+    ORDINALITY = 529,              /* ORDINALITY  */
+    OUT_P = 530,                   /* OUT_P  */
+    OUTER_P = 531,                 /* OUTER_P  */
+    OVER = 532,                    /* OVER  */
+    OVERLAPS = 533,                /* OVERLAPS  */
+    OVERLAY = 534,                 /* OVERLAY  */
+    OVERRIDING = 535,              /* OVERRIDING  */
+    OWNED = 536,                   /* OWNED  */
+    OWNER = 537,                   /* OWNER  */
+    PARALLEL = 538,                /* PARALLEL  */
+    PARSER = 539,                  /* PARSER  */
+    PARTIAL = 540,                 /* PARTIAL  */
+    PARTITION = 541,               /* PARTITION  */
+    PASSING = 542,                 /* PASSING  */
+    PASSWORD = 543,                /* PASSWORD  */
+    PLACING = 544,                 /* PLACING  */
+    PLANS = 545,                   /* PLANS  */
+    POLICY = 546,                  /* POLICY  */
+    POSITION = 547,                /* POSITION  */
+    PRECEDING = 548,               /* PRECEDING  */
+    PRECISION = 549,               /* PRECISION  */
+    PRESERVE = 550,                /* PRESERVE  */
+    PREPARE = 551,                 /* PREPARE  */
+    PREPARED = 552,                /* PREPARED  */
+    PRIMARY = 553,                 /* PRIMARY  */
+    PRIOR = 554,                   /* PRIOR  */
+    PRIVILEGES = 555,              /* PRIVILEGES  */
+    PROCEDURAL = 556,              /* PROCEDURAL  */
+    PROCEDURE = 557,               /* PROCEDURE  */
+    PROGRAM = 558,                 /* PROGRAM  */
+    PUBLICATION = 559,             /* PUBLICATION  */
+    QUOTE = 560,                   /* QUOTE  */
+    RANGE = 561,                   /* RANGE  */
+    READ = 562,                    /* READ  */
+    REAL = 563,                    /* REAL  */
+    REASSIGN = 564,                /* REASSIGN  */
+    RECHECK = 565,                 /* RECHECK  */
+    RECURSIVE = 566,               /* RECURSIVE  */
+    REF = 567,                     /* REF  */
+    REFERENCES = 568,              /* REFERENCES  */
+    REFERENCING = 569,             /* REFERENCING  */
+    REFRESH = 570,                 /* REFRESH  */
+    REINDEX = 571,                 /* REINDEX  */
+    RELATIVE_P = 572,              /* RELATIVE_P  */
+    RELEASE = 573,                 /* RELEASE  */
+    RENAME = 574,                  /* RENAME  */
+    REPEATABLE = 575,              /* REPEATABLE  */
+    REPLACE = 576,                 /* REPLACE  */
+    REPLICA = 577,                 /* REPLICA  */
+    RESET = 578,                   /* RESET  */
+    RESTART = 579,                 /* RESTART  */
+    RESTRICT = 580,                /* RESTRICT  */
+    RETURNING = 581,               /* RETURNING  */
+    RETURNS = 582,                 /* RETURNS  */
+    REVOKE = 583,                  /* REVOKE  */
+    RIGHT = 584,                   /* RIGHT  */
+    ROLE = 585,                    /* ROLE  */
+    ROLLBACK = 586,                /* ROLLBACK  */
+    ROLLUP = 587,                  /* ROLLUP  */
+    ROW = 588,                     /* ROW  */
+    ROWS = 589,                    /* ROWS  */
+    RULE = 590,                    /* RULE  */
+    SAVEPOINT = 591,               /* SAVEPOINT  */
+    SCHEMA = 592,                  /* SCHEMA  */
+    SCHEMAS = 593,                 /* SCHEMAS  */
+    SCROLL = 594,                  /* SCROLL  */
+    SEARCH = 595,                  /* SEARCH  */
+    SECOND_P = 596,                /* SECOND_P  */
+    SECURITY = 597,                /* SECURITY  */
+    SELECT = 598,                  /* SELECT  */
+    SEQUENCE = 599,                /* SEQUENCE  */
+    SEQUENCES = 600,               /* SEQUENCES  */
+    SERIALIZABLE = 601,            /* SERIALIZABLE  */
+    SERVER = 602,                  /* SERVER  */
+    SESSION = 603,                 /* SESSION  */
+    SESSION_USER = 604,            /* SESSION_USER  */
+    SET = 605,                     /* SET  */
+    SETS = 606,                    /* SETS  */
+    SETOF = 607,                   /* SETOF  */
+    SHARE = 608,                   /* SHARE  */
+    SHOW = 609,                    /* SHOW  */
+    SIMILAR = 610,                 /* SIMILAR  */
+    SIMPLE = 611,                  /* SIMPLE  */
+    SKIP = 612,                    /* SKIP  */
+    SMALLINT = 613,                /* SMALLINT  */
+    SNAPSHOT = 614,                /* SNAPSHOT  */
+    SOME = 615,                    /* SOME  */
+    SQL_P = 616,                   /* SQL_P  */
+    STABLE = 617,                  /* STABLE  */
+    STANDALONE_P = 618,            /* STANDALONE_P  */
+    START = 619,                   /* START  */
+    STATEMENT = 620,               /* STATEMENT  */
+    STATISTICS = 621,              /* STATISTICS  */
+    STDIN = 622,                   /* STDIN  */
+    STDOUT = 623,                  /* STDOUT  */
+    STORAGE = 624,                 /* STORAGE  */
+    STRICT_P = 625,                /* STRICT_P  */
+    STRIP_P = 626,                 /* STRIP_P  */
+    SUBSCRIPTION = 627,            /* SUBSCRIPTION  */
+    SUBSTRING = 628,               /* SUBSTRING  */
+    SYMMETRIC = 629,               /* SYMMETRIC  */
+    SYSID = 630,                   /* SYSID  */
+    SYSTEM_P = 631,                /* SYSTEM_P  */
+    TABLE = 632,                   /* TABLE  */
+    TABLES = 633,                  /* TABLES  */
+    TABLESAMPLE = 634,             /* TABLESAMPLE  */
+    TABLESPACE = 635,              /* TABLESPACE  */
+    TEMP = 636,                    /* TEMP  */
+    TEMPLATE = 637,                /* TEMPLATE  */
+    TEMPORARY = 638,               /* TEMPORARY  */
+    TEXT_P = 639,                  /* TEXT_P  */
+    THEN = 640,                    /* THEN  */
+    TIME = 641,                    /* TIME  */
+    TIMESTAMP = 642,               /* TIMESTAMP  */
+    TO = 643,                      /* TO  */
+    TRAILING = 644,                /* TRAILING  */
+    TRANSACTION = 645,             /* TRANSACTION  */
+    TRANSFORM = 646,               /* TRANSFORM  */
+    TREAT = 647,                   /* TREAT  */
+    TRIGGER = 648,                 /* TRIGGER  */
+    TRIM = 649,                    /* TRIM  */
+    TRUE_P = 650,                  /* TRUE_P  */
+    TRUNCATE = 651,                /* TRUNCATE  */
+    TRUSTED = 652,                 /* TRUSTED  */
+    TYPE_P = 653,                  /* TYPE_P  */
+    TYPES_P = 654,                 /* TYPES_P  */
+    UNBOUNDED = 655,               /* UNBOUNDED  */
+    UNCOMMITTED = 656,             /* UNCOMMITTED  */
+    UNENCRYPTED = 657,             /* UNENCRYPTED  */
+    UNION = 658,                   /* UNION  */
+    UNIQUE = 659,                  /* UNIQUE  */
+    UNKNOWN = 660,                 /* UNKNOWN  */
+    UNLISTEN = 661,                /* UNLISTEN  */
+    UNLOGGED = 662,                /* UNLOGGED  */
+    UNTIL = 663,                   /* UNTIL  */
+    UPDATE = 664,                  /* UPDATE  */
+    USER = 665,                    /* USER  */
+    USING = 666,                   /* USING  */
+    VACUUM = 667,                  /* VACUUM  */
+    VALID = 668,                   /* VALID  */
+    VALIDATE = 669,                /* VALIDATE  */
+    VALIDATOR = 670,               /* VALIDATOR  */
+    VALUE_P = 671,                 /* VALUE_P  */
+    VALUES = 672,                  /* VALUES  */
+    VARCHAR = 673,                 /* VARCHAR  */
+    VARIADIC = 674,                /* VARIADIC  */
+    VARYING = 675,                 /* VARYING  */
+    VERBOSE = 676,                 /* VERBOSE  */
+    VERSION_P = 677,               /* VERSION_P  */
+    VIEW = 678,                    /* VIEW  */
+    VIEWS = 679,                   /* VIEWS  */
+    VOLATILE = 680,                /* VOLATILE  */
+    WHEN = 681,                    /* WHEN  */
+    WHERE = 682,                   /* WHERE  */
+    WHITESPACE_P = 683,            /* WHITESPACE_P  */
+    WINDOW = 684,                  /* WINDOW  */
+    WITH = 685,                    /* WITH  */
+    WITHIN = 686,                  /* WITHIN  */
+    WITHOUT = 687,                 /* WITHOUT  */
+    WORK = 688,                    /* WORK  */
+    WRAPPER = 689,                 /* WRAPPER  */
+    WRITE = 690,                   /* WRITE  */
+    XML_P = 691,                   /* XML_P  */
+    XMLATTRIBUTES = 692,           /* XMLATTRIBUTES  */
+    XMLCONCAT = 693,               /* XMLCONCAT  */
+    XMLELEMENT = 694,              /* XMLELEMENT  */
+    XMLEXISTS = 695,               /* XMLEXISTS  */
+    XMLFOREST = 696,               /* XMLFOREST  */
+    XMLNAMESPACES = 697,           /* XMLNAMESPACES  */
+    XMLPARSE = 698,                /* XMLPARSE  */
+    XMLPI = 699,                   /* XMLPI  */
+    XMLROOT = 700,                 /* XMLROOT  */
+    XMLSERIALIZE = 701,            /* XMLSERIALIZE  */
+    XMLTABLE = 702,                /* XMLTABLE  */
+    YEAR_P = 703,                  /* YEAR_P  */
+    YES_P = 704,                   /* YES_P  */
+    ZONE = 705,                    /* ZONE  */
+    NOT_LA = 706,                  /* NOT_LA  */
+    NULLS_LA = 707,                /* NULLS_LA  */
+    WITH_LA = 708,                 /* WITH_LA  */
+    POSTFIXOP = 709,               /* POSTFIXOP  */
+    UMINUS = 710                   /* UMINUS  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 202 "gram.y"
+
+	core_YYSTYPE		core_yystype;
+	/* these fields must match core_YYSTYPE: */
+	int					ival;
+	char				*str;
+	const char			*keyword;
+
+	char				chr;
+	bool				boolean;
+	JoinType			jtype;
+	DropBehavior		dbehavior;
+	OnCommitAction		oncommit;
+	List				*list;
+	Node				*node;
+	Value				*value;
+	ObjectType			objtype;
+	TypeName			*typnam;
+	FunctionParameter   *fun_param;
+	FunctionParameterMode fun_param_mode;
+	ObjectWithArgs		*objwithargs;
+	DefElem				*defelt;
+	SortBy				*sortby;
+	WindowDef			*windef;
+	JoinExpr			*jexpr;
+	IndexElem			*ielem;
+	Alias				*alias;
+	RangeVar			*range;
+	IntoClause			*into;
+	WithClause			*with;
+	InferClause			*infer;
+	OnConflictClause	*onconflict;
+	A_Indices			*aind;
+	ResTarget			*target;
+	struct PrivTarget	*privtarget;
+	AccessPriv			*accesspriv;
+	struct ImportQual	*importqual;
+	InsertStmt			*istmt;
+	VariableSetStmt		*vsetstmt;
+	PartitionElem		*partelem;
+	PartitionSpec		*partspec;
+	PartitionBoundSpec	*partboundspec;
+	RoleSpec			*rolespec;
+
+#line 563 "gram.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+/* Location type.  */
+#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
+{
+  int first_line;
+  int first_column;
+  int last_line;
+  int last_column;
+};
+# define YYLTYPE_IS_DECLARED 1
+# define YYLTYPE_IS_TRIVIAL 1
+#endif
+
+
+
+
+int base_yyparse (core_yyscan_t yyscanner);
+
+
+#endif /* !YY_BASE_YY_GRAM_H_INCLUDED  */
@@ -0,0 +1,144 @@
+/*-------------------------------------------------------------------------
+ *
+ * simd.h
+ *	  Support for searching byte strings many bytes at a time.
+ *
+ * A ByteScan holds a small set of "special" bytes to look for, and
+ * byte_scan_find() returns the position of the first of them in a string.
+ * This is for inner loops, such as COPY's input parsing, that have to look
+ * at every byte of their input but do nothing for most of them.
+ *
+ * On x86-64 we use SSE2, which all processors of the architecture have, to
+ * compare 16 bytes at a time with all the special bytes.  Elsewhere we
+ * compare 8 bytes at a time using ordinary 64-bit integer arithmetic.  Both
+ * finish the last few bytes of the string one at a time.
+ *
+ * Portions Copyright (c) 1996-2017, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/port/simd.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__x86_64__) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define USE_SSE2
+#endif
+
+/* Maximum number of special bytes a ByteScan can look for */
+#define BYTE_SCAN_MAX_BYTES		4
+
+/*
+ * The vectors of copies of each byte are cheap to build, and are made by
+ * byte_scan_find itself, so that a ByteScan doesn't need any particular
+ * alignment.
+ */
+typedef struct ByteScan
+{
+	char		bytes[BYTE_SCAN_MAX_BYTES];
+} ByteScan;
+
+/*
+ * Set up a ByteScan to look for the given bytes.
+ *
+ * The same byte may be given more than once; the unused slots are filled
+ * with copies of the first one, so that the search always makes the same
+ * comparisons.
+ */
+static inline void
+byte_scan_init(ByteScan *scan, const char *bytes, int nbytes)
+{
+	int			i;
+
+	Assert(nbytes > 0 && nbytes <= BYTE_SCAN_MAX_BYTES);
+
+	for (i = 0; i < BYTE_SCAN_MAX_BYTES; i++)
+		scan->bytes[i] = bytes[i < nbytes ? i : 0];
+}
+
+/*
+ * Return the offset of the first byte in s[0..len-1] that is one of the
+ * ByteScan's special bytes, or len if there is none.
+ */
+static inline int
+byte_scan_find(const ByteScan *scan, const char *s, int len)
+{
+	int			i = 0;
+
+#ifdef USE_SSE2
+	__m128i		v0 = _mm_set1_epi8(scan->bytes[0]);
+	__m128i		v1 = _mm_set1_epi8(scan->bytes[1]);
+	__m128i		v2 = _mm_set1_epi8(scan->bytes[2]);
+	__m128i		v3 = _mm_set1_epi8(scan->bytes[3]);
+
+	for (; i + (int) sizeof(__m128i) <= len; i += sizeof(__m128i))
+	{
+		__m128i		chunk = _mm_loadu_si128((const __m128i *) (s + i));
+		__m128i		hits;
+		int			mask;
+
+		hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v0),
+										 _mm_cmpeq_epi8(chunk, v1)),
+							_mm_or_si128(_mm_cmpeq_epi8(chunk, v2),
+										 _mm_cmpeq_epi8(chunk, v3)));
+		mask = _mm_movemask_epi8(hits);
+		if (mask != 0)
+		{
+			/* bit n of mask is set if byte n matched */
+			while ((mask & 1) == 0)
+			{
+				mask >>= 1;
+				i++;
+			}
+			return i;
+		}
+	}
+#else
+	uint64		vbytes[BYTE_SCAN_MAX_BYTES];
+	int			j;
+
+	/* each special byte, 8 times */
+	for (j = 0; j < BYTE_SCAN_MAX_BYTES; j++)
+		vbytes[j] = UINT64CONST(0x0101010101010101) *
+			(unsigned char) scan->bytes[j];
+
+	for (; i + (int) sizeof(uint64) <= len; i += sizeof(uint64))
+	{
+		uint64		chunk;
+		uint64		hits = 0;
+
+		memcpy(&chunk, s + i, sizeof(uint64));
+
+		/*
+		 * A byte of chunk ^ vbytes[j] is zero if it matched.  This sets the
+		 * high bit of each byte that is zero, without carries from one byte
+		 * to the next.
+		 */
+		for (j = 0; j < BYTE_SCAN_MAX_BYTES; j++)
+		{
+			uint64		x = chunk ^ vbytes[j];
+
+			hits |= ~(((x & UINT64CONST(0x7F7F7F7F7F7F7F7F)) +
+					   UINT64CONST(0x7F7F7F7F7F7F7F7F)) | x);
+		}
+		if ((hits & UINT64CONST(0x8080808080808080)) != 0)
+			break;				/* find the matching byte below */
+	}
+#endif
+
+	for (; i < len; i++)
+	{
+		char		c = s[i];
+
+		if (c == scan->bytes[0] || c == scan->bytes[1] ||
+			c == scan->bytes[2] || c == scan->bytes[3])
+			break;
+	}
+
+	return i;
+}
+
+#endif							/* SIMD_H */
@@ -0,0 +1 @@
+/* src/include/port/win32_msvc/utime.h */
@@ -0,0 +1,14 @@
+/* src/test/modules/test_simd/test_simd--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION test_simd" to load this file. \quit
+
+CREATE FUNCTION test_byte_scan(size INTEGER)
+	RETURNS pg_catalog.void STRICT
+	AS 'MODULE_PATHNAME' LANGUAGE C;
+
+CREATE FUNCTION bench_byte_scan(data TEXT, special TEXT, loops INTEGER,
+	OUT bytewise_found BIGINT, OUT bytewise_ms FLOAT8,
+	OUT scan_found BIGINT, OUT scan_ms FLOAT8)
+	RETURNS record STRICT
+	AS 'MODULE_PATHNAME' LANGUAGE C;